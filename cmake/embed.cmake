@@ -101,22 +101,25 @@ endfunction()
 function(embed_file OUTPUT_FILE OUTPUT_SYMBOL FILE)
     set(${OUTPUT_FILE} "${FILE}.o" PARENT_SCOPE)
     set(WORKING_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR})
-    # Glob is used to compute the relative path
     get_filename_component(OUTPUT_FILE_DIR "${FILE}" DIRECTORY)
-    file(MAKE_DIRECTORY "${WORKING_DIRECTORY}/${OUTPUT_FILE_DIR}")
-    file(GLOB FILES RELATIVE ${WORKING_DIRECTORY} ${FILE})
-    foreach(REL_FILE ${FILES})
-        string(MAKE_C_IDENTIFIER "${REL_FILE}" SYMBOL)
-        set(${OUTPUT_SYMBOL} ${SYMBOL} PARENT_SCOPE)
-        add_custom_command(
-            OUTPUT "${FILE}.o"
-            COMMAND ${EMBED_LD} -r -o "${FILE}.o" -z noexecstack --format=binary "${REL_FILE}" 
-            COMMAND ${EMBED_OBJCOPY} --rename-section .data=.rodata,alloc,load,readonly,data,contents "${FILE}.o"
-            WORKING_DIRECTORY ${WORKING_DIRECTORY}
-            DEPENDS ${FILE}
-            VERBATIM
-        )
-    endforeach()
+    if(IS_ABSOLUTE "${FILE}")
+        file(MAKE_DIRECTORY "${OUTPUT_FILE_DIR}")
+    else()
+        file(MAKE_DIRECTORY "${WORKING_DIRECTORY}/${OUTPUT_FILE_DIR}")
+    endif()
+    # The relative path is computed without globbing as the file may be generated at build time
+    get_filename_component(ABS_FILE "${FILE}" ABSOLUTE)
+    file(RELATIVE_PATH REL_FILE ${WORKING_DIRECTORY} ${ABS_FILE})
+    string(MAKE_C_IDENTIFIER "${REL_FILE}" SYMBOL)
+    set(${OUTPUT_SYMBOL} ${SYMBOL} PARENT_SCOPE)
+    add_custom_command(
+        OUTPUT "${FILE}.o"
+        COMMAND ${EMBED_LD} -r -o "${FILE}.o" -z noexecstack --format=binary "${REL_FILE}" 
+        COMMAND ${EMBED_OBJCOPY} --rename-section .data=.rodata,alloc,load,readonly,data,contents "${FILE}.o"
+        WORKING_DIRECTORY ${WORKING_DIRECTORY}
+        DEPENDS ${ABS_FILE}
+        VERBATIM
+    )
 endfunction()
 
 function(add_embed_library EMBED_NAME)
@@ -0,0 +1,148 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/binary_db.hpp>
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+void PrintHelp()
+{
+    std::cout << "Usage: dbconvert {<option>}" << std::endl;
+    std::cout << "Converts a text find-db to the binary form." << std::endl;
+    std::cout << "Option format: -<option name>[ <option value>]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "[REQUIRED] -s[ource] <path>: text db to be converted." << std::endl;
+    std::cout << "           -t[arget] <path>: target file. Default: source with .txt replaced "
+                 "by .bin."
+              << std::endl;
+}
+
+[[gnu::noreturn]] void WrongUsage(const std::string& error)
+{
+    std::cout << "Wrong usage: " << error << std::endl;
+    std::cout << std::endl;
+    PrintHelp();
+    std::exit(1);
+}
+
+[[gnu::noreturn]] void UnknownArgument(const std::string& arg)
+{
+    std::ostringstream ss;
+    ss << "unknown argument - " << arg;
+    WrongUsage(ss.str());
+}
+
+int Convert(const std::string& sourcePath, const std::string& targetPath)
+{
+    std::ifstream sourceFile(sourcePath, std::ios::in | std::ios::binary);
+
+    if(!sourceFile.good())
+    {
+        std::cerr << "File not found: " << sourcePath << std::endl;
+        return 1;
+    }
+
+    const std::string text{std::istreambuf_iterator<char>{sourceFile},
+                           std::istreambuf_iterator<char>{}};
+
+    // The library checks the contents of the text db only if its modification time differs.
+    struct stat sourceStat;
+    const auto sourceTime = stat(sourcePath.c_str(), &sourceStat) == 0
+                                ? static_cast<std::int64_t>(sourceStat.st_mtime)
+                                : std::int64_t{0};
+
+    // Written to a temporary file first so an interrupted build never leaves a truncated db.
+    const auto tempPath = targetPath + ".tmp";
+    std::ofstream targetFile(tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+    const auto stats = miopen::WriteBinaryDb(text.data(), text.size(), sourceTime, targetFile);
+    targetFile.close();
+
+    if(!targetFile)
+    {
+        std::cerr << "Unable to write: " << tempPath << std::endl;
+        return 1;
+    }
+
+    for(const auto line : stats.ill_formed_lines)
+        std::cerr << "Ill-formed record: key not found: " << sourcePath << "#" << line
+                  << std::endl;
+    for(const auto line : stats.duplicate_lines)
+        std::cerr << "Duplicate key, the record is ignored: " << sourcePath << "#" << line
+                  << std::endl;
+
+    if(std::rename(tempPath.c_str(), targetPath.c_str()) != 0)
+    {
+        std::cerr << "Unable to rename " << tempPath << " to " << targetPath << std::endl;
+        return 1;
+    }
+
+    std::cout << sourcePath << ": " << stats.records << " records" << std::endl;
+    return 0;
+}
+
+int main(int argsn, char** args)
+{
+    if(argsn == 1)
+    {
+        PrintHelp();
+        return 2;
+    }
+
+    std::string source;
+    std::string target;
+
+    int i = 0;
+    while(++i < argsn)
+    {
+        std::string arg(args[i] + 1);
+        std::transform(arg.begin(), arg.end(), arg.begin(), ::tolower);
+
+        if(i + 1 >= argsn)
+            WrongUsage("value expected for " + arg);
+
+        if(arg == "s" || arg == "source")
+            source = args[++i];
+        else if(arg == "t" || arg == "target")
+            target = args[++i];
+        else
+            UnknownArgument(arg);
+    }
+
+    if(source.empty())
+        WrongUsage("source key is required");
+
+    return Convert(source, target.empty() ? miopen::GetBinaryDbPath(source) : target);
+}
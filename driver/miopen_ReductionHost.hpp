@@ -39,78 +39,6 @@
 
 using float16 = half_float::half;
 
-static inline void
-get_all_indexes(const std::vector<int>& dimLengths, int dim, std::vector<std::vector<int>>& indexes)
-{
-    if(dim < dimLengths.size())
-    {
-        std::vector<std::vector<int>> updated_indexes;
-
-        if(dim == 0)
-        {
-            for(int i = 0; i < dimLengths[dim]; i++)
-            {
-                std::vector<int> index = {i};
-
-                updated_indexes.push_back(index);
-            };
-        }
-        else
-        {
-            // go through all the current indexes
-            for(const auto& index : indexes)
-                for(int i = 0; i < dimLengths[dim]; i++)
-                {
-                    auto index_new = index; // explicit copying
-
-                    index_new.push_back(i);
-
-                    updated_indexes.push_back(index_new);
-                };
-        };
-
-        // update to the indexes (output)
-        indexes = updated_indexes;
-
-        // further to construct the indexes from the updated status
-        get_all_indexes(dimLengths, dim + 1, indexes);
-    };
-};
-
-static inline int get_offset_from_index(const std::vector<int>& strides,
-                                        const std::vector<int>& index)
-{
-    int offset = 0;
-
-    assert(index.size() == strides.size());
-    for(int i = 0; i < index.size(); i++)
-        offset += strides[i] * index[i];
-
-    return (offset);
-};
-
-static inline int get_flatten_offset(const std::vector<int>& lengths, const std::vector<int>& index)
-{
-    int offset = 0;
-
-    assert(lengths.size() == index.size() && lengths.size() > 0);
-
-    int len    = lengths.size();
-    int stride = 1;
-
-    // for len==1, the loop is not executed
-    for(int i = len - 1; i > 0; i--)
-    {
-        offset += stride * index[i];
-
-        stride *= lengths[i];
-    };
-
-    offset += stride * index[0];
-
-    return (offset);
-};
-
 template <typename Tgpu, typename Tref>
 class miopenReductionHost
 {
@@ -135,14 +63,6 @@ class miopenReductionHost
 
         assert(this->inLengths.size() == this->outLengths.size());
         assert(!this->toReduceDims.empty());
-
-        for(const auto dim : this->invariantDims)
-            this->invariantLengths.push_back(this->inLengths[dim]);
-
-        for(const auto dim : this->toReduceDims)
-            toReduceLengths.push_back(this->inLengths[dim]);
-
-        this->reduceAllDims = this->invariantDims.empty();
     };
 
     ~miopenReductionHost(){};
@@ -179,14 +99,9 @@ class miopenReductionHost
     std::vector<int> inStrides;
     std::vector<int> outStrides;
 
-    std::vector<int> invariantLengths;
-    std::vector<int> toReduceLengths;
-
     std::vector<int> invariantDims;
     std::vector<int> toReduceDims;
 
-    bool reduceAllDims;
-
     template <typename compType>
     void RunImpl(Tgpu alpha, const Tgpu* in_data, Tgpu beta, Tref* out_data, int* indices)
     {
@@ -211,28 +126,33 @@ class miopenReductionHost
         using reduce::convert_type;
         using reduce::binop_with_nan_check;
         using reduce::binop_with_nan_check2;
+        using reduce::reduce_index_space;
 
         auto opReduce = ReduceOpFn2<compType>(this->reduceOp);
 
-        if(reduceAllDims)
-        {
-            std::vector<std::vector<int>> indexes_1;
-
-            get_all_indexes(inLengths, 0, indexes_1); // generate the input indexes space
+        const reduce_index_space indexSpace(this->inLengths,
+                                            this->inStrides,
+                                            this->outStrides,
+                                            this->invariantDims,
+                                            this->toReduceDims);
 
+        // go through the output elements, each of them reduces its own part of the input
+        indexSpace.for_each_output([&](std::size_t first_offset, std::size_t dst_offset) {
             auto accuVal  = ReduceOpZeroVal<compType>(this->reduceOp);
             int accuIndex = 0;
 
-            // go through indexes of the invariant dimensions
-            for(const auto& src_index : indexes_1)
-            {
-                auto src_offset = get_offset_from_index(this->inStrides, src_index);
-
-                auto currVal = convert_type<compType>(in_data[src_offset]);
+            // go through the inputs along the toReduce dimensions
+            indexSpace.for_each_reduced(
+                first_offset, [&](std::size_t src_offset, std::size_t currIndex) {
+                    auto currVal = convert_type<compType>(in_data[src_offset]);
 
-                auto currIndex = get_flatten_offset(inLengths, src_index);
-                binop_with_nan_check2(nanOpt, opReduce, accuVal, currVal, accuIndex, currIndex);
-            };
+                    binop_with_nan_check2(nanOpt,
+                                          opReduce,
+                                          accuVal,
+                                          currVal,
+                                          accuIndex,
+                                          static_cast<int>(currIndex));
+                });
 
             // scale the accumulated value
             if(!float_equal_one(alpha))
@@ -240,74 +160,12 @@ class miopenReductionHost
 
             // scale the prior dst value and add it to the accumulated value
             if(!float_equal_zero(beta))
-                accuVal += convert_type<compType>(out_data[0] * convert_type<Tref>(beta));
+                accuVal += convert_type<compType>(out_data[dst_offset] * convert_type<Tref>(beta));
 
             // store the reduced value to dst location
-            out_data[0] = convert_type<Tref>(accuVal);
-            indices[0]  = accuIndex;
-        }
-        else
-        {
-            std::vector<std::vector<int>> indexes_1, indexes_2;
-
-            get_all_indexes(
-                this->invariantLengths, 0, indexes_1); // generate the invariant indexes space
-            get_all_indexes(
-                this->toReduceLengths, 0, indexes_2); // generate the toReduce indexes space
-
-            // go through indexes of the invariant dimensions
-            for(const auto& index_1 : indexes_1)
-            {
-                std::vector<int> src_index;
-                std::vector<int> dst_index;
-
-                src_index.resize(this->inLengths.size());
-                dst_index.resize(this->inLengths.size());
-
-                // initialize the src index
-                std::fill(dst_index.begin(), dst_index.end(), 0);
-
-                for(int k                       = 0; k < invariantDims.size(); k++)
-                    dst_index[invariantDims[k]] = index_1[k];
-
-                int dst_offset = get_offset_from_index(this->outStrides, dst_index);
-
-                // generate the part of src index belonging to invariant dims
-                for(int k                       = 0; k < invariantDims.size(); k++)
-                    src_index[invariantDims[k]] = index_1[k];
-
-                compType accuVal = ReduceOpZeroVal<compType>(this->reduceOp);
-                int accuIndex    = 0;
-
-                // go through indexes of the toReduce dimensions
-                for(const auto& index_2 : indexes_2)
-                {
-                    // generate the part of src index belonging to toReduce dims
-                    for(int k                      = 0; k < toReduceDims.size(); k++)
-                        src_index[toReduceDims[k]] = index_2[k];
-
-                    auto src_offset = get_offset_from_index(this->inStrides, src_index);
-
-                    auto currVal = convert_type<compType>(in_data[src_offset]);
-
-                    auto currIndex = get_flatten_offset(toReduceLengths, index_2);
-                    binop_with_nan_check2(nanOpt, opReduce, accuVal, currVal, accuIndex, currIndex);
-                };
-
-                // scale the accumulated value
-                if(!float_equal_one(alpha))
-                    accuVal *= convert_type<compType>(alpha);
-
-                // scale the prior dst value and add it to the accumulated value
-                if(!float_equal_zero(beta))
-                    accuVal +=
-                        convert_type<compType>(out_data[dst_offset] * convert_type<Tref>(beta));
-
-                // store the reduced value to dst location
-                out_data[dst_offset] = convert_type<Tref>(accuVal);
-                indices[dst_offset]  = accuIndex;
-            };
-        };
+            out_data[dst_offset] = convert_type<Tref>(accuVal);
+            indices[dst_offset]  = accuIndex;
+        });
     }; // end of RunImpl_with_indices()
 
     template <typename compType>
@@ -320,26 +178,26 @@ class miopenReductionHost
         using reduce::convert_type;
         using reduce::binop_with_nan_check;
         using reduce::binop_with_nan_check2;
+        using reduce::reduce_index_space;
 
         auto opReduce = ReduceOpFn<compType>(this->reduceOp);
 
-        if(reduceAllDims)
-        {
-            std::vector<std::vector<int>> indexes_1;
-
-            get_all_indexes(inLengths, 0, indexes_1); // generate the input indexes space
+        const reduce_index_space indexSpace(this->inLengths,
+                                            this->inStrides,
+                                            this->outStrides,
+                                            this->invariantDims,
+                                            this->toReduceDims);
 
+        // go through the output elements, each of them reduces its own part of the input
+        indexSpace.for_each_output([&](std::size_t first_offset, std::size_t dst_offset) {
             auto accuVal = ReduceOpZeroVal<compType>(this->reduceOp);
 
-            // go through indexes of the invariant dimensions
-            for(const auto& src_index : indexes_1)
-            {
-                auto src_offset = get_offset_from_index(this->inStrides, src_index);
-
+            // go through the inputs along the toReduce dimensions
+            indexSpace.for_each_reduced(first_offset, [&](std::size_t src_offset, std::size_t) {
                 auto currVal = convert_type<compType>(in_data[src_offset]);
 
                 binop_with_nan_check(nanOpt, opReduce, accuVal, currVal);
-            };
+            });
 
             // scale the accumulated value
             if(!float_equal_one(alpha))
@@ -347,70 +205,11 @@ class miopenReductionHost
 
             // scale the prior dst value and add it to the accumulated value
             if(!float_equal_zero(beta))
-                accuVal += convert_type<compType>(out_data[0] * convert_type<Tref>(beta));
+                accuVal += convert_type<compType>(out_data[dst_offset] * convert_type<Tref>(beta));
 
             // store the reduced value to dst location
-            out_data[0] = convert_type<Tref>(accuVal);
-        }
-        else
-        {
-            std::vector<std::vector<int>> indexes_1, indexes_2;
-
-            get_all_indexes(
-                this->invariantLengths, 0, indexes_1); // generate the invariant indexes space
-            get_all_indexes(
-                this->toReduceLengths, 0, indexes_2); // generate the toReduce indexes space
-
-            // go through indexes of the invariant dimensions
-            for(const auto& index_1 : indexes_1)
-            {
-                std::vector<int> src_index;
-                std::vector<int> dst_index;
-
-                src_index.resize(this->inLengths.size());
-                dst_index.resize(this->inLengths.size());
-
-                // initialize the src index
-                std::fill(dst_index.begin(), dst_index.end(), 0);
-
-                for(int k                       = 0; k < invariantDims.size(); k++)
-                    dst_index[invariantDims[k]] = index_1[k];
-
-                int dst_offset = get_offset_from_index(this->outStrides, dst_index);
-
-                // generate the part of src index belonging to invariant dims
-                for(int k                       = 0; k < invariantDims.size(); k++)
-                    src_index[invariantDims[k]] = index_1[k];
-
-                compType accuVal = ReduceOpZeroVal<compType>(this->reduceOp);
-
-                // go through indexes of the toReduce dimensions
-                for(const auto& index_2 : indexes_2)
-                {
-                    // generate the part of src index belonging to toReduce dims
-                    for(int k                      = 0; k < toReduceDims.size(); k++)
-                        src_index[toReduceDims[k]] = index_2[k];
-
-                    auto src_offset = get_offset_from_index(this->inStrides, src_index);
-
-                    auto currVal = convert_type<compType>(in_data[src_offset]);
-
-                    binop_with_nan_check(nanOpt, opReduce, accuVal, currVal);
-                };
-
-                // scale the accumulated value
-                if(!float_equal_one(alpha))
-                    accuVal *= convert_type<compType>(alpha);
-
-                // scale the prior dst value and add it to the accumulated value
-                if(!float_equal_zero(beta))
-                    accuVal +=
-                        convert_type<compType>(out_data[dst_offset] * convert_type<Tref>(beta));
-
-                // store the reduced value to dst location
-                out_data[dst_offset] = convert_type<Tref>(accuVal);
-            };
-        };
+            out_data[dst_offset] = convert_type<Tref>(accuVal);
+        });
     }; // end of RunImpl_no_indices()
 };
 
@@ -243,6 +243,33 @@ MIOPEN_EXPORT miopenStatus_t miopenGetKernelTime(miopenHandle_t handle, float* t
  * @return           miopenStatus_t
 */
 MIOPEN_EXPORT miopenStatus_t miopenEnableProfiling(miopenHandle_t handle, bool enable);
+
+/*! @brief Get runtime statistics of the library
+ *
+ * Returns a snapshot of process-wide counters and histograms as a null-terminated JSON string:
+ * hits and misses of the kernel, invoker and binary caches and of the database lookups, and the
+ * time spent in database lookups, binary loads and kernel compilation.
+ *
+ * If buffer is nullptr, the size of the snapshot, including the terminating null character, is
+ * returned in size. Otherwise, the snapshot is copied to the buffer of the given size. If the
+ * buffer is too small, the required size is returned in size and miopenStatusBadParm is returned.
+ * The snapshot may grow between the calls, so a bit larger buffer should be provided.
+ *
+ * @param handle     MIOpen handle (input)
+ * @param buffer     Pointer to a buffer to contain the snapshot or nullptr (output)
+ * @param size       Size of the buffer in bytes (input) / size of the snapshot (output)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenGetStatistics(miopenHandle_t handle, char* buffer, size_t* size);
+
+/*! @brief Reset runtime statistics of the library
+ *
+ * Zeroes all the counters and histograms returned by miopenGetStatistics.
+ *
+ * @param handle     MIOpen handle (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenResetStatistics(miopenHandle_t handle);
 /** @} */
 // CLOSEOUT HANDLE DOXYGEN GROUP
 
@@ -0,0 +1,208 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/solver_ranking.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+void PrintHelp()
+{
+    std::cout << "Usage: solverrank {<option>}" << std::endl;
+    std::cout << "Trains the solver ranking model used by immediate mode on find-db miss, or "
+                 "evaluates it."
+              << std::endl;
+    std::cout << "Option format: -<option name>[ <option value>]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "[REQUIRED] -s[ource] <path>: text find-db to train on. May be repeated."
+              << std::endl;
+    std::cout << "           -t[arget] <path>: target file. Default: the first source with "
+                 ".fdb.txt replaced by .rank.bin."
+              << std::endl;
+    std::cout << "           -e[valuate] <percent>: instead of writing the model, hold out "
+                 "this percentage of records, train on the rest and report the accuracy."
+              << std::endl;
+    std::cout << "           -n[eighbours] <count>: neighbours used for evaluation. Default: "
+              << miopen::SolverRankingModel::default_neighbours << "." << std::endl;
+}
+
+[[gnu::noreturn]] void WrongUsage(const std::string& error)
+{
+    std::cout << "Wrong usage: " << error << std::endl;
+    std::cout << std::endl;
+    PrintHelp();
+    std::exit(1);
+}
+
+[[gnu::noreturn]] void UnknownArgument(const std::string& arg)
+{
+    std::ostringstream ss;
+    ss << "unknown argument - " << arg;
+    WrongUsage(ss.str());
+}
+
+bool ReadSamples(const std::vector<std::string>& sourcePaths,
+                 std::vector<miopen::SolverRankingSample>& samples)
+{
+    for(const auto& sourcePath : sourcePaths)
+    {
+        std::ifstream sourceFile(sourcePath, std::ios::in | std::ios::binary);
+
+        if(!sourceFile.good())
+        {
+            std::cerr << "File not found: " << sourcePath << std::endl;
+            return false;
+        }
+
+        const std::string text{std::istreambuf_iterator<char>{sourceFile},
+                               std::istreambuf_iterator<char>{}};
+        auto illFormed    = std::size_t{0};
+        const auto parsed = miopen::ParseSolverRankingSamples(text, illFormed);
+
+        if(illFormed != 0)
+            std::cerr << sourcePath << ": " << illFormed << " ill-formed records are ignored"
+                      << std::endl;
+
+        samples.insert(samples.end(), parsed.begin(), parsed.end());
+    }
+
+    return true;
+}
+
+int Train(const std::vector<std::string>& sourcePaths, const std::string& targetPath)
+{
+    auto samples = std::vector<miopen::SolverRankingSample>{};
+    if(!ReadSamples(sourcePaths, samples))
+        return 1;
+
+    const auto model = miopen::SolverRankingModel::Train(samples);
+
+    // Written to a temporary file first so an interrupted build never leaves a truncated model.
+    const auto tempPath = targetPath + ".tmp";
+    std::ofstream targetFile(tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+    model.Save(targetFile);
+    targetFile.close();
+
+    if(!targetFile)
+    {
+        std::cerr << "Unable to write: " << tempPath << std::endl;
+        return 1;
+    }
+
+    if(std::rename(tempPath.c_str(), targetPath.c_str()) != 0)
+    {
+        std::cerr << "Unable to rename " << tempPath << " to " << targetPath << std::endl;
+        return 1;
+    }
+
+    std::cout << targetPath << ": " << model.GetSampleCount() << " samples" << std::endl;
+    return 0;
+}
+
+int Evaluate(const std::vector<std::string>& sourcePaths, int percent, std::size_t neighbours)
+{
+    auto samples = std::vector<miopen::SolverRankingSample>{};
+    if(!ReadSamples(sourcePaths, samples))
+        return 1;
+
+    const auto accuracy =
+        miopen::EvaluateSolverRanking(samples, static_cast<unsigned>(percent), neighbours);
+    const auto ranked = accuracy.test_samples - accuracy.unranked;
+    const auto share  = [&](std::size_t count) {
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision(1)
+           << (ranked == 0 ? 0.0 : 100.0 * static_cast<double>(count) / ranked) << "%";
+        return ss.str();
+    };
+
+    std::cout << "Trained on: " << accuracy.train_samples << " records" << std::endl;
+    std::cout << "Held out: " << accuracy.test_samples << " records, " << accuracy.unranked
+              << " of them unranked" << std::endl;
+    std::cout << "Top-1 accuracy: " << share(accuracy.top1) << std::endl;
+    std::cout << "Top-3 accuracy: " << share(accuracy.top3) << std::endl;
+    std::cout << "Slowdown of the first ranked solver vs the fastest one: " << accuracy.slowdown
+              << std::endl;
+    std::cout << "Slowdown of GEMM vs the fastest solver: " << accuracy.gemm_slowdown << " ("
+              << accuracy.gemm_samples << " records)" << std::endl;
+    return 0;
+}
+
+int main(int argsn, char** args)
+{
+    if(argsn == 1)
+    {
+        PrintHelp();
+        return 2;
+    }
+
+    std::vector<std::string> sources;
+    std::string target;
+    int percent            = -1;
+    std::size_t neighbours = miopen::SolverRankingModel::default_neighbours;
+
+    int i = 0;
+    while(++i < argsn)
+    {
+        std::string arg(args[i] + 1);
+        std::transform(arg.begin(), arg.end(), arg.begin(), ::tolower);
+
+        if(i + 1 >= argsn)
+            WrongUsage("value expected for " + arg);
+
+        if(arg == "s" || arg == "source")
+            sources.push_back(args[++i]);
+        else if(arg == "t" || arg == "target")
+            target = args[++i];
+        else if(arg == "e" || arg == "evaluate")
+            percent = std::atoi(args[++i]);
+        else if(arg == "n" || arg == "neighbours")
+            neighbours = std::strtoul(args[++i], nullptr, 10);
+        else
+            UnknownArgument(arg);
+    }
+
+    if(sources.empty())
+        WrongUsage("source key is required");
+
+    if(percent >= 0)
+    {
+        if(percent == 0 || percent >= 100)
+            WrongUsage("evaluate value shall be in (0, 100)");
+        if(neighbours == 0)
+            WrongUsage("neighbours value shall be positive");
+        return Evaluate(sources, percent, neighbours);
+    }
+
+    return Train(sources, target.empty() ? miopen::GetSolverRankingPath(sources.front()) : target);
+}
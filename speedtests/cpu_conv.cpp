@@ -0,0 +1,143 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <driver.hpp>
+#include <cpu_conv.hpp>
+#include <tensor_holder.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace cpu_conv_speedtest {
+
+/// Compares the naive reference convolutions with the im2col and GEMM ones on a 2D layer.
+/// The defaults are the shape of a 3x3 convolution of the third ResNet-50 stage.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(batch, "batch");
+        add(in_channels, "in-channels");
+        add(out_channels, "out-channels");
+        add(height, "height");
+        add(width, "width");
+        add(filter, "filter");
+        add(pad, "pad");
+        add(stride, "stride");
+        add(groups, "groups");
+    }
+
+    void run()
+    {
+        const auto out_height = (height + 2 * pad - filter) / stride + 1;
+        const auto out_width  = (width + 2 * pad - filter) / stride + 1;
+
+        auto in  = tensor<float>(batch, in_channels, height, width);
+        auto wei = tensor<float>(out_channels, in_channels / groups, filter, filter);
+        auto out = tensor<float>(batch, out_channels, out_height, out_width);
+        std::fill(in.begin(), in.end(), 0.5f);
+        std::fill(wei.begin(), wei.end(), 0.25f);
+        std::fill(out.begin(), out.end(), 1.0f);
+
+        const auto pads      = std::vector<int>{pad, pad};
+        const auto strides   = std::vector<int>{stride, stride};
+        const auto dilations = std::vector<int>{1, 1};
+        const auto g         = static_cast<std::size_t>(groups);
+
+        Measure("forward",
+                [&] { cpu_convolution_forward_impl<2>(in, wei, out, pads, strides, dilations, g); },
+                [&] { cpu_convolution_forward_gemm(in, wei, out, pads, strides, dilations, g); });
+        Measure("backward data",
+                [&] {
+                    cpu_convolution_backward_data_impl<2>(
+                        in, wei, out, pads, strides, dilations, g);
+                },
+                [&] {
+                    cpu_convolution_backward_data_gemm(in, wei, out, pads, strides, dilations, g);
+                });
+        Measure("backward weights",
+                [&] {
+                    cpu_convolution_backward_weight_impl<2>(
+                        in, wei, out, pads, strides, dilations, g);
+                },
+                [&] {
+                    cpu_convolution_backward_weight_gemm(
+                        in, wei, out, pads, strides, dilations, g);
+                });
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Example: --batch 8 --in-channels 128 --out-channels 128 --height 28 "
+                     "--width 28 --filter 3 --pad 1 --stride 1 --groups 1"
+                  << std::endl;
+    }
+
+    private:
+    int batch        = 8;
+    int in_channels  = 128;
+    int out_channels = 128;
+    int height       = 28;
+    int width        = 28;
+    int filter       = 3;
+    int pad          = 1;
+    int stride       = 1;
+    int groups       = 1;
+
+    template <class Naive, class Gemm>
+    static void Measure(const std::string& name, Naive naive, Gemm gemm)
+    {
+        using Clock   = std::chrono::steady_clock;
+        const auto ms = [](Clock::duration time) {
+            return std::chrono::duration_cast<std::chrono::microseconds>(time).count() / 1000.0;
+        };
+
+        auto begin = Clock::now();
+        naive();
+        const auto naive_time = Clock::now() - begin;
+
+        begin = Clock::now();
+        gemm();
+        const auto gemm_time = Clock::now() - begin;
+
+        std::cout << name << ": naive " << ms(naive_time) << " ms, im2col and gemm "
+                  << ms(gemm_time) << " ms, speedup " << ms(naive_time) / ms(gemm_time)
+                  << std::endl;
+    }
+};
+
+} // namespace cpu_conv_speedtest
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::cpu_conv_speedtest::SpeedTestDriver>(argc, argv);
+    return 0;
+}
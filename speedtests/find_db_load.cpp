@@ -0,0 +1,167 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/binary_db.hpp>
+#include <miopen/readonlyramdb.hpp>
+#include <miopen/tmp_dir.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace miopen {
+namespace find_db_load {
+
+/// Compares the time to load a system find-db (the first GetCached call for a path) and to look
+/// up all of its records between the text and the precompiled binary forms. Each iteration uses
+/// a copy of the db under a new path, as loaded dbs are cached for the process lifetime.
+/// Not applicable to MIOPEN_EMBED_DB builds, which only use embedded dbs.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(db_path, "db");
+        add(iterations, "iterations");
+    }
+
+    void run()
+    {
+        if(db_path.empty())
+        {
+            std::cerr << "Path to a text find-db is required." << std::endl;
+            std::exit(-1);
+        }
+
+        std::ifstream file(db_path, std::ios::binary);
+        text.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+
+        if(text.empty())
+        {
+            std::cerr << "Unable to read " << db_path << std::endl;
+            std::exit(-1);
+        }
+
+        CollectKeys();
+        std::cout << "Records: " << keys.size() << std::endl;
+
+        const TmpDir dir{"find_db_load"};
+        Test("Text", dir, false);
+        Test("Binary", dir, true);
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Example: --db src/kernels/gfx906_64.OpenCL.fdb.txt --iterations 10"
+                  << std::endl;
+    }
+
+    private:
+    std::string db_path;
+    int iterations = 10;
+    std::string text;
+    std::vector<std::string> keys;
+
+    void CollectKeys()
+    {
+        auto unique = std::unordered_set<std::string>{};
+        auto begin  = std::size_t{0};
+
+        while(begin < text.size())
+        {
+            auto end = text.find('\n', begin);
+            if(end == std::string::npos)
+                end = text.size();
+
+            const auto key_end = text.find('=', begin);
+            if(key_end < end && key_end != begin)
+            {
+                auto key = text.substr(begin, key_end - begin);
+                if(unique.insert(key).second)
+                    keys.push_back(std::move(key));
+            }
+
+            begin = end + 1;
+        }
+    }
+
+    void Test(const std::string& name, const TmpDir& dir, bool binary) const
+    {
+        using Clock = std::chrono::steady_clock;
+        auto load   = Clock::duration::zero();
+        auto lookup = Clock::duration::zero();
+        auto found  = std::size_t{0};
+
+        for(auto i = 0; i < iterations; ++i)
+        {
+            const auto path = (dir.path / (name + std::to_string(i) + ".fdb.txt")).string();
+
+            std::ofstream(path, std::ios::binary) << text;
+            if(binary)
+            {
+                std::ofstream binary_file(GetBinaryDbPath(path), std::ios::binary);
+                WriteBinaryDb(text.data(),
+                              text.size(),
+                              boost::filesystem::last_write_time(path),
+                              binary_file);
+            }
+
+            const auto start = Clock::now();
+            const auto& db   = ReadonlyRamDb::GetCached(path, true);
+            const auto mid   = Clock::now();
+
+            for(const auto& key : keys)
+                if(db.FindRecord(key))
+                    ++found;
+
+            load += mid - start;
+            lookup += Clock::now() - mid;
+        }
+
+        const auto to_ms = [&](Clock::duration time) {
+            return std::chrono::duration_cast<std::chrono::microseconds>(time).count() * .001 /
+                   iterations;
+        };
+
+        std::cout << name << ": load " << to_ms(load) << " ms, lookup of all records "
+                  << to_ms(lookup) << " ms, found " << found / iterations << std::endl;
+    }
+};
+
+} // namespace find_db_load
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::find_db_load::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,149 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/host_gemm.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace host_gemm_speedtest {
+
+/// Triple loop with the double accumulator, which was used by the RNN verifiers.
+void NaiveGemm(bool trans_a,
+               bool trans_b,
+               std::size_t m,
+               std::size_t n,
+               std::size_t k,
+               const float* a,
+               std::size_t lda,
+               const float* b,
+               std::size_t ldb,
+               float* c,
+               std::size_t ldc)
+{
+    for(auto i = std::size_t{0}; i < m; ++i)
+    {
+        for(auto j = std::size_t{0}; j < n; ++j)
+        {
+            auto sum = 0.0;
+            for(auto p = std::size_t{0}; p < k; ++p)
+                sum += (trans_a ? a[p * lda + i] : a[i * lda + p]) *
+                       (trans_b ? b[j * ldb + p] : b[p * ldb + j]);
+            c[i * ldc + j] += static_cast<float>(sum);
+        }
+    }
+}
+
+/// Compares HostGemm with the naive GEMM on the shapes of an LSTM layer:
+///  - input: projection of the whole sequence, (seq * batch) x (gates * hidden) x input;
+///  - hidden: projection of the hidden state at a time step, batch x (gates * hidden) x hidden;
+///  - weights: gradient of the weights, transposed A, (gates * hidden) x hidden x batch.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(batch, "batch");
+        add(seq_len, "seq-len");
+        add(input, "input");
+        add(hidden, "hidden");
+        add(gates, "gates");
+    }
+
+    void run()
+    {
+        const auto gates_hidden = static_cast<std::size_t>(gates * hidden);
+        const auto rows         = static_cast<std::size_t>(seq_len * batch);
+        Measure("input", false, true, rows, gates_hidden, input);
+        Measure("hidden", false, true, batch, gates_hidden, hidden);
+        Measure("weights", true, false, gates_hidden, hidden, batch);
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Example: --batch 32 --seq-len 16 --input 512 --hidden 512 --gates 4"
+                  << std::endl;
+    }
+
+    private:
+    int batch   = 32;
+    int seq_len = 16;
+    int input   = 512;
+    int hidden  = 512;
+    int gates   = 4;
+
+    static void Measure(const std::string& name,
+                        bool trans_a,
+                        bool trans_b,
+                        std::size_t m,
+                        std::size_t n,
+                        std::size_t k)
+    {
+        using Clock   = std::chrono::steady_clock;
+        const auto ms = [](Clock::duration time) {
+            return std::chrono::duration_cast<std::chrono::microseconds>(time).count() / 1000.0;
+        };
+
+        const auto lda = trans_a ? m : k;
+        const auto ldb = trans_b ? k : n;
+        const auto a   = std::vector<float>(m * k, 0.5f);
+        const auto b   = std::vector<float>(k * n, 0.25f);
+        auto c         = std::vector<float>(m * n, 1.0f);
+
+        auto begin = Clock::now();
+        NaiveGemm(trans_a, trans_b, m, n, k, a.data(), lda, b.data(), ldb, c.data(), n);
+        const auto naive = Clock::now() - begin;
+
+        begin = Clock::now();
+        HostGemm<double>(
+            trans_a, trans_b, m, n, k, 1.0, a.data(), lda, b.data(), ldb, 1.0, c.data(), n);
+        const auto blocked = Clock::now() - begin;
+
+        begin = Clock::now();
+        HostGemm<float>(
+            trans_a, trans_b, m, n, k, 1.0, a.data(), lda, b.data(), ldb, 1.0, c.data(), n);
+        const auto blocked_float = Clock::now() - begin;
+
+        const auto gflop = 2.0 * m * n * k / 1e9;
+        std::cout << name << " (" << m << "x" << n << "x" << k << "): naive " << ms(naive)
+                  << " ms, blocked " << ms(blocked) << " ms (" << gflop / ms(blocked) * 1000
+                  << " GFLOPS), blocked with float accumulator " << ms(blocked_float)
+                  << " ms, speedup " << ms(naive) / ms(blocked) << std::endl;
+    }
+};
+
+} // namespace host_gemm_speedtest
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::host_gemm_speedtest::SpeedTestDriver>(argc, argv);
+    return 0;
+}
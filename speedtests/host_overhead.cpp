@@ -0,0 +1,173 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/config.h>
+#include <miopen/convolution.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/miopen.h>
+#include <miopen/tensor.hpp>
+#if MIOPEN_MODE_NOGPU
+#include <miopen/null_device.hpp>
+#endif
+
+#include <driver.hpp>
+#include <get_handle.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace host_overhead {
+
+/// Measures the per-call latency of API calls at small batch sizes, where the host-side work
+/// (argument checks, network configs, invoker and kernel cache lookups, kernel argument packing)
+/// is comparable with the kernel times. Meant to be built with the HIPNOGPU backend, which
+/// leaves only that work, and also reports the number of kernels launched per call then.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(batch, "batch");
+        add(channels, "channels");
+        add(size, "size");
+        add(n_calls, "calls");
+    }
+
+    void run()
+    {
+        auto& handle = get_handle();
+        const auto n = static_cast<std::size_t>(batch);
+        const auto c = static_cast<std::size_t>(channels);
+        const auto s = static_cast<std::size_t>(size);
+
+        auto x_desc    = TensorDescriptor{miopenFloat, {n, c, s, s}};
+        auto w_desc    = TensorDescriptor{miopenFloat, {c, c, 3, 3}};
+        auto conv_desc = ConvolutionDescriptor{{1, 1}};
+        auto y_desc    = conv_desc.GetForwardOutputTensor(x_desc, w_desc);
+
+        auto x = handle.Create(x_desc.GetElementSpace() * sizeof(float));
+        auto w = handle.Create(w_desc.GetElementSpace() * sizeof(float));
+        auto y = handle.Create(y_desc.GetElementSpace() * sizeof(float));
+
+        std::cout << "Input: " << x_desc << ", weights: " << w_desc << std::endl;
+
+        const auto alpha = 1.0f;
+        const auto beta  = 0.0f;
+        Measure("miopenOpTensor", [&]() {
+            return miopenOpTensor(&handle,
+                                  miopenTensorOpAdd,
+                                  &alpha,
+                                  &x_desc,
+                                  x.get(),
+                                  &alpha,
+                                  &x_desc,
+                                  x.get(),
+                                  &beta,
+                                  &x_desc,
+                                  x.get());
+        });
+
+        auto solution_count = std::size_t{0};
+        auto solution       = miopenConvSolution_t{};
+        Check(miopenConvolutionForwardGetSolution(
+            &handle, &w_desc, &x_desc, &conv_desc, &y_desc, 1, &solution_count, &solution));
+        if(solution_count == 0)
+            MIOPEN_THROW("No solution for the convolution");
+
+        auto workspace = handle.Create(solution.workspace_size);
+        std::cout << "Convolution solution: " << solution.solution_id << std::endl;
+        Measure("miopenConvolutionForwardImmediate", [&]() {
+            return miopenConvolutionForwardImmediate(&handle,
+                                                     &w_desc,
+                                                     w.get(),
+                                                     &x_desc,
+                                                     x.get(),
+                                                     &conv_desc,
+                                                     &y_desc,
+                                                     y.get(),
+                                                     workspace.get(),
+                                                     solution.workspace_size,
+                                                     solution.solution_id);
+        });
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Example: --batch 1 --channels 64 --size 28 --calls 10000" << std::endl;
+    }
+
+    private:
+    int batch    = 1;
+    int channels = 64;
+    int size     = 28;
+    int n_calls  = 10000;
+
+    static void Check(miopenStatus_t status)
+    {
+        if(status != miopenStatusSuccess)
+            MIOPEN_THROW(status);
+    }
+
+    template <class F>
+    void Measure(const std::string& name, F call) const
+    {
+        using Clock = std::chrono::steady_clock;
+
+        // The first call builds the kernels and fills the caches.
+        Check(call());
+        get_handle().Finish();
+#if MIOPEN_MODE_NOGPU
+        const auto launches = NullDevice::Get().GetLaunchCount();
+#endif
+
+        const auto begin = Clock::now();
+        for(auto i = 0; i < n_calls; ++i)
+            Check(call());
+        get_handle().Finish();
+        const auto time = Clock::now() - begin;
+
+        const auto us =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(time).count() * 1e-3 / n_calls;
+        std::cout << name << ": " << us << " us per call";
+#if MIOPEN_MODE_NOGPU
+        std::cout << ", " << (NullDevice::Get().GetLaunchCount() - launches) * 1.0 / n_calls
+                  << " kernels per call";
+#endif
+        std::cout << std::endl;
+    }
+};
+
+} // namespace host_overhead
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::host_overhead::SpeedTestDriver>(argc, argv);
+    return 0;
+}
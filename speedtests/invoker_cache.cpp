@@ -0,0 +1,153 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/invoker_cache.hpp>
+
+#include <driver.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace invoker_cache {
+
+/// Measures the latency of InvokerCache lookups with the given number of registered network
+/// configs, each with several solvers and a find 1.0 result. For comparison, the same lookups
+/// are done in nested string-keyed std::maps, which the cache used to be.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(n_configs, "configs");
+        add(n_lookups, "lookups");
+        add(n_threads, "threads");
+    }
+
+    void run()
+    {
+        const auto solvers = std::vector<solver::Id>{
+            solver::Id{"ConvAsm3x3U"}, solver::Id{"ConvAsm1x1U"}, solver::Id{"ConvOclDirectFwd"}};
+        const auto algorithm = AlgorithmName{"miopenConvolutionFwdAlgoDirect"};
+        const auto invoker   = Invoker{[](const Handle&, const AnyInvokeParams&) {}};
+
+        auto configs = std::vector<NetworkConfig>{};
+        for(auto i = 0; i < n_configs; ++i)
+            configs.emplace_back(MakeConfig(i));
+
+        auto cache    = InvokerCache{};
+        auto baseline = std::map<std::string, std::map<std::string, Invoker>>{};
+        for(const auto& config : configs)
+        {
+            for(const auto& id : solvers)
+            {
+                cache.Register(config, id, invoker);
+                baseline[config.ToString()][id.ToString()] = invoker;
+            }
+            cache.SetAsFound1_0(config, algorithm, solvers.back());
+        }
+
+        auto order = std::vector<std::size_t>(n_lookups);
+        auto rng   = std::mt19937{};
+        for(auto& index : order)
+            index = rng() % configs.size();
+
+        std::cout << "Configs: " << configs.size() << ", solvers: " << solvers.size()
+                  << ", threads: " << n_threads << std::endl;
+
+        const auto solver_id  = solvers.front();
+        const auto solver_str = solver_id.ToString();
+
+        Measure("std::map (baseline)", [&](std::size_t index) {
+            const auto item = baseline.find(configs[index].ToString());
+            return item != baseline.end() && item->second.find(solver_str) != item->second.end();
+        }, order);
+        Measure("GetInvoker", [&](std::size_t index) {
+            return static_cast<bool>(cache.GetInvoker(configs[index], solver_id));
+        }, order);
+        Measure("GetFound1_0", [&](std::size_t index) {
+            return static_cast<bool>(cache.GetFound1_0(configs[index], algorithm));
+        }, order);
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Example: --configs 10000 --lookups 1000000 --threads 4" << std::endl;
+    }
+
+    private:
+    int n_configs = 10000;
+    int n_lookups = 1000000;
+    int n_threads = 1;
+
+    /// Resembles a network config of a convolution.
+    static std::string MakeConfig(int i)
+    {
+        return std::to_string(64 + i % 7) + "x" + std::to_string(i % 224) + "x" +
+               std::to_string(i / 224 + 1) + "x3x3x" + std::to_string(32 << (i % 4)) +
+               "x28x28x100x1x1x1x1x1x1xNCHWxFP32xF";
+    }
+
+    template <class F>
+    void Measure(const std::string& name, F lookup, const std::vector<std::size_t>& order) const
+    {
+        using Clock = std::chrono::steady_clock;
+        auto threads = std::vector<std::thread>{};
+        auto found   = std::vector<std::size_t>(n_threads, 0);
+
+        const auto begin = Clock::now();
+        for(auto t = 0; t < n_threads; ++t)
+        {
+            threads.emplace_back([&, t]() {
+                for(const auto index : order)
+                    if(lookup(index))
+                        ++found[t];
+            });
+        }
+        for(auto& thread : threads)
+            thread.join();
+        const auto time = Clock::now() - begin;
+
+        const auto ns =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(time).count() * 1.0 / order.size();
+        std::cout << name << ": " << ns << " ns per lookup, found "
+                  << found.front() * 100.0 / order.size() << '%' << std::endl;
+    }
+};
+
+} // namespace invoker_cache
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::invoker_cache::SpeedTestDriver>(argc, argv);
+    return 0;
+}
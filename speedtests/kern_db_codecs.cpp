@@ -0,0 +1,179 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/config.h>
+
+#if MIOPEN_ENABLE_SQLITE && MIOPEN_ENABLE_SQLITE_KERN_CACHE
+
+#include <miopen/kern_db.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <driver.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace kern_db_codecs {
+
+/// Compares the codecs of the kernel binary cache: the time to store a set of synthetic
+/// code-object-sized kernels, the resulting db size and the latency of loading a kernel.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(n_kernels, "kernels");
+        add(min_size, "min-size");
+        add(max_size, "max-size");
+        add(n_loads, "loads");
+    }
+
+    void run()
+    {
+        auto rng     = std::mt19937{};
+        auto kernels = std::vector<KernelConfig>(n_kernels);
+        auto bytes   = std::size_t{0};
+        for(auto i = 0; i < n_kernels; ++i)
+        {
+            const auto size        = min_size + rng() % (max_size - min_size + 1);
+            kernels[i].kernel_name = "kernel" + std::to_string(i) + ".s";
+            kernels[i].kernel_args = " -mcpu=gfx906 -DMIOPEN_KERNEL_ID=" + std::to_string(i);
+            kernels[i].kernel_blob = MakeCodeObject(size * 1024, rng);
+            bytes += kernels[i].kernel_blob.size();
+        }
+
+        auto order = std::vector<std::size_t>(n_loads);
+        for(auto& index : order)
+            index = rng() % kernels.size();
+
+        std::cout << "Kernels: " << kernels.size() << ", " << bytes / 1024 << " KB" << std::endl;
+
+        const auto none = KernDbCodec{KernDbCodec::Bz2,
+                                      "none",
+                                      [](const std::string& data, bool* compressed) {
+                                          *compressed = false;
+                                          return data;
+                                      },
+                                      [](const std::string& data, unsigned int) { return data; }};
+
+        Measure(none, kernels, order);
+        Measure(*FindKernDbCodec(KernDbCodec::Bz2), kernels, order);
+        Measure(*FindKernDbCodec(KernDbCodec::Lz4), kernels, order);
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Sizes are in KB. Example: --kernels 200 --min-size 16 --max-size 256"
+                  << std::endl;
+    }
+
+    private:
+    int n_kernels = 200;
+    int min_size  = 16;
+    int max_size  = 256;
+    int n_loads   = 1000;
+
+    /// Resembles a code object: a text section of instructions of a small vocabulary with
+    /// varying immediates, followed by metadata strings and zero padding.
+    static std::string MakeCodeObject(std::size_t size, std::mt19937& rng)
+    {
+        auto vocabulary = std::vector<std::uint32_t>(256);
+        for(auto& word : vocabulary)
+            word = rng();
+
+        auto blob = std::string{};
+        blob.reserve(size);
+
+        while(blob.size() < size * 3 / 4)
+        {
+            auto word = vocabulary[rng() % vocabulary.size()];
+            if(rng() % 4 == 0)
+                word ^= rng() & 0xfff;
+            blob.append(reinterpret_cast<const char*>(&word), sizeof(word));
+        }
+
+        while(blob.size() < size * 15 / 16)
+            blob += "amdhsa.kernel." + std::to_string(rng() % 1000) + ".vgpr_count=" +
+                    std::to_string(rng() % 256) + ";";
+
+        blob.resize(size, '\0');
+        return blob;
+    }
+
+    void Measure(const KernDbCodec& codec,
+                 const std::vector<KernelConfig>& kernels,
+                 const std::vector<std::size_t>& order) const
+    {
+        using Clock = std::chrono::steady_clock;
+        const auto ms = [](Clock::duration time) {
+            return std::chrono::duration_cast<std::chrono::microseconds>(time).count() / 1000.0;
+        };
+
+        const TempFile file{"kern-db-" + codec.name};
+        auto db         = KernDb{std::string(file), false, "gfx906", 60, codec};
+        db.SetSizeLimit(0);
+
+        auto begin = Clock::now();
+        db.sql.Exec("BEGIN;");
+        for(const auto& kernel : kernels)
+            db.StoreRecordUnsafe(kernel);
+        db.sql.Exec("COMMIT;");
+        const auto store_time = Clock::now() - begin;
+
+        begin      = Clock::now();
+        auto found = std::size_t{0};
+        for(const auto index : order)
+            if(db.FindRecordUnsafe(kernels[index]))
+                ++found;
+        const auto load_time = Clock::now() - begin;
+
+        const auto db_size = boost::filesystem::file_size(std::string(file));
+        std::cout << codec.name << ": db size " << db_size / 1024 << " KB, store "
+                  << ms(store_time) << " ms, load " << ms(load_time) * 1000 / order.size()
+                  << " us per kernel, found " << found * 100.0 / order.size() << '%' << std::endl;
+    }
+};
+
+} // namespace kern_db_codecs
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::kern_db_codecs::SpeedTestDriver>(argc, argv);
+    return 0;
+}
+
+#else
+
+int main() { return 0; }
+
+#endif
@@ -0,0 +1,161 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/par_for.hpp>
+#include <miopen/thread_pool.hpp>
+
+#include <driver.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace par_for_speedtest {
+
+/// Thread-per-call par_for with equal static grains, which was used before the thread pool.
+template <class F>
+void ThreadPerCallParFor(std::size_t n, std::size_t threadsize, F f)
+{
+    if(threadsize <= 1)
+    {
+        for(std::size_t i = 0; i < n; i++)
+            f(i);
+        return;
+    }
+
+    std::vector<joinable_thread> threads(threadsize);
+    const std::size_t grainsize = std::ceil(static_cast<double>(n) / threads.size());
+    for(auto t = std::size_t{0}; t < threads.size(); ++t)
+    {
+        threads[t] = joinable_thread([=] {
+            const auto last = std::min(n, (t + 1) * grainsize);
+            for(auto i = t * grainsize; i < last; i++)
+                f(i);
+        });
+    }
+}
+
+/// Compares the thread pool with the thread-per-call par_for on uneven workloads:
+///  - compile: waiting for kernel compilations of very different durations (log-normal, as the
+///    sizes of kernels), sorted by kernel family, so the longest ones are next to each other;
+///  - triangle: CPU-bound iterations which cost proportionally to the index, like loops over the
+///    output of a reference convolution with growing windows;
+///  - small: many short loops, which show the per-call overhead.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(threads, "threads");
+        add(n_kernels, "kernels");
+        add(compile_ms, "compile-ms");
+        add(n_small, "small-loops");
+    }
+
+    void run()
+    {
+        auto& pool = ThreadPool::Instance();
+        std::cout << "Threads: " << threads << " (pool workers: " << pool.GetWorkerCount()
+                  << ")" << std::endl;
+
+        auto rng       = std::mt19937{};
+        auto durations = std::vector<double>(n_kernels);
+        auto lognormal = std::lognormal_distribution<double>{0.0, 1.0};
+        for(auto& duration : durations)
+            duration = compile_ms * lognormal(rng);
+        std::sort(durations.begin(), durations.end());
+
+        const auto compile = [&](std::size_t i) {
+            std::this_thread::sleep_for(std::chrono::microseconds{
+                static_cast<std::int64_t>(durations[i] * 1000)});
+        };
+        Measure("compile", n_kernels, compile);
+
+        const auto triangle_n = std::size_t{2000};
+        const auto triangle   = [&](std::size_t i) {
+            volatile auto sum = 0.0;
+            for(auto j = std::size_t{0}; j < i * 200; ++j)
+                sum = sum + std::sqrt(static_cast<double>(j));
+        };
+        Measure("triangle", triangle_n, triangle);
+
+        const auto small = [&](std::size_t i) {
+            volatile auto sum = 0.0;
+            for(auto j = std::size_t{0}; j < 1000; ++j)
+                sum = sum + static_cast<double>(i + j);
+        };
+        Measure("small", 64, small, n_small);
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Example: --threads 8 --kernels 64 --compile-ms 50" << std::endl;
+    }
+
+    private:
+    int threads    = std::max<int>(std::thread::hardware_concurrency(), 2);
+    int n_kernels  = 64;
+    int compile_ms = 20;
+    int n_small    = 1000;
+
+    template <class F>
+    void Measure(const std::string& name, std::size_t n, F f, int repeat = 1) const
+    {
+        using Clock   = std::chrono::steady_clock;
+        const auto ms = [](Clock::duration time) {
+            return std::chrono::duration_cast<std::chrono::microseconds>(time).count() / 1000.0;
+        };
+        const auto threadsize = static_cast<std::size_t>(threads);
+
+        auto begin = Clock::now();
+        for(auto i = 0; i < repeat; ++i)
+            ThreadPerCallParFor(n, threadsize, f);
+        const auto thread_per_call = Clock::now() - begin;
+
+        // Same as par_for() with max_threads{threads}, which is also limited by the number of
+        // hardware threads.
+        begin = Clock::now();
+        for(auto i = 0; i < repeat; ++i)
+            par_for_impl(n, threadsize, 1, f);
+        const auto pool = Clock::now() - begin;
+
+        std::cout << name << ": thread per call " << ms(thread_per_call) << " ms, pool "
+                  << ms(pool) << " ms, speedup " << ms(thread_per_call) / ms(pool) << std::endl;
+    }
+};
+
+} // namespace par_for_speedtest
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::par_for_speedtest::SpeedTestDriver>(argc, argv);
+    return 0;
+}
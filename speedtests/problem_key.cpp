@@ -0,0 +1,156 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/conv/problem_description.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace miopen {
+namespace problem_key {
+
+/// Measures building the keys of convolution problems and lookups by them:
+///  - construction of a description and of its text forms, which is done once per description;
+///  - repeated requests of the text forms, which are cached;
+///  - lookups in hash maps keyed by the db key text and by the packed key.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(n_problems, "problems");
+        add(n_lookups, "lookups");
+    }
+
+    void run()
+    {
+        auto problems = std::vector<conv::ProblemDescription>{};
+        Measure("construction", n_problems, [&](std::size_t i) {
+            problems.push_back(MakeProblem(i));
+            return problems.back().GetKey().spatial_dims;
+        });
+        Measure("first text forms", n_problems, [&](std::size_t i) {
+            return problems[i].GetDbKey().size() + problems[i].BuildConfKey().GetValue().size();
+        });
+
+        auto order = std::vector<std::size_t>(n_lookups);
+        auto rng   = std::mt19937{};
+        for(auto& index : order)
+            index = rng() % problems.size();
+
+        Measure("cached db key", n_lookups, [&](std::size_t i) {
+            return problems[order[i]].GetDbKey().size();
+        });
+        Measure("cached network config", n_lookups, [&](std::size_t i) {
+            return problems[order[i]].BuildConfKey().GetHash();
+        });
+        Measure("packed key hash", n_lookups, [&](std::size_t i) {
+            return problems[order[i]].GetKey().Hash();
+        });
+
+        // The packed key table is keyed by the hash precomputed with the description and
+        // compares the keys on match, as InvokerCache does with network configs.
+        auto by_text = std::unordered_map<std::string, std::size_t>{};
+        auto by_key  = std::unordered_multimap<std::uint64_t, std::size_t>{};
+        for(auto i = std::size_t{0}; i < problems.size(); ++i)
+        {
+            by_text.emplace(problems[i].GetDbKey(), i);
+            by_key.emplace(problems[i].GetKeyHash(), i);
+        }
+
+        Measure("lookup by db key", n_lookups, [&](std::size_t i) {
+            return by_text.find(problems[order[i]].GetDbKey())->second;
+        });
+        Measure("lookup by packed key", n_lookups, [&](std::size_t i) {
+            const auto& problem = problems[order[i]];
+            const auto range    = by_key.equal_range(problem.GetKeyHash());
+            for(auto it = range.first; it != range.second; ++it)
+                if(problems[it->second].GetKey() == problem.GetKey())
+                    return it->second;
+            return problems.size();
+        });
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Example: --problems 10000 --lookups 1000000" << std::endl;
+    }
+
+    private:
+    int n_problems = 10000;
+    int n_lookups  = 1000000;
+
+    /// Resembles layers of CNNs.
+    static conv::ProblemDescription MakeProblem(std::size_t i)
+    {
+        const auto n    = std::size_t{1} << (i % 8);
+        const auto c    = std::size_t{16} << (i / 8 % 6);
+        const auto k    = std::size_t{16} << (i / 48 % 6);
+        const auto hw   = std::size_t{7} << (i / 288 % 6);
+        const auto filt = i / 1728 % 2 == 0 ? std::size_t{1} : std::size_t{3};
+        const auto pad  = static_cast<int>(filt / 2);
+        const auto dir  = static_cast<conv::Direction>(i / 3456 % 3);
+
+        const auto in      = TensorDescriptor{miopenFloat, {n, c, hw, hw}};
+        const auto weights = TensorDescriptor{miopenFloat, {k, c, filt, filt}};
+        const auto out     = TensorDescriptor{miopenFloat, {n, k, hw, hw}};
+        const auto conv    = ConvolutionDescriptor{{pad, pad}};
+
+        return dir == conv::Direction::Forward
+                   ? conv::ProblemDescription{in, weights, out, conv, dir}
+                   : conv::ProblemDescription{out, weights, in, conv, dir};
+    }
+
+    template <class F>
+    static void Measure(const std::string& name, int n, F f)
+    {
+        using Clock = std::chrono::steady_clock;
+        auto sink   = std::size_t{0};
+
+        const auto begin = Clock::now();
+        for(auto i = 0; i < n; ++i)
+            sink += f(i);
+        const auto time = Clock::now() - begin;
+
+        const auto ns =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(time).count() * 1.0 / n;
+        std::cout << name << ": " << ns << " ns (" << sink % 10 << ")" << std::endl;
+    }
+};
+
+} // namespace problem_key
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::problem_key::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,132 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/generic_search.hpp>
+
+#include <driver.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace search_strategies {
+
+/// Replays search traces recorded with MIOPEN_DEBUG_GENERIC_SEARCH_TRACE and shows, for each
+/// search strategy, how many configs it measures and how far its answer is from the exhaustive
+/// optimum. Regret is averaged over all the traces in the file.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(trace_path, "trace");
+        add(max_trials, "max-trials");
+        add(seeds, "seeds");
+    }
+
+    void run()
+    {
+        if(trace_path.empty())
+        {
+            std::cerr << "Path to a search trace is required." << std::endl;
+            std::exit(-1);
+        }
+
+        std::ifstream file(trace_path);
+        const auto traces = solver::SearchTrace::Read(file);
+
+        if(traces.empty())
+        {
+            std::cerr << "Unable to read " << trace_path << std::endl;
+            std::exit(-1);
+        }
+
+        std::cout << "Traces: " << traces.size() << std::endl;
+
+        for(const auto strategy : {solver::SearchStrategy::Exhaustive,
+                                   solver::SearchStrategy::Random,
+                                   solver::SearchStrategy::Halving,
+                                   solver::SearchStrategy::CoordinateDescent})
+            Test(traces, strategy);
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Example: --trace search.trace --max-trials 100 --seeds 10" << std::endl;
+    }
+
+    private:
+    std::string trace_path;
+    int max_trials = 0;
+    int seeds      = 10;
+
+    void Test(const std::vector<solver::SearchTrace>& traces, solver::SearchStrategy strategy) const
+    {
+        // Only the random strategies depend on the seed.
+        const auto is_random = strategy == solver::SearchStrategy::Random ||
+                               (strategy == solver::SearchStrategy::Halving && max_trials != 0);
+        const auto n_seeds = is_random ? std::max(seeds, 1) : 1;
+        auto trials        = 0.0;
+        auto regret        = 0.0;
+        auto max_regret    = 0.0;
+        auto n_optimal     = 0;
+        auto options       = solver::SearchOptions{};
+        options.strategy   = strategy;
+        options.max_trials = max_trials;
+
+        for(const auto& trace : traces)
+        {
+            for(auto seed = 0; seed < n_seeds; ++seed)
+            {
+                options.seed          = seed;
+                const auto evaluation = solver::EvaluateSearchStrategy(trace, options);
+                trials += static_cast<double>(evaluation.trials) / trace.configs.size();
+                regret += evaluation.GetRegret();
+                max_regret = std::max<double>(max_regret, evaluation.GetRegret());
+                if(evaluation.GetRegret() == 0.0f)
+                    ++n_optimal;
+            }
+        }
+
+        const auto n_runs = static_cast<double>(traces.size() * n_seeds);
+        std::cout << strategy << ": measured " << trials / n_runs * 100
+                  << "% of configs, optimum found in " << n_optimal / n_runs * 100
+                  << "% of searches, regret avg " << regret / n_runs * 100 << "%, max "
+                  << max_regret * 100 << '%' << std::endl;
+    }
+};
+
+} // namespace search_strategies
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::search_strategies::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -37,6 +37,9 @@
 #include <miopen/kern_db.hpp>
 #include <miopen/db.hpp>
 #include <miopen/db_path.hpp>
+#include <miopen/write_behind.hpp>
+#include <miopen/statistics.hpp>
+#include <miopen/trace.hpp>
 #include <boost/filesystem.hpp>
 #include <fstream>
 #include <iostream>
@@ -113,18 +116,28 @@ static bool IsCacheDisabled()
 
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
 using KDb = DbTimer<MultiFileDb<KernDb, KernDb, false>>;
+static std::string GetUserDbPath(const std::string& device, size_t num_cu)
+{
+    // Never destroyed, as GetDb() is called by the kernel writes performed at process exit.
+    static const auto& user_dir = *new boost::filesystem::path{ComputeUserCachePath()};
+    if(user_dir.empty())
+        return {};
+    return (user_dir / (Handle::GetDbBasename(device, num_cu) + ".ukdb")).string();
+}
+
 KDb GetDb(const std::string& device, size_t num_cu)
 {
-    static const auto user_dir = ComputeUserCachePath();
-    static const auto sys_dir  = ComputeSysCachePath();
-    boost::filesystem::path user_path =
-        user_dir / (Handle::GetDbBasename(device, num_cu) + ".ukdb");
+    static const auto& sys_dir       = *new boost::filesystem::path{ComputeSysCachePath()};
     boost::filesystem::path sys_path = sys_dir / (Handle::GetDbBasename(device, num_cu) + ".kdb");
-    if(user_dir.empty())
-        user_path = user_dir;
     if(!boost::filesystem::exists(sys_path))
         sys_path = boost::filesystem::path{};
-    return {sys_path.string(), user_path.string(), device, num_cu};
+    return {sys_path.string(), GetUserDbPath(device, num_cu), device, num_cu};
+}
+
+/// Identifies the kernel in the write-behind queue.
+static std::string GetWriteBehindKey(const KernelConfig& cfg)
+{
+    return cfg.kernel_name + " " + cfg.kernel_args;
 }
 #endif
 
@@ -137,6 +150,24 @@ boost::filesystem::path GetCacheFile(const std::string& device,
     return GetCachePath(false) / miopen::md5(device + ":" + args) / filename;
 }
 
+static StatCounter& LoadBinaryHits()
+{
+    static auto& hits = Statistics::Counter("binary_cache.hits");
+    return hits;
+}
+
+static StatCounter& LoadBinaryMisses()
+{
+    static auto& misses = Statistics::Counter("binary_cache.misses");
+    return misses;
+}
+
+static StatHistogram& LoadBinaryTime()
+{
+    static auto& time = Statistics::Histogram("binary_cache.load");
+    return time;
+}
+
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
 std::string LoadBinary(const std::string& device,
                        const size_t num_cu,
@@ -147,18 +178,24 @@ std::string LoadBinary(const std::string& device,
     if(miopen::IsCacheDisabled())
         return {};
 
+    MIOPEN_TRACE_SPAN_DETAIL("cache", "LoadBinary", name);
+    const StatTimer timer{LoadBinaryTime()};
+
     auto db              = GetDb(device, num_cu);
     std::string filename = (is_kernel_str ? miopen::md5(name) : name) + ".o";
     KernelConfig cfg{filename, args, ""};
     MIOPEN_LOG_I2("Loading binary for: " << name << " ;args: " << args);
+    WriteBehindQueue::Instance().Flush(GetUserDbPath(device, num_cu), GetWriteBehindKey(cfg));
     auto record = db.FindRecord(cfg);
     if(record)
     {
+        ++LoadBinaryHits();
         MIOPEN_LOG_I2("Sucessfully loaded binary for: " << name << " ;args: " << args);
         return record.get();
     }
     else
     {
+        ++LoadBinaryMisses();
         MIOPEN_LOG_I2("Unable to load binary for: " << name << " ;args: " << args);
         return {};
     }
@@ -174,12 +211,36 @@ void SaveBinary(const std::string& hsaco,
     if(miopen::IsCacheDisabled())
         return;
 
-    auto db = GetDb(device, num_cu);
+    MIOPEN_TRACE_SPAN_DETAIL("cache", "SaveBinary", name);
+
+    // Kernels are only stored to the user db.
+    const auto user_path = GetUserDbPath(device, num_cu);
+    if(user_path.empty())
+        return;
 
     std::string filename = (is_kernel_str ? miopen::md5(name) : name) + ".o";
     KernelConfig cfg{filename, args, hsaco};
     MIOPEN_LOG_I2("Saving binary for: " << name << " ;args: " << args);
-    db.StoreRecord(cfg);
+
+    auto key = GetWriteBehindKey(cfg);
+    WriteBehindQueue::Instance().Push(
+        user_path,
+        key,
+        [cfg = std::move(cfg), device, num_cu]() { GetDb(device, num_cu).StoreRecord(cfg); },
+        WriteBehindQueue::Coalesce::Replace,
+        [user_path, device, num_cu](const std::function<void()>& write) {
+            // One transaction for all the kernels instead of one per kernel.
+            auto& db = KernDb::GetCached(user_path, false, device, num_cu);
+            if(db.dbInvalid)
+            {
+                write();
+                return;
+            }
+            const auto lock = db.sql.LockTransaction();
+            db.sql.Exec("BEGIN;");
+            write();
+            db.sql.Exec("COMMIT;");
+        });
 }
 #else
 boost::filesystem::path LoadBinary(const std::string& device,
@@ -191,14 +252,19 @@ boost::filesystem::path LoadBinary(const std::string& device,
     if(miopen::IsCacheDisabled())
         return {};
 
+    MIOPEN_TRACE_SPAN_DETAIL("cache", "LoadBinary", name);
+    const StatTimer timer{LoadBinaryTime()};
+
     (void)num_cu;
     auto f = GetCacheFile(device, name, args, is_kernel_str);
     if(boost::filesystem::exists(f))
     {
+        ++LoadBinaryHits();
         return f.string();
     }
     else
     {
+        ++LoadBinaryMisses();
         return {};
     }
 }
@@ -209,6 +275,8 @@ void SaveBinary(const boost::filesystem::path& binary_path,
                 const std::string& args,
                 bool is_kernel_str)
 {
+    MIOPEN_TRACE_SPAN_DETAIL("cache", "SaveBinary", name);
+
     if(miopen::IsCacheDisabled())
     {
         boost::filesystem::remove(binary_path);
@@ -0,0 +1,294 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/binary_db.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+#include <unordered_set>
+
+namespace miopen {
+
+struct BinaryDbHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t source_size;
+    std::int64_t source_time; // Modification time of the text db, 0 if unknown.
+    std::uint64_t source_hash;
+    std::uint64_t record_count;
+    std::uint64_t bucket_count; // Power of 2.
+    std::uint64_t buckets_offset;
+    std::uint64_t records_offset;
+    std::uint64_t lines_offset;
+};
+
+struct BinaryDbRecord
+{
+    std::uint64_t hash;
+    std::uint64_t line_offset; // Relative to the lines section.
+    std::uint32_t key_size;
+    std::uint32_t contents_size;
+    std::uint32_t n_line;
+    std::uint32_t reserved;
+};
+
+static const char BinaryDbMagic[8]               = {'M', 'I', 'O', 'P', 'E', 'N', 'D', 'B'};
+static constexpr std::uint32_t BinaryDbVersion   = 2;
+static constexpr std::uint32_t BinaryDbByteOrder = 0x01020304;
+
+/// FNV-1a. The binary db is produced and used by different builds, so the hash shall be stable.
+static std::uint64_t Hash(const char* begin, std::size_t size)
+{
+    auto hash = std::uint64_t{14695981039346656037ull};
+    for(auto i = std::size_t{0}; i < size; ++i)
+    {
+        hash ^= static_cast<unsigned char>(begin[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Embedded data is not guaranteed to be aligned, so all the reads are done by copying.
+template <class T>
+static T Read(const char* at)
+{
+    T value;
+    std::memcpy(&value, at, sizeof(T));
+    return value;
+}
+
+bool BinaryDbView::Open(const char* data_, std::size_t size_)
+{
+    data = nullptr;
+
+    if(data_ == nullptr || size_ < sizeof(BinaryDbHeader))
+        return false;
+
+    const auto header = Read<BinaryDbHeader>(data_);
+
+    if(std::memcmp(header.magic, BinaryDbMagic, sizeof(BinaryDbMagic)) != 0 ||
+       header.version != BinaryDbVersion || header.byte_order != BinaryDbByteOrder)
+        return false;
+
+    const auto is_power_of_2 =
+        header.bucket_count != 0 && (header.bucket_count & (header.bucket_count - 1)) == 0;
+    const auto buckets_end =
+        header.buckets_offset + (header.bucket_count + 1) * sizeof(std::uint32_t);
+    const auto records_end = header.records_offset + header.record_count * sizeof(BinaryDbRecord);
+
+    if(!is_power_of_2 || buckets_end > size_ || records_end > size_ || header.lines_offset > size_)
+        return false;
+
+    if(Read<std::uint32_t>(data_ + buckets_end - sizeof(std::uint32_t)) != header.record_count)
+        return false;
+
+    data         = data_;
+    size         = size_;
+    source_size  = header.source_size;
+    source_time  = header.source_time;
+    source_hash  = header.source_hash;
+    record_count = header.record_count;
+    bucket_mask  = header.bucket_count - 1;
+    buckets      = header.buckets_offset;
+    records      = header.records_offset;
+    lines        = header.lines_offset;
+    return true;
+}
+
+bool BinaryDbView::IsSource(const char* text, std::size_t text_size) const
+{
+    return data != nullptr && text_size == source_size && Hash(text, text_size) == source_hash;
+}
+
+bool BinaryDbView::Find(const std::string& key, Match& match) const
+{
+    if(data == nullptr)
+        return false;
+
+    const auto hash   = Hash(key.data(), key.size());
+    const auto bucket = data + buckets + (hash & bucket_mask) * sizeof(std::uint32_t);
+    const auto first  = Read<std::uint32_t>(bucket);
+    const auto last   = std::min<std::uint64_t>(Read<std::uint32_t>(bucket + 4), record_count);
+
+    for(auto i = std::uint64_t{first}; i < last; ++i)
+    {
+        const auto record = Read<BinaryDbRecord>(data + records + i * sizeof(BinaryDbRecord));
+
+        if(record.hash != hash || record.key_size != key.size())
+            continue;
+
+        const auto line_begin = lines + record.line_offset;
+        const auto line_end   = line_begin + record.key_size + 1 + record.contents_size;
+
+        if(line_end > size)
+            return false;
+        if(std::memcmp(data + line_begin, key.data(), key.size()) != 0)
+            continue;
+
+        match.contents_begin = data + line_begin + record.key_size + 1;
+        match.contents_end   = data + line_end;
+        match.n_line         = record.n_line;
+        return true;
+    }
+
+    return false;
+}
+
+BinaryDbStats WriteBinaryDb(const char* text,
+                            std::size_t text_size,
+                            std::int64_t text_time,
+                            std::ostream& target)
+{
+    struct Line
+    {
+        const char* begin;
+        std::uint32_t key_size;
+        std::uint32_t contents_size;
+        int n_line;
+        std::uint64_t hash;
+    };
+
+    auto stats     = BinaryDbStats{};
+    auto lines     = std::vector<Line>{};
+    auto keys      = std::unordered_set<std::string>{};
+    auto n_line    = 0;
+    const auto end = text + text_size;
+
+    for(auto line_begin = text; line_begin < end;)
+    {
+        const auto eol =
+            static_cast<const char*>(std::memchr(line_begin, '\n', end - line_begin));
+        const auto line_end  = eol != nullptr ? eol : end;
+        const auto next_line = eol != nullptr ? eol + 1 : end;
+        ++n_line;
+
+        if(line_end != line_begin)
+        {
+            const auto key_end =
+                static_cast<const char*>(std::memchr(line_begin, '=', line_end - line_begin));
+
+            if(key_end == nullptr || key_end == line_begin)
+            {
+                stats.ill_formed_lines.push_back(n_line);
+            }
+            else if(!keys.emplace(line_begin, key_end).second)
+            {
+                stats.duplicate_lines.push_back(n_line);
+            }
+            else
+            {
+                const auto key_size = static_cast<std::uint32_t>(key_end - line_begin);
+                lines.push_back({line_begin,
+                                 key_size,
+                                 static_cast<std::uint32_t>(line_end - key_end - 1),
+                                 n_line,
+                                 Hash(line_begin, key_size)});
+            }
+        }
+
+        line_begin = next_line;
+    }
+
+    auto bucket_count = std::uint64_t{1};
+    while(bucket_count < lines.size())
+        bucket_count *= 2;
+
+    const auto bucket_of = [&](const Line& line) { return line.hash & (bucket_count - 1); };
+    std::stable_sort(lines.begin(), lines.end(), [&](const Line& l, const Line& r) {
+        return bucket_of(l) < bucket_of(r);
+    });
+
+    auto header = BinaryDbHeader{};
+    std::memcpy(header.magic, BinaryDbMagic, sizeof(BinaryDbMagic));
+    header.version        = BinaryDbVersion;
+    header.byte_order     = BinaryDbByteOrder;
+    header.source_size    = text_size;
+    header.source_time    = text_time;
+    header.source_hash    = Hash(text, text_size);
+    header.record_count   = lines.size();
+    header.bucket_count   = bucket_count;
+    header.buckets_offset = sizeof(BinaryDbHeader);
+    header.records_offset =
+        (header.buckets_offset + (bucket_count + 1) * sizeof(std::uint32_t) + 7) / 8 * 8;
+    header.lines_offset = header.records_offset + lines.size() * sizeof(BinaryDbRecord);
+
+    auto buckets = std::vector<std::uint32_t>(bucket_count + 1, 0);
+    for(const auto& line : lines)
+        ++buckets[bucket_of(line) + 1];
+    for(auto i = std::size_t{1}; i < buckets.size(); ++i)
+        buckets[i] += buckets[i - 1];
+
+    auto records     = std::vector<BinaryDbRecord>{};
+    auto line_offset = std::uint64_t{0};
+    records.reserve(lines.size());
+
+    for(const auto& line : lines)
+    {
+        records.push_back({line.hash,
+                           line_offset,
+                           line.key_size,
+                           line.contents_size,
+                           static_cast<std::uint32_t>(line.n_line),
+                           0});
+        line_offset += line.key_size + 1 + line.contents_size + 1;
+    }
+
+    const auto padding = header.records_offset - header.buckets_offset -
+                         buckets.size() * sizeof(std::uint32_t);
+
+    target.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    target.write(reinterpret_cast<const char*>(buckets.data()),
+                 buckets.size() * sizeof(std::uint32_t));
+    target.write("\0\0\0\0\0\0\0", padding);
+    target.write(reinterpret_cast<const char*>(records.data()),
+                 records.size() * sizeof(BinaryDbRecord));
+
+    for(const auto& line : lines)
+    {
+        target.write(line.begin, line.key_size + 1 + line.contents_size);
+        target.put('\n');
+    }
+
+    stats.records = lines.size();
+    return stats;
+}
+
+std::string GetBinaryDbPath(const std::string& text_db_path)
+{
+    static const std::string text_extension = ".txt";
+
+    if(text_db_path.size() >= text_extension.size() &&
+       text_db_path.compare(text_db_path.size() - text_extension.size(),
+                            text_extension.size(),
+                            text_extension) == 0)
+        return text_db_path.substr(0, text_db_path.size() - text_extension.size()) + ".bin";
+
+    return text_db_path + ".bin";
+}
+
+} // namespace miopen
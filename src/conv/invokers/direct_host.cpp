@@ -0,0 +1,367 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/conv/invokers/direct_host.hpp>
+
+#include <miopen/conv/data_invoke_params.hpp>
+#include <miopen/conv/wrw_invoke_params.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/par_for.hpp>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace miopen {
+namespace conv {
+namespace {
+
+/// Number of output channels (forward) or input channels (backward data) computed by a task, so
+/// the rows of the other tensor are reused from L1.
+constexpr std::ptrdiff_t ChannelBlock = 4;
+
+using Dims3 = std::array<std::ptrdiff_t, 3>; // d, h, w
+using Dims5 = std::array<std::ptrdiff_t, 5>; // n, c, d, h, w
+
+/// 2D problems are handled as 3D ones of depth 1.
+Dims3 To3d(const std::vector<int>& v, int fill)
+{
+    if(v.size() == 3)
+        return {{v[0], v[1], v[2]}};
+    return {{fill, v[0], v[1]}};
+}
+
+Dims5 To5d(const std::vector<std::size_t>& v, std::size_t fill)
+{
+    const auto d = [&](std::size_t i) { return static_cast<std::ptrdiff_t>(v[i]); };
+    if(v.size() == 5)
+        return {{d(0), d(1), d(2), d(3), d(4)}};
+    return {{d(0), d(1), static_cast<std::ptrdiff_t>(fill), d(2), d(3)}};
+}
+
+struct ConvParams
+{
+    ConvParams(const ConvolutionDescriptor& conv)
+        : pads(To3d(conv.GetConvPads(), 0)),
+          strides(To3d(conv.GetConvStrides(), 1)),
+          dilations(To3d(conv.GetConvDilations(), 1)),
+          groups(conv.GetGroupCount())
+    {
+    }
+
+    Dims3 pads;
+    Dims3 strides;
+    Dims3 dilations;
+    std::ptrdiff_t groups;
+};
+
+/// Convolution in the forward sense: x is the input, y is the output. c and k are the numbers of
+/// channels per group.
+struct Geometry
+{
+    Geometry(const TensorDescriptor& x_desc,
+             const TensorDescriptor& w_desc,
+             const TensorDescriptor& y_desc,
+             const ConvParams& params_)
+        : params(params_),
+          x_strides(To5d(x_desc.GetStrides(), 0)),
+          w_strides(To5d(w_desc.GetStrides(), 0)),
+          y_strides(To5d(y_desc.GetStrides(), 0))
+    {
+        const auto x_lens = To5d(x_desc.GetLengths(), 1);
+        const auto w_lens = To5d(w_desc.GetLengths(), 1);
+        const auto y_lens = To5d(y_desc.GetLengths(), 1);
+
+        n = x_lens[0];
+        c = x_lens[1] / params.groups;
+        k = y_lens[1] / params.groups;
+        std::copy(x_lens.begin() + 2, x_lens.end(), x_size.begin());
+        std::copy(w_lens.begin() + 2, w_lens.end(), w_size.begin());
+        std::copy(y_lens.begin() + 2, y_lens.end(), y_size.begin());
+    }
+
+    std::ptrdiff_t XPlane() const { return x_size[0] * x_size[1] * x_size[2]; }
+    std::ptrdiff_t YPlane() const { return y_size[0] * y_size[1] * y_size[2]; }
+
+    std::ptrdiff_t WIndex(std::ptrdiff_t k_, std::ptrdiff_t c_, const Dims3& f) const
+    {
+        return k_ * w_strides[0] + c_ * w_strides[1] + f[0] * w_strides[2] +
+               f[1] * w_strides[3] + f[2] * w_strides[4];
+    }
+
+    ConvParams params;
+    std::ptrdiff_t n = 0;
+    std::ptrdiff_t c = 0;
+    std::ptrdiff_t k = 0;
+    Dims3 x_size    = {};
+    Dims3 w_size    = {};
+    Dims3 y_size    = {};
+    Dims5 x_strides;
+    Dims5 w_strides;
+    Dims5 y_strides;
+};
+
+/// Output positions [begin, end) of a dimension, for which the input position
+/// o * stride + offset, where offset = f * dilation - pad, is within the input.
+struct Range
+{
+    Range(const Geometry& g, int dim, std::ptrdiff_t f)
+        : offset(f * g.params.dilations[dim] - g.params.pads[dim]), stride(g.params.strides[dim])
+    {
+        const auto last = g.x_size[dim] - 1 - offset;
+        end   = last < 0 ? 0 : std::min(last / stride + 1, g.y_size[dim]);
+        begin = std::min(offset >= 0 ? 0 : (stride - 1 - offset) / stride, end);
+    }
+
+    bool Empty() const { return begin == end; }
+    std::ptrdiff_t In(std::ptrdiff_t o) const { return o * stride + offset; }
+
+    std::ptrdiff_t offset;
+    std::ptrdiff_t stride;
+    std::ptrdiff_t begin = 0;
+    std::ptrdiff_t end   = 0;
+};
+
+/// Calls f(filter position, ranges of output positions) for all the filter positions which
+/// touch the input.
+template <class F>
+void ForEachFilterPosition(const Geometry& g, F f)
+{
+    auto pos = Dims3{};
+    for(pos[0] = 0; pos[0] < g.w_size[0]; ++pos[0])
+    {
+        const auto rz = Range{g, 0, pos[0]};
+        for(pos[1] = 0; pos[1] < g.w_size[1]; ++pos[1])
+        {
+            const auto ry = Range{g, 1, pos[1]};
+            for(pos[2] = 0; pos[2] < g.w_size[2]; ++pos[2])
+            {
+                const auto rx = Range{g, 2, pos[2]};
+                if(!rz.Empty() && !ry.Empty() && !rx.Empty())
+                    f(pos, rz, ry, rx);
+            }
+        }
+    }
+}
+
+void Forward(const Geometry& g, const float* x, const float* w, float* y)
+{
+    const auto& xs      = g.x_strides;
+    const auto& ys      = g.y_strides;
+    const auto k_blocks = (g.k + ChannelBlock - 1) / ChannelBlock;
+    const auto plane    = g.YPlane();
+    const auto tasks    = g.n * g.params.groups * k_blocks;
+
+    par_for(tasks, min_grain{1}, [&](std::size_t task) {
+        const auto t      = static_cast<std::ptrdiff_t>(task);
+        const auto n      = t / (g.params.groups * k_blocks);
+        const auto group  = t / k_blocks % g.params.groups;
+        const auto k_base = group * g.k + t % k_blocks * ChannelBlock;
+        const auto k_size = std::min(ChannelBlock, (group + 1) * g.k - k_base);
+        auto acc          = std::vector<float>(k_size * plane, 0.0f);
+
+        for(auto c = group * g.c; c < (group + 1) * g.c; ++c)
+        {
+            const auto x_plane = x + n * xs[0] + c * xs[1];
+
+            ForEachFilterPosition(g, [&](auto f, auto rz, auto ry, auto rx) {
+                float weights[ChannelBlock];
+                for(auto kb = 0; kb < k_size; ++kb)
+                    weights[kb] = w[g.WIndex(k_base + kb, c - group * g.c, f)];
+
+                const auto x_step = rx.stride * xs[4];
+                for(auto oz = rz.begin; oz < rz.end; ++oz)
+                {
+                    for(auto oy = ry.begin; oy < ry.end; ++oy)
+                    {
+                        const auto x_row =
+                            x_plane + rz.In(oz) * xs[2] + ry.In(oy) * xs[3] + rx.In(0) * xs[4];
+                        for(auto kb = 0; kb < k_size; ++kb)
+                        {
+                            const auto acc_row =
+                                acc.data() + kb * plane + (oz * g.y_size[1] + oy) * g.y_size[2];
+                            for(auto ox = rx.begin; ox < rx.end; ++ox)
+                                acc_row[ox] += weights[kb] * x_row[ox * x_step];
+                        }
+                    }
+                }
+            });
+        }
+
+        for(auto kb = 0; kb < k_size; ++kb)
+        {
+            const auto y_plane = y + n * ys[0] + (k_base + kb) * ys[1];
+            auto value         = acc.data() + kb * plane;
+            for(auto oz = 0; oz < g.y_size[0]; ++oz)
+                for(auto oy = 0; oy < g.y_size[1]; ++oy)
+                    for(auto ox = 0; ox < g.y_size[2]; ++ox)
+                        y_plane[oz * ys[2] + oy * ys[3] + ox * ys[4]] = *value++;
+        }
+    });
+}
+
+void BackwardData(const Geometry& g, const float* dy, const float* w, float* dx)
+{
+    const auto& xs      = g.x_strides;
+    const auto& ys      = g.y_strides;
+    const auto c_blocks = (g.c + ChannelBlock - 1) / ChannelBlock;
+    const auto plane    = g.XPlane();
+    const auto tasks    = g.n * g.params.groups * c_blocks;
+
+    par_for(tasks, min_grain{1}, [&](std::size_t task) {
+        const auto t      = static_cast<std::ptrdiff_t>(task);
+        const auto n      = t / (g.params.groups * c_blocks);
+        const auto group  = t / c_blocks % g.params.groups;
+        const auto c_base = t % c_blocks * ChannelBlock; // Within the group.
+        const auto c_size = std::min(ChannelBlock, g.c - c_base);
+        auto acc          = std::vector<float>(c_size * plane, 0.0f);
+
+        for(auto k = group * g.k; k < (group + 1) * g.k; ++k)
+        {
+            const auto dy_plane = dy + n * ys[0] + k * ys[1];
+
+            ForEachFilterPosition(g, [&](auto f, auto rz, auto ry, auto rx) {
+                float weights[ChannelBlock];
+                for(auto cb = 0; cb < c_size; ++cb)
+                    weights[cb] = w[g.WIndex(k, c_base + cb, f)];
+
+                for(auto oz = rz.begin; oz < rz.end; ++oz)
+                {
+                    for(auto oy = ry.begin; oy < ry.end; ++oy)
+                    {
+                        const auto dy_row = dy_plane + oz * ys[2] + oy * ys[3];
+                        const auto acc_offset =
+                            (rz.In(oz) * g.x_size[1] + ry.In(oy)) * g.x_size[2] + rx.In(0);
+                        for(auto cb = 0; cb < c_size; ++cb)
+                        {
+                            const auto acc_row = acc.data() + cb * plane + acc_offset;
+                            for(auto ox = rx.begin; ox < rx.end; ++ox)
+                                acc_row[ox * rx.stride] += weights[cb] * dy_row[ox * ys[4]];
+                        }
+                    }
+                }
+            });
+        }
+
+        for(auto cb = 0; cb < c_size; ++cb)
+        {
+            const auto dx_plane = dx + n * xs[0] + (group * g.c + c_base + cb) * xs[1];
+            auto value          = acc.data() + cb * plane;
+            for(auto iz = 0; iz < g.x_size[0]; ++iz)
+                for(auto iy = 0; iy < g.x_size[1]; ++iy)
+                    for(auto ix = 0; ix < g.x_size[2]; ++ix)
+                        dx_plane[iz * xs[2] + iy * xs[3] + ix * xs[4]] = *value++;
+        }
+    });
+}
+
+void BackwardWeights(const Geometry& g, const float* dy, const float* x, float* dw)
+{
+    const auto& xs   = g.x_strides;
+    const auto& ys   = g.y_strides;
+    const auto tasks = g.params.groups * g.k * g.c;
+
+    par_for(tasks, min_grain{1}, [&](std::size_t task) {
+        const auto t     = static_cast<std::ptrdiff_t>(task);
+        const auto k     = t / g.c; // Across the groups.
+        const auto c     = t % g.c; // Within the group.
+        const auto group = k / g.k;
+
+        auto pos = Dims3{};
+        for(pos[0] = 0; pos[0] < g.w_size[0]; ++pos[0])
+            for(pos[1] = 0; pos[1] < g.w_size[1]; ++pos[1])
+                for(pos[2] = 0; pos[2] < g.w_size[2]; ++pos[2])
+                    dw[g.WIndex(k, c, pos)] = 0.0f;
+
+        for(auto n = 0; n < g.n; ++n)
+        {
+            const auto x_plane  = x + n * xs[0] + (group * g.c + c) * xs[1];
+            const auto dy_plane = dy + n * ys[0] + k * ys[1];
+
+            ForEachFilterPosition(g, [&](auto f, auto rz, auto ry, auto rx) {
+                const auto x_step = rx.stride * xs[4];
+                auto sum          = 0.0f;
+                for(auto oz = rz.begin; oz < rz.end; ++oz)
+                {
+                    for(auto oy = ry.begin; oy < ry.end; ++oy)
+                    {
+                        const auto dy_row = dy_plane + oz * ys[2] + oy * ys[3];
+                        const auto x_row =
+                            x_plane + rz.In(oz) * xs[2] + ry.In(oy) * xs[3] + rx.In(0) * xs[4];
+                        for(auto ox = rx.begin; ox < rx.end; ++ox)
+                            sum += dy_row[ox * ys[4]] * x_row[ox * x_step];
+                    }
+                }
+                dw[g.WIndex(k, c, f)] += sum;
+            });
+        }
+    });
+}
+
+} // namespace
+
+Invoker MakeDirectHostInvoker(const ConvolutionDescriptor& conv, Direction direction)
+{
+    const auto params = ConvParams{conv};
+
+    return [params, direction](const Handle& handle, const AnyInvokeParams& primitive_params) {
+        const auto start = std::chrono::steady_clock::now();
+
+        if(direction == Direction::BackwardWeights)
+        {
+            const auto& t = primitive_params.CastTo<WrWInvokeParams>().tensors;
+            BackwardWeights(Geometry{t.xDesc, t.dwDesc, t.dyDesc, params},
+                            static_cast<const float*>(t.dy),
+                            static_cast<const float*>(t.x),
+                            static_cast<float*>(t.dw));
+        }
+        else
+        {
+            const auto& t  = primitive_params.CastTo<DataInvokeParams>().tensors;
+            const auto in  = static_cast<const float*>(t.in);
+            const auto w   = static_cast<const float*>(t.w);
+            const auto out = static_cast<float*>(t.out);
+
+            if(direction == Direction::Forward)
+                Forward(Geometry{t.inDesc, t.wDesc, t.outDesc, params}, in, w, out);
+            else
+                BackwardData(Geometry{t.outDesc, t.wDesc, t.inDesc, params}, in, w, out);
+        }
+
+        if(handle.IsProfilingEnabled())
+        {
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            handle.ResetKernelTime();
+            handle.AccumKernelTime(std::chrono::duration<float, std::milli>(elapsed).count());
+        }
+    };
+}
+
+} // namespace conv
+} // namespace miopen
@@ -29,6 +29,8 @@
 #include <miopen/conv/data_invoke_params.hpp>
 #include <miopen/conv/wrw_invoke_params.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
 
 namespace miopen {
@@ -59,7 +61,135 @@ std::ostream& operator<<(std::ostream& stream, std::function<void(std::ostream&)
     return stream;
 }
 
+LayoutId GetLayoutId(const std::string& layout)
+{
+    if(layout == "NCHW")
+        return LayoutId::NCHW;
+    if(layout == "NHWC")
+        return LayoutId::NHWC;
+    if(layout == "CHWN")
+        return LayoutId::CHWN;
+    if(layout == "NCDHW")
+        return LayoutId::NCDHW;
+    if(layout == "NDHWC")
+        return LayoutId::NDHWC;
+    return LayoutId::Other;
+}
+
+static constexpr std::uint64_t Prime1 = 0x9e3779b185ebca87ull;
+static constexpr std::uint64_t Prime2 = 0xc2b2ae3d27d4eb4full;
+
+static std::uint64_t RotateLeft(std::uint64_t x, int bits) { return (x << bits) | (x >> (64 - bits)); }
+
+static std::uint64_t Round(std::uint64_t acc, std::uint64_t word)
+{
+    return RotateLeft(acc + word * Prime2, 31) * Prime1;
+}
+
+/// XXH64 scheme over whole words: four independent lanes, merged and avalanched at the end.
+std::uint64_t ProblemKey::Hash() const
+{
+    constexpr auto n_words = sizeof(ProblemKey) / sizeof(std::uint64_t);
+    static_assert(sizeof(ProblemKey) % sizeof(std::uint64_t) == 0, "");
+
+    std::uint64_t words[n_words];
+    std::memcpy(words, this, sizeof(words));
+
+    std::uint64_t lanes[4] = {Prime1 + Prime2, Prime2, 0, 0 - Prime1};
+    auto i = std::size_t{0};
+    for(; i + 4 <= n_words; i += 4)
+        for(auto lane = std::size_t{0}; lane < 4; ++lane)
+            lanes[lane] = Round(lanes[lane], words[i + lane]);
+
+    auto hash = RotateLeft(lanes[0], 1) + RotateLeft(lanes[1], 7) + RotateLeft(lanes[2], 12) +
+                RotateLeft(lanes[3], 18);
+    for(const auto lane : lanes)
+        hash = (hash ^ Round(0, lane)) * Prime1 + 0x85ebca77c2b2ae63ull;
+    for(; i < n_words; ++i)
+        hash = RotateLeft(hash ^ Round(0, words[i]), 27) * Prime1 + 0x85ebca77c2b2ae63ull;
+
+    hash += sizeof(ProblemKey);
+    hash ^= hash >> 33;
+    hash *= Prime2;
+    hash ^= hash >> 29;
+    hash *= 0x165667b19e3779f9ull;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+bool ProblemKey::operator==(const ProblemKey& other) const
+{
+    return std::memcmp(this, &other, sizeof(ProblemKey)) == 0;
+}
+
+template <class TDst, class TSrc>
+static void CopyDims(TDst& dst, const std::vector<TSrc>& src)
+{
+    const auto n = std::min(dst.size(), src.size());
+    for(auto i = std::size_t{0}; i < n; ++i)
+        dst[i] = src[i];
+}
+
+ProblemKey ProblemDescription::MakeKey() const
+{
+    auto ret = ProblemKey{};
+
+    CopyDims(ret.in_lengths, in.GetLengths());
+    CopyDims(ret.in_strides, in.GetStrides());
+    CopyDims(ret.weights_lengths, weights.GetLengths());
+    CopyDims(ret.weights_strides, weights.GetStrides());
+    CopyDims(ret.out_lengths, out.GetLengths());
+    CopyDims(ret.out_strides, out.GetStrides());
+    CopyDims(ret.pads, conv.GetConvPads());
+    CopyDims(ret.conv_strides, conv.GetConvStrides());
+    CopyDims(ret.dilations, conv.GetConvDilations());
+    CopyDims(ret.trans_output_pads, conv.GetTransposeConvPads());
+
+    ret.group_count    = conv.GetGroupCount();
+    ret.bias           = bias;
+    ret.spatial_dims   = static_cast<std::uint8_t>(GetSpatialDims());
+    ret.in_type        = static_cast<std::uint8_t>(GetInDataType());
+    ret.weights_type   = static_cast<std::uint8_t>(GetWeightsDataType());
+    ret.out_type       = static_cast<std::uint8_t>(GetOutDataType());
+    ret.in_layout      = GetLayoutId(in_layout);
+    ret.weights_layout = GetLayoutId(weights_layout);
+    ret.out_layout     = GetLayoutId(out_layout);
+    ret.direction      = static_cast<std::uint8_t>(direction);
+    ret.conv_mode      = static_cast<std::uint8_t>(conv.mode);
+    ret.padding_mode   = static_cast<std::uint8_t>(conv.paddingMode);
+
+    return ret;
+}
+
+static bool IsLayoutDefault(const ProblemKey& key)
+{
+    const auto all_are = [&](LayoutId layout) {
+        return key.in_layout == layout && key.weights_layout == layout && key.out_layout == layout;
+    };
+    return all_are(LayoutId::NCHW) || all_are(LayoutId::NCDHW);
+}
+
+const NetworkConfig& ProblemDescription::GetNetworkConfig() const
+{
+    std::call_once(cache->network_config_flag,
+                   [&]() { cache->network_config = NetworkConfig{BuildConfKeyImpl()}; });
+    return cache->network_config;
+}
+
+const std::string& ProblemDescription::GetDbKey() const
+{
+    std::call_once(cache->db_key_flag, [&]() { cache->db_key = SerializeImpl(); });
+    return cache->db_key;
+}
+
 void ProblemDescription::BuildConfKey(std::string& conf_key) const
+{
+    conf_key = GetNetworkConfig().GetValue();
+}
+
+void ProblemDescription::Serialize(std::ostream& stream) const { stream << GetDbKey(); }
+
+std::string ProblemDescription::BuildConfKeyImpl() const
 {
     std::ostringstream ss;
 
@@ -70,8 +200,7 @@ void ProblemDescription::BuildConfKey(std::string& conf_key) const
     ss << 'x' << GetOutChannels();
     ss << 'x' << PrintDHW('x', GetSpatialDims(), GetOutDepth(), GetOutHeight(), GetOutWidth());
     ss << 'x' << GetInBatchSize();
-    if((GetInLayout() == "NCHW" && GetWeightsLayout() == "NCHW" && GetOutLayout() == "NCHW") ||
-       (GetInLayout() == "NCDHW" && GetWeightsLayout() == "NCDHW" && GetOutLayout() == "NCDHW"))
+    if(IsLayoutDefault(key))
     {
         ss << 'x' << GetInLayout();
     }
@@ -96,11 +225,12 @@ void ProblemDescription::BuildConfKey(std::string& conf_key) const
     case Direction::BackwardWeights: ss << 'x' << "W"; break;
     }
 
-    conf_key = ss.str();
+    return ss.str();
 }
 
-void ProblemDescription::Serialize(std::ostream& stream) const
+std::string ProblemDescription::SerializeImpl() const
 {
+    std::ostringstream stream;
     const auto sep = '-';
     // Problem description with default layout
     // 576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-F
@@ -117,8 +247,7 @@ void ProblemDescription::Serialize(std::ostream& stream) const
     stream << sep << PrintDHW('x', GetSpatialDims(), GetKernelStrideD(), GetKernelStrideH(), GetKernelStrideW());
     stream << sep << PrintDHW('x', GetSpatialDims(), GetDilationD(), GetDilationH(), GetDilationW());
     stream << sep << GetBias();
-    if ((GetInLayout() == "NCHW" && GetWeightsLayout() == "NCHW" && GetOutLayout() == "NCHW") 
-        || (GetInLayout() == "NCDHW" && GetWeightsLayout() == "NCDHW" && GetOutLayout() == "NCDHW"))
+    if (IsLayoutDefault(key))
     {
         stream << sep << GetInLayout();
     }else {
@@ -148,6 +277,7 @@ void ProblemDescription::Serialize(std::ostream& stream) const
     {
         stream << '_' << optional.str();
     }
+    return stream.str();
 }
 
 } // namespace conv
@@ -24,11 +24,15 @@
  *
  *******************************************************************************/
 #include <miopen/db.hpp>
+#include <miopen/db_index.hpp>
 #include <miopen/db_record.hpp>
+#include <miopen/db_record_cache.hpp>
+#include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/md5.hpp>
+#include <miopen/statistics.hpp>
 
 #include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/filesystem.hpp>
@@ -44,11 +48,29 @@
 #include <ios>
 #include <mutex>
 #include <shared_mutex>
+#include <sstream>
 #include <string>
 #include <vector>
 
 namespace miopen {
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_PLAIN_TEXT_DB_INDEX)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_PLAIN_TEXT_DB_JOURNAL)
+
+/// Lookups are served from the memory-mapped index (see DbIndex) unless disabled.
+static bool IsIndexEnabled() { return !miopen::IsDisabled(MIOPEN_DEBUG_PLAIN_TEXT_DB_INDEX{}); }
+
+/// In journaled mode changes are appended to the end of the file, and the last line with a key
+/// supersedes all the previous ones. The index is required to track superseded lines.
+static bool IsJournalEnabled()
+{
+    return IsIndexEnabled() && miopen::IsEnabled(MIOPEN_DEBUG_PLAIN_TEXT_DB_JOURNAL{});
+}
+
+/// The journal is compacted when superseded lines take at least half of the file,
+/// which keeps the amortized cost of a change proportional to the record size.
+static constexpr std::uint64_t JournalCompactionMinSize() { return 64 * 1024; }
+
 struct RecordPositions
 {
     std::streamoff begin = -1;
@@ -96,45 +118,155 @@ static std::chrono::seconds GetLockTimeout() { return std::chrono::seconds{60};
 using exclusive_lock = std::unique_lock<LockFile>;
 using shared_lock    = std::shared_lock<LockFile>;
 
+using RecordCache = DbRecordCache<DbFileStamp>;
+
 boost::optional<DbRecord> PlainTextDb::FindRecord(const std::string& key)
 {
+    static auto& hits   = Statistics::Counter("plain_text_db.hits");
+    static auto& misses = Statistics::Counter("plain_text_db.misses");
+    static auto& time   = Statistics::Histogram("plain_text_db.find");
+
+    const StatTimer timer{time};
+    const auto counted = [&](boost::optional<DbRecord>&& record) {
+        ++(record ? hits : misses);
+        return std::move(record);
+    };
+    auto& cache = RecordCache::Instance();
+
+    if(cache.IsEnabled())
+    {
+        auto cached = boost::optional<DbRecord>{};
+        if(cache.Find(filename, key, DbFileStamp::Get(filename), cached))
+            return counted(std::move(cached));
+    }
+
+    if(IsIndexEnabled())
+    {
+        // An up-to-date index covers only completely written data, so no lock is needed.
+        const auto index = DbIndex::GetCurrent(filename);
+        if(index)
+        {
+            auto record = FindRecordIndexed(*index, key, nullptr);
+            cache.Store(filename, key, index->GetStamp(), record);
+            return counted(std::move(record));
+        }
+    }
+
     const auto lock = shared_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
-    return FindRecordUnsafe(key, nullptr);
+    auto record = FindRecordUnsafe(key, nullptr);
+    if(cache.IsEnabled())
+        cache.Store(filename, key, DbFileStamp::Get(filename), record);
+    return counted(std::move(record));
+}
+
+std::vector<SimilarDbRecord> PlainTextDb::FindSimilarRecords(const std::string& key,
+                                                             const std::string& id,
+                                                             std::size_t limit,
+                                                             float max_distance)
+{
+    static auto& time = Statistics::Histogram("plain_text_db.find_similar");
+    const StatTimer timer{time};
+
+    // Similar records are looked up in the index regardless of MIOPEN_DEBUG_PLAIN_TEXT_DB_INDEX,
+    // as reading the file line by line would parse every record of it.
+    auto index = DbIndex::GetCurrent(filename);
+    if(!index)
+    {
+        const auto lock = shared_lock(lock_file, GetLockTimeout());
+        MIOPEN_VALIDATE_LOCK(lock);
+        index = DbIndex::Get(filename);
+    }
+
+    auto records = std::vector<SimilarDbRecord>{};
+    if(!index->IsReadable())
+        return records;
+
+    for(const auto& similar : index->FindSimilar(key, id, limit, max_distance))
+    {
+        DbRecord record(similar.key);
+        if(!record.ParseContents(similar.match.contents_begin, similar.match.contents_end))
+        {
+            MIOPEN_LOG_E("Error parsing payload under the key: " << similar.key << " form file "
+                                                                 << filename
+                                                                 << "#"
+                                                                 << similar.match.n_line);
+            continue;
+        }
+        records.push_back({similar.distance, std::move(record)});
+    }
+
+    MIOPEN_LOG_I2("Found " << records.size() << " records similar to " << key << " in file "
+                           << filename);
+    return records;
 }
 
 bool PlainTextDb::StoreRecord(const DbRecord& record)
 {
     const auto lock = exclusive_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
-    return StoreRecordUnsafe(record);
+    const auto before = DbFileStamp::Get(filename);
+    if(!StoreRecordUnsafe(record))
+        return false;
+    UpdateCached(record.key, before, boost::make_optional(record.GetSize() != 0, record));
+    return true;
 }
 
 bool PlainTextDb::UpdateRecord(DbRecord& record)
 {
     const auto lock = exclusive_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
-    return UpdateRecordUnsafe(record);
+    const auto before = DbFileStamp::Get(filename);
+    if(!UpdateRecordUnsafe(record))
+        return false;
+    UpdateCached(record.key, before, record);
+    return true;
 }
 
 bool PlainTextDb::RemoveRecord(const std::string& key)
 {
     const auto lock = exclusive_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
-    return RemoveRecordUnsafe(key);
+    const auto before = DbFileStamp::Get(filename);
+    if(!RemoveRecordUnsafe(key))
+        return false;
+    UpdateCached(key, before, boost::none);
+    return true;
+}
+
+bool PlainTextDb::Compact()
+{
+    const auto lock = exclusive_lock(lock_file, GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+    return CompactUnsafe();
 }
 
 bool PlainTextDb::Remove(const std::string& key, const std::string& id)
 {
     const auto lock = exclusive_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
-    auto record = FindRecordUnsafe(key, nullptr);
+    const auto before = DbFileStamp::Get(filename);
+    auto record       = FindRecordUnsafe(key, nullptr);
     if(!record)
         return false;
     bool erased = record->EraseValues(id);
     if(!erased)
         return false;
-    return StoreRecordUnsafe(*record);
+    if(!StoreRecordUnsafe(*record))
+        return false;
+    UpdateCached(key, before, boost::make_optional(record->GetSize() != 0, *record));
+    return true;
+}
+
+void PlainTextDb::UpdateCached(const std::string& key,
+                               const DbFileStamp& before,
+                               const boost::optional<DbRecord>& record) const
+{
+    // The exclusive lock is held since 'before' has been taken, so the only change of the file
+    // is the one of the record.
+    auto& cache = RecordCache::Instance();
+    if(cache.IsEnabled())
+        cache.Update(filename, key, before, DbFileStamp::Get(filename), record);
 }
 
 boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
@@ -146,6 +278,11 @@ boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
         pos->end   = -1;
     }
 
+    if(IsIndexEnabled())
+    {
+        return FindRecordIndexed(*DbIndex::Get(filename), key, pos);
+    }
+
     MIOPEN_LOG_I2("Looking for key " << key << " in file " << filename);
 
     std::ifstream file(filename);
@@ -160,6 +297,9 @@ boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
         return boost::none;
     }
 
+    // Records may be superseded by later lines with the same key (see journaled writes),
+    // so the whole file is scanned and the last line wins.
+    auto found = boost::optional<DbRecord>{};
     int n_line = 0;
     while(true)
     {
@@ -191,9 +331,17 @@ boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
 
         if(contents.empty())
         {
-            MIOPEN_LOG_E("None contents under the key: " << current_key << " form file " << filename
-                                                         << "#"
-                                                         << n_line);
+            // A tombstone: the record has been removed.
+            MIOPEN_LOG_I2("Removed record under the key: " << current_key << " form file "
+                                                           << filename
+                                                           << "#"
+                                                           << n_line);
+            found = boost::none;
+            if(pos != nullptr)
+            {
+                pos->begin = -1;
+                pos->end   = -1;
+            }
             continue;
         }
         MIOPEN_LOG_I2("Contents found: " << contents);
@@ -215,10 +363,50 @@ boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
             pos->begin = line_begin;
             pos->end   = next_line_begin;
         }
-        return record;
+        found = std::move(record);
     }
-    // Record was not found
-    return boost::none;
+    return found;
+}
+
+boost::optional<DbRecord> PlainTextDb::FindRecordIndexed(const DbIndex& index,
+                                                         const std::string& key,
+                                                         RecordPositions* pos) const
+{
+    MIOPEN_LOG_I2("Looking for key " << key << " in file " << filename);
+
+    if(!index.IsReadable())
+    {
+        if(warn_if_unreadable && !MIOPEN_DISABLE_SYSDB)
+            MIOPEN_LOG_W("File is unreadable: " << filename);
+        else
+            MIOPEN_LOG_I2("File is unreadable: " << filename);
+
+        return boost::none;
+    }
+
+    auto match = DbIndex::Match{};
+    if(!index.Find(key, match))
+        return boost::none;
+
+    MIOPEN_LOG_I2("Key match: " << key);
+
+    DbRecord record(key);
+    const bool is_parse_ok = record.ParseContents(match.contents_begin, match.contents_end);
+
+    if(!is_parse_ok)
+    {
+        MIOPEN_LOG_E("Error parsing payload under the key: " << key << " form file " << filename
+                                                             << "#"
+                                                             << match.n_line);
+        MIOPEN_LOG_E("Contents: " << std::string(match.contents_begin, match.contents_end));
+    }
+
+    if(pos != nullptr)
+    {
+        pos->begin = match.line_begin;
+        pos->end   = match.line_end;
+    }
+    return record;
 }
 
 static void Copy(std::istream& from, std::ostream& to, std::streamoff count)
@@ -242,6 +430,9 @@ bool PlainTextDb::FlushUnsafe(const DbRecord& record, const RecordPositions* pos
 {
     assert(pos);
 
+    if(IsJournalEnabled())
+        return AppendUnsafe(record, *pos);
+
     if(pos->begin < 0 || pos->end < 0)
     {
         {
@@ -261,6 +452,18 @@ bool PlainTextDb::FlushUnsafe(const DbRecord& record, const RecordPositions* pos
     }
     else
     {
+        if(IsIndexEnabled() && DbIndex::Get(filename)->GetSupersededBytes() != 0)
+        {
+            // The file has been written in journaled mode. Replacing the actual line in place
+            // could expose the superseded ones, so the file is compacted first. Blank and
+            // ill-formed lines are harmless and are kept.
+            if(!CompactUnsafe())
+                return false;
+            RecordPositions compacted;
+            FindRecordUnsafe(record.key, &compacted);
+            return FlushUnsafe(record, &compacted);
+        }
+
         std::ifstream from(filename, std::ios::ate);
 
         if(!from)
@@ -297,6 +500,89 @@ bool PlainTextDb::FlushUnsafe(const DbRecord& record, const RecordPositions* pos
     return true;
 }
 
+bool PlainTextDb::AppendUnsafe(const DbRecord& record, const RecordPositions& pos)
+{
+    const auto is_found = pos.begin >= 0 && pos.end >= 0;
+    const auto is_removal = record.map.empty();
+
+    if(is_removal && !is_found)
+        return true;
+
+    // Index of the file before the change. It is up to date as the lock is held since the
+    // lookup of the record.
+    const auto index = DbIndex::Get(filename);
+
+    std::ostringstream line;
+    if(is_removal)
+        line << record.key << '=' << std::endl; // Tombstone
+    else
+        record.WriteContents(line);
+
+    {
+        std::ofstream file(filename, std::ios::app);
+
+        if(!file)
+        {
+            MIOPEN_LOG_E("File is unwritable: " << filename);
+            return false;
+        }
+
+        file << line.str();
+    }
+
+    boost::filesystem::permissions(filename, boost::filesystem::all_all);
+
+    const auto written = static_cast<std::uint64_t>(line.str().size());
+    const auto total   = index->GetStamp().size + written;
+    auto dead          = index->GetDeadBytes();
+
+    if(is_found)
+        dead += pos.end - pos.begin;
+    if(is_removal)
+        dead += written;
+
+    if(total >= JournalCompactionMinSize() && dead * 2 >= total)
+        return CompactUnsafe();
+    return true;
+}
+
+bool PlainTextDb::CompactUnsafe()
+{
+    const auto index = DbIndex::Get(filename);
+
+    if(!index->IsReadable() || index->GetDeadBytes() == 0)
+        return true;
+
+    MIOPEN_LOG_I("Compacting " << filename << ": " << index->GetDeadBytes() << " of "
+                               << index->GetStamp().size
+                               << " bytes are superseded");
+
+    const auto temp_name = filename + ".temp";
+
+    {
+        std::ofstream to(temp_name);
+
+        if(!to)
+        {
+            MIOPEN_LOG_E("Temp file is unwritable: " << temp_name);
+            return false;
+        }
+
+        index->WriteLive(to);
+
+        if(!to)
+        {
+            MIOPEN_LOG_E("Unable to write temp file: " << temp_name);
+            return false;
+        }
+    }
+
+    std::remove(filename.c_str());
+    std::rename(temp_name.c_str(), filename.c_str());
+    boost::filesystem::permissions(filename, boost::filesystem::all_all);
+    return true;
+}
+
 bool PlainTextDb::StoreRecordUnsafe(const DbRecord& record)
 {
     MIOPEN_LOG_I2("Storing record: " << record.key);
@@ -313,6 +599,14 @@ bool PlainTextDb::UpdateRecordUnsafe(DbRecord& record)
     if(old_record)
     {
         new_record.Merge(*old_record);
+
+        if(new_record.map == old_record->map)
+        {
+            MIOPEN_LOG_I2("Record is the same, not changed: " << record.key);
+            record = std::move(new_record);
+            return true;
+        }
+
         MIOPEN_LOG_I2("Updating record: " << record.key);
     }
     else
@@ -0,0 +1,438 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/db_index.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/solver_ranking.hpp>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <ostream>
+
+namespace miopen {
+
+DbFileStamp DbFileStamp::Get(const std::string& path)
+{
+    auto stamp = DbFileStamp{};
+    struct stat st;
+
+    if(stat(path.c_str(), &st) != 0)
+        return stamp;
+
+    stamp.exists   = true;
+    stamp.inode    = st.st_ino;
+    stamp.size     = st.st_size;
+    stamp.mtime_ns = static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+    return stamp;
+}
+
+// Never destroyed, as well as the other registries used by the db writes, which may be performed at
+// process exit (see WriteBehindQueue).
+static std::mutex& IndicesMutex()
+{
+    static auto& mutex = *new std::mutex{};
+    return mutex;
+}
+
+static std::map<std::string, std::shared_ptr<const DbIndex>>& Indices()
+{
+    static auto& indices = *new std::map<std::string, std::shared_ptr<const DbIndex>>{};
+    return indices;
+}
+
+DbIndex::DbIndex(const std::string& path, const DbFileStamp& stamp_) : stamp(stamp_)
+{
+    if(Map(path))
+        Build(path);
+}
+
+DbIndex::DbIndex(const std::string& path, const DbFileStamp& stamp_, const DbIndex& previous)
+    : stamp(stamp_)
+{
+    if(!Map(path))
+        return;
+
+    if(IsAppendOf(previous))
+        Extend(path, previous);
+    else
+        Build(path);
+}
+
+DbIndex::~DbIndex() = default;
+
+bool DbIndex::Map(const std::string& path)
+{
+    if(!stamp.exists || stamp.size == 0)
+        return false;
+
+    try
+    {
+        namespace bip = boost::interprocess;
+        const auto mapping = bip::file_mapping{path.c_str(), bip::read_only};
+        region = std::make_unique<bip::mapped_region>(mapping, bip::read_only, 0, stamp.size);
+        data   = static_cast<const char*>(region->get_address());
+    }
+    catch(const boost::interprocess::interprocess_exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to map file " << path << ": " << ex.what());
+        stamp.exists = false;
+        return false;
+    }
+
+    return true;
+}
+
+bool DbIndex::IsAppendOf(const DbIndex& previous) const
+{
+    // The db rewrites files by renaming temporary ones, so the same inode and a larger size mean
+    // that lines have been appended. An external in-place edit is not distinguishable by the
+    // stamp, so the last line of the previous state is compared too.
+    const auto& old = previous.stamp;
+    if(!old.exists || old.size == 0 || old.inode != stamp.inode || old.size >= stamp.size ||
+       previous.data[old.size - 1] != '\n')
+        return false;
+
+    const auto tail      = std::min<std::uint64_t>(old.size, 4096);
+    const auto tail_from = old.size - tail;
+    return std::memcmp(data + tail_from, previous.data + tail_from, tail) == 0;
+}
+
+void DbIndex::Parse(const std::string& path, std::uint64_t begin, std::vector<Entry>& parsed)
+{
+    const auto end = data + stamp.size;
+    parsed_bytes   = stamp.size - begin;
+
+    for(auto line_begin = data + begin; line_begin < end;)
+    {
+        const auto eol =
+            static_cast<const char*>(std::memchr(line_begin, '\n', end - line_begin));
+        const auto line_end  = eol != nullptr ? eol : end;
+        const auto next_line = eol != nullptr ? eol + 1 : end;
+        ++n_lines;
+
+        const auto key_end =
+            static_cast<const char*>(std::memchr(line_begin, '=', line_end - line_begin));
+        const auto key_size = key_end != nullptr ? key_end - line_begin : 0;
+
+        if(key_size == 0)
+        {
+            if(line_end != line_begin) // Do not blame empty lines.
+                MIOPEN_LOG_E("Ill-formed record: key not found: " << path << "#" << n_lines);
+            ill_formed_bytes += next_line - line_begin;
+            dead_bytes += next_line - line_begin;
+        }
+        else
+        {
+            // Lines with empty contents are tombstones of removed records and are indexed too.
+            parsed.push_back({static_cast<std::uint64_t>(line_begin - data),
+                              static_cast<std::uint64_t>(next_line - data),
+                              static_cast<std::uint32_t>(key_size),
+                              n_lines});
+        }
+
+        line_begin = next_line;
+    }
+
+    // Stable sort keeps lines with the same key in file order, so the last one is the actual.
+    std::stable_sort(parsed.begin(), parsed.end(), [&](const Entry& l, const Entry& r) {
+        return Compare(l, data + r.line_begin, r.key_size) < 0;
+    });
+}
+
+void DbIndex::Build(const std::string& path)
+{
+    Parse(path, 0, entries);
+
+    for(auto it = entries.cbegin(); it != entries.cend(); ++it)
+        if(IsSuperseded(it) || IsTombstone(*it))
+            dead_bytes += it->line_end - it->line_begin;
+
+    MIOPEN_LOG_I2("Indexed " << entries.size() << " records of " << path << ", " << dead_bytes
+                             << " bytes of "
+                             << stamp.size
+                             << " are superseded");
+}
+
+void DbIndex::Extend(const std::string& path, const DbIndex& previous)
+{
+    entries          = previous.entries;
+    dead_bytes       = previous.dead_bytes;
+    ill_formed_bytes = previous.ill_formed_bytes;
+    n_lines          = previous.n_lines;
+
+    auto appended = std::vector<Entry>{};
+    Parse(path, previous.stamp.size, appended);
+
+    for(auto it = appended.cbegin(); it != appended.cend(); ++it)
+    {
+        const auto next = std::next(it);
+        if(next != appended.cend() && Compare(*it, data + next->line_begin, next->key_size) == 0)
+        {
+            dead_bytes += it->line_end - it->line_begin;
+            continue;
+        }
+
+        if(IsTombstone(*it))
+            dead_bytes += it->line_end - it->line_begin;
+
+        // The actual line of the key in the previous state, if any, is superseded now.
+        const auto key   = data + it->line_begin;
+        const auto after = std::upper_bound(
+            entries.cbegin(), entries.cend(), *it, [&](const Entry& line, const Entry& entry) {
+                return Compare(entry, data + line.line_begin, line.key_size) > 0;
+            });
+        if(after == entries.cbegin())
+            continue;
+
+        const auto actual = std::prev(after);
+        if(Compare(*actual, key, it->key_size) == 0 && !IsTombstone(*actual))
+            dead_bytes += actual->line_end - actual->line_begin;
+    }
+
+    // Merge is stable as well, the previous lines precede the appended ones with the same key.
+    const auto previous_size = entries.size();
+    entries.insert(entries.end(), appended.begin(), appended.end());
+    std::inplace_merge(entries.begin(),
+                       entries.begin() + previous_size,
+                       entries.end(),
+                       [&](const Entry& l, const Entry& r) {
+                           return Compare(l, data + r.line_begin, r.key_size) < 0;
+                       });
+
+    MIOPEN_LOG_I2("Extended index of " << path << " by " << appended.size() << " records, "
+                                       << dead_bytes
+                                       << " bytes of "
+                                       << stamp.size
+                                       << " are superseded");
+}
+
+bool DbIndex::IsSuperseded(std::vector<Entry>::const_iterator entry) const
+{
+    const auto next = std::next(entry);
+    return next != entries.end() && Compare(*entry, data + next->line_begin, next->key_size) == 0;
+}
+
+int DbIndex::Compare(const Entry& entry, const char* key, std::size_t key_size) const
+{
+    const auto size = std::min<std::size_t>(entry.key_size, key_size);
+    const auto cmp  = std::memcmp(data + entry.line_begin, key, size);
+    if(cmp != 0)
+        return cmp;
+    return entry.key_size < key_size ? -1 : (entry.key_size > key_size ? 1 : 0);
+}
+
+const char* DbIndex::ContentsEnd(const Entry& entry) const
+{
+    const auto end = data + entry.line_end;
+    return end[-1] == '\n' ? end - 1 : end;
+}
+
+bool DbIndex::IsTombstone(const Entry& entry) const
+{
+    return data + entry.line_begin + entry.key_size + 1 == ContentsEnd(entry);
+}
+
+bool DbIndex::Find(const std::string& key, Match& match) const
+{
+    // The last of the lines with the given key.
+    const auto after = std::upper_bound(
+        entries.begin(), entries.end(), key, [&](const std::string&, const Entry& entry) {
+            return Compare(entry, key.data(), key.size()) > 0;
+        });
+
+    if(after == entries.begin())
+        return false;
+
+    const auto it = std::prev(after);
+    if(Compare(*it, key.data(), key.size()) != 0 || IsTombstone(*it))
+        return false;
+
+    match.contents_begin = data + it->line_begin + it->key_size + 1;
+    match.contents_end   = ContentsEnd(*it);
+    match.line_begin     = it->line_begin;
+    match.line_end       = it->line_end;
+    match.n_line         = it->n_line;
+    return true;
+}
+
+void DbIndex::BuildCategories() const
+{
+    auto problem = SolverRankingProblem{};
+
+    for(auto it = entries.cbegin(); it != entries.cend(); ++it)
+    {
+        if(IsSuperseded(it) || IsTombstone(*it) ||
+           !ParseSolverRankingProblem(std::string(data + it->line_begin, it->key_size), problem))
+            continue;
+
+        auto& category = categories[problem.category];
+        category.features.insert(
+            category.features.end(), problem.features.begin(), problem.features.end());
+        category.entries.push_back(it - entries.cbegin());
+    }
+}
+
+/// Checks if there are values under the id in the "id:values;id:values" contents.
+static bool HasValues(const char* begin, const char* end, const std::string& id)
+{
+    for(auto at = begin; end - at > static_cast<std::ptrdiff_t>(id.size());)
+    {
+        if(std::memcmp(at, id.data(), id.size()) == 0 && at[id.size()] == ':')
+            return true;
+
+        const auto next = static_cast<const char*>(std::memchr(at, ';', end - at));
+        if(next == nullptr)
+            break;
+        at = next + 1;
+    }
+    return false;
+}
+
+std::vector<DbIndex::Similar> DbIndex::FindSimilar(const std::string& key,
+                                                   const std::string& id,
+                                                   std::size_t limit,
+                                                   float max_distance) const
+{
+    auto found   = std::vector<Similar>{};
+    auto problem = SolverRankingProblem{};
+
+    if(limit == 0 || !ParseSolverRankingProblem(key, problem))
+        return found;
+
+    std::call_once(categories_once, [&]() { BuildCategories(); });
+
+    const auto category = categories.find(problem.category);
+    if(category == categories.end())
+        return found;
+
+    constexpr auto feature_count = SolverRankingProblem::feature_count;
+    const auto& features         = category->second.features;
+    auto candidates              = std::vector<std::pair<float, std::size_t>>{};
+
+    for(auto i = std::size_t{0}; i < category->second.entries.size(); ++i)
+    {
+        auto distance = 0.f;
+        for(auto f = std::size_t{0}; f < feature_count; ++f)
+            distance += std::abs(features[i * feature_count + f] - problem.features[f]);
+
+        if(distance <= max_distance)
+            candidates.emplace_back(distance, category->second.entries[i]);
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+
+    for(const auto& candidate : candidates)
+    {
+        const auto& entry         = entries[candidate.second];
+        const auto contents_begin = data + entry.line_begin + entry.key_size + 1;
+        const auto contents_end   = ContentsEnd(entry);
+
+        if(!HasValues(contents_begin, contents_end, id))
+            continue;
+
+        const auto match = Match{contents_begin,
+                                 contents_end,
+                                 static_cast<std::int64_t>(entry.line_begin),
+                                 static_cast<std::int64_t>(entry.line_end),
+                                 entry.n_line};
+        const auto similar_key = std::string(data + entry.line_begin, entry.key_size);
+        found.push_back({candidate.first, similar_key, match});
+
+        if(found.size() == limit)
+            break;
+    }
+
+    return found;
+}
+
+void DbIndex::WriteLive(std::ostream& stream) const
+{
+    auto live = std::vector<const Entry*>{};
+
+    for(auto it = entries.cbegin(); it != entries.cend(); ++it)
+        if(!IsSuperseded(it) && !IsTombstone(*it))
+            live.push_back(&*it);
+
+    std::sort(live.begin(), live.end(), [](const Entry* l, const Entry* r) {
+        return l->line_begin < r->line_begin;
+    });
+
+    for(const auto entry : live)
+    {
+        const auto contents_end = ContentsEnd(*entry);
+        stream.write(data + entry->line_begin, contents_end - (data + entry->line_begin));
+        stream << '\n';
+    }
+}
+
+std::shared_ptr<const DbIndex> DbIndex::GetCurrent(const std::string& path)
+{
+    auto index = std::shared_ptr<const DbIndex>{};
+
+    {
+        const std::lock_guard<std::mutex> lock{IndicesMutex()};
+        const auto it = Indices().find(path);
+        if(it == Indices().end())
+            return nullptr;
+        index = it->second;
+    }
+
+    if(index->GetStamp() != DbFileStamp::Get(path))
+        return nullptr;
+    return index;
+}
+
+std::shared_ptr<const DbIndex> DbIndex::Get(const std::string& path)
+{
+    auto cached = std::shared_ptr<const DbIndex>{};
+
+    {
+        const std::lock_guard<std::mutex> lock{IndicesMutex()};
+        const auto it = Indices().find(path);
+        if(it != Indices().end())
+            cached = it->second;
+    }
+
+    const auto stamp = DbFileStamp::Get(path);
+    if(cached && cached->GetStamp() == stamp)
+        return cached;
+
+    const auto index = cached ? std::make_shared<const DbIndex>(path, stamp, *cached)
+                              : std::make_shared<const DbIndex>(path, stamp);
+    const std::lock_guard<std::mutex> lock{IndicesMutex()};
+    Indices()[path] = index;
+    return index;
+}
+
+} // namespace miopen
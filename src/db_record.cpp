@@ -23,6 +23,7 @@
  * SOFTWARE.
  *
  *******************************************************************************/
+#include <algorithm>
 #include <iostream>
 #include <numeric>
 #include <ostream>
@@ -114,6 +115,45 @@ bool DbRecord::ParseContents(std::istream& contents)
     return (found > 0);
 }
 
+bool DbRecord::ParseContents(const char* begin, const char* end)
+{
+    int found = 0;
+
+    map.clear();
+
+    // Same splitting rules as std::getline(contents, id_and_values, ';') above,
+    // but without copying the whole contents into a stream first.
+    for(auto item_begin = begin; item_begin < end;)
+    {
+        const auto item_end = std::find(item_begin, end, ';');
+        const auto id_end   = std::find(item_begin, item_end, ':');
+
+        // Empty VALUES is ok, empty ID is not:
+        if(id_end == item_end)
+        {
+            MIOPEN_LOG_E("Ill-formed file: ID not found; skipped; key: " << key);
+        }
+        else
+        {
+            auto id = std::string(item_begin, id_end);
+
+            if(map.find(id) != map.end())
+            {
+                MIOPEN_LOG_E("Duplicate ID (ignored): " << id << "; key: " << key);
+            }
+            else
+            {
+                map.emplace(std::move(id), std::string(id_end + 1, item_end));
+                ++found;
+            }
+        }
+
+        item_begin = item_end == end ? end : item_end + 1;
+    }
+
+    return (found > 0);
+}
+
 void DbRecord::WriteContents(std::ostream& stream) const
 {
     if(map.empty())
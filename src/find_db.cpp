@@ -30,7 +30,18 @@
 #include <miopen/finddb_kernel_cache_key.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/perf_field.hpp>
+#include <miopen/solver_ranking.hpp>
 
+#if MIOPEN_EMBED_DB
+#include <miopen_data.hpp>
+#endif
+
+#include <boost/filesystem/path.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -44,8 +55,7 @@ boost::optional<std::string>& testing_find_db_path_override()
     return data;
 }
 
-template <class TDb>
-std::string FindDbRecord_t<TDb>::GetInstalledPath(Handle& handle)
+static std::string GetSystemFindDbPath(Handle& handle)
 {
 #if !MIOPEN_DISABLE_SYSDB
     return GetSystemDbPath() + "/" + handle.GetDbBasename() + "." + GetSystemFindDbSuffix() +
@@ -56,6 +66,12 @@ std::string FindDbRecord_t<TDb>::GetInstalledPath(Handle& handle)
 #endif
 }
 
+template <class TDb>
+std::string FindDbRecord_t<TDb>::GetInstalledPath(Handle& handle)
+{
+    return GetSystemFindDbPath(handle);
+}
+
 template <class TDb>
 std::string FindDbRecord_t<TDb>::GetUserPath(Handle& handle)
 {
@@ -167,6 +183,59 @@ bool FindDbRecord_t<TDb>::HasKernel(Handle& handle, const FindDbKCacheKey& key)
     return handle.HasKernel(key.algorithm_name, key.network_config);
 }
 
+static void LoadSolverRanking(const std::string& path, SolverRankingModel& model)
+{
+    constexpr bool isEmbedded = MIOPEN_EMBED_DB;
+    if(!testing_find_db_path_override() && isEmbedded)
+    {
+#if MIOPEN_EMBED_DB
+        const auto name = boost::filesystem::path(path).filename().string();
+        const auto& it  = miopen_data().find(name + ".o");
+        if(it != miopen_data().end() &&
+           model.Load(it->second.first, it->second.second - it->second.first))
+        {
+            MIOPEN_LOG_I2("Using In Memory solver ranking model: " << name);
+            return;
+        }
+#endif
+    }
+    else
+    {
+        auto file = std::ifstream{path, std::ios::binary};
+        if(file)
+        {
+            const auto data = std::string{std::istreambuf_iterator<char>{file},
+                                          std::istreambuf_iterator<char>{}};
+            if(model.Load(data.data(), data.size()))
+            {
+                MIOPEN_LOG_I2("Using solver ranking model: " << path);
+                return;
+            }
+        }
+    }
+
+    MIOPEN_LOG_I("Solver ranking model is unavailable: " << path);
+}
+
+const SolverRankingModel& GetSystemSolverRanking(Handle& handle)
+{
+    static std::mutex mutex;
+    static std::map<std::string, SolverRankingModel> models;
+
+    const auto find_db_path = testing_find_db_path_override() ? *testing_find_db_path_override()
+                                                              : GetSystemFindDbPath(handle);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = models.find(find_db_path);
+    if(it != models.end())
+        return it->second;
+
+    auto& model = models[find_db_path];
+    if(!find_db_path.empty())
+        LoadSolverRanking(GetSolverRankingPath(find_db_path), model);
+    return model;
+}
+
 template class FindDbRecord_t<FindDb>;
 template class FindDbRecord_t<UserFindDb>;
 
@@ -0,0 +1,173 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/generic_search.hpp>
+#include <miopen/db_path.hpp>
+
+#include <algorithm>
+#include <istream>
+#include <map>
+#include <ostream>
+
+namespace miopen {
+namespace solver {
+
+static const char* const SearchStrategyNames[] = {"exhaustive", "random", "halving", "descent"};
+
+std::ostream& operator<<(std::ostream& os, SearchStrategy strategy)
+{
+    return os << SearchStrategyNames[static_cast<int>(strategy)];
+}
+
+bool ParseSearchStrategy(const std::string& name, SearchStrategy& strategy)
+{
+    for(auto i = 0; i < static_cast<int>(sizeof(SearchStrategyNames) / sizeof(char*)); ++i)
+    {
+        if(name == SearchStrategyNames[i])
+        {
+            strategy = static_cast<SearchStrategy>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool& IsLastSearchLimited()
+{
+    static thread_local auto is_limited = false;
+    return is_limited;
+}
+
+void SearchTrace::Write(std::ostream& stream) const
+{
+    stream << '#' << solver << '\n';
+
+    for(auto i = std::size_t{0}; i < configs.size(); ++i)
+    {
+        stream << times[i];
+        for(const auto& field : configs[i].fields)
+            stream << '\t' << field;
+        stream << '\n';
+    }
+}
+
+std::vector<SearchTrace> SearchTrace::Read(std::istream& stream)
+{
+    auto traces = std::vector<SearchTrace>{};
+    auto line   = std::string{};
+
+    while(std::getline(stream, line))
+    {
+        if(line.empty())
+            continue;
+
+        if(line[0] == '#')
+        {
+            traces.push_back({line.substr(1), {}, {}});
+            continue;
+        }
+
+        if(traces.empty())
+        {
+            MIOPEN_LOG_W("Search trace line before a header: " << line);
+            continue;
+        }
+
+        std::istringstream ss{line};
+        auto time   = 0.0f;
+        auto config = Config{};
+        auto field  = std::string{};
+
+        if(!(ss >> time) || ss.get() != '\t')
+        {
+            MIOPEN_LOG_W("Ill-formed search trace line: " << line);
+            continue;
+        }
+
+        while(std::getline(ss, field, '\t'))
+            config.fields.push_back(field);
+
+        traces.back().configs.push_back(std::move(config));
+        traces.back().times.push_back(time);
+    }
+
+    return traces;
+}
+
+std::string GetSearchCheckpointPath(const Handle& handle)
+{
+#if MIOPEN_DISABLE_USERDB
+    (void)handle;
+    return "";
+#else
+    const auto& udb = GetUserDbPath();
+    if(udb.empty())
+        return "";
+    return udb + "/" + handle.GetDbBasename() + "." + GetUserDbSuffix() + ".ckpt.txt";
+#endif
+}
+
+SearchEvaluation EvaluateSearchStrategy(const SearchTrace& trace, const SearchOptions& options)
+{
+    auto evaluation = SearchEvaluation{};
+    auto times      = std::map<std::vector<std::string>, float>{};
+
+    if(trace.configs.empty())
+        return evaluation;
+
+    for(auto i = std::size_t{0}; i < trace.configs.size(); ++i)
+        times.emplace(trace.configs[i].fields, trace.times[i]);
+
+    evaluation.optimum = *std::min_element(trace.times.begin(), trace.times.end());
+
+    const auto prepare = [&](const SearchTrace::Config& config) {
+        return times.at(config.fields);
+    };
+
+    const auto start = [&](const SearchTrace::Config&, float time) {
+        ++evaluation.trials;
+        return [time]() { return time; };
+    };
+
+    // Replay is cheap, so there is no need to pipeline it.
+    if(!RunSearchStrategy(options,
+                          trace.configs,
+                          static_cast<int>(trace.configs.size()),
+                          trace.configs.front(),
+                          0,
+                          0,
+                          prepare,
+                          start,
+                          evaluation.best_config,
+                          evaluation.best_time))
+        MIOPEN_THROW("Replay of the search trace of " + trace.solver + " failed");
+
+    // Strategies which re-measure configs may average the time, the recorded one is reported.
+    evaluation.best_time = times.at(evaluation.best_config.fields);
+    return evaluation;
+}
+
+} // namespace solver
+} // namespace miopen
@@ -27,6 +27,9 @@
 #include <miopen/version.h>
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/statistics.hpp>
+
+#include <cstring>
 
 extern "C" const char* miopenGetErrorString(miopenStatus_t error)
 {
@@ -110,3 +113,36 @@ extern "C" miopenStatus_t miopenEnableProfiling(miopenHandle_t handle, bool enab
 {
     return miopen::try_([&] { miopen::deref(handle).EnableProfiling(enable); });
 }
+
+extern "C" miopenStatus_t miopenGetStatistics(miopenHandle_t handle, char* buffer, size_t* size)
+{
+    return miopen::try_([&] {
+        miopen::deref(handle);
+        const auto snapshot = miopen::Statistics::Snapshot();
+        const auto required = snapshot.size() + 1;
+        auto& buffer_size   = miopen::deref(size);
+
+        if(buffer == nullptr)
+        {
+            buffer_size = required;
+            return;
+        }
+
+        if(buffer_size < required)
+        {
+            buffer_size = required;
+            MIOPEN_THROW(miopenStatusBadParm, "Buffer is too small for the statistics");
+        }
+
+        std::memcpy(buffer, snapshot.c_str(), required);
+        buffer_size = required;
+    });
+}
+
+extern "C" miopenStatus_t miopenResetStatistics(miopenHandle_t handle)
+{
+    return miopen::try_([&] {
+        miopen::deref(handle);
+        miopen::Statistics::Reset();
+    });
+}
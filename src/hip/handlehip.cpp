@@ -333,7 +333,7 @@ Invoker Handle::PrepareInvoker(const InvokerFactory& factory,
                                                         kernels.size());
         built.push_back(kernel);
     }
-    return factory(built);
+    return MakeTracedInvoker(factory(built), kernels.empty() ? "" : kernels.front().kernel_name);
 }
 
 void Handle::ClearKernels(const std::string& algorithm, const std::string& network_config) const
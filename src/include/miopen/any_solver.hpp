@@ -33,6 +33,7 @@
 
 #include <cassert>
 #include <memory>
+#include <string>
 #include <typeinfo>
 
 namespace miopen {
@@ -46,9 +47,14 @@ struct AnySolver
     template <class U>
     AnySolver(U src) : ptr_value(new AnySolver_tmpl<U>(std::forward<U>(src))){};
     bool IsApplicable(const ConvolutionContext& ctx) const
+    {
+        return IsApplicable(ctx, GetSolverMemoKey(ctx));
+    };
+    /// Callers querying many solvers for the same context may compute the memo key once.
+    bool IsApplicable(const ConvolutionContext& ctx, const std::string& memo_key) const
     {
         assert(ptr_value != nullptr);
-        return ptr_value->IsApplicable(ctx);
+        return ptr_value->IsApplicable(ctx, memo_key);
     };
     const std::type_info& Type() const
     {
@@ -59,9 +65,16 @@ struct AnySolver
     ConvSolution FindSolution(const ConvolutionContext& ctx,
                               Db& db,
                               const miopen::AnyInvokeParams& invoke_ctx) const
+    {
+        return FindSolution(ctx, db, invoke_ctx, GetSolverMemoKey(ctx));
+    };
+    ConvSolution FindSolution(const ConvolutionContext& ctx,
+                              Db& db,
+                              const miopen::AnyInvokeParams& invoke_ctx,
+                              const std::string& memo_key) const
     {
         assert(ptr_value != nullptr);
-        return ptr_value->FindSolution(ctx, db, invoke_ctx);
+        return ptr_value->FindSolution(ctx, db, invoke_ctx, memo_key);
     };
     std::string GetSolverDbId() const
     {
@@ -70,9 +83,13 @@ struct AnySolver
     }
 
     size_t GetWorkspaceSize(const ConvolutionContext& ctx) const
+    {
+        return GetWorkspaceSize(ctx, GetSolverMemoKey(ctx));
+    }
+    size_t GetWorkspaceSize(const ConvolutionContext& ctx, const std::string& memo_key) const
     {
         assert(ptr_value != nullptr);
-        return ptr_value->GetWorkspaceSize(ctx);
+        return ptr_value->GetWorkspaceSize(ctx, memo_key);
     }
 
     // virtual base class
@@ -81,13 +98,16 @@ struct AnySolver
         using ptr = std::shared_ptr<const AnySolver_base>;
 
         virtual ~AnySolver_base(){};
-        virtual bool IsApplicable(const ConvolutionContext& ctx) const = 0;
-        virtual const std::type_info& Type() const                     = 0;
-        virtual std::string GetSolverDbId() const                      = 0;
+        virtual bool IsApplicable(const ConvolutionContext& ctx,
+                                  const std::string& memo_key) const = 0;
+        virtual const std::type_info& Type() const                   = 0;
+        virtual std::string GetSolverDbId() const                    = 0;
         virtual ConvSolution FindSolution(const ConvolutionContext& ctx,
                                           Db& db,
-                                          const miopen::AnyInvokeParams& invoke_ctx) const = 0;
-        virtual size_t GetWorkspaceSize(const ConvolutionContext& ctx) const               = 0;
+                                          const miopen::AnyInvokeParams& invoke_ctx,
+                                          const std::string& memo_key) const = 0;
+        virtual size_t GetWorkspaceSize(const ConvolutionContext& ctx,
+                                        const std::string& memo_key) const   = 0;
     };
 
     // templated derived class
@@ -95,19 +115,22 @@ struct AnySolver
     struct AnySolver_tmpl : AnySolver_base
     {
         AnySolver_tmpl(T obj) : value(std::move(obj)){};
-        bool IsApplicable(const ConvolutionContext& ctx) const override
+        bool IsApplicable(const ConvolutionContext& ctx,
+                          const std::string& memo_key) const override
         {
-            return value.IsApplicable(ctx);
+            return IsApplicableTraced(value, ctx, memo_key);
         }
         ConvSolution FindSolution(const ConvolutionContext& ctx,
                                   Db& db,
-                                  const miopen::AnyInvokeParams& invoke_ctx) const override
+                                  const miopen::AnyInvokeParams& invoke_ctx,
+                                  const std::string& memo_key) const override
         {
-            return miopen::solver::FindSolution(value, ctx, db, invoke_ctx);
+            return miopen::solver::FindSolution(value, ctx, db, invoke_ctx, memo_key);
         };
-        size_t GetWorkspaceSize(const ConvolutionContext& ctx) const override
+        size_t GetWorkspaceSize(const ConvolutionContext& ctx,
+                                const std::string& memo_key) const override
         {
-            return value.GetWorkspaceSize(ctx);
+            return GetWorkspaceSizeMemoized(value, ctx, memo_key);
         }
         const std::type_info& Type() const override { return typeid(T); };
         std::string GetSolverDbId() const override { return ComputeSolverDbId(value); }
@@ -0,0 +1,107 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_BINARY_DB_HPP_
+#define GUARD_MIOPEN_BINARY_DB_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+/// Precompiled form of a read-only text db (e.g. system find-db), which is used in place, without
+/// parsing, from a mapped file or from data embedded into the library.
+///
+/// Layout (host byte order, checked on open):
+///   header  - see BinaryDbHeader;
+///   buckets - bucket_count + 1 uint32 indices of the first record of each hash bucket;
+///   records - record_count BinaryDbRecord entries, grouped by bucket;
+///   lines   - the original "key=contents" lines, one per record.
+///
+/// This file does not depend on the rest of the library, so it is also built into the
+/// dbconvert tool which produces binary dbs at build time.
+class BinaryDbView
+{
+    public:
+    struct Match
+    {
+        const char* contents_begin;
+        const char* contents_end;
+        int n_line; // Line of the record in the source text db.
+    };
+
+    /// Returns false if the data is not a binary db of the supported version.
+    bool Open(const char* data, std::size_t size);
+
+    bool IsOpen() const { return data != nullptr; }
+    std::size_t GetSize() const { return record_count; }
+
+    /// Size of the text db the binary one has been generated from.
+    std::uint64_t GetSourceSize() const { return source_size; }
+    /// Modification time of the text db, in seconds since the epoch, or 0 if unknown.
+    std::int64_t GetSourceTime() const { return source_time; }
+    /// Whether the binary db has been generated from the text db with these contents. Checks the
+    /// size and the hash of the contents.
+    bool IsSource(const char* text, std::size_t text_size) const;
+
+    bool Find(const std::string& key, Match& match) const;
+
+    private:
+    const char* data           = nullptr;
+    std::size_t size           = 0;
+    std::uint64_t source_size  = 0;
+    std::int64_t source_time   = 0;
+    std::uint64_t source_hash  = 0;
+    std::uint64_t record_count = 0;
+    std::uint64_t bucket_mask  = 0;
+    std::uint64_t buckets      = 0;
+    std::uint64_t records      = 0;
+    std::uint64_t lines        = 0;
+};
+
+struct BinaryDbStats
+{
+    std::size_t records = 0;
+    std::vector<int> duplicate_lines;  // Records with keys seen before. The first record is used.
+    std::vector<int> ill_formed_lines; // Non-empty lines without a key.
+};
+
+/// Converts a text db to the binary form. Follows the ReadonlyRamDb rules of parsing. text_time
+/// is the modification time of the text db in seconds since the epoch, or 0 if unknown.
+BinaryDbStats WriteBinaryDb(const char* text,
+                            std::size_t text_size,
+                            std::int64_t text_time,
+                            std::ostream& target);
+
+/// Name of the binary db generated from the text db with the given name: .txt extension is
+/// replaced by .bin.
+std::string GetBinaryDbPath(const std::string& text_db_path);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_BINARY_DB_HPP_
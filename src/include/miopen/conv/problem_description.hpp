@@ -34,6 +34,11 @@
 
 #include <boost/any.hpp>
 
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
 namespace miopen {
 
 std::string
@@ -121,6 +126,66 @@ constexpr TElement GetW5(int spatial_dims, const std::vector<TElement>& data)
 
 namespace conv {
 
+/// Layouts of tensors which are known to the solvers. Other layouts are told apart by strides.
+enum class LayoutId : std::uint8_t
+{
+    Other,
+    NCHW,
+    NHWC,
+    CHWN,
+    NCDHW,
+    NDHWC,
+};
+
+LayoutId GetLayoutId(const std::string& layout);
+
+/// Fixed-size packed form of a ProblemDescription: the lengths and strides of the tensors,
+/// the convolution parameters, data types, layouts and direction. It has no padding bytes,
+/// so keys are compared and hashed as raw memory. Unused dimensions are zero.
+struct ProblemKey
+{
+    static constexpr std::size_t MaxTensorDims  = 5;
+    static constexpr std::size_t MaxSpatialDims = 3;
+
+    using TensorDims  = std::array<std::uint64_t, MaxTensorDims>;
+    using SpatialDims = std::array<std::int32_t, MaxSpatialDims>;
+
+    TensorDims in_lengths;
+    TensorDims in_strides;
+    TensorDims weights_lengths;
+    TensorDims weights_strides;
+    TensorDims out_lengths;
+    TensorDims out_strides;
+    SpatialDims pads;
+    SpatialDims conv_strides;
+    SpatialDims dilations;
+    SpatialDims trans_output_pads;
+    std::int32_t group_count;
+    std::int32_t bias;
+    std::uint8_t spatial_dims;
+    std::uint8_t in_type;
+    std::uint8_t weights_type;
+    std::uint8_t out_type;
+    LayoutId in_layout;
+    LayoutId weights_layout;
+    LayoutId out_layout;
+    std::uint8_t direction;
+    std::uint8_t conv_mode;
+    std::uint8_t padding_mode;
+    std::array<std::uint8_t, 6> reserved;
+
+    /// 64-bit hash with good avalanche, suitable for hash tables keyed by problems.
+    std::uint64_t Hash() const;
+
+    bool operator==(const ProblemKey& other) const;
+    bool operator!=(const ProblemKey& other) const { return !(*this == other); }
+};
+
+static_assert(sizeof(ProblemKey) == 6 * sizeof(ProblemKey::TensorDims) +
+                                        4 * sizeof(ProblemKey::SpatialDims) +
+                                        2 * sizeof(std::int32_t) + 16,
+              "ProblemKey shall have no padding bytes");
+
 struct ProblemDescription
 #if MIOPEN_ENABLE_SQLITE
     : SQLiteSerializable<ProblemDescription>
@@ -142,7 +207,9 @@ struct ProblemDescription
           weights_layout(ComputeWeightsLayout()),
           out_layout(ComputeOutLayout()),
           direction(direction_),
-          bias(bias_)
+          bias(bias_),
+          key(MakeKey()),
+          key_hash(key.Hash())
     {
     }
 
@@ -306,14 +373,18 @@ struct ProblemDescription
                GetOutDataType() == miopenBFloat16;
     }
 
+    /// Packed form of the problem and its hash, which are computed on construction.
+    const ProblemKey& GetKey() const { return key; }
+    std::uint64_t GetKeyHash() const { return key_hash; }
+
     void BuildConfKey(std::string& conf_key) const;
 
-    NetworkConfig BuildConfKey() const
-    {
-        std::string ret;
-        BuildConfKey(ret);
-        return NetworkConfig{ret};
-    }
+    NetworkConfig BuildConfKey() const { return GetNetworkConfig(); }
+
+    /// The network config and the db key (see Serialize()) are built once per problem and shared
+    /// by copies of the description.
+    const NetworkConfig& GetNetworkConfig() const;
+    const std::string& GetDbKey() const;
 
     void Serialize(std::ostream& stream) const;
 
@@ -367,6 +438,22 @@ struct ProblemDescription
     std::string out_layout;
     Direction direction = Direction::Forward;
     int bias            = 0;
+    ProblemKey key{};
+    std::uint64_t key_hash = key.Hash();
+
+    struct Cache
+    {
+        std::once_flag network_config_flag;
+        NetworkConfig network_config;
+        std::once_flag db_key_flag;
+        std::string db_key;
+    };
+
+    std::shared_ptr<Cache> cache = std::make_shared<Cache>();
+
+    ProblemKey MakeKey() const;
+    std::string BuildConfKeyImpl() const;
+    std::string SerializeImpl() const;
 };
 
 } // namespace conv
@@ -457,15 +457,18 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
                              const TensorDescriptor& xDesc,
                              const TensorDescriptor& dwDesc) const;
 
-    std::size_t GetFwdSolutionCountFallback(const TensorDescriptor& wDesc,
+    std::size_t GetFwdSolutionCountFallback(Handle& handle,
+                                            const TensorDescriptor& wDesc,
                                             const TensorDescriptor& xDesc,
                                             const TensorDescriptor& yDesc) const;
 
-    std::size_t GetBwdSolutionCountFallback(const TensorDescriptor& dyDesc,
+    std::size_t GetBwdSolutionCountFallback(Handle& handle,
+                                            const TensorDescriptor& dyDesc,
                                             const TensorDescriptor& wDesc,
                                             const TensorDescriptor& dxDesc) const;
 
-    std::size_t GetWrwSolutionCountFallback(const TensorDescriptor& dyDesc,
+    std::size_t GetWrwSolutionCountFallback(Handle& handle,
+                                            const TensorDescriptor& dyDesc,
                                             const TensorDescriptor& xDesc,
                                             const TensorDescriptor& dwDesc) const;
 
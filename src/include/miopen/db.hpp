@@ -27,14 +27,19 @@
 #define GUARD_MIOPEN_DB_HPP_
 
 #include <miopen/db_record.hpp>
+#include <miopen/db_record_cache.hpp>
 #include <miopen/rank.hpp>
 
 #include <boost/core/explicit_operator_bool.hpp>
 #include <boost/none.hpp>
 #include <boost/optional/optional.hpp>
 
+#include <algorithm>
 #include <chrono>
+#include <iterator>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace boost {
 namespace filesystem {
@@ -46,6 +51,8 @@ namespace miopen {
 
 struct RecordPositions;
 class LockFile;
+class DbIndex;
+struct DbFileStamp;
 
 /// No instance of this class should be used from several threads at the same time.
 class PlainTextDb
@@ -68,6 +75,35 @@ class PlainTextDb
         return FindRecord(key);
     }
 
+    /// Searches db for all the provided keys and returns the results in the same order.
+    template <class T>
+    inline std::vector<boost::optional<DbRecord>> FindRecords(const std::vector<T>& problem_configs)
+    {
+        auto records = std::vector<boost::optional<DbRecord>>{};
+        records.reserve(problem_configs.size());
+        for(const auto& problem_config : problem_configs)
+            records.push_back(FindRecord(problem_config));
+        return records;
+    }
+
+    /// Searches db for records of the problems closest to the one with provided key which have
+    /// values under the ID, see DbIndex::FindSimilar. Returns at most LIMIT records not farther
+    /// than MAX_DISTANCE, closest first.
+    std::vector<SimilarDbRecord> FindSimilarRecords(const std::string& key,
+                                                    const std::string& id,
+                                                    std::size_t limit,
+                                                    float max_distance);
+
+    template <class T>
+    inline std::vector<SimilarDbRecord> FindSimilarRecords(const T& problem_config,
+                                                           const std::string& id,
+                                                           std::size_t limit,
+                                                           float max_distance)
+    {
+        const auto key = DbRecord::Serialize(problem_config);
+        return FindSimilarRecords(key, id, limit, max_distance);
+    }
+
     /// Stores provided record in database. If record with same key is already in database it is
     /// replaced by provided record.
     ///
@@ -100,6 +136,12 @@ class PlainTextDb
 
     bool Remove(const std::string& key, const std::string& id);
 
+    /// Rewrites the file leaving only actual records in it. Has effect only if the file has
+    /// been written in journaled mode (MIOPEN_DEBUG_PLAIN_TEXT_DB_JOURNAL).
+    ///
+    /// Returns true if compaction was successful or not needed, false otherwise.
+    bool Compact();
+
     template <class T>
     inline bool RemoveRecord(const T& problem_config)
     {
@@ -147,10 +189,17 @@ class PlainTextDb
     const bool warn_if_unreadable;
 
     boost::optional<DbRecord> FindRecordUnsafe(const std::string& key, RecordPositions* pos);
+    boost::optional<DbRecord>
+    FindRecordIndexed(const DbIndex& index, const std::string& key, RecordPositions* pos) const;
     bool FlushUnsafe(const DbRecord& record, const RecordPositions* pos);
+    bool AppendUnsafe(const DbRecord& record, const RecordPositions& pos);
+    bool CompactUnsafe();
     bool StoreRecordUnsafe(const DbRecord& record);
     bool UpdateRecordUnsafe(DbRecord& record);
     bool RemoveRecordUnsafe(const std::string& key);
+    void UpdateCached(const std::string& key,
+                      const DbFileStamp& before,
+                      const boost::optional<DbRecord>& record) const;
 
     template <class T>
     inline boost::optional<DbRecord> FindRecordUnsafe(const T& problem_config)
@@ -222,6 +271,73 @@ class MultiFileDb
 #endif
     }
 
+    template <bool merge = merge_records, std::enable_if_t<merge>* = nullptr, class T>
+    auto FindRecords(const std::vector<T>& problem_configs)
+    {
+        auto installed = _installed.FindRecords(problem_configs);
+
+#if !MIOPEN_DISABLE_USERDB
+        auto users = _user.FindRecords(problem_configs);
+
+        for(std::size_t i = 0; i < users.size(); ++i)
+        {
+            if(users[i] && installed[i])
+                users[i]->Merge(installed[i].value());
+            else if(!users[i])
+                users[i] = std::move(installed[i]);
+        }
+
+        return users;
+#else
+        return installed;
+#endif
+    }
+
+    template <bool merge = merge_records, std::enable_if_t<!merge>* = nullptr, class T>
+    auto FindRecords(const std::vector<T>& problem_configs)
+    {
+        auto installed = _installed.FindRecords(problem_configs);
+
+#if !MIOPEN_DISABLE_USERDB
+        auto users = _user.FindRecords(problem_configs);
+
+        for(std::size_t i = 0; i < users.size(); ++i)
+        {
+            if(!users[i])
+                users[i] = std::move(installed[i]);
+        }
+
+        return users;
+#else
+        return installed;
+#endif
+    }
+
+    /// Closest records of both dbs. User db records go first among equally close ones.
+    template <class T>
+    std::vector<SimilarDbRecord> FindSimilarRecords(const T& problem_config,
+                                                    const std::string& id,
+                                                    std::size_t limit,
+                                                    float max_distance)
+    {
+        auto records = _installed.FindSimilarRecords(problem_config, id, limit, max_distance);
+
+#if !MIOPEN_DISABLE_USERDB
+        auto users = _user.FindSimilarRecords(problem_config, id, limit, max_distance);
+        users.insert(users.end(),
+                     std::make_move_iterator(records.begin()),
+                     std::make_move_iterator(records.end()));
+        std::stable_sort(users.begin(), users.end(), [](const auto& l, const auto& r) {
+            return l.distance < r.distance;
+        });
+        if(users.size() > limit)
+            users.erase(users.begin() + limit, users.end());
+        records = std::move(users);
+#endif
+
+        return records;
+    }
+
     template <typename... U>
     auto StoreRecord(const U&... args)
     {
@@ -338,6 +454,19 @@ class DbTimer
         return Measure("FindRecord", [&]() { return inner.FindRecord(args...); });
     }
 
+    template <typename... U>
+    auto FindRecords(const U&... args)
+    {
+        return Measure("FindRecords", [&]() { return inner.FindRecords(args...); });
+    }
+
+    template <typename... U>
+    auto FindSimilarRecords(const U&... args)
+        -> decltype(std::declval<TInnerDb&>().FindSimilarRecords(args...))
+    {
+        return Measure("FindSimilarRecords", [&]() { return inner.FindSimilarRecords(args...); });
+    }
+
     template <typename... U>
     auto StoreRecord(U&... record)
     {
@@ -378,15 +507,21 @@ class DbTimer
     TInnerDb inner;
 
     template <class TFunc>
-    static auto Measure(const std::string& funcName, TFunc&& func)
+    static auto Measure(const char* funcName, TFunc&& func)
     {
+        MIOPEN_TRACE_SPAN("db", funcName);
+
         if(!miopen::IsLogging(LoggingLevel::Info2))
             return func();
 
         const auto start = std::chrono::high_resolution_clock::now();
         auto ret         = func();
         const auto end   = std::chrono::high_resolution_clock::now();
-        MIOPEN_LOG_I2("Db::" << funcName << " time: " << (end - start).count() * .000001f << " ms");
+        MIOPEN_LOG_I2("Db::" << funcName << " time: " << (end - start).count() * .000001f
+                             << " ms, record cache hits: "
+                             << DbRecordCacheStats::Hits().load()
+                             << ", misses: "
+                             << DbRecordCacheStats::Misses().load());
         return ret;
     }
 };
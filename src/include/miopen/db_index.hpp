@@ -0,0 +1,177 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DB_INDEX_HPP_
+#define GUARD_MIOPEN_DB_INDEX_HPP_
+
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace interprocess {
+class mapped_region;
+} // namespace interprocess
+} // namespace boost
+
+namespace miopen {
+
+/// Identifies a particular state of a db file. Any rewrite (new inode), append (new size)
+/// or in-place modification (new mtime) of the file produces a different stamp.
+struct DbFileStamp
+{
+    bool exists           = false;
+    std::uint64_t inode   = 0;
+    std::uint64_t size    = 0;
+    std::int64_t mtime_ns = 0;
+
+    static DbFileStamp Get(const std::string& path);
+
+    bool operator==(const DbFileStamp& other) const
+    {
+        return exists == other.exists && inode == other.inode && size == other.size &&
+               mtime_ns == other.mtime_ns;
+    }
+    bool operator!=(const DbFileStamp& other) const { return !(*this == other); }
+};
+
+/// Read-only memory-mapped view of a PlainTextDb file with a sorted key -> line index.
+///
+/// Instances are immutable and shared process-wide by file name. An index is valid only for
+/// the file state it was built from (see DbFileStamp). Building one requires the caller to hold
+/// at least a shared lock of the db file; using an up-to-date one does not.
+class DbIndex
+{
+    public:
+    struct Match
+    {
+        const char* contents_begin;
+        const char* contents_end;
+        std::int64_t line_begin;
+        std::int64_t line_end; // Position of the next line.
+        int n_line;
+    };
+
+    DbIndex(const std::string& path, const DbFileStamp& stamp);
+    /// If the file has only been appended to since the previous index was built, parses the
+    /// appended lines only and merges them into a copy of the previous index.
+    DbIndex(const std::string& path, const DbFileStamp& stamp, const DbIndex& previous);
+    ~DbIndex();
+    DbIndex(const DbIndex&) = delete;
+    DbIndex& operator=(const DbIndex&) = delete;
+
+    /// Returns cached index of the file if it matches current state of the file, nullptr
+    /// otherwise.
+    static std::shared_ptr<const DbIndex> GetCurrent(const std::string& path);
+
+    /// Returns index of the current state of the file, (re)building and caching it if needed.
+    /// The cached index is extended if the file has been appended to. Shall be called under the
+    /// db file lock.
+    static std::shared_ptr<const DbIndex> Get(const std::string& path);
+
+    bool IsReadable() const { return stamp.exists; }
+    const DbFileStamp& GetStamp() const { return stamp; }
+    std::size_t GetSize() const { return entries.size(); }
+
+    /// Size of lines which do not contribute to the contents of the db: superseded by later
+    /// lines with the same key, tombstones and ill-formed lines.
+    std::uint64_t GetDeadBytes() const { return dead_bytes; }
+
+    /// Size of superseded lines and tombstones, i.e. the dead bytes but the ill-formed lines.
+    std::uint64_t GetSupersededBytes() const { return dead_bytes - ill_formed_bytes; }
+
+    /// Size of the part of the file parsed to build the index: the whole file or, if the index
+    /// has been extended from the previous one, the appended lines.
+    std::uint64_t GetParsedBytes() const { return parsed_bytes; }
+
+    /// Binary search of the key. If there are several lines with the key, the last one is
+    /// returned. Returns false if the key is not present or the record has been removed.
+    bool Find(const std::string& key, Match& match) const;
+
+    struct Similar
+    {
+        float distance;
+        std::string key;
+        Match match;
+    };
+
+    /// Actual records of problems of the same kind as the one with the given key (see
+    /// ParseSolverRankingProblem) which have values under the id, closest first. Returns at most
+    /// limit records not farther than max_distance (see SimilarDbRecord). The features of the
+    /// records are extracted on the first call.
+    std::vector<Similar> FindSimilar(const std::string& key,
+                                     const std::string& id,
+                                     std::size_t limit,
+                                     float max_distance) const;
+
+    /// Writes actual records, each one once, in the order of appearance in the file.
+    void WriteLive(std::ostream& stream) const;
+
+    private:
+    struct Entry
+    {
+        std::uint64_t line_begin;
+        std::uint64_t line_end;
+        std::uint32_t key_size;
+        int n_line;
+    };
+
+    /// Actual records of problems of the same kind and their features, one row per record.
+    struct Category
+    {
+        std::vector<float> features;
+        std::vector<std::size_t> entries;
+    };
+
+    DbFileStamp stamp;
+    std::unique_ptr<boost::interprocess::mapped_region> region;
+    const char* data = nullptr;
+    std::vector<Entry> entries;
+    std::uint64_t dead_bytes       = 0;
+    std::uint64_t ill_formed_bytes = 0;
+    std::uint64_t parsed_bytes     = 0;
+    int n_lines                    = 0;
+    mutable std::once_flag categories_once;
+    mutable std::map<std::string, Category> categories;
+
+    bool Map(const std::string& path);
+    bool IsAppendOf(const DbIndex& previous) const;
+    void Parse(const std::string& path, std::uint64_t begin, std::vector<Entry>& parsed);
+    void Build(const std::string& path);
+    void Extend(const std::string& path, const DbIndex& previous);
+    void BuildCategories() const;
+    bool IsSuperseded(std::vector<Entry>::const_iterator entry) const;
+    int Compare(const Entry& entry, const char* key, std::size_t key_size) const;
+    const char* ContentsEnd(const Entry& entry) const;
+    bool IsTombstone(const Entry& entry) const;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DB_INDEX_HPP_
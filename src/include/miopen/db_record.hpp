@@ -29,6 +29,7 @@
 #include <miopen/config.h>
 
 #include <miopen/logger.hpp>
+#include <miopen/rank.hpp>
 
 #include <cassert>
 #include <istream>
@@ -49,7 +50,9 @@ namespace miopen {
 /// values, hence the name.
 ///
 /// Neither of ";:=" within KEY, ID and VALUES is allowed.
-/// There should be none identical KEYs in the same db file.
+/// There should be none identical KEYs in the same db file. The exception is a file written in
+/// journaled mode: a later line supersedes earlier ones with the same KEY, and a line with empty
+/// contents ("KEY=") marks a removed record.
 /// There should be none identical IDs within the same record.
 ///
 /// Intended usage:
@@ -158,6 +161,19 @@ class DbRecord
     static // 'static' is for calling from ctor
         std::string
         Serialize(const T& data)
+    {
+        return SerializeImpl(rank<1>{}, data);
+    }
+
+    // Problems which cache their db key, e.g. conv::ProblemDescription, are not serialized again.
+    template <class T>
+    static auto SerializeImpl(rank<1>, const T& data) -> decltype(std::string{data.GetDbKey()})
+    {
+        return data.GetDbKey();
+    }
+
+    template <class T>
+    static std::string SerializeImpl(rank<0>, const T& data)
     {
         std::ostringstream ss;
         data.Serialize(ss);
@@ -165,6 +181,7 @@ class DbRecord
     }
 
     bool ParseContents(std::istream& contents);
+    bool ParseContents(const char* begin, const char* end);
     void WriteContents(std::ostream& stream) const;
     bool SetValues(const std::string& id, const std::string& values);
     bool GetValues(const std::string& id, std::string& values) const;
@@ -173,8 +190,7 @@ class DbRecord
 
     bool ParseContents(const std::string& contents)
     {
-        auto ss = std::istringstream(contents);
-        return ParseContents(ss);
+        return ParseContents(contents.data(), contents.data() + contents.size());
     }
 
     public:
@@ -244,6 +260,15 @@ class DbRecord
     friend class ReadonlyRamDb;
 };
 
+/// Record of a problem config which is close to the requested one. The distance is the sum of
+/// absolute differences of log2(1 + size) over the sizes of the problems, so e.g. twice the batch
+/// size adds about 1.
+struct SimilarDbRecord
+{
+    float distance;
+    DbRecord record;
+};
+
 } // namespace miopen
 
 #endif // GUARD_MIOPEN_DB_RECORD_HPP_
@@ -0,0 +1,254 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DB_RECORD_CACHE_HPP_
+#define GUARD_MIOPEN_DB_RECORD_CACHE_HPP_
+
+#include <miopen/db_record.hpp>
+#include <miopen/env.hpp>
+#include <miopen/statistics.hpp>
+
+#include <boost/optional.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace miopen {
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_DB_RECORD_CACHE_SIZE)
+
+/// Hit/miss counters shared by all the record caches.
+struct DbRecordCacheStats
+{
+    static StatCounter& Hits()
+    {
+        static auto& hits = Statistics::Counter("db_record_cache.hits");
+        return hits;
+    }
+
+    static StatCounter& Misses()
+    {
+        static auto& misses = Statistics::Counter("db_record_cache.misses");
+        return misses;
+    }
+};
+
+/// Process-wide MT-safe LRU cache of db records (including absent ones), keyed by a db path
+/// and a record key.
+///
+/// Each db path has a generation which identifies the state of the db, e.g. DbFileStamp of the
+/// file or SQLite data_version. Once a different generation of a db is observed, all the cached
+/// records of the db become stale. Writers which know that only one record has been changed
+/// between two generations may update the cache in place instead.
+template <class TGeneration>
+class DbRecordCache
+{
+    public:
+    static DbRecordCache& Instance()
+    {
+        // Never destroyed: updated by the db writes performed at process exit.
+        static auto& instance = *new DbRecordCache{
+            miopen::Value(MIOPEN_DEBUG_DB_RECORD_CACHE_SIZE{}, DefaultCapacity())};
+        return instance;
+    }
+
+    bool IsEnabled() const { return capacity > 0; }
+
+    /// Returns true and sets the record if there is an actual cache entry for the key.
+    bool Find(const std::string& path,
+              const std::string& key,
+              const TGeneration& generation,
+              boost::optional<DbRecord>& record)
+    {
+        if(!IsEnabled())
+            return false;
+
+        const std::lock_guard<std::mutex> lock{mutex};
+        const auto epoch = SetGeneration(path, generation);
+        const auto it    = entries.find(EntryKey(path, key));
+
+        if(it == entries.end() || it->second->epoch != epoch)
+        {
+            ++DbRecordCacheStats::Misses();
+            return false;
+        }
+
+        ++DbRecordCacheStats::Hits();
+        lru.splice(lru.begin(), lru, it->second);
+        record = it->second->record;
+        return true;
+    }
+
+    /// Stores a record read from the db of given generation.
+    void Store(const std::string& path,
+               const std::string& key,
+               const TGeneration& generation,
+               const boost::optional<DbRecord>& record)
+    {
+        if(!IsEnabled())
+            return;
+
+        const std::lock_guard<std::mutex> lock{mutex};
+        StoreUnsafe(path, key, SetGeneration(path, generation), record);
+    }
+
+    /// Stores a record written to the db by a writer which had exclusive access to the db while
+    /// it has changed from the generation 'before' to 'after'.
+    void Update(const std::string& path,
+                const std::string& key,
+                const TGeneration& before,
+                const TGeneration& after,
+                const boost::optional<DbRecord>& record)
+    {
+        if(!IsEnabled())
+            return;
+
+        const std::lock_guard<std::mutex> lock{mutex};
+        StoreUnsafe(path, key, Advance(path, before, after), record);
+    }
+
+    /// Modifies an actual cache entry in place, if any. Same conditions as for Update() apply.
+    template <class TModifier>
+    void Modify(const std::string& path,
+                const std::string& key,
+                const TGeneration& before,
+                const TGeneration& after,
+                TModifier&& modifier)
+    {
+        if(!IsEnabled())
+            return;
+
+        const std::lock_guard<std::mutex> lock{mutex};
+        const auto epoch = Advance(path, before, after);
+        const auto it    = entries.find(EntryKey(path, key));
+
+        if(it != entries.end() && it->second->epoch == epoch)
+            modifier(it->second->record);
+    }
+
+    /// Makes all the cached records of the db stale.
+    void Invalidate(const std::string& path)
+    {
+        if(!IsEnabled())
+            return;
+
+        const std::lock_guard<std::mutex> lock{mutex};
+        ++paths[path].epoch;
+    }
+
+    private:
+    struct PathState
+    {
+        TGeneration generation{};
+        std::uint64_t epoch = 0;
+    };
+
+    struct Entry
+    {
+        std::string key;
+        std::uint64_t epoch;
+        boost::optional<DbRecord> record;
+    };
+
+    using Lru = std::list<Entry>;
+
+    std::size_t capacity;
+    std::mutex mutex;
+    std::map<std::string, PathState> paths;
+    Lru lru;
+    std::unordered_map<std::string, typename Lru::iterator> entries;
+
+    DbRecordCache(std::size_t capacity_) : capacity(capacity_) {}
+
+    static std::size_t DefaultCapacity() { return 1024; }
+
+    static std::string EntryKey(const std::string& path, const std::string& key)
+    {
+        auto ret = path;
+        ret.push_back('\0');
+        ret.append(key);
+        return ret;
+    }
+
+    std::uint64_t SetGeneration(const std::string& path, const TGeneration& generation)
+    {
+        auto& state = paths[path];
+
+        if(state.generation != generation)
+        {
+            state.generation = generation;
+            ++state.epoch;
+        }
+
+        return state.epoch;
+    }
+
+    std::uint64_t
+    Advance(const std::string& path, const TGeneration& before, const TGeneration& after)
+    {
+        auto& state = paths[path];
+
+        if(state.generation != before)
+            ++state.epoch;
+
+        state.generation = after;
+        return state.epoch;
+    }
+
+    void StoreUnsafe(const std::string& path,
+                     const std::string& key,
+                     std::uint64_t epoch,
+                     const boost::optional<DbRecord>& record)
+    {
+        auto entry_key = EntryKey(path, key);
+        const auto it  = entries.find(entry_key);
+
+        if(it != entries.end())
+        {
+            it->second->epoch  = epoch;
+            it->second->record = record;
+            lru.splice(lru.begin(), lru, it->second);
+            return;
+        }
+
+        lru.push_front({entry_key, epoch, record});
+        entries.emplace(std::move(entry_key), lru.begin());
+
+        while(entries.size() > capacity)
+        {
+            entries.erase(lru.back().key);
+            lru.pop_back();
+        }
+    }
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DB_RECORD_CACHE_HPP_
@@ -33,6 +33,7 @@
 #include <miopen/env.hpp>
 #include <miopen/perf_field.hpp>
 #include <miopen/readonlyramdb.hpp>
+#include <miopen/write_behind.hpp>
 
 #include <boost/optional.hpp>
 
@@ -94,6 +95,8 @@ class FindDbRecord_t
         if(!db.is_initialized())
             return;
 
+        MIOPEN_TRACE_SPAN("find_db", "Lookup");
+        WriteBehindQueue::Instance().Flush(path, DbRecord{problem}.GetKey());
         content = db->FindRecord(problem);
         in_sync = content.is_initialized();
     }
@@ -113,6 +116,8 @@ class FindDbRecord_t
         if(!db.is_initialized())
             return;
 
+        MIOPEN_TRACE_SPAN("find_db", "Lookup");
+        WriteBehindQueue::Instance().Flush(path, DbRecord{problem}.GetKey());
         content = db->FindRecord(problem);
         in_sync = content.is_initialized();
     }
@@ -121,8 +126,14 @@ class FindDbRecord_t
     {
         if(!db.is_initialized() || !content.is_initialized() || in_sync)
             return;
-        if(!db->StoreRecord(content.get()))
-            MIOPEN_LOG_E("Failed to store record to find-db at <" << path << ">");
+
+        WriteBehindQueue::Instance().Push(
+            path,
+            content->GetKey(),
+            [db = static_cast<const DbTimer<TDb>&>(*db), path = path, record = *content]() mutable {
+                if(!db.StoreRecord(record))
+                    MIOPEN_LOG_E("Failed to store record to find-db at <" << path << ">");
+            });
     }
 
     auto begin() const { return content->As<FindDbData>().begin(); }
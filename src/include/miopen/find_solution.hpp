@@ -27,20 +27,109 @@
 #ifndef MIOPEN_GUARD_MLOPEN_FIND_SOLUTION_HPP
 #define MIOPEN_GUARD_MLOPEN_FIND_SOLUTION_HPP
 
+#include <miopen/config.h>
 #include <miopen/env.hpp>
 #include <miopen/conv_solution.hpp>
+#include <miopen/db_record.hpp>
 #include <miopen/find_controls.hpp>
 #include <miopen/solver_id.hpp>
+#include <miopen/trace.hpp>
+#include <miopen/par_for.hpp>
+#include <miopen/solver_memo.hpp>
+#include <miopen/statistics.hpp>
+#include <miopen/write_behind.hpp>
+#if MIOPEN_MODE_NOGPU
+#include <miopen/null_device.hpp>
+#endif
+
+#include <boost/optional.hpp>
 
+#include <exception>
+#include <functional>
 #include <limits>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 namespace miopen {
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_FIND_PARALLEL_SOLVERS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_PERF_DB_NEAREST)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_PERF_DB_NEAREST_MAX_DISTANCE)
+
 struct AnyInvokeParams;
 
 namespace solver {
 
+bool& IsLastSearchLimited(); // See generic_search.hpp.
+
+template <class Context, class Db>
+auto FindSimilarRecords(rank<1>,
+                        Db& db,
+                        const Context& context,
+                        const std::string& id,
+                        std::size_t limit,
+                        float max_distance)
+    -> decltype(db.FindSimilarRecords(context, id, limit, max_distance))
+{
+    return db.FindSimilarRecords(context, id, limit, max_distance);
+}
+
+template <class Context, class Db>
+std::vector<SimilarDbRecord>
+FindSimilarRecords(rank<0>, Db&, const Context&, const std::string&, std::size_t, float)
+{
+    return {};
+}
+
+/// Looks for configs tuned for the closest problems of the same kind, e.g. ones which differ
+/// only in batch or image size, and takes the closest one which is valid for this problem.
+/// Enabled by MIOPEN_DEBUG_PERF_DB_NEAREST.
+template <class Solver, class Context, class Db, class PerformanceConfig>
+bool LoadSimilarConfig(const Solver& s, const Context& context, Db& db, PerformanceConfig& config)
+{
+    static auto& hits     = Statistics::Counter("perf_db.nearest.hits");
+    static auto& misses   = Statistics::Counter("perf_db.nearest.misses");
+    static auto& rejected = Statistics::Counter("perf_db.nearest.rejected");
+
+    if(!IsEnabled(MIOPEN_DEBUG_PERF_DB_NEAREST{}))
+        return false;
+
+    // Validation of a candidate is cheap, but the farther the problem is the less likely its
+    // config is to be good for this one, so only a few closest ones are tried.
+    constexpr auto max_candidates = std::size_t{8};
+    const auto max_distance =
+        static_cast<float>(Value(MIOPEN_DEBUG_PERF_DB_NEAREST_MAX_DISTANCE{}, 8));
+    const auto candidates =
+        FindSimilarRecords(rank<1>{}, db, context, SolverDbId(s), max_candidates, max_distance);
+
+    for(const auto& candidate : candidates)
+    {
+        if(!candidate.record.GetValues(SolverDbId(s), config))
+            continue;
+
+        if(!s.IsValidPerformanceConfig(context, config))
+        {
+            ++rejected;
+            MIOPEN_LOG_I2("Perf Db: config of a similar problem is not valid: "
+                          << SolverDbId(s) << ": " << candidate.record.GetKey() << ": " << config);
+            continue;
+        }
+
+        ++hits;
+        MIOPEN_LOG_I("Perf Db: using config of a similar problem: "
+                     << SolverDbId(s) << ": " << candidate.record.GetKey() << ", distance "
+                     << candidate.distance);
+        return true;
+    }
+
+    ++misses;
+    MIOPEN_LOG_I2("Perf Db: no valid config of a similar problem among " << candidates.size()
+                                                                         << " for: "
+                                                                         << SolverDbId(s));
+    return false;
+}
+
 template <class Solver, class Context, class Db>
 auto FindSolutionImpl(
     rank<1>, Solver s, const Context& context, Db& db, const AnyInvokeParams& invoke_ctx)
@@ -53,8 +142,16 @@ auto FindSolutionImpl(
         return s.GetSolution(context, s.GetPerformanceConfig(context));
     }
     MIOPEN_LOG_I(SolverDbId(s));
+
+    // Searched configs are stored in background, see below.
+    auto& write_behind   = WriteBehindQueue::Instance();
+    const auto db_target = context.GetUserPerfDbPath();
+    const auto db_key    = DbRecord{context}.GetKey();
+    write_behind.Flush(db_target, db_key);
+
     if(enforce.IsDbClean(context))
     {
+        SolverMemo::Instance().Invalidate();
         if(db.Remove(context, SolverDbId(s)))
             MIOPEN_LOG_W("Perf Db: record removed: " << SolverDbId(s) << ", enforce: " << enforce);
     }
@@ -82,6 +179,9 @@ auto FindSolutionImpl(
             else
             {
                 MIOPEN_LOG_I("Perf Db: record not found for: " << SolverDbId(s));
+                if(!context.do_search && !enforce.IsSearch(context) &&
+                   LoadSimilarConfig(s, context, db, config))
+                    return s.GetSolution(context, config);
             }
         }
 
@@ -90,8 +190,29 @@ auto FindSolutionImpl(
             MIOPEN_LOG_I("Starting search: " << SolverDbId(s) << ", enforce: " << enforce);
             try
             {
-                auto c = s.Search(context, invoke_ctx);
-                db.Update(context, SolverDbId(s), c);
+                trace::Span search_span{"solver", "Search"};
+                if(search_span.IsActive())
+                    search_span.SetDetail(SolverDbId(s));
+                IsLastSearchLimited() = false;
+                auto c                = s.Search(context, invoke_ctx);
+                search_span.End();
+                // Solutions memoized before the search may use other configs. Solutions which
+                // are memoized before the write below completes are dropped once more after it.
+                SolverMemo::Instance().Invalidate();
+                if(IsLastSearchLimited())
+                {
+                    MIOPEN_LOG_W("Perf Db: result of the limited search is not stored: "
+                                 << SolverDbId(s));
+                    return s.GetSolution(context, c);
+                }
+                write_behind.Push(
+                    db_target,
+                    db_key,
+                    [db = static_cast<const Db&>(db), context, id = SolverDbId(s), c]() mutable {
+                        db.Update(context, id, c);
+                        SolverMemo::Instance().Invalidate();
+                    },
+                    WriteBehindQueue::Coalesce::Append);
                 return s.GetSolution(context, c);
             }
             catch(const miopen::Exception& ex)
@@ -101,6 +222,9 @@ auto FindSolutionImpl(
         }
     }
 
+    static auto& defaults = Statistics::Counter("perf_db.default_config");
+    ++defaults;
+    MIOPEN_LOG_I2("Perf Db: using default config: " << SolverDbId(s));
     return s.GetSolution(context, s.GetPerformanceConfig(context));
 }
 
@@ -118,18 +242,106 @@ auto FindSolutionImpl(rank<0>, Solver s, const Context& context, Db&, const AnyI
 /// solution-specific parameters and returns the Solution object.
 /// Could take long if an exhaustive search is requested/performed.
 /// May read/write perfDb.
+///
+/// Solutions which do not involve search are memoized, see SolverMemo. The memo_key is
+/// GetSolverMemoKey(context), which callers querying many solvers compute once.
 template <class Solver, class Context, class Db>
-ConvSolution
-FindSolution(Solver s, const Context& context, Db& db, const AnyInvokeParams& invoke_ctx)
+ConvSolution FindSolution(Solver s,
+                          const Context& context,
+                          Db& db,
+                          const AnyInvokeParams& invoke_ctx,
+                          const std::string& memo_key)
 {
     static_assert(std::is_empty<Solver>{} && std::is_trivially_constructible<Solver>{},
                   "Solver must be stateless");
-    // TODO: This assumes all solutions are ConvSolution
-    auto solution      = FindSolutionImpl(rank<1>{}, s, context, db, invoke_ctx);
-    solution.solver_id = SolverDbId(s);
-    return solution;
+    MIOPEN_TRACE_SPAN_DETAIL("solver", "GetSolution", SolverDbId(s));
+    const FindEnforce enforce;
+    const auto may_search_or_clean =
+        context.do_search || enforce.IsSearch(context) || enforce.IsDbClean(context);
+
+    return SolverMemo::Instance().GetSolution(
+        may_search_or_clean ? std::string{} : memo_key, SolverDbId(s), [&]() {
+            // TODO: This assumes all solutions are ConvSolution
+            auto solution      = FindSolutionImpl(rank<1>{}, s, context, db, invoke_ctx);
+            solution.solver_id = SolverDbId(s);
+            return solution;
+        });
+}
+
+template <class Solver, class Context, class Db>
+ConvSolution
+FindSolution(Solver s, const Context& context, Db& db, const AnyInvokeParams& invoke_ctx)
+{
+    return FindSolution(s, context, db, invoke_ctx, GetSolverMemoKey(context));
 }
 
+template <class Solver, class Context>
+bool IsApplicableTraced(const Solver& s, const Context& context, const std::string& memo_key)
+{
+#if MIOPEN_MODE_NOGPU
+    // Kernels are not executed by the null device.
+    if(NullDevice::Get().IsHostExecution() && !s.IsHost())
+        return false;
+#endif
+    return SolverMemo::Instance().IsApplicable(memo_key, SolverDbId(s), [&]() {
+        MIOPEN_TRACE_SPAN_DETAIL("solver", "IsApplicable", SolverDbId(s));
+        return s.IsApplicable(context);
+    });
+}
+
+template <class Solver, class Context>
+std::size_t
+GetWorkspaceSizeMemoized(const Solver& s, const Context& context, const std::string& memo_key)
+{
+    return SolverMemo::Instance().GetWorkspaceSize(
+        memo_key, SolverDbId(s), [&]() { return s.GetWorkspaceSize(context); });
+}
+
+/// Db shared by the threads which evaluate solvers concurrently. Reads are thread-safe in the
+/// underlying dbs, writes (including the background ones) are serialized.
+template <class Db>
+class SerializedDbWrites
+{
+    public:
+    SerializedDbWrites(const Db& db_) : db(db_) {}
+
+    template <class... Ts>
+    bool Load(Ts&&... xs)
+    {
+        return db.Load(std::forward<Ts>(xs)...);
+    }
+
+    template <class... Ts>
+    auto FindSimilarRecords(Ts&&... xs)
+        -> decltype(std::declval<Db&>().FindSimilarRecords(std::forward<Ts>(xs)...))
+    {
+        return db.FindSimilarRecords(std::forward<Ts>(xs)...);
+    }
+
+    template <class... Ts>
+    auto Update(Ts&&... xs)
+    {
+        const std::lock_guard<std::mutex> lock(Mutex());
+        return db.Update(std::forward<Ts>(xs)...);
+    }
+
+    template <class... Ts>
+    bool Remove(Ts&&... xs)
+    {
+        const std::lock_guard<std::mutex> lock(Mutex());
+        return db.Remove(std::forward<Ts>(xs)...);
+    }
+
+    private:
+    Db db;
+
+    static std::mutex& Mutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+};
+
 template <class... Solvers>
 struct SolverContainer
 {
@@ -141,9 +353,14 @@ struct SolverContainer
                           const AnyInvokeParams& invoke_ctx,
                           std::size_t limit = std::numeric_limits<std::size_t>::max()) const
     {
+        if(IsEnabled(MIOPEN_DEBUG_FIND_PARALLEL_SOLVERS{}))
+            return SearchForAllSolutionsParallel<Context, Db, Solution>(
+                search_params, std::forward<Db>(db), invoke_ctx, limit);
+
         std::vector<Solution> ss;
         std::size_t count    = 0;
         const auto find_only = GetEnvFindOnlySolver();
+        const auto memo_key  = GetSolverMemoKey(search_params);
         miopen::each_args(
             [&](auto solver) {
                 if(count >= limit)
@@ -151,13 +368,14 @@ struct SolverContainer
                 if(find_only.IsValid() && find_only != Id{SolverDbId(solver)})
                 { // Do nothing (and keep silence for the sake of Tuna), just skip.
                 }
-                else if(!solver.IsApplicable(search_params))
+                else if(!IsApplicableTraced(solver, search_params, memo_key))
                     MIOPEN_LOG_I2(SolverDbId(solver) << ": Not applicable");
                 else if(search_params.use_dynamic_solutions_only && !solver.IsDynamic())
                     MIOPEN_LOG_I2(SolverDbId(solver) << ": Skipped (non-dynamic)");
                 else
                 {
-                    const Solution s = FindSolution(solver, search_params, db, invoke_ctx);
+                    const Solution s =
+                        FindSolution(solver, search_params, db, invoke_ctx, memo_key);
                     if(s.Succeeded())
                     {
                         ++count;
@@ -179,23 +397,134 @@ struct SolverContainer
             Solvers{}...);
         return ss;
     }
+
+    /// Same as SearchForAllSolutions, but IsApplicable() and FindSolution() of the solvers are
+    /// called concurrently on the thread pool, in waves of as many solvers as there are threads.
+    /// Results are the same as of the serial search: solutions are returned in the order of the
+    /// solvers, errors are reported in this order too, and no solutions past the limit are
+    /// returned. FindSolution() is still called serially if it may search, so that the
+    /// benchmarks of solvers do not disturb each other.
+    template <class Context, class Db, class Solution = miopen::solver::ConvSolution>
+    std::vector<Solution>
+    SearchForAllSolutionsParallel(const Context& search_params,
+                                  Db&& db,
+                                  const AnyInvokeParams& invoke_ctx,
+                                  std::size_t limit = std::numeric_limits<std::size_t>::max()) const
+    {
+        struct Candidate
+        {
+            std::string id;
+            std::function<bool()> is_applicable;
+            std::function<Solution()> find_solution;
+        };
+
+        auto shared_db       = SerializedDbWrites<std::decay_t<Db>>{db};
+        auto candidates      = std::vector<Candidate>{};
+        const auto find_only = GetEnvFindOnlySolver();
+        const auto memo_key  = GetSolverMemoKey(search_params);
+
+        miopen::each_args(
+            [&](auto solver) {
+                if(find_only.IsValid() && find_only != Id{SolverDbId(solver)})
+                    return; // Do nothing (and keep silence for the sake of Tuna), just skip.
+
+                candidates.push_back({SolverDbId(solver),
+                                      [&search_params, &memo_key, solver]() {
+                                          if(!IsApplicableTraced(
+                                                 solver, search_params, memo_key))
+                                          {
+                                              MIOPEN_LOG_I2(SolverDbId(solver)
+                                                            << ": Not applicable");
+                                              return false;
+                                          }
+                                          if(search_params.use_dynamic_solutions_only &&
+                                             !solver.IsDynamic())
+                                          {
+                                              MIOPEN_LOG_I2(SolverDbId(solver)
+                                                            << ": Skipped (non-dynamic)");
+                                              return false;
+                                          }
+                                          return true;
+                                      },
+                                      [&, solver]() -> Solution {
+                                          return FindSolution(solver,
+                                                              search_params,
+                                                              shared_db,
+                                                              invoke_ctx,
+                                                              memo_key);
+                                      }});
+            },
+            Solvers{}...);
+
+        const FindEnforce enforce;
+        const auto may_search = search_params.do_search || enforce.IsSearch(search_params);
+        const auto wave_size  = ThreadPool::Instance().GetWorkerCount() + 1;
+        std::vector<Solution> ss;
+
+        for(auto wave = std::size_t{0}; wave < candidates.size() && ss.size() < limit;
+            wave += wave_size)
+        {
+            const auto n          = std::min(wave_size, candidates.size() - wave);
+            auto is_applicable    = std::vector<char>(n, 0);
+            auto solutions        = std::vector<boost::optional<Solution>>(n);
+            auto errors           = std::vector<std::exception_ptr>(n);
+
+            par_for(n, max_threads{n}, [&](std::size_t i) {
+                try
+                {
+                    const auto& candidate = candidates[wave + i];
+                    is_applicable[i]      = candidate.is_applicable() ? 1 : 0;
+                    if(is_applicable[i] != 0 && !may_search)
+                        solutions[i] = candidate.find_solution();
+                }
+                catch(...)
+                {
+                    errors[i] = std::current_exception();
+                }
+            });
+
+            for(auto i = std::size_t{0}; i < n && ss.size() < limit; ++i)
+            {
+                if(errors[i])
+                    std::rethrow_exception(errors[i]);
+                if(is_applicable[i] == 0)
+                    continue;
+
+                const auto& candidate = candidates[wave + i];
+                const Solution s = solutions[i] ? *solutions[i] : candidate.find_solution();
+                if(s.Succeeded())
+                {
+                    ss.push_back(s);
+                    MIOPEN_LOG_I2(candidate.id << ": Success.");
+                }
+                else
+                {
+                    MIOPEN_LOG_I(candidate.id << ": [Warning] Applicable Solver not succeeded.");
+                }
+            }
+        }
+
+        return ss;
+    }
+
     template <class Context>
     std::vector<std::pair<std::string, size_t>> GetWorkspaceSize(const Context& search_params) const
     {
         std::vector<std::pair<std::string, size_t>> res;
         const auto find_only = GetEnvFindOnlySolver();
+        const auto memo_key  = GetSolverMemoKey(search_params);
         miopen::each_args(
             [&](auto solver) {
                 if(find_only.IsValid() && find_only != Id{SolverDbId(solver)})
                 { // Do nothing (and keep silence for the sake of Tuna), just skip.
                 }
-                else if(!solver.IsApplicable(search_params))
+                else if(!IsApplicableTraced(solver, search_params, memo_key))
                     MIOPEN_LOG_I2(SolverDbId(solver) << ": Not applicable");
                 else if(search_params.use_dynamic_solutions_only && !solver.IsDynamic())
                     MIOPEN_LOG_I2(SolverDbId(solver) << ": Skipped (non-dynamic)");
                 else
                 {
-                    auto sz = solver.GetWorkspaceSize(search_params);
+                    auto sz = GetWorkspaceSizeMemoized(solver, search_params, memo_key);
                     res.push_back(std::make_pair(SolverDbId(solver), sz));
                 }
             },
@@ -28,17 +28,37 @@
 #define GUARD_MIOPEN_GENERIC_SEARCH_HPP_
 
 #include <miopen/config.h>
+#include <miopen/db.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/invoke_params.hpp>
 #include <miopen/env.hpp>
+#include <miopen/rank.hpp>
+#include <miopen/search_pipeline.hpp>
 
+#include <boost/optional.hpp>
+#include <boost/range/iterator_range.hpp>
+
+#include <algorithm>
 #include <vector>
 #include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <iosfwd>
+#include <random>
+#include <sstream>
 #include <limits>
 #include <iterator>
+#include <map>
 #include <chrono>
 #include <cassert>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
 
 #include <miopen/conv/context.hpp>
 #include <miopen/conv_solution.hpp>
@@ -50,6 +70,14 @@ namespace miopen {
 namespace solver {
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_COMPILE_ONLY)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_COMPILE_PARALLEL_LEVEL)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_GENERIC_SEARCH_LOOKAHEAD)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_GENERIC_SEARCH_STRATEGY)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_GENERIC_SEARCH_MAX_TRIALS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_GENERIC_SEARCH_MAX_TIME)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_GENERIC_SEARCH_TRACE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_GENERIC_SEARCH_CHECKPOINT)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_GENERIC_SEARCH_CHECKPOINT_INTERVAL)
 
 /// This STL-like container together with corresponding iterator provide access
 /// to a set of all available performance configs for the given problem config.
@@ -305,6 +333,1004 @@ using RunAndMeasure_t =
                                                           std::declval<ConvSolution>(),
                                                           std::declval<float&>()));
 
+inline std::size_t GetSearchCompileWorkers()
+{
+    static const auto workers = std::min<std::size_t>(
+        std::thread::hardware_concurrency(), Value(MIOPEN_COMPILE_PARALLEL_LEVEL{}, 20));
+    return workers;
+}
+
+/// By default, compilation may run ahead of measurement by two configs per worker.
+inline std::size_t GetSearchLookahead()
+{
+    static const auto lookahead =
+        Value(MIOPEN_DEBUG_GENERIC_SEARCH_LOOKAHEAD{}, 2 * GetSearchCompileWorkers());
+    return lookahead;
+}
+
+enum class SearchStrategy
+{
+    Exhaustive,        // Every config is measured.
+    Random,            // Configs are measured in random order until the budget is exhausted.
+    Halving,           // Successive halving: all configs are measured once, then the better half
+                       // is re-measured with twice as many runs, and so on.
+    CoordinateDescent, // Fields of the config are tuned one at a time, starting from the default.
+};
+
+std::ostream& operator<<(std::ostream& os, SearchStrategy strategy);
+
+/// Returns false if the name is unknown.
+bool ParseSearchStrategy(const std::string& name, SearchStrategy& strategy);
+
+struct SearchOptions
+{
+    SearchStrategy strategy = SearchStrategy::Exhaustive;
+    std::size_t max_trials  = 0; // Max number of configs to be measured, 0 for unlimited.
+    std::size_t max_time    = 0; // Max time of the search in seconds, 0 for unlimited.
+    unsigned seed           = 0; // Seed of random sampling.
+};
+
+/// Limits the number of measured configs and the duration of a search.
+class SearchBudget
+{
+    public:
+    SearchBudget(const SearchOptions& options)
+        : max_trials(options.max_trials),
+          max_time(options.max_time),
+          start(std::chrono::steady_clock::now())
+    {
+    }
+
+    /// Shall be called before measuring one more config. Once it returns true, the search which
+    /// stops is cut short.
+    bool IsExhausted()
+    {
+        const auto is_exhausted = (max_trials != 0 && trials >= max_trials) || IsOutOfTime();
+        is_cut                  = is_cut || is_exhausted;
+        return is_exhausted;
+    }
+
+    /// Only checks the time limit, which also applies to re-measurements of configs.
+    bool IsOutOfTime() const
+    {
+        return max_time != 0 && std::chrono::steady_clock::now() - start >=
+                                    std::chrono::seconds(max_time);
+    }
+
+    void Spend() { ++trials; }
+    std::size_t GetTrials() const { return trials; }
+
+    /// The search has been stopped by the budget or only measures a sample of the configs, so it
+    /// may miss the best config.
+    bool IsCut() const { return is_cut; }
+    void Cut() { is_cut = true; }
+
+    private:
+    std::size_t trials = 0;
+    std::size_t max_trials;
+    std::size_t max_time;
+    std::chrono::steady_clock::time_point start;
+    bool is_cut = false;
+};
+
+/// Measurement loop of the GenericSearch, which is independent of the device.
+///
+/// prepare(config) shall return everything which is required to run the config, e.g. compiled
+/// programs. It is called for upcoming configs in parallel with the measurement (see
+/// PipelinedForEach), and thus shall be thread-safe.
+/// start(config, prepared) is called in the order of configs on the calling thread. It shall
+/// return a functor which runs the config and returns the elapsed time.
+/// Any exception thrown by these marks the config as failed.
+///
+/// Only configs better than the incoming best_time may replace best_config. Each measured
+/// config is charged to the budget, and the search stops once the budget is exhausted.
+/// on_consumed(n_current, is_failed), if set, is called after each config has been measured.
+///
+/// Returns false if no config has passed.
+template <class PerformanceConfig, class Range, class Prepare, class Start>
+bool SearchBestConfig(const Range& all_configs,
+                      const int n_runs_total,
+                      const std::size_t n_workers,
+                      const std::size_t lookahead,
+                      SearchBudget& budget,
+                      Prepare prepare,
+                      Start start,
+                      PerformanceConfig& best_config,
+                      float& best_time,
+                      const std::function<void(std::size_t, bool)>& on_consumed = {})
+{
+    using Prepared = decltype(prepare(std::declval<const PerformanceConfig&>()));
+
+    bool is_passed  = false; // left false only if all iterations failed.
+    size_t n_failed = 0;
+    size_t n_best   = 0;
+    HeartBeat<PerformanceConfig> heartbeat;
+    heartbeat.Start();
+
+    const auto try_prepare = [&prepare](const PerformanceConfig& config) {
+        try
+        {
+            return boost::make_optional(prepare(config));
+        }
+        catch(...)
+        {
+            return boost::optional<Prepared>{};
+        }
+    };
+
+    const auto consume = [&](std::size_t n_current,
+                             const PerformanceConfig& current_config,
+                             boost::optional<Prepared>& prepared) {
+        if(budget.IsExhausted())
+        {
+            MIOPEN_LOG_W("Search budget is exhausted after " << budget.GetTrials() << " configs");
+            return false;
+        }
+
+        budget.Spend();
+        float elapsed_time = 0.0f;
+        int ret            = 0;
+        MIOPEN_LOG_I2('#' << n_current << '/' << n_failed << '/' << n_runs_total << ' '
+                          << current_config);
+
+        if(!prepared)
+            ret = 1;
+
+        try
+        {
+            if(ret == 0)
+            {
+                auto run     = start(current_config, *prepared);
+                elapsed_time = run();
+
+                // Smooth the jitter of measurements:
+                // If the 1st probe is NOT too bad (measured time <= 1.05 * best known time),
+                // then re-run it 4 times more and compute average time,
+                // and decide using average of all 5 attempts vs. the best.
+                if(elapsed_time / best_time < 1.05f)
+                {
+                    MIOPEN_LOG_I2("Finding average for: " << elapsed_time << " / " << best_time
+                                                          << " = "
+                                                          << (elapsed_time / best_time));
+
+                    for(int i = 0; i < 4; ++i)
+                        elapsed_time += run();
+
+                    is_passed = true;
+                    elapsed_time /= 5;
+                    if(elapsed_time < best_time)
+                    {
+                        MIOPEN_LOG_I('#' << n_current << '/' << n_failed << '/' << n_runs_total
+                                         << ' '
+                                         << elapsed_time
+                                         << " < "
+                                         << best_time
+                                         << ' '
+                                         << current_config);
+                        best_config = current_config;
+                        best_time   = elapsed_time;
+                        n_best      = n_current;
+                    }
+                    else
+                    {
+                        MIOPEN_LOG_I2("Average is not better: " << elapsed_time << " >= "
+                                                                << best_time);
+                    }
+                }
+            }
+        }
+        catch(...)
+        {
+            ret = 1;
+        }
+
+        MIOPEN_LOG_T("##"
+                     << "(n_current, n_failed, n_runs_total):  "
+                     << n_current
+                     << '/'
+                     << n_failed
+                     << '/'
+                     << n_runs_total
+                     << " elapsed_time: "
+                     << elapsed_time
+                     << ", best_time: "
+                     << best_time
+                     << ", "
+                     << current_config);
+
+        if(ret != 0)
+        {
+            MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
+                             << " Failed rc="
+                             << ret);
+            ++n_failed;
+        }
+        heartbeat.Monitor(ret != 0,
+                          elapsed_time,
+                          n_current,
+                          best_time,
+                          n_failed,
+                          n_runs_total,
+                          current_config);
+        if(on_consumed)
+            on_consumed(n_current, ret != 0);
+        return true;
+    };
+
+    PipelinedForEach(
+        all_configs.begin(), all_configs.end(), n_workers, lookahead, try_prepare, consume);
+
+    MIOPEN_LOG_W("Done: " << n_runs_total << '/' << n_failed << '/' << n_runs_total << ", best #"
+                          << n_best
+                          << ' '
+                          << best_time
+                          << ' '
+                          << best_config);
+    return is_passed;
+}
+
+template <class PerformanceConfig, class Range, class Prepare, class Start>
+bool SearchBestConfig(const Range& all_configs,
+                      const int n_runs_total,
+                      const std::size_t n_workers,
+                      const std::size_t lookahead,
+                      Prepare prepare,
+                      Start start,
+                      PerformanceConfig& best_config,
+                      float& best_time)
+{
+    auto budget = SearchBudget{SearchOptions{}};
+    best_time   = std::numeric_limits<float>::max();
+    return SearchBestConfig(all_configs,
+                            n_runs_total,
+                            n_workers,
+                            lookahead,
+                            budget,
+                            prepare,
+                            start,
+                            best_config,
+                            best_time);
+}
+
+namespace detail {
+
+struct CollectField
+{
+    std::vector<std::string>& fields;
+
+    template <class T>
+    void operator()(const T& value, const char* /*name*/) const
+    {
+        std::ostringstream ss;
+        ss << value;
+        fields.push_back(ss.str());
+    }
+};
+
+template <class PerformanceConfig>
+auto CollectFields(rank<1>, const PerformanceConfig& config, std::vector<std::string>& fields)
+    -> decltype(PerformanceConfig::Visit(config, CollectField{fields}))
+{
+    PerformanceConfig::Visit(config, CollectField{fields});
+}
+
+// A config which does not provide Visit() is considered as a single field.
+template <class PerformanceConfig>
+void CollectFields(rank<0>, const PerformanceConfig& config, std::vector<std::string>& fields)
+{
+    std::ostringstream ss;
+    ss << config;
+    fields.push_back(ss.str());
+}
+
+} // namespace detail
+
+/// Values of the fields of the config (see Serializable::Visit), which are the dimensions of the
+/// search space for the coordinate descent.
+template <class PerformanceConfig>
+std::vector<std::string> GetConfigFields(const PerformanceConfig& config)
+{
+    auto fields = std::vector<std::string>{};
+    detail::CollectFields(rank<1>{}, config, fields);
+    return fields;
+}
+
+/// Successive halving. All the configs are measured once, then the better half of them is
+/// measured again with twice as many runs, and so on while more than one config is left.
+/// Only the configs and their times are kept between the rounds, and the survivors of a round
+/// are prepared again, so the memory held does not grow with the number of configs. Programs
+/// are usually found in the cache of the handle then.
+/// Once the time budget is over, the best of the candidates by their last measurements wins.
+template <class PerformanceConfig, class Prepare, class Start>
+bool SearchHalving(const std::vector<PerformanceConfig>& configs,
+                   const std::size_t n_workers,
+                   const std::size_t lookahead,
+                   SearchBudget& budget,
+                   Prepare prepare,
+                   Start start,
+                   PerformanceConfig& best_config,
+                   float& best_time)
+{
+    using Prepared = decltype(prepare(std::declval<const PerformanceConfig&>()));
+
+    struct Candidate
+    {
+        PerformanceConfig config;
+        float time;
+    };
+
+    const auto by_time = [](const Candidate& l, const Candidate& r) { return l.time < r.time; };
+    const auto n_kept  = (configs.size() + 1) / 2;
+    auto candidates    = std::vector<Candidate>{};
+
+    const auto try_prepare = [&prepare](const PerformanceConfig& config) {
+        try
+        {
+            return boost::make_optional(prepare(config));
+        }
+        catch(...)
+        {
+            return boost::optional<Prepared>{};
+        }
+    };
+
+    PipelinedForEach(configs.begin(),
+                     configs.end(),
+                     n_workers,
+                     lookahead,
+                     try_prepare,
+                     [&](std::size_t n_current,
+                         const PerformanceConfig& config,
+                         boost::optional<Prepared>& prepared) {
+                         if(budget.IsExhausted())
+                             return false;
+                         budget.Spend();
+
+                         try
+                         {
+                             if(!prepared)
+                                 MIOPEN_THROW("Preparation failed");
+                             auto run = start(config, *prepared);
+                             candidates.push_back({config, run()});
+                         }
+                         catch(...)
+                         {
+                             MIOPEN_LOG_E('#' << n_current << " (" << configs.size() << ") "
+                                              << config
+                                              << " Failed");
+                         }
+
+                         // Only the configs which may survive the first round are kept.
+                         if(candidates.size() >= 2 * n_kept)
+                         {
+                             std::nth_element(candidates.begin(),
+                                              candidates.begin() + n_kept,
+                                              candidates.end(),
+                                              by_time);
+                             candidates.resize(n_kept);
+                         }
+                         return true;
+                     });
+
+    for(auto n_runs = 2; candidates.size() > 1 && !budget.IsOutOfTime(); n_runs *= 2)
+    {
+        std::sort(candidates.begin(), candidates.end(), by_time);
+        candidates.resize((candidates.size() + 1) / 2);
+        MIOPEN_LOG_I("Halving: measuring " << candidates.size() << " configs " << n_runs
+                                           << " times each, best "
+                                           << candidates.front().time
+                                           << ' '
+                                           << candidates.front().config);
+
+        auto survivors = std::vector<PerformanceConfig>{};
+        survivors.reserve(candidates.size());
+        for(const auto& candidate : candidates)
+            survivors.push_back(candidate.config);
+        auto is_failed = std::vector<bool>(candidates.size(), false);
+
+        PipelinedForEach(survivors.begin(),
+                         survivors.end(),
+                         n_workers,
+                         lookahead,
+                         try_prepare,
+                         [&](std::size_t n_current,
+                             const PerformanceConfig& config,
+                             boost::optional<Prepared>& prepared) {
+                             if(budget.IsOutOfTime())
+                                 return false;
+
+                             try
+                             {
+                                 if(!prepared)
+                                     MIOPEN_THROW("Preparation failed");
+                                 auto run   = start(config, *prepared);
+                                 auto total = 0.0f;
+                                 for(auto i = 0; i < n_runs; ++i)
+                                     total += run();
+                                 candidates[n_current].time = total / n_runs;
+                             }
+                             catch(...)
+                             {
+                                 MIOPEN_LOG_E(config << " Failed");
+                                 is_failed[n_current] = true;
+                             }
+                             return true;
+                         });
+
+        auto n_left = std::size_t{0};
+        for(auto i = std::size_t{0}; i < candidates.size(); ++i)
+            if(!is_failed[i])
+                candidates[n_left++] = candidates[i];
+        candidates.resize(n_left);
+    }
+
+    if(candidates.empty())
+        return false;
+
+    if(candidates.size() > 1)
+    {
+        MIOPEN_LOG_W("Search time budget is exhausted with " << candidates.size()
+                                                             << " configs left");
+        budget.Cut();
+    }
+
+    const auto best = std::min_element(candidates.begin(), candidates.end(), by_time);
+    best_config     = best->config;
+    best_time       = best->time;
+    MIOPEN_LOG_W("Done: " << budget.GetTrials() << '/' << configs.size() << ", best " << best_time
+                          << ' '
+                          << best_config);
+    return true;
+}
+
+/// Coordinate descent. Starting from the initial config, configs which differ from the current
+/// best one in a single field are measured, one field at a time, and the best of them becomes
+/// the current one. Stops once a pass over all the fields gives no improvement.
+template <class PerformanceConfig, class Prepare, class Start>
+bool SearchCoordinateDescent(const std::vector<PerformanceConfig>& configs,
+                             const PerformanceConfig& initial,
+                             const std::size_t n_workers,
+                             const std::size_t lookahead,
+                             SearchBudget& budget,
+                             Prepare prepare,
+                             Start start,
+                             PerformanceConfig& best_config,
+                             float& best_time)
+{
+    if(configs.empty())
+        return false;
+
+    auto fields = std::vector<std::vector<std::string>>{};
+    fields.reserve(configs.size());
+    for(const auto& config : configs)
+        fields.push_back(GetConfigFields(config));
+
+    const auto initial_it = std::find(configs.begin(), configs.end(), initial);
+    auto current =
+        static_cast<std::size_t>(initial_it != configs.end() ? initial_it - configs.begin() : 0);
+    auto is_measured = std::vector<bool>(configs.size(), false);
+    auto is_passed   = false;
+    auto n_fields    = std::size_t{0};
+    for(const auto& config_fields : fields)
+        n_fields = std::max(n_fields, config_fields.size());
+
+    // The initial config may fail, then the first one which passes is used instead.
+    best_time = std::numeric_limits<float>::max();
+    for(auto i = std::size_t{0}; i < configs.size() && !is_passed && !budget.IsExhausted(); ++i)
+    {
+        const auto index   = (current + i) % configs.size();
+        is_measured[index] = true;
+        is_passed          = SearchBestConfig(std::vector<PerformanceConfig>{configs[index]},
+                                     1,
+                                     0,
+                                     0,
+                                     budget,
+                                     prepare,
+                                     start,
+                                     best_config,
+                                     best_time);
+        current = index;
+    }
+
+    for(auto is_improved = is_passed; is_improved;)
+    {
+        is_improved = false;
+
+        for(auto field = std::size_t{0}; field < n_fields && !budget.IsExhausted(); ++field)
+        {
+            auto neighbours = std::vector<PerformanceConfig>{};
+
+            for(auto i = std::size_t{0}; i < configs.size(); ++i)
+            {
+                if(is_measured[i] || fields[i].size() != fields[current].size())
+                    continue;
+
+                auto n_differences = 0;
+                for(auto f = std::size_t{0}; f < fields[i].size(); ++f)
+                    if(fields[i][f] != fields[current][f])
+                        n_differences += f == field ? 1 : 2;
+
+                if(n_differences == 1)
+                {
+                    is_measured[i] = true;
+                    neighbours.push_back(configs[i]);
+                }
+            }
+
+            if(neighbours.empty())
+                continue;
+
+            MIOPEN_LOG_I("Coordinate descent: " << neighbours.size() << " configs along field #"
+                                                << field
+                                                << " of "
+                                                << best_config);
+
+            const auto time_before = best_time;
+            SearchBestConfig(neighbours,
+                             static_cast<int>(neighbours.size()),
+                             n_workers,
+                             lookahead,
+                             budget,
+                             prepare,
+                             start,
+                             best_config,
+                             best_time);
+
+            if(best_time < time_before)
+            {
+                const auto it = std::find(configs.begin(), configs.end(), best_config);
+                current       = it - configs.begin();
+                is_improved   = true;
+            }
+        }
+    }
+
+    return is_passed;
+}
+
+namespace detail {
+
+template <class PerformanceConfig, class Range, class Prepare, class Start>
+bool RunSearchStrategy(const SearchOptions& options,
+                       SearchBudget& budget,
+                       const Range& all_configs,
+                       const int n_total,
+                       const PerformanceConfig& initial,
+                       const std::size_t n_workers,
+                       const std::size_t lookahead,
+                       Prepare prepare,
+                       Start start,
+                       PerformanceConfig& best_config,
+                       float& best_time)
+{
+    if(options.strategy == SearchStrategy::Exhaustive)
+        return SearchBestConfig(all_configs,
+                                n_total,
+                                n_workers,
+                                lookahead,
+                                budget,
+                                prepare,
+                                start,
+                                best_config,
+                                best_time);
+
+    auto configs = std::vector<PerformanceConfig>{};
+    configs.reserve(n_total);
+    std::copy(all_configs.begin(), all_configs.end(), std::back_inserter(configs));
+
+    switch(options.strategy)
+    {
+    case SearchStrategy::Random:
+    {
+        std::shuffle(configs.begin(), configs.end(), std::mt19937{options.seed});
+        if(options.max_trials != 0 && options.max_trials < configs.size())
+        {
+            configs.resize(options.max_trials);
+            budget.Cut();
+        }
+        return SearchBestConfig(configs,
+                                static_cast<int>(configs.size()),
+                                n_workers,
+                                lookahead,
+                                budget,
+                                prepare,
+                                start,
+                                best_config,
+                                best_time);
+    }
+    case SearchStrategy::Halving:
+        // With a trial budget, a random sample of configs takes part in the first round.
+        if(options.max_trials != 0 && options.max_trials < configs.size())
+        {
+            std::shuffle(configs.begin(), configs.end(), std::mt19937{options.seed});
+            configs.resize(options.max_trials);
+            budget.Cut();
+        }
+        return SearchHalving(
+            configs, n_workers, lookahead, budget, prepare, start, best_config, best_time);
+    case SearchStrategy::CoordinateDescent:
+        // A local search, which may miss the best config regardless of the budget.
+        budget.Cut();
+        return SearchCoordinateDescent(configs,
+                                       initial,
+                                       n_workers,
+                                       lookahead,
+                                       budget,
+                                       prepare,
+                                       start,
+                                       best_config,
+                                       best_time);
+    case SearchStrategy::Exhaustive: break;
+    }
+
+    return false;
+}
+
+} // namespace detail
+
+/// Whether the result of the last search on the calling thread may miss the best config, as the
+/// search has been cut short by its budget or is not an exhaustive one (see SearchBudget::IsCut).
+/// Such results are not stored to the perf-db as tuned ones. Searches run one at a time on the
+/// calling thread.
+bool& IsLastSearchLimited();
+
+/// Runs the search with the given strategy. all_configs shall be an input range of n_total
+/// configs. Strategies other than the exhaustive one keep a copy of the configs in memory.
+template <class PerformanceConfig, class Range, class Prepare, class Start>
+bool RunSearchStrategy(const SearchOptions& options,
+                       const Range& all_configs,
+                       const int n_total,
+                       const PerformanceConfig& initial,
+                       const std::size_t n_workers,
+                       const std::size_t lookahead,
+                       Prepare prepare,
+                       Start start,
+                       PerformanceConfig& best_config,
+                       float& best_time)
+{
+    auto budget = SearchBudget{options};
+    best_time   = std::numeric_limits<float>::max();
+
+    const auto is_passed = detail::RunSearchStrategy(options,
+                                                     budget,
+                                                     all_configs,
+                                                     n_total,
+                                                     initial,
+                                                     n_workers,
+                                                     lookahead,
+                                                     prepare,
+                                                     start,
+                                                     best_config,
+                                                     best_time);
+    IsLastSearchLimited() = budget.IsCut();
+    return is_passed;
+}
+
+/// Search options are taken from Solver::GetSearchOptions(context), if implemented, and may be
+/// overridden by environment variables.
+template <class Solver, class Context>
+auto GetSolverSearchOptions(rank<1>, const Solver& s, const Context& context)
+    -> decltype(s.GetSearchOptions(context))
+{
+    return s.GetSearchOptions(context);
+}
+
+template <class Solver, class Context>
+SearchOptions GetSolverSearchOptions(rank<0>, const Solver&, const Context&)
+{
+    return {};
+}
+
+template <class Solver, class Context>
+SearchOptions GetSearchOptions(const Solver& s, const Context& context)
+{
+    auto options = GetSolverSearchOptions(rank<1>{}, s, context);
+
+    const auto strategy = GetStringEnv(MIOPEN_DEBUG_GENERIC_SEARCH_STRATEGY{});
+    if(strategy != nullptr && !ParseSearchStrategy(strategy, options.strategy))
+        MIOPEN_LOG_W("Unknown search strategy: " << strategy);
+
+    options.max_trials = Value(MIOPEN_DEBUG_GENERIC_SEARCH_MAX_TRIALS{}, options.max_trials);
+    options.max_time   = Value(MIOPEN_DEBUG_GENERIC_SEARCH_MAX_TIME{}, options.max_time);
+    return options;
+}
+
+/// State of an exhaustive search, which allows to resume it after the process is interrupted.
+///
+/// Serialized as "<n_total>/<cursor>/<attempts>/<best_time>/<failed>/<best_config>", where
+/// failed is a comma-separated list of indices of failed configs, and best_config is empty if
+/// no config has passed yet.
+template <class PerformanceConfig>
+struct SearchCheckpoint
+{
+    std::size_t n_total  = 0; // Size of the search space, which shall match on resume.
+    std::size_t cursor   = 0; // Number of configs processed.
+    std::size_t attempts = 0; // Number of resumes from the cursor without further progress.
+    float best_time      = std::numeric_limits<float>::max();
+    std::vector<std::size_t> failed;
+    PerformanceConfig best_config;
+
+    bool IsPassed() const { return best_time < std::numeric_limits<float>::max(); }
+
+    void Serialize(std::ostream& stream) const
+    {
+        stream << n_total << '/' << cursor << '/' << attempts << '/';
+        if(IsPassed())
+            stream << std::setprecision(std::numeric_limits<float>::max_digits10) << best_time;
+        stream << '/';
+        for(auto i = std::size_t{0}; i < failed.size(); ++i)
+            stream << (i == 0 ? "" : ",") << failed[i];
+        stream << '/';
+        if(IsPassed())
+            best_config.Serialize(stream);
+    }
+
+    bool Deserialize(const std::string& str)
+    {
+        auto fields = std::vector<std::string>{};
+        auto begin  = std::size_t{0};
+
+        // The last field is not split, as it belongs to the config.
+        while(fields.size() < 5)
+        {
+            const auto end = str.find('/', begin);
+            if(end == std::string::npos)
+                return false;
+            fields.push_back(str.substr(begin, end - begin));
+            begin = end + 1;
+        }
+
+        auto checkpoint = SearchCheckpoint{};
+        try
+        {
+            checkpoint.n_total  = std::stoull(fields[0]);
+            checkpoint.cursor   = std::stoull(fields[1]);
+            checkpoint.attempts = std::stoull(fields[2]);
+            if(!fields[3].empty())
+                checkpoint.best_time = std::stof(fields[3]);
+
+            std::istringstream failed_stream{fields[4]};
+            std::string index;
+            while(std::getline(failed_stream, index, ','))
+                checkpoint.failed.push_back(std::stoull(index));
+        }
+        catch(const std::logic_error&)
+        {
+            return false;
+        }
+
+        if(checkpoint.IsPassed() && !checkpoint.best_config.Deserialize(str.substr(begin)))
+            return false;
+
+        *this = checkpoint;
+        return true;
+    }
+};
+
+/// Path of the file in the user db directory which keeps checkpoints of searches, or an empty
+/// string if the user db is disabled.
+std::string GetSearchCheckpointPath(const Handle& handle);
+
+/// Periodically saves the progress of an exhaustive search (see SearchCheckpoint) to the db,
+/// under the key of the problem and the id of the solver.
+///
+/// A config which crashes the process would stop every resumed search at the same cursor. So,
+/// once a search is resumed twice from the same cursor, it is suspect: progress is saved after
+/// each config, and if the search is interrupted at the cursor again, the config is considered
+/// as failed. A crash may come from compiling an upcoming config as well, so suspect searches
+/// do not compile ahead (see SearchWithCheckpoints).
+template <class PerformanceConfig, class Problem>
+class SearchCheckpointer
+{
+    public:
+    SearchCheckpointer(const std::string& path,
+                       const Problem& problem_,
+                       const std::string& id_,
+                       std::size_t n_total,
+                       std::chrono::steady_clock::duration interval_)
+        : db(path), problem(problem_), id(id_), interval(interval_)
+    {
+        checkpoint.n_total = n_total;
+    }
+
+    /// Loads the checkpoint of the search, if any, and sets the best config found before the
+    /// interruption. Returns the number of configs to be skipped.
+    std::size_t Resume(PerformanceConfig& best_config, float& best_time)
+    {
+        auto loaded = SearchCheckpoint<PerformanceConfig>{};
+        if(!db.Load(problem, id, loaded))
+            return 0;
+
+        if(loaded.n_total != checkpoint.n_total || loaded.cursor > loaded.n_total)
+        {
+            MIOPEN_LOG_W("Search checkpoint does not match the search space (" << loaded.n_total
+                                                                               << " configs), "
+                                                                                  "ignored");
+            return 0;
+        }
+
+        checkpoint = loaded;
+
+        if(checkpoint.attempts >= MaxAttempts && checkpoint.cursor < checkpoint.n_total)
+        {
+            MIOPEN_LOG_W("Config #" << checkpoint.cursor << " has interrupted the search "
+                                    << checkpoint.attempts
+                                    << " times, skipped");
+            checkpoint.failed.push_back(checkpoint.cursor);
+            ++checkpoint.cursor;
+            checkpoint.attempts = 0;
+        }
+
+        ++checkpoint.attempts;
+        Save();
+
+        if(checkpoint.IsPassed())
+        {
+            best_config = checkpoint.best_config;
+            best_time   = checkpoint.best_time;
+        }
+
+        MIOPEN_LOG_W("Resuming search from config #" << checkpoint.cursor << '/'
+                                                     << checkpoint.n_total
+                                                     << ", failed "
+                                                     << checkpoint.failed.size()
+                                                     << ", best "
+                                                     << best_time);
+        return checkpoint.cursor;
+    }
+
+    /// Shall be called in order for each config after the skipped ones.
+    void OnConsumed(bool is_failed, const PerformanceConfig& best_config, float best_time)
+    {
+        if(is_failed)
+            checkpoint.failed.push_back(checkpoint.cursor);
+        ++checkpoint.cursor;
+
+        if(checkpoint.attempts < MaxAttempts &&
+           std::chrono::steady_clock::now() - last_save < interval)
+            return;
+
+        checkpoint.attempts = 0;
+        if(best_time < std::numeric_limits<float>::max())
+        {
+            checkpoint.best_config = best_config;
+            checkpoint.best_time   = best_time;
+        }
+        Save();
+    }
+
+    bool IsPassed() const { return checkpoint.IsPassed(); }
+
+    /// The search has been interrupted at the cursor before, see the class description.
+    bool IsSuspect() const { return checkpoint.attempts >= MaxAttempts; }
+
+    /// Removes the checkpoint once the search is over.
+    void Finish() { db.Remove(problem, id); }
+
+    private:
+    static constexpr std::size_t MaxAttempts = 2;
+
+    PlainTextDb db;
+    const Problem& problem;
+    std::string id;
+    std::chrono::steady_clock::duration interval;
+    std::chrono::steady_clock::time_point last_save = std::chrono::steady_clock::now();
+    SearchCheckpoint<PerformanceConfig> checkpoint;
+
+    void Save()
+    {
+        if(!db.Update(problem, id, checkpoint))
+            MIOPEN_LOG_W("Unable to save search checkpoint");
+        last_save = std::chrono::steady_clock::now();
+    }
+};
+
+/// Exhaustive search, which resumes from the checkpoint, if any, and saves its progress.
+template <class PerformanceConfig, class Problem, class Range, class Prepare, class Start>
+bool SearchWithCheckpoints(SearchCheckpointer<PerformanceConfig, Problem>& checkpointer,
+                           const SearchOptions& options,
+                           const Range& all_configs,
+                           const int n_total,
+                           const std::size_t n_workers,
+                           const std::size_t lookahead,
+                           Prepare prepare,
+                           Start start,
+                           PerformanceConfig& best_config,
+                           float& best_time)
+{
+    auto budget = SearchBudget{options};
+    best_time   = std::numeric_limits<float>::max();
+
+    const auto n_skipped = checkpointer.Resume(best_config, best_time);
+    auto first           = all_configs.begin();
+    for(auto i = std::size_t{0}; i < n_skipped && first != all_configs.end(); ++i)
+        ++first;
+
+    // Only the config at the cursor is compiled while it is measured, so that an interruption
+    // of a suspect search is caused by it.
+    const auto is_suspect = checkpointer.IsSuspect();
+    if(is_suspect)
+        MIOPEN_LOG_W("Configs are not compiled ahead after interruptions at #" << n_skipped);
+
+    const auto is_passed =
+        SearchBestConfig(boost::make_iterator_range(first, all_configs.end()),
+                         n_total - static_cast<int>(n_skipped),
+                         n_workers,
+                         is_suspect ? 0 : lookahead,
+                         budget,
+                         prepare,
+                         start,
+                         best_config,
+                         best_time,
+                         [&](std::size_t, bool is_failed) {
+                             checkpointer.OnConsumed(is_failed, best_config, best_time);
+                         }) ||
+        checkpointer.IsPassed();
+
+    checkpointer.Finish();
+    IsLastSearchLimited() = budget.IsCut();
+    return is_passed;
+}
+
+/// Configs measured by a search and their times, which allow to evaluate search strategies
+/// without a device. Written to the file given by MIOPEN_DEBUG_GENERIC_SEARCH_TRACE.
+///
+/// File format: a "#<solver id>" line starts each trace, followed by "<time>\t<field>\t..."
+/// lines, one per measured config.
+struct SearchTrace
+{
+    /// Config restored from a trace, which only consists of its fields.
+    struct Config
+    {
+        std::vector<std::string> fields;
+
+        template <class Self, class F>
+        static void Visit(Self&& self, F f)
+        {
+            for(auto& field : self.fields)
+                f(field, "");
+        }
+
+        bool operator==(const Config& other) const { return fields == other.fields; }
+
+        friend std::ostream& operator<<(std::ostream& os, const Config& config)
+        {
+            for(auto i = std::size_t{0}; i < config.fields.size(); ++i)
+                os << (i == 0 ? "" : ",") << config.fields[i];
+            return os;
+        }
+    };
+
+    std::string solver;
+    std::vector<Config> configs;
+    std::vector<float> times;
+
+    template <class PerformanceConfig>
+    void Add(const PerformanceConfig& config, float time)
+    {
+        configs.push_back({GetConfigFields(config)});
+        times.push_back(time);
+    }
+
+    void Write(std::ostream& stream) const;
+    static std::vector<SearchTrace> Read(std::istream& stream);
+};
+
+struct SearchEvaluation
+{
+    std::size_t trials = 0; // Number of configs measured.
+    float best_time    = 0.0f;
+    float optimum      = 0.0f; // Time of the best config in the trace.
+    SearchTrace::Config best_config;
+
+    /// Relative distance of the answer from the exhaustive optimum.
+    float GetRegret() const { return optimum > 0.0f ? best_time / optimum - 1.0f : 0.0f; }
+};
+
+/// Replays the search over the recorded trace, using the recorded times as measurements.
+/// The first config of the trace is used as the initial one.
+SearchEvaluation EvaluateSearchStrategy(const SearchTrace& trace, const SearchOptions& options);
+
 template <class Solver, class Context>
 auto GenericSearch(const Solver s, const Context& context, const AnyInvokeParams& invoke_ctx_)
     -> decltype(s.GetPerformanceConfig(context))
@@ -338,158 +1364,192 @@ auto GenericSearch(const Solver s, const Context& context, const AnyInvokeParams
                                << (useSpare ? " (spare)" : "")
                                << "...");
 
-    bool is_passed  = false; // left false only if all iterations failed.
-    float best_time = std::numeric_limits<float>::max();
-    size_t n_failed = 0;
-    size_t n_best   = 0;
-    HeartBeat<PerformanceConfig> heartbeat;
-    heartbeat.Start();
+    // Programs of upcoming configs are compiled by worker threads while the current config is
+    // being measured. The program cache of the handle is only accessed under the lock, and
+    // nothing is compiled under it. A program is compiled by the first config which needs it,
+    // other configs wait for it before they are measured.
+    using ProgramKey    = std::pair<std::string, std::string>; // Kernel file, options.
+    using ProgramFuture = std::shared_future<Program>;
 
-// PrecompileKernels call saves to binary_cache, this needs to be escaped if KERN_CACHE is not on.
-#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
-    std::vector<KernelInfo> kernels;
-    for(const auto& current_config : all_configs)
+    struct Prepared
     {
-        ConvSolution current_solution = s.GetSolution(context, current_config, true);
-        for(auto&& kernel : current_solution.construction_params)
-        {
-            if(profile_h.HasProgram(kernel.kernel_file, kernel.comp_options))
-                continue;
-            kernels.push_back(kernel);
-        }
-    }
-    std::ignore = PrecompileKernels(profile_h, kernels);
-#endif
+        ConvSolution solution;
+        std::vector<std::pair<std::size_t, ProgramFuture>> programs; // Index of kernel, program.
+    };
 
-    if(!IsEnabled(MIOPEN_DEBUG_COMPILE_ONLY{}))
-    {
-        size_t n_current = 0;
-        for(const auto& current_config : all_configs)
-        {
-            float elapsed_time = 0.0f;
-            int ret            = 0;
-            MIOPEN_LOG_I2('#' << n_current << '/' << n_failed << '/' << n_runs_total << ' '
-                              << current_config);
+    std::mutex cache_mutex;
+    std::map<ProgramKey, ProgramFuture> in_flight;
 
-            ConvSolution current_solution;
-            Invoker invoker;
+    const auto prepare = [&](const PerformanceConfig& config) {
+        auto prepared = Prepared{s.GetSolution(context, config, true), {}};
+        const auto& kernels = prepared.solution.construction_params;
 
-            try
+        for(auto i = std::size_t{0}; i < kernels.size(); ++i)
+        {
+            const auto& kernel = kernels[i];
+            const auto key     = ProgramKey{kernel.kernel_file, kernel.comp_options};
+            auto promise       = std::promise<Program>{};
             {
-                current_solution = s.GetSolution(context, current_config, true);
-                if(default_solution.workspce_sz != current_solution.workspce_sz)
+                const std::lock_guard<std::mutex> lock(cache_mutex);
+                if(profile_h.HasProgram(kernel.kernel_file, kernel.comp_options))
+                    continue;
+
+                const auto claimed = in_flight.find(key);
+                if(claimed != in_flight.end())
                 {
-                    ret = -2;
-                    MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
-                                     << "Workspace size should not depend on PerformanceConfig: "
-                                     << default_solution.workspce_sz
-                                     << " != "
-                                     << current_solution.workspce_sz);
+                    prepared.programs.emplace_back(i, claimed->second);
+                    continue;
                 }
 
-                invoker = profile_h.PrepareInvoker(*current_solution.invoker_factory,
-                                                   current_solution.construction_params);
-                invoker(profile_h, invoke_ctx);
-                elapsed_time = profile_h.GetKernelTime();
+                const auto future = promise.get_future().share();
+                in_flight.emplace(key, future);
+                prepared.programs.emplace_back(i, future);
+            }
+
+            try
+            {
+                promise.set_value(
+                    profile_h.LoadProgram(kernel.kernel_file, kernel.comp_options, false, ""));
             }
             catch(...)
             {
-                ret = 1;
+                promise.set_exception(std::current_exception());
+                throw;
             }
+        }
 
-            MIOPEN_LOG_T("##"
-                         << "(n_current, n_failed, n_runs_total):  "
-                         << n_current
-                         << '/'
-                         << n_failed
-                         << '/'
-                         << n_runs_total
-                         << " elapsed_time: "
-                         << elapsed_time
-                         << ", best_time: "
-                         << best_time
-                         << ", "
-                         << current_config);
+        return prepared;
+    };
 
-            if(ret == 0)
-            {
-                // Smooth the jitter of measurements:
-                // If the 1st probe is NOT too bad (measured time <= 1.05 * best known time),
-                // then re-run it 4 times more and compute average time,
-                // and decide using average of all 5 attempts vs. the best.
-                if(elapsed_time / best_time < 1.05f)
-                {
-                    MIOPEN_LOG_I2("Finding average for: " << elapsed_time << " / " << best_time
-                                                          << " = "
-                                                          << (elapsed_time / best_time));
+    const auto start = [&](const PerformanceConfig& config, const Prepared& prepared) {
+        const auto& solution = prepared.solution;
 
-                    try
-                    {
-                        for(int i = 0; i < 4; ++i)
-                        {
-                            invoker(profile_h, invoke_ctx);
-                            elapsed_time += profile_h.GetKernelTime();
-                        }
-                    }
-                    catch(...)
-                    {
-                        ret = 1;
-                    }
+        if(default_solution.workspce_sz != solution.workspce_sz)
+        {
+            MIOPEN_LOG_E(config << ": Workspace size should not depend on PerformanceConfig: "
+                                << default_solution.workspce_sz
+                                << " != "
+                                << solution.workspce_sz);
+            MIOPEN_THROW("Workspace size should not depend on PerformanceConfig");
+        }
 
-                    if(ret == 0)
-                    {
-                        is_passed = true;
-                        elapsed_time /= 5;
-                        if(elapsed_time < best_time)
-                        {
-                            MIOPEN_LOG_I('#' << n_current << '/' << n_failed << '/' << n_runs_total
-                                             << ' '
-                                             << elapsed_time
-                                             << " < "
-                                             << best_time
-                                             << ' '
-                                             << current_config);
-                            best_config = current_config;
-                            best_time   = elapsed_time;
-                            n_best      = n_current;
-                        }
-                        else
-                        {
-                            MIOPEN_LOG_I2(
-                                "Average is not better: " << elapsed_time << " >= " << best_time);
-                        }
-                    }
-                }
-            }
+        // Programs being compiled by other workers are waited for outside of the lock.
+        for(const auto& program : prepared.programs)
+            program.second.wait();
 
-            if(ret != 0)
-            {
-                MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
-                                 << " Failed rc="
-                                 << ret);
-                ++n_failed;
-            }
-            heartbeat.Monitor(ret != 0,
-                              elapsed_time,
-                              n_current,
-                              best_time,
-                              n_failed,
-                              n_runs_total,
-                              current_config);
-            ++n_current;
+        const std::lock_guard<std::mutex> lock(cache_mutex);
+
+        for(const auto& program : prepared.programs)
+        {
+            const auto& kernel = solution.construction_params[program.first];
+            if(!profile_h.HasProgram(kernel.kernel_file, kernel.comp_options))
+                profile_h.AddProgram(
+                    program.second.get(), kernel.kernel_file, kernel.comp_options);
+            in_flight.erase(ProgramKey{kernel.kernel_file, kernel.comp_options});
         }
+
+        // All the programs are in the cache by now, so this does not compile.
+        const auto invoker =
+            profile_h.PrepareInvoker(*solution.invoker_factory, solution.construction_params);
+
+        return [&profile_h, &invoke_ctx, invoker]() {
+            invoker(profile_h, invoke_ctx);
+            return profile_h.GetKernelTime();
+        };
+    };
+
+    // The first measurement of each config is recorded to the trace, if enabled.
+    const auto trace_path = GetStringEnv(MIOPEN_DEBUG_GENERIC_SEARCH_TRACE{});
+    auto trace            = SearchTrace{SolverDbId(s), {}, {}};
+
+    const auto traced_start = [&](const PerformanceConfig& config, const Prepared& prepared) {
+        auto run = start(config, prepared);
+        return [&trace, trace_path, config, run, is_recorded = false]() mutable {
+            const auto time = run();
+            if(trace_path != nullptr && !is_recorded)
+                trace.Add(config, time);
+            is_recorded = true;
+            return time;
+        };
+    };
+
+    if(IsEnabled(MIOPEN_DEBUG_COMPILE_ONLY{}))
+    {
+// Compiled programs are only kept in the binary cache, so there is nothing to do without it.
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+        PipelinedForEach(all_configs.begin(),
+                         all_configs.end(),
+                         GetSearchCompileWorkers(),
+                         GetSearchLookahead(),
+                         prepare,
+                         [](std::size_t, const PerformanceConfig&, const Prepared&) {
+                             return true;
+                         });
+#endif
+        MIOPEN_THROW("Running kernels on GPU is disabled. Search skipped");
+    }
+
+    const auto options = GetSearchOptions(s, context);
+    if(options.strategy != SearchStrategy::Exhaustive || options.max_trials != 0 ||
+       options.max_time != 0)
+        MIOPEN_LOG_W("Search strategy: " << options.strategy << ", max trials "
+                                         << options.max_trials
+                                         << ", max time "
+                                         << options.max_time
+                                         << " s");
+
+    // Only the exhaustive search is resumable, as others do not measure configs in order.
+    const auto checkpoint_path = GetSearchCheckpointPath(profile_h);
+    const auto is_checkpointed = !IsDisabled(MIOPEN_DEBUG_GENERIC_SEARCH_CHECKPOINT{}) &&
+                                 !checkpoint_path.empty() &&
+                                 options.strategy == SearchStrategy::Exhaustive;
+
+    float best_time = std::numeric_limits<float>::max();
+    bool is_passed  = false;
+
+    if(is_checkpointed)
+    {
+        const auto interval = Value(MIOPEN_DEBUG_GENERIC_SEARCH_CHECKPOINT_INTERVAL{}, 60);
+        auto checkpointer   = SearchCheckpointer<PerformanceConfig, Context>{
+            checkpoint_path,
+            context,
+            SolverDbId(s) + (useSpare ? "_spare" : ""),
+            static_cast<std::size_t>(n_runs_total),
+            std::chrono::seconds(interval)};
+
+        is_passed = SearchWithCheckpoints(checkpointer,
+                                          options,
+                                          all_configs,
+                                          n_runs_total,
+                                          GetSearchCompileWorkers(),
+                                          GetSearchLookahead(),
+                                          prepare,
+                                          traced_start,
+                                          best_config,
+                                          best_time);
     }
     else
     {
-        MIOPEN_THROW("Running kernels on GPU is disabled. Search skipped");
+        is_passed = RunSearchStrategy(options,
+                                      all_configs,
+                                      n_runs_total,
+                                      s.GetPerformanceConfig(context),
+                                      GetSearchCompileWorkers(),
+                                      GetSearchLookahead(),
+                                      prepare,
+                                      traced_start,
+                                      best_config,
+                                      best_time);
+    }
+
+    if(trace_path != nullptr)
+    {
+        auto file = std::ofstream{trace_path, std::ios::app};
+        trace.Write(file);
+        if(!file)
+            MIOPEN_LOG_W("Unable to write search trace to " << trace_path);
     }
 
-    MIOPEN_LOG_W("Done: " << n_runs_total << '/' << n_failed << '/' << n_runs_total << ", best #"
-                          << n_best
-                          << ' '
-                          << best_time
-                          << ' '
-                          << best_config);
     if(!is_passed)
         MIOPEN_THROW("Search failed");
     // Run once with the default config and show score.
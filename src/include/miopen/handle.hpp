@@ -213,8 +213,8 @@ struct Handle : miopenHandle
                          solver::Id solver,
                          const AlgorithmName& algo)
     {
-        invokers.Register({config, solver.ToString()}, invoker);
-        invokers.SetAsFound1_0(config, algo, solver.ToString());
+        invokers.Register(config, solver, invoker);
+        invokers.SetAsFound1_0(config, algo, solver);
     }
 
     boost::optional<const Invoker&>
@@ -228,7 +228,7 @@ struct Handle : miopenHandle
         {
             MIOPEN_LOG_I2("Returning an invoker for problem " << config.ToString() << " and solver "
                                                               << solver->ToString());
-            return invokers[std::make_pair(config.ToString(), solver->ToString())];
+            return invokers.GetInvoker(config, *solver);
         }
         MIOPEN_LOG_I2("Returning an invoker for problem " << config.ToString() << " and algorithm "
                                                           << algo->ToString());
@@ -28,6 +28,7 @@
 
 #include <array>
 #include <cassert>
+#include <miopen/config.h>
 #include <miopen/errors.hpp>
 #include <miopen/hipoc_program.hpp>
 #include <miopen/stringutils.hpp>
@@ -194,11 +195,13 @@ struct HIPOCKernel
         std::copy(global_dims.begin(), global_dims.end(), gdims.begin());
 
         kernel_module = name;
-        auto status   = hipModuleGetFunction(&fun, program.GetModule(), kernel_module.c_str());
+#if !MIOPEN_MODE_NOGPU
+        auto status = hipModuleGetFunction(&fun, program.GetModule(), kernel_module.c_str());
         if(hipSuccess != status)
             MIOPEN_THROW_HIP_STATUS(status,
                                     "Failed to get function: " + kernel_module + " from " +
                                         program.GetCodeObjectPathname().string());
+#endif
     }
 
     HIPOCKernelInvoke Invoke(hipStream_t stream,
@@ -0,0 +1,199 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_HOST_GEMM_HPP_
+#define GUARD_MIOPEN_HOST_GEMM_HPP_
+
+#include <miopen/float_equal.hpp>
+#include <miopen/par_for.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace miopen {
+namespace detail {
+
+// Blocking of HostGemm. The micro-kernel keeps MR x NR accumulators in registers and its
+// innermost loop over NR columns is vectorized by the compiler. A task computes an MC x NC tile
+// of C from panels of op(A) and op(B) of depth KC, which are packed to stay in L1 and L2.
+constexpr std::size_t HostGemmMR = 4;
+constexpr std::size_t HostGemmNR = 16;
+constexpr std::size_t HostGemmMC = 64;
+constexpr std::size_t HostGemmNC = 256;
+constexpr std::size_t HostGemmKC = 256;
+
+inline std::size_t HostGemmRoundUp(std::size_t value, std::size_t step)
+{
+    return (value + step - 1) / step * step;
+}
+
+/// Row-major matrix, which is read transposed if trans is set.
+template <class T>
+struct HostGemmMatrix
+{
+    const T* data;
+    std::size_t ld;
+    bool trans;
+
+    const T& operator()(std::size_t row, std::size_t col) const
+    {
+        return trans ? data[col * ld + row] : data[row * ld + col];
+    }
+};
+
+/// Packs the rows x depth block of op(A) at (row, k) into slivers of MR rows, each one stored
+/// column by column. Rows past the end are zeros.
+template <class Acc, class T>
+void HostGemmPackA(const HostGemmMatrix<T>& a,
+                   std::size_t row,
+                   std::size_t rows,
+                   std::size_t k,
+                   std::size_t depth,
+                   Acc* packed)
+{
+    for(auto i0 = std::size_t{0}; i0 < rows; i0 += HostGemmMR)
+        for(auto p = std::size_t{0}; p < depth; ++p)
+            for(auto i = i0; i < i0 + HostGemmMR; ++i)
+                *packed++ = i < rows ? static_cast<Acc>(a(row + i, k + p)) : Acc(0);
+}
+
+/// Packs the depth x cols block of op(B) at (k, col) into slivers of NR columns, each one stored
+/// row by row. Columns past the end are zeros.
+template <class Acc, class T>
+void HostGemmPackB(const HostGemmMatrix<T>& b,
+                   std::size_t k,
+                   std::size_t depth,
+                   std::size_t col,
+                   std::size_t cols,
+                   Acc* packed)
+{
+    for(auto j0 = std::size_t{0}; j0 < cols; j0 += HostGemmNR)
+        for(auto p = std::size_t{0}; p < depth; ++p)
+            for(auto j = j0; j < j0 + HostGemmNR; ++j)
+                *packed++ = j < cols ? static_cast<Acc>(b(k + p, col + j)) : Acc(0);
+}
+
+/// Adds the product of packed slivers of op(A) and op(B) to MR x NR accumulators at c.
+template <class Acc>
+void HostGemmMicroKernel(std::size_t depth, const Acc* a, const Acc* b, Acc* c, std::size_t ldc)
+{
+    Acc acc[HostGemmMR][HostGemmNR];
+    for(auto& row : acc)
+        std::fill(std::begin(row), std::end(row), Acc(0));
+
+    for(auto p = std::size_t{0}; p < depth; ++p, a += HostGemmMR, b += HostGemmNR)
+    {
+        for(auto i = std::size_t{0}; i < HostGemmMR; ++i)
+        {
+            const auto a_i = a[i];
+            for(auto j = std::size_t{0}; j < HostGemmNR; ++j)
+                acc[i][j] += a_i * b[j];
+        }
+    }
+
+    for(auto i = std::size_t{0}; i < HostGemmMR; ++i)
+        for(auto j = std::size_t{0}; j < HostGemmNR; ++j)
+            c[i * ldc + j] += acc[i][j];
+}
+
+} // namespace detail
+
+/// C = alpha * op(A) * op(B) + beta * C on the host, where op(A) is m x k, op(B) is k x n and
+/// all the matrices are row-major with the leading dimensions lda, ldb and ldc. Products are
+/// accumulated in Acc, e.g. double for the reference results of float data. C is not read if
+/// beta is 0.
+///
+/// Tiles of C are computed in parallel by the thread pool.
+template <class Acc = double, class T>
+void HostGemm(bool trans_a,
+              bool trans_b,
+              std::size_t m,
+              std::size_t n,
+              std::size_t k,
+              double alpha,
+              const T* a,
+              std::size_t lda,
+              const T* b,
+              std::size_t ldb,
+              double beta,
+              T* c,
+              std::size_t ldc)
+{
+    using namespace detail;
+
+    const auto a_matrix  = HostGemmMatrix<T>{a, lda, trans_a};
+    const auto b_matrix  = HostGemmMatrix<T>{b, ldb, trans_b};
+    const auto m_tiles   = (m + HostGemmMC - 1) / HostGemmMC;
+    const auto n_tiles   = (n + HostGemmNC - 1) / HostGemmNC;
+    const auto alpha_acc = static_cast<Acc>(alpha);
+    const auto beta_acc  = static_cast<Acc>(beta);
+    const auto read_c    = !float_equal(beta, 0.0);
+
+    par_for(m_tiles * n_tiles, min_grain{1}, [&](std::size_t tile) {
+        const auto row      = tile / n_tiles * HostGemmMC;
+        const auto col      = tile % n_tiles * HostGemmNC;
+        const auto rows     = std::min(HostGemmMC, m - row);
+        const auto cols     = std::min(HostGemmNC, n - col);
+        const auto acc_ld   = HostGemmRoundUp(cols, HostGemmNR);
+        const auto max_rows = HostGemmRoundUp(rows, HostGemmMR);
+        const auto max_kc   = std::min(HostGemmKC, k);
+
+        auto acc      = std::vector<Acc>(max_rows * acc_ld, Acc(0));
+        auto packed_a = std::vector<Acc>(max_rows * max_kc);
+        auto packed_b = std::vector<Acc>(max_kc * acc_ld);
+
+        for(auto p = std::size_t{0}; p < k; p += HostGemmKC)
+        {
+            const auto depth = std::min(HostGemmKC, k - p);
+            HostGemmPackA(a_matrix, row, rows, p, depth, packed_a.data());
+            HostGemmPackB(b_matrix, p, depth, col, cols, packed_b.data());
+
+            for(auto i = std::size_t{0}; i < rows; i += HostGemmMR)
+                for(auto j = std::size_t{0}; j < cols; j += HostGemmNR)
+                    HostGemmMicroKernel(depth,
+                                        packed_a.data() + i * depth,
+                                        packed_b.data() + j * depth,
+                                        acc.data() + i * acc_ld + j,
+                                        acc_ld);
+        }
+
+        for(auto i = std::size_t{0}; i < rows; ++i)
+        {
+            const auto c_row = c + (row + i) * ldc + col;
+            for(auto j = std::size_t{0}; j < cols; ++j)
+            {
+                Acc value = alpha_acc * acc[i * acc_ld + j];
+                if(read_c)
+                    value += beta_acc * static_cast<Acc>(c_row[j]);
+                c_row[j] = static_cast<T>(value);
+            }
+        }
+    });
+}
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_HOST_GEMM_HPP_
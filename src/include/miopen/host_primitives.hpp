@@ -0,0 +1,224 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_HOST_PRIMITIVES_HPP_
+#define GUARD_MIOPEN_HOST_PRIMITIVES_HPP_
+
+#include <miopen/common.hpp>
+#include <miopen/miopen.h>
+
+#include <cstddef>
+
+namespace miopen {
+
+struct ActivationDescriptor;
+struct LRNDescriptor;
+struct PoolingDescriptor;
+struct ReduceTensorDescriptor;
+struct TensorDescriptor;
+
+/// Implementations of the primitives other than convolution for the host execution mode of the
+/// null device (see NullDevice::IsHostExecution). The buffers are in the host memory then. The
+/// entry points of the primitives validate the arguments and call these instead of launching the
+/// kernels. Offsets are in elements. fp32, fp16 and bf16 are computed in fp32, accumulations in
+/// fp64. The cases not supported on the host throw miopenStatusNotImplemented.
+namespace host {
+
+void OpTensor(miopenTensorOp_t tensorOp,
+              const void* alpha0,
+              const TensorDescriptor& aTensorDesc,
+              ConstData_t ATensor,
+              const void* alpha1,
+              const TensorDescriptor& bTensorDesc,
+              ConstData_t BTensor,
+              const void* beta,
+              const TensorDescriptor& cTensorDesc,
+              Data_t CTensor,
+              std::size_t Aoffset,
+              std::size_t Boffset,
+              std::size_t Coffset);
+
+void SetTensor(const TensorDescriptor& yDesc, Data_t y, const void* alpha, int offset);
+
+void ScaleTensor(const TensorDescriptor& yDesc, Data_t y, const void* alpha, int offset);
+
+void CopyTensor(const TensorDescriptor& srcDesc,
+                ConstData_t src,
+                const TensorDescriptor& dstDesc,
+                Data_t dst,
+                int srcOffset,
+                int dstOffset);
+
+void TransformTensor(const void* alpha,
+                     const TensorDescriptor& xDesc,
+                     ConstData_t x,
+                     const void* beta,
+                     const TensorDescriptor& yDesc,
+                     Data_t y,
+                     std::size_t Xoffset,
+                     std::size_t Yoffset);
+
+void ActivationForward(const ActivationDescriptor& desc,
+                       const TensorDescriptor& xDesc,
+                       ConstData_t x,
+                       const TensorDescriptor& yDesc,
+                       Data_t y,
+                       std::size_t xOffset,
+                       std::size_t yOffset);
+
+void ActivationBackward(const ActivationDescriptor& desc,
+                        const TensorDescriptor& yDesc,
+                        ConstData_t y,
+                        const TensorDescriptor& dyDesc,
+                        ConstData_t dy,
+                        const TensorDescriptor& xDesc,
+                        ConstData_t x,
+                        const TensorDescriptor& dxDesc,
+                        Data_t dx,
+                        std::size_t yOffset,
+                        std::size_t dyOffset,
+                        std::size_t xOffset,
+                        std::size_t dxOffset);
+
+/// The workspace holds the positions of the maxima in the layout of y: within the window in the
+/// mask mode and within the image in the image mode.
+void PoolingForward(const PoolingDescriptor& desc,
+                    const TensorDescriptor& xDesc,
+                    ConstData_t x,
+                    const TensorDescriptor& yDesc,
+                    Data_t y,
+                    bool save_index,
+                    Data_t workSpace);
+
+void PoolingBackward(const PoolingDescriptor& desc,
+                     const TensorDescriptor& dyDesc,
+                     ConstData_t dy,
+                     const TensorDescriptor& dxDesc,
+                     Data_t dx,
+                     ConstData_t workSpace);
+
+void SoftmaxForward(float alpha,
+                    float beta,
+                    const TensorDescriptor& xDesc,
+                    ConstData_t x,
+                    const TensorDescriptor& yDesc,
+                    Data_t y,
+                    miopenSoftmaxAlgorithm_t algorithm,
+                    miopenSoftmaxMode_t mode,
+                    int x_offset,
+                    int y_offset);
+
+void SoftmaxBackward(float alpha,
+                     const TensorDescriptor& yDesc,
+                     ConstData_t y,
+                     const TensorDescriptor& dyDesc,
+                     ConstData_t dy,
+                     float beta,
+                     const TensorDescriptor& dxDesc,
+                     Data_t dx,
+                     miopenSoftmaxAlgorithm_t algorithm,
+                     miopenSoftmaxMode_t mode,
+                     int y_offset,
+                     int dy_offset,
+                     int dx_offset);
+
+/// Any of the running and saved statistics may be null.
+void BatchNormForwardTraining(miopenBatchNormMode_t bn_mode,
+                              const TensorDescriptor& xDesc,
+                              ConstData_t x,
+                              const TensorDescriptor& yDesc,
+                              Data_t y,
+                              const TensorDescriptor& bnScaleBiasMeanVarDesc,
+                              ConstData_t bnScale,
+                              ConstData_t bnBias,
+                              double expAvgFactor,
+                              Data_t resultRunningMean,
+                              Data_t resultRunningVariance,
+                              double epsilon,
+                              Data_t resultSaveMean,
+                              Data_t resultSaveInvVariance);
+
+void BatchNormForwardInference(miopenBatchNormMode_t bn_mode,
+                               const TensorDescriptor& xDesc,
+                               ConstData_t x,
+                               const TensorDescriptor& yDesc,
+                               Data_t y,
+                               const TensorDescriptor& bnScaleBiasMeanVarDesc,
+                               ConstData_t bnScale,
+                               ConstData_t bnBias,
+                               ConstData_t estimatedMean,
+                               ConstData_t estimatedVariance,
+                               double epsilon);
+
+/// The statistics are recomputed from x when the saved ones are null.
+void BatchNormBackward(miopenBatchNormMode_t bn_mode,
+                       const TensorDescriptor& xDesc,
+                       ConstData_t x,
+                       const TensorDescriptor& dyDesc,
+                       ConstData_t dy,
+                       const TensorDescriptor& dxDesc,
+                       Data_t dx,
+                       const TensorDescriptor& bnScaleBiasDiffDesc,
+                       ConstData_t bnScale,
+                       Data_t resultBnScaleDiff,
+                       Data_t resultBnBiasDiff,
+                       double epsilon,
+                       ConstData_t savedMean,
+                       ConstData_t savedInvVariance);
+
+/// The workspace holds the scales, K + alpha / area * sum(x^2), in the layout of y.
+void LRNForward(const LRNDescriptor& desc,
+                const TensorDescriptor& xDesc,
+                ConstData_t x,
+                const TensorDescriptor& yDesc,
+                Data_t y,
+                bool do_backward,
+                Data_t workSpace);
+
+void LRNBackward(const LRNDescriptor& desc,
+                 const TensorDescriptor& yDesc,
+                 ConstData_t y,
+                 const TensorDescriptor& dyDesc,
+                 ConstData_t dy,
+                 const TensorDescriptor& xDesc,
+                 ConstData_t x,
+                 const TensorDescriptor& dxDesc,
+                 Data_t dx,
+                 ConstData_t workSpace);
+
+/// The indices, when requested by the descriptor, are int32 in the layout of C.
+void ReduceTensor(const ReduceTensorDescriptor& desc,
+                  Data_t indices,
+                  const void* alpha,
+                  const TensorDescriptor& aDesc,
+                  ConstData_t A,
+                  const void* beta,
+                  const TensorDescriptor& cDesc,
+                  Data_t C);
+
+} // namespace host
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_HOST_PRIMITIVES_HPP_
@@ -27,8 +27,10 @@
 #pragma once
 
 #include <miopen/kernel.hpp>
+#include <miopen/trace.hpp>
 
 #include <functional>
+#include <string>
 #include <vector>
 
 namespace miopen {
@@ -39,4 +41,19 @@ struct AnyInvokeParams;
 using Invoker = std::function<void(const Handle&, const AnyInvokeParams& primitive_parameters)>;
 using InvokerFactory = std::function<Invoker(const std::vector<Kernel>&)>;
 
+/// Adds a span to the trace for each execution of the invoker, if tracing is enabled when the
+/// invoker is prepared.
+inline Invoker MakeTracedInvoker(Invoker invoker, std::string detail)
+{
+    if(!trace::IsEnabled() || !invoker)
+        return invoker;
+
+    return [invoker = std::move(invoker), detail = std::move(detail)](
+               const Handle& handle, const AnyInvokeParams& primitive_parameters) {
+        trace::Span span{"invoker", "Invoke"};
+        span.SetDetail(detail);
+        invoker(handle, primitive_parameters);
+    };
+}
+
 } // namespace miopen
@@ -28,44 +28,223 @@
 
 #include <miopen/errors.hpp>
 #include <miopen/invoker.hpp>
+#include <miopen/names.hpp>
+#include <miopen/solver_id.hpp>
 
 #include <boost/optional.hpp>
 
-#include <map>
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace miopen {
 
-class InvokerCache
+/// Hash table which is read without locks. Entries are never removed, and values are never
+/// replaced, so a reader may follow the chain of a bucket while another thread inserts. When
+/// the table grows, the previous bucket array and its nodes are kept until destruction, as
+/// readers may still use them. Thus references to values stay valid for the lifetime of the
+/// table. Memory overhead of that is bounded by the size of the last bucket array, as each
+/// array is twice the size of the previous one.
+///
+/// Hash of a key is provided by the caller, so it can be precomputed. Lookups accept any probe
+/// comparable with keys (probe == key), so that keys need not be constructed for lookups.
+template <class TKey, class TValue>
+class AppendOnlyHashMap
 {
     public:
-    // network_config, solver_id
-    using Key = std::pair<std::string, std::string>;
+    AppendOnlyHashMap() : table(new Table(MinBuckets)) {}
+    AppendOnlyHashMap(const AppendOnlyHashMap&) = delete;
+    AppendOnlyHashMap& operator=(const AppendOnlyHashMap&) = delete;
+    ~AppendOnlyHashMap() { delete table.load(); }
+
+    /// May be called concurrently with Insert(). Returns nullptr if there is no such key.
+    template <class TProbe>
+    const TValue* Find(std::uint64_t hash, const TProbe& probe) const
+    {
+        const auto current = table.load(std::memory_order_acquire);
+        return current->Find(hash, probe);
+    }
+
+    /// Inserts the value unless there is such key already.
+    void Insert(std::uint64_t hash, const TKey& key, const TValue& value)
+    {
+        InsertOrUpdate(hash, key, value, [](TValue&) {});
+    }
+
+    /// Inserts the value or, if there is such key already, calls update(stored_value). Updates
+    /// shall only modify atomic members of the value, as readers do not lock.
+    template <class TUpdate>
+    void InsertOrUpdate(std::uint64_t hash, const TKey& key, const TValue& value, TUpdate update)
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        auto current = table.load(std::memory_order_relaxed);
+
+        const auto found = current->Find(hash, key);
+        if(found != nullptr)
+        {
+            update(*found);
+            return;
+        }
+
+        if(current->size >= current->buckets.size())
+            current = Grow(current);
+
+        current->Insert(hash, key, value);
+    }
+
+    private:
+    static constexpr std::size_t MinBuckets = 64;
+
+    struct Node
+    {
+        std::uint64_t hash;
+        TKey key;
+        TValue value;
+        Node* next;
+    };
+
+    struct Table
+    {
+        std::vector<std::atomic<Node*>> buckets;
+        std::size_t size = 0;
+        std::unique_ptr<Table> previous;
+
+        Table(std::size_t n_buckets) : buckets(n_buckets) {}
+
+        ~Table()
+        {
+            for(auto& bucket : buckets)
+            {
+                for(auto node = bucket.load(std::memory_order_relaxed); node != nullptr;)
+                {
+                    const auto next = node->next;
+                    delete node;
+                    node = next;
+                }
+            }
+        }
+
+        template <class TProbe>
+        TValue* Find(std::uint64_t hash, const TProbe& probe) const
+        {
+            const auto& bucket = buckets[hash & (buckets.size() - 1)];
+            for(auto node = bucket.load(std::memory_order_acquire); node != nullptr;
+                node      = node->next)
+            {
+                if(node->hash == hash && probe == node->key)
+                    return &node->value;
+            }
+            return nullptr;
+        }
+
+        void Insert(std::uint64_t hash, const TKey& key, const TValue& value)
+        {
+            auto& bucket    = buckets[hash & (buckets.size() - 1)];
+            const auto node = new Node{hash, key, value, bucket.load(std::memory_order_relaxed)};
+            bucket.store(node, std::memory_order_release);
+            ++size;
+        }
+    };
+
+    std::atomic<Table*> table;
+    std::mutex mutex;
+
+    Table* Grow(Table* current)
+    {
+        auto grown = std::unique_ptr<Table>{new Table(current->buckets.size() * 2)};
+
+        for(const auto& bucket : current->buckets)
+            for(auto node = bucket.load(std::memory_order_relaxed); node != nullptr;
+                node      = node->next)
+                grown->Insert(node->hash, node->key, node->value);
+
+        grown->previous.reset(current);
+        table.store(grown.get(), std::memory_order_release);
+        return grown.release();
+    }
+};
 
-    boost::optional<const Invoker&> operator[](const Key& key) const;
+/// Invokers registered for problems (by network config) and solvers, and the results of
+/// find 1.0 (the best solver by network config and algorithm).
+///
+/// Keys are hashed with the digest precomputed by NetworkConfig, and lookups take no locks, so
+/// the cache may be used from several threads without external synchronization.
+class InvokerCache
+{
+    public:
+    boost::optional<const Invoker&> GetInvoker(const NetworkConfig& config,
+                                               const solver::Id& solver_id) const;
     // For find 1.0
-    boost::optional<const Invoker&> GetFound1_0(const std::string& network_config,
-                                                const std::string& algorithm) const;
-    void Register(const Key& key, const Invoker& invoker);
+    boost::optional<const Invoker&> GetFound1_0(const NetworkConfig& config,
+                                                const AlgorithmName& algorithm) const;
+    void Register(const NetworkConfig& config, const solver::Id& solver_id, const Invoker& invoker);
     // For find 1.0
-    void SetAsFound1_0(const std::string& network_config,
-                       const std::string& algorithm,
-                       const std::string& solver_id);
+    void SetAsFound1_0(const NetworkConfig& config,
+                       const AlgorithmName& algorithm,
+                       const solver::Id& solver_id);
 
     private:
-    struct Item
+    struct InvokerKey
+    {
+        std::string network_config;
+        std::uint64_t solver_id;
+
+        bool operator==(const InvokerKey& other) const
+        {
+            return solver_id == other.solver_id && network_config == other.network_config;
+        }
+    };
+
+    struct InvokerProbe
+    {
+        const std::string& network_config;
+        std::uint64_t solver_id;
+
+        bool operator==(const InvokerKey& key) const
+        {
+            return solver_id == key.solver_id && network_config == key.network_config;
+        }
+    };
+
+    struct Found1_0Key
+    {
+        std::string network_config;
+        std::string algorithm;
+
+        bool operator==(const Found1_0Key& other) const
+        {
+            return algorithm == other.algorithm && network_config == other.network_config;
+        }
+    };
+
+    struct Found1_0Probe
+    {
+        const std::string& network_config;
+        const std::string& algorithm;
+
+        bool operator==(const Found1_0Key& key) const
+        {
+            return algorithm == key.algorithm && network_config == key.network_config;
+        }
+    };
+
+    struct Found1_0
     {
-        // algorithm -> solver_id
-        // for find 1.0
-        std::map<std::string, std::string> found_1_0;
-        // solver_id -> invoker
-        std::map<std::string, Invoker> invokers;
+        std::atomic<std::uint64_t> solver_id;
+
+        Found1_0(std::uint64_t solver_id_) : solver_id(solver_id_) {}
+        Found1_0(const Found1_0& other) : solver_id(other.solver_id.load()) {}
     };
 
-    // network_config -> Item
-    std::map<std::string, Item> invokers;
+    // The maps are held by pointers to keep the cache (and thus Handle) movable.
+    std::unique_ptr<AppendOnlyHashMap<InvokerKey, Invoker>> invokers{
+        new AppendOnlyHashMap<InvokerKey, Invoker>{}};
+    std::unique_ptr<AppendOnlyHashMap<Found1_0Key, Found1_0>> found_1_0{
+        new AppendOnlyHashMap<Found1_0Key, Found1_0>{}};
 };
 
 } // namespace miopen
@@ -32,15 +32,20 @@
 
 #include <miopen/sqlite_db.hpp>
 #include <miopen/bz2.hpp>
+#include <miopen/lz4.hpp>
 #include <miopen/md5.hpp>
 
 #include <boost/core/explicit_operator_bool.hpp>
 #include <boost/none.hpp>
 #include <boost/optional/optional.hpp>
 
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <chrono>
 #include <thread>
+#include <tuple>
+#include <vector>
 
 namespace boost {
 namespace filesystem {
@@ -59,6 +64,8 @@ struct KernelConfig
     {
         return {"kernel_name", "kernel_args", "kernel_blob"};
     }
+    /// Columns added after the first release. Databases without them are still readable.
+    static std::vector<std::string> CodecFieldNames() { return {"codec", "last_access"}; }
     static std::string CreateQuery()
     {
         std::ostringstream ss;
@@ -69,31 +76,73 @@ struct KernelConfig
            << ",`kernel_blob` BLOB NOT NULL"
            << ",`kernel_hash` TEXT NOT NULL"
            << ",`uncompressed_size` INT NOT NULL"
+           << ",`codec` INT NOT NULL DEFAULT 0"
+           << ",`last_access` INT NOT NULL DEFAULT 0"
            << ");"
            << "CREATE UNIQUE INDEX IF NOT EXISTS "
            << "`idx_" << KernelConfig::table_name() << "` "
            << "ON " << KernelConfig::table_name() << "(kernel_name, kernel_args);";
         return ss.str();
     }
-    std::string Where() const
+    /// Lets evictions find the least recently used kernels without sorting the table. Created
+    /// whenever a user database is opened, so older files get it too.
+    static std::string CreateAccessIndexQuery()
     {
         std::ostringstream ss;
-        ss << "(kernel_name = '" << kernel_name << "')"
-           << " AND (kernel_args = '" << kernel_args << "')";
+        ss << "CREATE INDEX IF NOT EXISTS "
+           << "`idx_" << KernelConfig::table_name() << "_last_access` "
+           << "ON " << KernelConfig::table_name() << "(last_access);";
         return ss.str();
     }
+    /// Values are bound as parameters, so the query text is the same for all the kernels and
+    /// the prepared statement is reused.
+    std::tuple<std::string, std::vector<std::string>> WhereClause() const
+    {
+        return std::make_tuple("(kernel_name = ?) AND (kernel_args = ?)",
+                               std::vector<std::string>{kernel_name, kernel_args});
+    }
+};
+
+/// Compression of the kernel binaries. The id of the codec is stored with each kernel, so the
+/// ids shall never change. Rows without the id have been written by bz2.
+struct KernDbCodec
+{
+    enum : int
+    {
+        Bz2 = 0,
+        Lz4 = 1,
+    };
+
+    int id;
+    std::string name;
+    std::function<std::string(std::string, bool*)> compress;
+    std::function<std::string(std::string, unsigned int)> decompress;
 };
 
+/// Returns nullptr if the id is unknown, e.g. the database has been written by a newer library.
+const KernDbCodec* FindKernDbCodec(int id);
+/// Codec used for new kernels: lz4, or the one set by MIOPEN_DEBUG_KERN_DB_CODEC.
+const KernDbCodec& GetKernDbCodec();
+
+/// Kernel binary cache. User databases are limited in size (MIOPEN_KERN_DB_SIZE_LIMIT): once
+/// the limit is exceeded, the least recently used kernels are evicted.
 class KernDb : public SQLiteBase<KernDb>
 {
-    std::function<std::string(std::string, bool*)> compress_fn;
-    std::function<std::string(std::string, unsigned int)> decompress_fn;
+    KernDbCodec codec;
+    bool read_only;
+    bool has_codec_fields = false;
+    std::uint64_t size_limit;
 
     public:
     KernDb(const std::string& filename_,
            bool is_system,
            const std::string& arch,
            std::size_t num_cu);
+    KernDb(const std::string& filename_,
+           bool is_system,
+           const std::string& arch,
+           std::size_t num_cu,
+           const KernDbCodec& codec_);
     // This constructor is only intended for testing
     KernDb(const std::string& filename_,
            bool _is_system,
@@ -101,14 +150,22 @@ class KernDb : public SQLiteBase<KernDb>
            std::size_t _num_cu,
            std::function<std::string(std::string, bool*)> _compress_fn,
            std::function<std::string(std::string, unsigned int)> _decompress_fn);
+
+    /// In bytes, 0 means unlimited.
+    void SetSizeLimit(std::uint64_t size_limit_) { size_limit = size_limit_; }
+    /// Size of the pages in use, i.e. the file size less the free pages left by evictions.
+    std::uint64_t GetUsedSize() const;
+
     template <typename T>
     bool RemoveRecordUnsafe(const T& problem_config)
     {
         if(filename.empty())
             return true;
-        auto del_query =
-            "DELETE FROM " + T::table_name() + " WHERE " + problem_config.Where() + ";";
-        auto stmt = SQLite::Statement{sql, del_query};
+        std::string clause;
+        std::vector<std::string> values;
+        std::tie(clause, values) = problem_config.WhereClause();
+        auto del_query = "DELETE FROM " + T::table_name() + " WHERE " + clause + ";";
+        auto stmt      = SQLite::Statement{sql, del_query, values};
         auto rc   = stmt.Step(sql);
         if(rc == SQLITE_DONE)
             return true;
@@ -124,33 +181,55 @@ class KernDb : public SQLiteBase<KernDb>
     {
         if(filename.empty())
             return boost::none;
-        // Where clause with inserted values defeats the purpose of a prepraed statement
-        auto select_query = "SELECT kernel_blob, kernel_hash, uncompressed_size FROM " +
-                            T::table_name() + " WHERE " + problem_config.Where() + ";";
-        auto stmt = SQLite::Statement{sql, select_query};
-        // only one result field
-        // assert one row
-        auto rc = stmt.Step(sql);
-        if(rc == SQLITE_ROW)
+        std::string clause;
+        std::vector<std::string> values;
+        std::tie(clause, values) = problem_config.WhereClause();
+        auto select_query = std::string{"SELECT kernel_blob, kernel_hash, uncompressed_size"} +
+                            (has_codec_fields ? ", codec, id, last_access" : "") + " FROM " +
+                            T::table_name() + " WHERE " + clause + ";";
+        std::string blob;
+        std::string md5_hash;
+        std::int64_t uncompressed_size;
+        auto codec_id    = std::int64_t{KernDbCodec::Bz2};
+        auto id          = std::int64_t{0};
+        auto last_access = std::int64_t{0};
         {
-            auto compressed_blob           = stmt.ColumnBlob(0);
-            auto md5_hash                  = stmt.ColumnText(1);
-            auto uncompressed_size         = stmt.ColumnInt64(2);
-            std::string& decompressed_blob = compressed_blob;
-            if(uncompressed_size != 0)
+            auto stmt = SQLite::Statement{sql, select_query, values};
+            // only one result field
+            // assert one row
+            auto rc = stmt.Step(sql);
+            if(rc == SQLITE_DONE)
+                return boost::none;
+            if(rc != SQLITE_ROW)
+                MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+
+            blob              = stmt.ColumnBlob(0);
+            md5_hash          = stmt.ColumnText(1);
+            uncompressed_size = stmt.ColumnInt64(2);
+            if(has_codec_fields)
             {
-                decompressed_blob = decompress_fn(compressed_blob, uncompressed_size);
+                codec_id    = stmt.ColumnInt64(3);
+                id          = stmt.ColumnInt64(4);
+                last_access = stmt.ColumnInt64(5);
             }
-            auto new_md5 = md5(decompressed_blob);
-            if(new_md5 != md5_hash)
-                MIOPEN_THROW(miopenStatusInternalError, "Possible database corruption");
-            return decompressed_blob;
         }
-        else if(rc == SQLITE_DONE)
-            return boost::none;
-        else
-            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
-        return boost::none;
+
+        if(uncompressed_size != 0)
+        {
+            const auto row_codec = codec_id == codec.id ? &codec : FindKernDbCodec(codec_id);
+            if(row_codec == nullptr)
+            {
+                MIOPEN_LOG_W("Unknown codec " << codec_id << " of a kernel in " << filename);
+                return boost::none;
+            }
+            blob = row_codec->decompress(blob, uncompressed_size);
+        }
+        auto new_md5 = md5(blob);
+        if(new_md5 != md5_hash)
+            MIOPEN_THROW(miopenStatusInternalError, "Possible database corruption");
+        if(has_codec_fields)
+            TouchUnsafe(id, last_access);
+        return blob;
     }
 
     template <typename T>
@@ -160,11 +239,13 @@ class KernDb : public SQLiteBase<KernDb>
             return boost::none;
         auto insert_query = "INSERT OR IGNORE INTO " + T::table_name() +
                             "(kernel_name, kernel_args, kernel_blob, kernel_hash, "
-                            "uncompressed_size) VALUES(?, ?, ?, ?, ?);";
+                            "uncompressed_size" +
+                            (has_codec_fields ? ", codec, last_access) VALUES(?, ?, ?, ?, ?, ?, ?);"
+                                              : ") VALUES(?, ?, ?, ?, ?);");
         auto md5_sum           = md5(problem_config.kernel_blob);
         auto uncompressed_size = problem_config.kernel_blob.size();
         bool success           = false;
-        auto compressed_blob   = compress_fn(problem_config.kernel_blob, &success);
+        auto compressed_blob   = codec.compress(problem_config.kernel_blob, &success);
         auto stmt              = SQLite::Statement{sql, insert_query};
         stmt.BindText(1, problem_config.kernel_name);
         stmt.BindText(2, problem_config.kernel_args);
@@ -179,12 +260,25 @@ class KernDb : public SQLiteBase<KernDb>
             stmt.BindInt64(5, uncompressed_size);
         }
         stmt.BindText(4, md5_sum);
+        if(has_codec_fields)
+        {
+            // Bz2 (0) is also stored for uncompressed kernels to stay readable by old libraries.
+            stmt.BindInt64(6, success ? codec.id : KernDbCodec::Bz2);
+            stmt.BindInt64(7, Now());
+        }
 
         auto rc = stmt.Step(sql);
         if(rc != SQLITE_DONE)
             MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+        if(sql.Changes() > 0 && has_codec_fields && !read_only && size_limit != 0)
+            EvictUnsafe();
         return problem_config.kernel_blob;
     }
+
+    private:
+    static std::int64_t Now();
+    void TouchUnsafe(std::int64_t id, std::int64_t last_access);
+    void EvictUnsafe();
 };
 } // namespace miopen
 #endif
@@ -171,7 +171,8 @@ class LockFile
 
     static std::map<std::string, LockFile>& LockFiles()
     {
-        static std::map<std::string, LockFile> lock_files;
+        // Never destroyed: the locks are taken by the db writes performed at process exit.
+        static auto& lock_files = *new std::map<std::string, LockFile>{};
         return lock_files;
     }
 
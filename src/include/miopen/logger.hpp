@@ -36,6 +36,7 @@
 #include <miopen/each_args.hpp>
 #include <miopen/object.hpp>
 #include <miopen/config.h>
+#include <miopen/trace.hpp>
 
 // See https://github.com/pfultz2/Cloak/wiki/C-Preprocessor-tricks,-tips,-and-idioms
 #define MIOPEN_PP_CAT(x, y) MIOPEN_PP_PRIMITIVE_CAT(x, y)
@@ -278,6 +279,7 @@ std::ostream& LogParam(std::ostream& os, std::string name, const std::vector<T>&
     } while(false);
 
 #define MIOPEN_LOG_FUNCTION(...)                                                        \
+    MIOPEN_TRACE_SPAN("api", __func__);                                                 \
     do                                                                                  \
         if(miopen::IsLoggingFunctionCalls())                                            \
         {                                                                               \
@@ -292,7 +294,7 @@ std::ostream& LogParam(std::ostream& os, std::string name, const std::vector<T>&
         }                                                                               \
     while(false)
 #else
-#define MIOPEN_LOG_FUNCTION(...)
+#define MIOPEN_LOG_FUNCTION(...) MIOPEN_TRACE_SPAN("api", __func__)
 #endif
 
 std::string LoggingParseFunction(const char* func, const char* pretty_func);
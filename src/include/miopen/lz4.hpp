@@ -0,0 +1,44 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_LZ4_HPP_
+#define GUARD_MIOPEN_LZ4_HPP_
+
+#include <cstddef>
+#include <string>
+
+namespace miopen {
+
+/// Compresses the data into the LZ4 block format, which trades compression ratio for much faster
+/// decompression than bzip2. If the data does not compress, then sets *compressed to false and
+/// returns the data as is, or throws if compressed is nullptr.
+std::string Lz4Compress(const std::string& data, bool* compressed = nullptr);
+
+/// Throws if the data is not a valid LZ4 block or decompresses to more than size bytes.
+std::string Lz4Decompress(const std::string& data, std::size_t size);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_LZ4_HPP_
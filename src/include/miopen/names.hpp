@@ -26,19 +26,28 @@
 
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <string>
 
 namespace miopen {
 
 struct NetworkConfig
 {
-    NetworkConfig() = default;
-    explicit NetworkConfig(const std::string& value_) : value(value_) {}
+    NetworkConfig() : NetworkConfig(std::string{}) {}
+    explicit NetworkConfig(const std::string& value_)
+        : value(value_), hash(std::hash<std::string>{}(value_))
+    {
+    }
     operator std::string() const { return value; }
     std::string ToString() const { return value; }
+    const std::string& GetValue() const { return value; }
+    /// Digest of the value, which is computed once to speed up lookups by the network config.
+    std::uint64_t GetHash() const { return hash; }
 
     private:
     std::string value;
+    std::uint64_t hash;
 };
 
 struct AlgorithmName
@@ -47,6 +56,7 @@ struct AlgorithmName
     explicit AlgorithmName(const std::string& value_) : value(value_) {}
     operator std::string() const { return value; }
     std::string ToString() const { return value; }
+    const std::string& GetValue() const { return value; }
 
     private:
     std::string value;
@@ -0,0 +1,119 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_NULL_DEVICE_HPP_
+#define GUARD_MIOPEN_NULL_DEVICE_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+/// Kernel launch recorded by the null device.
+struct NullDeviceLaunch
+{
+    std::string name;
+    std::array<std::size_t, 3> ldims = {};
+    std::array<std::size_t, 3> gdims = {};
+    /// Packed kernel arguments.
+    std::vector<char> args;
+    /// Upper bound of the memory traffic: sizes of the null device buffers referenced by the
+    /// kernel arguments, counted from the passed pointers to the ends of the buffers.
+    std::size_t bytes = 0;
+    /// Synthetic duration, ms.
+    float time = 0.0f;
+};
+
+/// Device of the HIPNOGPU backend. Buffers live in host memory, kernels are not compiled and not
+/// executed: each launch is recorded and assigned a duration by the time model, which is reported
+/// as the kernel time when profiling is enabled. This allows to measure the host overhead of the
+/// library and to check the sequences of launches on machines without GPUs.
+///
+/// The default time model is
+///   MIOPEN_DEBUG_NOGPU_KERNEL_TIME_US + bytes / MIOPEN_DEBUG_NOGPU_BANDWIDTH_GBPS.
+/// Only the last MIOPEN_DEBUG_NOGPU_LAUNCH_LOG_SIZE launches are kept.
+///
+/// In the host execution mode (MIOPEN_DEBUG_NOGPU_HOST_EXECUTION) the device is reported as
+/// "cpu" and only host solvers, which compute the results on the CPU, are applicable. The other
+/// primitives are computed by the host:: functions (see host_primitives.hpp). Launches of
+/// kernels are errors then, as these would silently produce no results.
+///
+/// The device is shared by all the handles of the process. All the methods are MT-safe.
+class NullDevice
+{
+    public:
+    using TimeModel = std::function<float(const NullDeviceLaunch&)>;
+
+    static NullDevice& Get();
+
+    /// Zero-initialized host memory.
+    void* Allocate(std::size_t size);
+    void Deallocate(void* ptr);
+    std::size_t GetAllocatedSize() const;
+
+    /// Returns the duration assigned to the launch.
+    float Launch(const std::string& name,
+                 const std::array<std::size_t, 3>& ldims,
+                 const std::array<std::size_t, 3>& gdims,
+                 const void* args,
+                 std::size_t args_size);
+    /// Duration of the last launch done by the calling thread.
+    static float GetLastLaunchTime();
+
+    std::vector<NullDeviceLaunch> GetLaunches() const;
+    /// Counts all the launches, including the ones dropped from the log.
+    std::size_t GetLaunchCount() const;
+    void ClearLaunches();
+
+    /// Empty model restores the default one.
+    void SetTimeModel(TimeModel model);
+
+    bool IsHostExecution() const { return host_execution; }
+    void SetHostExecution(bool enable) { host_execution = enable; }
+
+    private:
+    NullDevice();
+
+    std::size_t GetReferencedBytes(const void* args, std::size_t args_size) const;
+
+    mutable std::mutex mutex;
+    std::map<const char*, std::size_t> allocations;
+    std::deque<NullDeviceLaunch> launches;
+    std::size_t launch_count = 0;
+    std::size_t log_size;
+    TimeModel time_model;
+    std::atomic<bool> host_execution;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_NULL_DEVICE_HPP_
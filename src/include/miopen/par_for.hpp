@@ -27,12 +27,10 @@
 #ifndef MIOPEN_GUARD_MLOPEN_PAR_FOR_HPP
 #define MIOPEN_GUARD_MLOPEN_PAR_FOR_HPP
 
+#include <miopen/thread_pool.hpp>
+
 #include <algorithm>
-#include <cassert>
-#include <cmath>
-#include <functional>
-#include <numeric>
-#include <vector>
+#include <cstddef>
 
 #ifdef __MINGW32__
 #include <mingw.thread.h>
@@ -59,26 +57,10 @@ struct joinable_thread : std::thread
     }
 };
 
-struct thread_factory
-{
-    template <class F>
-    joinable_thread operator()(std::size_t& work, std::size_t n, std::size_t grainsize, F f) const
-    {
-        auto result = joinable_thread([=] {
-            std::size_t start = work;
-            std::size_t last  = std::min(n, work + grainsize);
-            for(std::size_t i = start; i < last; i++)
-            {
-                f(i);
-            }
-        });
-        work += grainsize;
-        return result;
-    }
-};
-
+/// Runs the loop on the process-wide thread pool with at most threadsize threads, including the
+/// calling one.
 template <class F>
-void par_for_impl(std::size_t n, std::size_t threadsize, F f)
+void par_for_impl(std::size_t n, std::size_t threadsize, std::size_t grainsize, F f)
 {
     if(threadsize <= 1)
     {
@@ -87,14 +69,11 @@ void par_for_impl(std::size_t n, std::size_t threadsize, F f)
     }
     else
     {
-        std::vector<joinable_thread> threads(threadsize);
-        const std::size_t grainsize = std::ceil(static_cast<double>(n) / threads.size());
-
-        std::size_t work = 0;
-        std::generate(threads.begin(),
-                      threads.end(),
-                      std::bind(thread_factory{}, std::ref(work), n, grainsize, f));
-        assert(work >= n);
+        ThreadPool::Instance().ParallelFor(
+            n, threadsize, grainsize, [&](std::size_t start, std::size_t last) {
+                for(std::size_t i = start; i < last; i++)
+                    f(i);
+            });
     }
 }
 
@@ -103,7 +82,7 @@ void par_for(std::size_t n, std::size_t min_grain, F f)
 {
     const auto threadsize =
         std::min<std::size_t>(std::thread::hardware_concurrency(), n / min_grain);
-    par_for_impl(n, threadsize, f);
+    par_for_impl(n, threadsize, min_grain, f);
 }
 
 struct min_grain
@@ -115,7 +94,7 @@ template <class F>
 void par_for(std::size_t n, min_grain mg, F f)
 {
     const auto threadsize = std::min<std::size_t>(std::thread::hardware_concurrency(), n / mg.n);
-    par_for_impl(n, threadsize, f);
+    par_for_impl(n, threadsize, mg.n, f);
 }
 
 template <class F>
@@ -133,7 +112,7 @@ template <class F>
 void par_for(std::size_t n, max_threads mt, F f)
 {
     const auto threadsize = std::min<std::size_t>(std::thread::hardware_concurrency(), mt.n);
-    par_for_impl(n, std::min(threadsize, n), f);
+    par_for_impl(n, std::min(threadsize, n), 1, f);
 }
 
 } // namespace miopen
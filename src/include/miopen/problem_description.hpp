@@ -330,12 +330,7 @@ struct ProblemDescription
 
     int mloBuildConf_Key(std::string& conf_key) const;
 
-    NetworkConfig BuildConfKey() const
-    {
-        std::string ret;
-        mloBuildConf_Key(ret);
-        return NetworkConfig{ret};
-    }
+    NetworkConfig BuildConfKey() const { return conv_problem.BuildConfKey(); }
 };
 } // namespace miopen
 
@@ -26,51 +26,47 @@
 #ifndef MIOPEN_GUARD_MLOPEN_READONLYRAMDB_HPP
 #define MIOPEN_GUARD_MLOPEN_READONLYRAMDB_HPP
 
+#include <miopen/binary_db.hpp>
 #include <miopen/db_record.hpp>
 
 #include <boost/optional.hpp>
 
-#include <unordered_map>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <string>
-#include <sstream>
+#include <vector>
+
+namespace boost {
+namespace interprocess {
+class mapped_region;
+} // namespace interprocess
+} // namespace boost
 
 namespace miopen {
 
+/// Immutable in-memory copy of a system db.
+///
+/// The db is stored as a single buffer (or is not copied at all if embedded into the library)
+/// with a table of records sorted by key. Contents of a record are parsed on lookup.
+/// If a precompiled binary db (see BinaryDbView) matching the text one is available, it is
+/// used in place instead, so nothing is parsed at load.
 class ReadonlyRamDb
 {
     public:
-    ReadonlyRamDb(std::string path) : db_path(path) {}
+    ReadonlyRamDb(std::string path);
+    ~ReadonlyRamDb();
+    ReadonlyRamDb(const ReadonlyRamDb&) = delete;
+    ReadonlyRamDb& operator=(const ReadonlyRamDb&) = delete;
 
+    /// Instances are created once per path and live until the process exits. Only the first
+    /// call for a path takes a lock.
     static ReadonlyRamDb& GetCached(const std::string& path,
                                     bool warn_if_unreadable,
                                     const std::string& arch = "",
                                     std::size_t num_cu      = 0);
 
-    boost::optional<DbRecord> FindRecord(const std::string& problem) const
-    {
-        const auto it = cache.find(problem);
-
-        if(it == cache.end())
-            return boost::none;
-
-        auto record = DbRecord{problem};
-
-        if(!record.ParseContents(it->second.content))
-        {
-            MIOPEN_LOG_E("Error parsing payload under the key: " << problem << " form file "
-                                                                 << db_path
-                                                                 << "#"
-                                                                 << it->second.line);
-            MIOPEN_LOG_E("Contents: " << it->second.content);
-            return boost::none;
-        }
-        else
-        {
-            MIOPEN_LOG_I2("Looking for key " << problem << " in file " << db_path);
-        }
-
-        return record;
-    }
+    boost::optional<DbRecord> FindRecord(const std::string& problem) const;
 
     template <class TProblem>
     boost::optional<DbRecord> FindRecord(const TProblem& problem) const
@@ -79,6 +75,16 @@ class ReadonlyRamDb
         return FindRecord(key);
     }
 
+    template <class TProblem>
+    std::vector<boost::optional<DbRecord>> FindRecords(const std::vector<TProblem>& problems) const
+    {
+        auto records = std::vector<boost::optional<DbRecord>>{};
+        records.reserve(problems.size());
+        for(const auto& problem : problems)
+            records.push_back(FindRecord(problem));
+        return records;
+    }
+
     template <class TProblem, class TValue>
     bool Load(const TProblem& problem, const std::string& id, TValue& value) const
     {
@@ -89,23 +95,35 @@ class ReadonlyRamDb
     }
 
     private:
-    struct CacheItem
+    struct Entry
     {
-        int line;
-        std::string content;
+        std::size_t line_begin;
+        std::uint32_t key_size;
+        std::uint32_t contents_size;
+        int n_line;
     };
 
     std::string db_path;
-    std::unordered_map<std::string, CacheItem> cache;
+    std::string storage; // Contents of the file. Unused if the db is embedded.
+    const char* data = nullptr;
+    std::size_t size = 0;
+    std::vector<Entry> entries; // Sorted by key.
+    BinaryDbView binary;
+    std::unique_ptr<boost::interprocess::mapped_region> region; // Mapped binary db, if any.
+    ReadonlyRamDb* next = nullptr;
 
-    ReadonlyRamDb(const ReadonlyRamDb&) = default;
-    ReadonlyRamDb(ReadonlyRamDb&&)      = default;
-    ReadonlyRamDb& operator=(const ReadonlyRamDb&) = default;
-    ReadonlyRamDb& operator=(ReadonlyRamDb&&) = default;
+    static std::atomic<ReadonlyRamDb*>& Instances();
+    static ReadonlyRamDb* FindInstance(ReadonlyRamDb* head, const std::string& path);
 
     void Prefetch(const std::string& path, bool warn_if_unreadable);
-    void
-    ParseAndLoadDb(std::istream& input_stream, const std::string& path, bool warn_if_unreadable);
+    bool OpenBinary(const std::string& path);
+    bool IsBinaryActual(const std::string& path) const;
+    void Parse(const std::string& path);
+    int Compare(const Entry& entry, const char* key, std::size_t key_size) const;
+    boost::optional<DbRecord> MakeRecord(const std::string& problem,
+                                         const char* contents_begin,
+                                         const char* contents_end,
+                                         int n_line) const;
 };
 
 } // namespace miopen
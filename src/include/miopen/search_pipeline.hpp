@@ -0,0 +1,204 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_SEARCH_PIPELINE_HPP_
+#define GUARD_MIOPEN_SEARCH_PIPELINE_HPP_
+
+#include <miopen/par_for.hpp>
+
+#include <boost/optional.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+/// Two-stage producer/consumer loop over an input range.
+///
+/// prepare(value) is called by a pool of n_workers threads, which take values from the range
+/// one by one. consume(index, value, prepared) is called on the calling thread strictly in the
+/// order of the range, and returns false to stop the loop early. Workers are never more than
+/// lookahead values ahead of the consumer, so at most lookahead prepared values exist at a time.
+///
+/// Advancing the iterator is serialized, so the range is only required to be an input one.
+/// An exception thrown by prepare() is rethrown on the calling thread when the value would have
+/// been consumed. Workers are stopped if consume() throws.
+///
+/// With no workers or no look-ahead, both steps are done by the calling thread one by one.
+template <class Iterator, class Prepare, class Consume>
+void PipelinedForEach(Iterator begin,
+                      Iterator end,
+                      std::size_t n_workers,
+                      std::size_t lookahead,
+                      Prepare prepare,
+                      Consume consume)
+{
+    using Value    = typename std::iterator_traits<Iterator>::value_type;
+    using Prepared = decltype(prepare(std::declval<const Value&>()));
+
+    if(n_workers == 0 || lookahead == 0)
+    {
+        auto index = std::size_t{0};
+        for(auto it = begin; it != end; ++it)
+        {
+            const Value value = *it;
+            auto prepared     = prepare(value);
+            if(!consume(index++, value, prepared))
+                return;
+        }
+        return;
+    }
+
+    struct Slot
+    {
+        boost::optional<Value> value;
+        boost::optional<Prepared> prepared;
+        std::exception_ptr error;
+        bool ready = false;
+    };
+
+    std::mutex mutex;
+    std::condition_variable produced;
+    std::condition_variable consumed;
+    auto slots       = std::vector<Slot>(lookahead);
+    auto it          = begin;
+    auto n_taken     = std::size_t{0};
+    auto n_consumed  = std::size_t{0};
+    auto n_total     = std::size_t{0};
+    auto is_finished = false; // The range is exhausted, n_total is known.
+    auto is_stopped  = false;
+
+    const auto work = [&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        while(true)
+        {
+            consumed.wait(lock, [&]() {
+                return is_stopped || is_finished || n_taken < n_consumed + lookahead;
+            });
+
+            if(is_stopped || is_finished)
+                return;
+
+            if(it == end)
+            {
+                is_finished = true;
+                n_total     = n_taken;
+                produced.notify_all();
+                consumed.notify_all();
+                return;
+            }
+
+            const auto index = n_taken++;
+            const Value value = *it;
+            ++it;
+            lock.unlock();
+
+            auto prepared = boost::optional<Prepared>{};
+            auto error    = std::exception_ptr{};
+
+            try
+            {
+                prepared.emplace(prepare(value));
+            }
+            catch(...)
+            {
+                error = std::current_exception();
+            }
+
+            lock.lock();
+            auto& slot = slots[index % lookahead];
+            slot.value.emplace(value);
+            slot.prepared = std::move(prepared);
+            slot.error    = error;
+            slot.ready    = true;
+            produced.notify_all();
+        }
+    };
+
+    std::vector<joinable_thread> workers;
+
+    // Declared after the workers so they are stopped before being joined.
+    struct Stopper
+    {
+        std::mutex& mutex;
+        std::condition_variable& consumed;
+        bool& is_stopped;
+
+        ~Stopper()
+        {
+            {
+                const std::lock_guard<std::mutex> lock(mutex);
+                is_stopped = true;
+            }
+            consumed.notify_all();
+        }
+    } stopper{mutex, consumed, is_stopped};
+
+    for(auto i = std::size_t{0}; i < n_workers; ++i)
+        workers.emplace_back(work);
+
+    for(auto index = std::size_t{0};; ++index)
+    {
+        auto value    = boost::optional<Value>{};
+        auto prepared = boost::optional<Prepared>{};
+        auto error    = std::exception_ptr{};
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            auto& slot = slots[index % lookahead];
+            produced.wait(lock, [&]() { return slot.ready || (is_finished && index >= n_total); });
+
+            if(!slot.ready)
+                return;
+
+            value    = std::move(slot.value);
+            prepared = std::move(slot.prepared);
+            error    = slot.error;
+            slot     = Slot{};
+        }
+
+        if(error)
+            std::rethrow_exception(error);
+
+        if(!consume(index, *value, *prepared))
+            return;
+
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+            ++n_consumed;
+        }
+        consumed.notify_all();
+    }
+}
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SEARCH_PIPELINE_HPP_
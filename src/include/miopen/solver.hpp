@@ -116,6 +116,10 @@ struct SolverBase
     /// run-time parameters.
     bool IsDynamic() const { return false; }
 
+    /// Host solvers compute the results on the CPU instead of launching kernels. These are only
+    /// applicable in the host execution mode of the null device, see NullDevice.
+    bool IsHost() const { return false; }
+
     // Returns the workspace size required by the solver for a given ConvolutionContext
     size_t GetWorkspaceSize(const Context&) const { return 0; };
 
@@ -1878,6 +1882,15 @@ struct fft : SolverBase<ConvolutionContext>
     ConvSolution GetSolution(const ConvolutionContext& ctx) const;
 };
 
+/// Direct convolution of fp32 NCHW and NCDHW tensors in all directions, computed on the CPU.
+struct ConvDirectHost : SolverBase<ConvolutionContext>
+{
+    bool IsApplicable(const ConvolutionContext& ctx) const;
+    bool IsDynamic() const { return true; }
+    bool IsHost() const { return true; }
+    ConvSolution GetSolution(const ConvolutionContext& ctx) const;
+};
+
 /// Partial implementation.
 struct gemm : SolverBase<ConvolutionContext>
 {
@@ -0,0 +1,160 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_SOLVER_MEMO_HPP_
+#define GUARD_MIOPEN_SOLVER_MEMO_HPP_
+
+#include <miopen/conv_solution.hpp>
+#include <miopen/env.hpp>
+#include <miopen/statistics.hpp>
+
+#include <boost/optional.hpp>
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace miopen {
+
+struct ConvolutionContext;
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_SOLVER_MEMO_SIZE)
+
+namespace solver {
+
+/// Process-wide MT-safe LRU memo of IsApplicable(), GetWorkspaceSize() and the solutions of
+/// solvers, keyed by a problem key (see GetSolverMemoKey) and a solver id.
+///
+/// The key covers the problem, the device and the execution context. The whole memo is dropped
+/// on Invalidate(), e.g. after auto-tuning, which changes the perf-db. MIOPEN_* environment
+/// variables are read once by solvers, so their later changes need not be tracked.
+class SolverMemo
+{
+    public:
+    static SolverMemo& Instance();
+
+    bool IsEnabled() const { return capacity > 0; }
+
+    /// Drops all the entries. Values being computed concurrently are not stored.
+    void Invalidate();
+
+    /// Each of the following returns the memoized value or stores and returns the result of
+    /// compute(). An empty key disables memoization.
+    template <class F>
+    bool IsApplicable(const std::string& key, const std::string& solver_id, F&& compute)
+    {
+        return Memoize(key, solver_id, &Entry::is_applicable, compute);
+    }
+
+    template <class F>
+    std::size_t GetWorkspaceSize(const std::string& key, const std::string& solver_id, F&& compute)
+    {
+        return Memoize(key, solver_id, &Entry::workspace_size, compute);
+    }
+
+    template <class F>
+    ConvSolution GetSolution(const std::string& key, const std::string& solver_id, F&& compute)
+    {
+        return Memoize(key, solver_id, &Entry::solution, compute);
+    }
+
+    private:
+    struct Entry
+    {
+        std::string key;
+        boost::optional<bool> is_applicable;
+        boost::optional<std::size_t> workspace_size;
+        boost::optional<ConvSolution> solution;
+    };
+
+    using Lru = std::list<Entry>;
+
+    std::size_t capacity;
+    std::mutex mutex;
+    std::uint64_t epoch = 0;
+    Lru lru;
+    std::unordered_map<std::string, Lru::iterator> entries;
+
+    SolverMemo(std::size_t capacity_);
+
+    static StatCounter& Hits();
+    static StatCounter& Misses();
+
+    /// Returns the entry for the key, which becomes the most recently used one, or nullptr.
+    Entry* FindUnsafe(const std::string& entry_key);
+    /// Returns the existing or a new entry for the key and evicts the least recently used ones.
+    Entry& InsertUnsafe(const std::string& entry_key);
+
+    template <class T, class F>
+    T Memoize(const std::string& key,
+              const std::string& solver_id,
+              boost::optional<T> Entry::*field,
+              F& compute)
+    {
+        if(key.empty() || !IsEnabled())
+            return compute();
+
+        const auto entry_key = key + '\0' + solver_id;
+        auto computed_at     = std::uint64_t{0};
+
+        {
+            const std::lock_guard<std::mutex> lock{mutex};
+            const auto entry = FindUnsafe(entry_key);
+            if(entry != nullptr && entry->*field)
+            {
+                ++Hits();
+                return *(entry->*field);
+            }
+            computed_at = epoch;
+        }
+
+        ++Misses();
+        // Solvers may be slow to answer and may use the memo themselves, so the lock is released.
+        T value = compute();
+
+        const std::lock_guard<std::mutex> lock{mutex};
+        if(computed_at == epoch)
+            InsertUnsafe(entry_key).*field = value;
+        return value;
+    }
+};
+
+/// Contexts other than the convolution one are not memoized.
+template <class Context>
+std::string GetSolverMemoKey(const Context&)
+{
+    return {};
+}
+
+/// Problem and execution context part of the memo key. Serializes the context, so this shall be
+/// called once per query, not per solver.
+std::string GetSolverMemoKey(const ConvolutionContext& ctx);
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SOLVER_MEMO_HPP_
@@ -0,0 +1,171 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_SOLVER_RANKING_HPP_
+#define GUARD_MIOPEN_SOLVER_RANKING_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+/// Problem as seen by the solver ranking model. Parsed from the db key (see
+/// conv::ProblemDescription::Serialize), so the model is trained from find-db records and queried
+/// with exactly the same representation.
+struct SolverRankingProblem
+{
+    static constexpr std::size_t feature_count = 22;
+
+    /// Layouts, data types, direction, number of spatial dims and group mode. Problems of
+    /// different categories are never compared.
+    std::string category;
+    /// log2(1 + x) of the sizes, pads, strides, dilations and group count.
+    std::array<float, feature_count> features;
+    /// Arithmetic work of the direct convolution. Times are scaled by it between neighbours.
+    double flops;
+};
+
+/// Returns false if the key has unknown format.
+bool ParseSolverRankingProblem(const std::string& db_key, SolverRankingProblem& problem);
+
+/// Find-db record: measured times (ms) of solvers for a problem.
+struct SolverRankingSample
+{
+    std::string db_key;
+    std::vector<std::pair<std::string, float>> times;
+};
+
+/// Parses text find-db records ("key=algo:solver,time,workspace,...;..."). Lines which are not
+/// find-db records are counted in ill_formed.
+std::vector<SolverRankingSample> ParseSolverRankingSamples(const std::string& text,
+                                                           std::size_t& ill_formed);
+
+struct RankedSolver
+{
+    std::string solver; // Solver id string, e.g. "ConvBinWinogradRxSf3x2".
+    float time;         // Estimated time, ms.
+};
+
+/// Ranks solvers for problems which are missing from the find-db, so immediate mode on a find-db
+/// miss is not limited to GEMM.
+///
+/// This is a weighted k-nearest-neighbours regression of log(time / flops) of every solver over
+/// the problems of the find-db the model has been trained from, among the problems of the same
+/// category. The estimated time of a solver is the weighted mean over the neighbours it has been
+/// measured on, scaled by the flops of the problem, so an exact match returns the measured times.
+///
+/// The model is trained by the solverrank tool at build time and is used from a file next to the
+/// system find-db or from data embedded into the library. Serialized layout (host byte order,
+/// checked on load): header, solver and category names, categories, samples with quantized
+/// features, per-sample solver times.
+///
+/// This file does not depend on the rest of the library, so it is also built into the solverrank
+/// tool.
+class SolverRankingModel
+{
+    public:
+    static constexpr std::size_t default_neighbours = 8;
+
+    static SolverRankingModel Train(const std::vector<SolverRankingSample>& samples);
+
+    /// Returns false and leaves the model empty if the data is not a model of the supported
+    /// version.
+    bool Load(const char* data, std::size_t size);
+    void Save(std::ostream& stream) const;
+
+    bool IsEmpty() const { return samples.empty(); }
+    std::size_t GetSampleCount() const { return samples.size(); }
+
+    /// Solvers measured on the nearest problems, fastest first. Applicability is not checked.
+    std::vector<RankedSolver> Rank(const SolverRankingProblem& problem,
+                                   std::size_t neighbours = default_neighbours) const;
+    std::vector<RankedSolver> Rank(const std::string& db_key,
+                                   std::size_t neighbours = default_neighbours) const;
+
+    private:
+    struct Category
+    {
+        std::uint32_t first_sample;
+        std::uint32_t sample_count;
+    };
+
+    struct Sample
+    {
+        std::array<std::int16_t, SolverRankingProblem::feature_count> features;
+        std::uint32_t first_entry;
+        std::uint32_t entry_count;
+    };
+
+    struct Entry
+    {
+        std::uint32_t solver;
+        float log2_time_per_flop;
+    };
+
+    std::vector<std::string> solvers;
+    std::vector<std::string> category_names; // Sorted.
+    std::vector<Category> categories;
+    std::vector<Sample> samples;
+    std::vector<Entry> entries;
+};
+
+/// Accuracy of the model on the find-db records held out from training. Only the solvers present
+/// in a held-out record are considered, as the record lists the solvers applicable to it.
+struct SolverRankingAccuracy
+{
+    std::size_t train_samples = 0;
+    std::size_t test_samples  = 0;
+    std::size_t unranked      = 0; // Test samples for which none of the recorded solvers is ranked.
+    std::size_t top1          = 0; // The fastest recorded solver is ranked first.
+    std::size_t top3          = 0; // The fastest recorded solver is among the first three.
+    double slowdown           = 1; // Geometric mean of time(first ranked) / time(fastest).
+    std::size_t gemm_samples  = 0; // Test samples GEMM has been recorded for.
+    double gemm_slowdown      = 1; // Geometric mean of time(GEMM) / time(fastest).
+};
+
+/// Holds out the records whose key hashes to below holdout_percent out of 100, trains the model
+/// on the rest and evaluates it. The split is stable between runs and platforms.
+SolverRankingAccuracy EvaluateSolverRanking(const std::vector<SolverRankingSample>& samples,
+                                            unsigned holdout_percent,
+                                            std::size_t neighbours);
+
+/// Name of the model trained from the find-db with the given name: .fdb.txt extension is
+/// replaced by .rank.bin.
+std::string GetSolverRankingPath(const std::string& find_db_path);
+
+/// The model trained from the system find-db of the device. Empty if there is none. Loaded once
+/// per find-db. Defined in the library only.
+const SolverRankingModel& GetSystemSolverRanking(Handle& handle);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SOLVER_RANKING_HPP_
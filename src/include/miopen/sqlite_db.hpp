@@ -30,8 +30,10 @@
 #if MIOPEN_ENABLE_SQLITE
 
 #include <miopen/db_record.hpp>
+#include <miopen/db_record_cache.hpp>
 #include <miopen/manage_ptr.hpp>
 #include <miopen/errors.hpp>
+#include <miopen/statistics.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/lock_file.hpp>
 
@@ -45,8 +47,16 @@
 #include <thread>
 
 #include <string>
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <tuple>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace boost {
 namespace filesystem {
@@ -158,7 +168,7 @@ class SQLite
 {
     class impl;
     // do we need propagate const
-    std::unique_ptr<impl> pImpl;
+    std::shared_ptr<impl> pImpl;
 
     public:
     class Statement
@@ -195,6 +205,16 @@ class SQLite
     bool Valid() const;
     result_type Exec(const std::string& query) const;
     int Changes() const;
+    /// The connection is shared by all the SQLite objects of the same file in the process.
+    std::uint64_t ConnectionId() const;
+    /// Number of rows changed through this connection since it has been opened.
+    std::int64_t TotalChanges() const;
+    /// Changes whenever another connection commits to the database. Changes made through this
+    /// connection do not affect it.
+    std::int64_t DataVersion() const;
+    /// Explicit transactions of the threads sharing the connection shall not overlap, so they are
+    /// done while holding this lock.
+    std::unique_lock<std::mutex> LockTransaction() const;
     int Retry(std::function<int()>) const;
     static int Retry(std::function<int()> f, std::string filename);
     std::string ErrorMessage() const;
@@ -295,6 +315,49 @@ class SQLiteBase
         return reinterpret_cast<Derived*>(this)->FindRecordUnsafe(args...);
     }
 
+    /// Searches db for all the provided keys at once and returns the results in the same order.
+    /// Lookups are done in one read transaction with the same prepared statement, which is much
+    /// cheaper than separate FindRecord() calls for a large number of keys.
+    template <class T>
+    inline auto FindRecords(const std::vector<T>& problem_configs)
+    {
+        const auto derived = reinterpret_cast<Derived*>(this);
+        using Record       = decltype(derived->FindRecordUnsafe(std::declval<const T&>()));
+        auto records       = std::vector<Record>{};
+        records.reserve(problem_configs.size());
+
+        const auto use_transaction = !dbInvalid && problem_configs.size() > 1;
+        auto transaction_lock      = std::unique_lock<std::mutex>{};
+
+        if(use_transaction)
+        {
+            transaction_lock = sql.LockTransaction();
+            sql.Exec("BEGIN;");
+        }
+
+        try
+        {
+            for(const auto& problem_config : problem_configs)
+                records.push_back(derived->FindRecordUnsafe(problem_config));
+        }
+        catch(...)
+        {
+            if(use_transaction)
+                sql.Exec("ROLLBACK;");
+            throw;
+        }
+
+        if(use_transaction)
+            sql.Exec("COMMIT;");
+        return records;
+    }
+
+    template <typename... U>
+    inline auto FindSimilarRecords(const U&... args)
+    {
+        return reinterpret_cast<Derived*>(this)->FindSimilarRecordsUnsafe(args...);
+    }
+
     template <typename... U>
     inline auto RemoveRecord(U&... args)
     {
@@ -338,11 +401,12 @@ Derived& SQLiteBase<Derived>::GetCached(const std::string& path,
                                         const std::string& arch,
                                         const size_t num_cu)
 {
-    static std::mutex mutex;
+    // Never destroyed: the connections are used by the writes performed at process exit.
+    static auto& mutex = *new std::mutex{};
     std::lock_guard<std::mutex> lock{mutex};
 
-    static auto instances = std::map<std::string, Derived>{};
-    const auto it         = instances.find(path);
+    static auto& instances = *new std::map<std::string, Derived>{};
+    const auto it          = instances.find(path);
 
     if(it != instances.end())
         return it->second;
@@ -398,9 +462,25 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
     {
         if(dbInvalid)
             return boost::none;
+
+        static auto& hits   = Statistics::Counter("sqlite_perf_db.hits");
+        static auto& misses = Statistics::Counter("sqlite_perf_db.misses");
+        static auto& time   = Statistics::Histogram("sqlite_perf_db.find");
+        const StatTimer timer{time};
+
         std::string clause;
         std::vector<std::string> values;
         std::tie(clause, values) = problem_config.WhereClause();
+        auto& cache          = RecordCache::Instance();
+        const auto cache_key = CacheKey(problem_config, values);
+        const auto version   = GetCacheGeneration();
+        auto cached          = boost::optional<DbRecord>{};
+        if(cache.Find(filename, cache_key, version, cached))
+        {
+            ++(cached ? hits : misses);
+            return cached;
+        }
+
         // clang-format off
         auto select_query =
             "SELECT solver, params "
@@ -424,10 +504,100 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
             else if(rc == SQLITE_ERROR || rc == SQLITE_MISUSE)
                 MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
         }
-        if(rec.GetSize() == 0)
-            return boost::none;
-        else
-            return boost::optional<DbRecord>(rec);
+        const auto found = rec.GetSize() == 0 ? boost::none : boost::optional<DbRecord>(rec);
+        cache.Store(filename, cache_key, version, found);
+        ++(found ? hits : misses);
+        return found;
+    }
+
+    /// Searches for configs of the problems closest to PROBLEM_CONFIG which have values under
+    /// the ID, see SimilarDbRecord. Layout, data type, direction, spatial dimensions and bias of
+    /// the problems shall match, which is the prefix of the config table index, and both or
+    /// none of the problems shall be grouped. The rest of the fields contribute to the distance.
+    ///
+    /// Returns at most LIMIT records not farther than MAX_DISTANCE, closest first. Keys of the
+    /// records list the fields of the problems and are meant for logging only.
+    template <class T>
+    inline std::vector<SimilarDbRecord> FindSimilarRecordsUnsafe(const T& problem_config,
+                                                                 const std::string& id,
+                                                                 std::size_t limit,
+                                                                 float max_distance)
+    {
+        auto records = std::vector<SimilarDbRecord>{};
+        if(dbInvalid || limit == 0)
+            return records;
+
+        static auto& time = Statistics::Histogram("sqlite_perf_db.find_similar");
+        const StatTimer timer{time};
+
+        std::vector<std::string> clauses;
+        std::vector<std::string> values;
+        std::vector<std::string> names;
+        std::vector<float> features;
+        T::Visit(problem_config, [&](const std::string& value, const std::string& name) {
+            clauses.push_back("(" + name + " = ? )");
+            values.push_back(value);
+        });
+        T::Visit(problem_config, [&](const int value, const std::string& name) {
+            if(name == "spatial_dim" || name == "bias")
+            {
+                clauses.push_back("(" + name + " = ? )");
+                values.push_back(std::to_string(value));
+                return;
+            }
+            if(name == "group_count")
+                clauses.push_back(value == 1 ? "(group_count = 1 )" : "(group_count > 1 )");
+            names.push_back(name);
+            features.push_back(static_cast<float>(std::log2(1.0 + value)));
+        });
+        values.push_back(id);
+
+        // clang-format off
+        auto select_query =
+            "SELECT params, " + JoinStrings(names, ", ") + " "
+            "FROM perf_db "
+            "INNER JOIN " + problem_config.table_name() + " "
+            "ON perf_db.config = " + problem_config.table_name() +".id "
+            "WHERE "
+            "( " + JoinStrings(clauses, " AND ") + " )"
+            "AND (solver = ? ) "
+            "AND (arch = '" + arch + "' ) "
+            "AND (num_cu = '" + std::to_string(num_cu) + "');";
+        // clang-format on
+        auto stmt = SQLite::Statement{sql, select_query, values};
+        while(true)
+        {
+            auto rc = stmt.Step(sql);
+            if(rc == SQLITE_DONE)
+                break;
+            else if(rc == SQLITE_ERROR || rc == SQLITE_MISUSE)
+                MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+            else if(rc != SQLITE_ROW)
+                continue;
+
+            auto distance = 0.f;
+            std::ostringstream key;
+            for(auto i = std::size_t{0}; i < names.size(); ++i)
+            {
+                const auto value = stmt.ColumnInt64(static_cast<int>(i) + 1);
+                distance += std::abs(static_cast<float>(std::log2(1.0 + value)) - features[i]);
+                key << (i == 0 ? "" : ",") << names[i] << "=" << value;
+            }
+
+            if(distance > max_distance)
+                continue;
+
+            DbRecord record(key.str());
+            record.SetValues(id, stmt.ColumnText(0));
+            records.push_back({distance, std::move(record)});
+        }
+
+        std::stable_sort(records.begin(), records.end(), [](const auto& l, const auto& r) {
+            return l.distance < r.distance;
+        });
+        if(records.size() > limit)
+            records.erase(records.begin() + limit, records.end());
+        return records;
     }
 
     /// Removes ID with associated VALUES from record with key PROBLEM_CONFIG from db.
@@ -448,12 +618,22 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
             "WHERE config IN ("
             "SELECT id FROM config WHERE ( "
             + clause + " ) )"
-            "AND solver == '" +  id + "' ;";
+            "AND solver == ? ;";
         // clang-format on
-        auto stmt = SQLite::Statement{sql, query, values};
-        auto rc   = stmt.Step(sql);
+        const auto cache_key = CacheKey(problem_config, values);
+        values.push_back(id);
+        const auto before = GetCacheGeneration();
+        auto stmt         = SQLite::Statement{sql, query, values};
+        auto rc           = stmt.Step(sql);
         if(rc == SQLITE_DONE)
+        {
+            const auto erase = [&](boost::optional<DbRecord>& record) {
+                if(record && record->EraseValues(id) && record->GetSize() == 0)
+                    record = boost::none;
+            };
+            ModifyCached(cache_key, before, erase);
             return true;
+        }
         else
         {
             std::string msg = "Unable to remove database entry: ";
@@ -491,6 +671,7 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
             std::string clause;
             std::vector<std::string> vals;
             std::tie(clause, vals) = problem_config.WhereClause();
+            const auto cache_key   = CacheKey(problem_config, vals);
 
             // clang-format off
             std::string query =
@@ -504,14 +685,20 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
             vals.push_back(params.str());
             vals.push_back(arch);
             vals.push_back(std::to_string(num_cu));
-            auto stmt = SQLite::Statement{sql, query, vals};
-            auto rc   = stmt.Step(sql);
+            const auto before = GetCacheGeneration();
+            auto stmt         = SQLite::Statement{sql, query, vals};
+            auto rc           = stmt.Step(sql);
             if(rc != SQLITE_DONE)
             {
                 MIOPEN_LOG_E("Failed to insert performance record in the database: " +
                              sql.ErrorMessage());
                 return boost::none;
             }
+            ModifyCached(cache_key, before, [&](boost::optional<DbRecord>& cached) {
+                if(!cached)
+                    cached = DbRecord{};
+                cached->SetValues(id, params.str());
+            });
         }
         DbRecord record;
         record.SetValues(id, values);
@@ -544,15 +731,21 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
             "SELECT id FROM config WHERE ( "
             + clause + " ))";
         // clang-format on
-        auto stmt = SQLite::Statement{sql, query, values};
-        auto rc   = stmt.Step(sql);
+        const auto before = GetCacheGeneration();
+        auto stmt         = SQLite::Statement{sql, query, values};
+        auto rc           = stmt.Step(sql);
         if(rc != SQLITE_DONE)
         {
             MIOPEN_LOG_E("Unable to Clear databaes entry: " + sql.ErrorMessage());
             return false;
         }
         else
+        {
+            ModifyCached(CacheKey(problem_config, values),
+                         before,
+                         [](boost::optional<DbRecord>& record) { record = boost::none; });
             return true;
+        }
     }
 
     /// Searches for record with key PROBLEM_CONFIG and gets VALUES under the ID from it.
@@ -572,6 +765,46 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
             return false;
         return record->GetValues(id, values);
     }
+
+    private:
+    /// Connection id, data_version and total changes of the connection. The connection is shared
+    /// by the dbs of the same file (see SQLite), so they share the cached records too. The
+    /// data_version tracks commits of other connections, e.g. of other processes, and the total
+    /// changes track changes made through this one.
+    using CacheGeneration = std::tuple<std::uint64_t, std::int64_t, std::int64_t>;
+    using RecordCache     = DbRecordCache<CacheGeneration>;
+
+    CacheGeneration GetCacheGeneration() const
+    {
+        if(!RecordCache::Instance().IsEnabled())
+            return {};
+        return CacheGeneration{sql.ConnectionId(), sql.DataVersion(), sql.TotalChanges()};
+    }
+
+    template <class T>
+    static std::string CacheKey(const T& problem_config, const std::vector<std::string>& values)
+    {
+        return problem_config.table_name() + ":" + JoinStrings(values, ",");
+    }
+
+    /// Applies a change made through this connection to the cached record, if any.
+    template <class TModifier>
+    void ModifyCached(const std::string& cache_key,
+                      const CacheGeneration& before,
+                      TModifier&& modifier)
+    {
+        auto& cache = RecordCache::Instance();
+        if(!cache.IsEnabled())
+            return;
+
+        const auto after = GetCacheGeneration();
+
+        // Another connection has committed meanwhile, so other records might have changed too.
+        if(std::get<1>(after) != std::get<1>(before))
+            cache.Invalidate(filename);
+        else
+            cache.Modify(filename, cache_key, before, after, modifier);
+    }
 };
 } // namespace miopen
 #endif
@@ -0,0 +1,102 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_STATISTICS_HPP_
+#define GUARD_MIOPEN_STATISTICS_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
+#include <string>
+
+namespace miopen {
+
+using StatCounter = std::atomic<std::uint64_t>;
+
+/// MT-safe distribution of durations.
+class StatHistogram
+{
+    public:
+    /// Bucket i counts durations in [2^(i-1), 2^i) us, bucket 0 counts durations below 1 us and
+    /// the last one counts all the longer durations.
+    static constexpr std::size_t BucketCount = 32;
+
+    void Add(std::chrono::nanoseconds duration);
+    void Reset();
+    void Write(std::ostream& os) const;
+
+    private:
+    std::atomic<std::uint64_t> count{0};
+    std::atomic<std::uint64_t> total_ns{0};
+    std::atomic<std::uint64_t> min_ns{std::numeric_limits<std::uint64_t>::max()};
+    std::atomic<std::uint64_t> max_ns{0};
+    std::array<std::atomic<std::uint64_t>, BucketCount> buckets{};
+};
+
+/// Process-wide registry of named counters and histograms: cache hits and misses, time spent in
+/// db lookups, kernel compilation, etc. Updates take no locks, so the hot paths shall keep the
+/// references, e.g. in function-local statics, instead of looking them up by name each time.
+class Statistics
+{
+    public:
+    /// Registers the counter on first use. The reference is valid until process exit.
+    static StatCounter& Counter(const std::string& name);
+    /// Registers the histogram on first use. The reference is valid until process exit.
+    static StatHistogram& Histogram(const std::string& name);
+
+    /// JSON object of the form
+    /// {"counters":{"<name>":<value>,...},
+    ///  "histograms":{"<name>":{"count":<n>,"total_ns":<t>,"min_ns":<t>,"max_ns":<t>,
+    ///                          "buckets":[<n>,...]},...}}
+    static std::string Snapshot();
+    /// Zeroes all the counters and histograms. Updates concurrent with the reset may be lost.
+    static void Reset();
+};
+
+/// Adds the lifetime of the object to the histogram.
+class StatTimer
+{
+    public:
+    StatTimer(StatHistogram& histogram_)
+        : histogram(histogram_), start(std::chrono::steady_clock::now())
+    {
+    }
+
+    StatTimer(const StatTimer&) = delete;
+    StatTimer& operator=(const StatTimer&) = delete;
+
+    ~StatTimer() { histogram.Add(std::chrono::steady_clock::now() - start); }
+
+    private:
+    StatHistogram& histogram;
+    std::chrono::steady_clock::time_point start;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_STATISTICS_HPP_
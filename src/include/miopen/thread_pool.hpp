@@ -0,0 +1,102 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_THREAD_POOL_HPP_
+#define GUARD_MIOPEN_THREAD_POOL_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+
+/// Work-stealing pool of threads for parallel loops.
+///
+/// Each worker has its own queue of tasks. It runs the latest tasks of its own queue first and
+/// steals the oldest tasks of other queues when its own one is empty. Threads which are not
+/// workers of the pool push tasks to a shared queue.
+///
+/// A parallel loop is run by the calling thread together with helper tasks queued to the pool.
+/// Participants take chunks of the iteration space from a shared counter, so the threads which
+/// got cheap iterations take more of them. The calling thread runs queued tasks while waiting for
+/// the other participants, so loops may be nested, e.g. called from an iteration of another loop.
+class ThreadPool
+{
+    public:
+    /// Lazily created process-wide pool of MIOPEN_DEBUG_THREAD_POOL_SIZE workers, by default one
+    /// less than the number of hardware threads (the calling thread participates in loops).
+    static ThreadPool& Instance();
+
+    ThreadPool(std::size_t n_workers);
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ~ThreadPool();
+
+    std::size_t GetWorkerCount() const { return workers.size(); }
+
+    /// Calls f(begin, end) for disjoint ranges which cover [0, n) by at most max_parallelism
+    /// threads including the calling one. Ranges are not shorter than min_grain, except the last
+    /// one. Returns when all the calls have returned. If a call throws, the ranges which have not
+    /// been started yet are skipped and the first exception is rethrown.
+    void ParallelFor(std::size_t n,
+                     std::size_t max_parallelism,
+                     std::size_t min_grain,
+                     const std::function<void(std::size_t, std::size_t)>& f);
+
+    private:
+    using Task = std::function<void()>;
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    struct Loop;
+
+    std::vector<std::unique_ptr<Queue>> queues; // One per worker and the shared one.
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::atomic<std::size_t> n_queued{0};
+    bool is_stopped = false;
+
+    /// Index of the queue of the calling thread.
+    std::size_t GetQueueIndex() const;
+    void Push(Task task);
+    /// Runs one queued task, if any.
+    bool TryRun(std::size_t queue_index);
+    void Work(std::size_t index);
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_THREAD_POOL_HPP_
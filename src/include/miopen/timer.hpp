@@ -27,6 +27,7 @@
 #define GUARD_MIOPEN_TIMER_HPP_
 
 #include <miopen/logger.hpp>
+#include <miopen/statistics.hpp>
 #include <chrono>
 
 namespace miopen {
@@ -54,6 +55,9 @@ class CompileTimer
 #if MIOPEN_BUILD_DEV
     Timer timer;
 #endif
+    trace::Span span{"compile", "Compile"};
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
     public:
     CompileTimer()
     {
@@ -63,6 +67,12 @@ class CompileTimer
     }
     void Log(const std::string& s1, const std::string& s2 = {})
     {
+        Statistics::Histogram("compile." + s1).Add(std::chrono::steady_clock::now() - start);
+        if(span.IsActive())
+        {
+            span.SetDetail(s1 + (s2.empty() ? "" : " ") + s2);
+            span.End();
+        }
 #if MIOPEN_BUILD_DEV
         MIOPEN_LOG_I2(
             s1 << (s2.empty() ? "" : " ") << s2 << " Compile Time, ms: " << timer.elapsed_ms());
@@ -0,0 +1,123 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TRACE_HPP_
+#define GUARD_MIOPEN_TRACE_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <utility>
+
+namespace miopen {
+namespace trace {
+
+/// Timeline of library-internal spans (API calls, db lookups, solver queries, kernel compilation,
+/// cache accesses, invoker runs) in the Chrome trace event format, which can be opened with
+/// chrome://tracing or https://ui.perfetto.dev.
+///
+/// Enabled by MIOPEN_TRACE_FILE=<path>, the trace is written to the file at process exit. Each
+/// thread records into its own ring buffer of MIOPEN_TRACE_BUFFER_SIZE events, so the oldest
+/// events of a thread are dropped once the buffer is full. When tracing is disabled, a span costs
+/// one relaxed atomic load.
+
+namespace detail {
+extern std::atomic<bool> enabled;
+std::uint64_t Now();
+void Record(const char* category, const char* name, std::string detail, std::uint64_t begin);
+} // namespace detail
+
+inline bool IsEnabled() { return detail::enabled.load(std::memory_order_relaxed); }
+
+/// Overrides the environment. Spans which are already open are not affected.
+void SetEnabled(bool enabled);
+
+/// Writes the events recorded so far. Does not remove them.
+void Write(std::ostream& os);
+/// Returns false if the file cannot be written.
+bool Write(const std::string& path);
+
+/// Removes all the recorded events.
+void Clear();
+
+/// Scoped span. Category and name shall be string literals or have static storage duration.
+class Span
+{
+    public:
+    Span(const char* category_, const char* name_)
+        : category(category_), name(name_), active(IsEnabled())
+    {
+        if(active)
+            begin = detail::Now();
+    }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+    ~Span() { End(); }
+
+    bool IsActive() const { return active; }
+
+    /// Shown as an argument of the event, e.g. a solver id or a kernel name.
+    void SetDetail(std::string detail_)
+    {
+        if(IsActive())
+            detail = std::move(detail_);
+    }
+
+    void End()
+    {
+        if(!IsActive())
+            return;
+        active = false;
+        detail::Record(category, name, std::move(detail), begin);
+    }
+
+    private:
+    const char* category;
+    const char* name;
+    bool active;
+    std::uint64_t begin = 0;
+    std::string detail;
+};
+
+} // namespace trace
+} // namespace miopen
+
+#define MIOPEN_TRACE_SPAN_NAME(line) MIOPEN_TRACE_SPAN_NAME_CAT(miopen_trace_span_, line)
+#define MIOPEN_TRACE_SPAN_NAME_CAT(x, line) x##line
+
+/// Opens a span which ends at the end of the enclosing scope.
+#define MIOPEN_TRACE_SPAN(category, name) \
+    const miopen::trace::Span MIOPEN_TRACE_SPAN_NAME(__LINE__) { category, name }
+
+/// Same as MIOPEN_TRACE_SPAN. The detail expression is evaluated only when tracing is enabled.
+#define MIOPEN_TRACE_SPAN_DETAIL(category, name, detail)                  \
+    miopen::trace::Span MIOPEN_TRACE_SPAN_NAME(__LINE__){category, name}; \
+    if(MIOPEN_TRACE_SPAN_NAME(__LINE__).IsActive())                       \
+    MIOPEN_TRACE_SPAN_NAME(__LINE__).SetDetail(detail)
+
+#endif // GUARD_MIOPEN_TRACE_HPP_
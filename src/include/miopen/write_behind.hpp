@@ -0,0 +1,133 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_WRITE_BEHIND_HPP_
+#define GUARD_MIOPEN_WRITE_BEHIND_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+
+/// Background writer of db records (perf-db, find-db, kernel cache), which takes file locks and
+/// disk writes off the threads which produce the records.
+///
+/// Writes are queued per target (a db file) and key (a record). A worker thread performs all the
+/// pending writes of a target at once, optionally within a batch, e.g. one transaction, when the
+/// oldest write has been pending for a while, when too many writes are pending, on Flush() and at
+/// process exit.
+///
+/// Readers shall call Flush(target, key) before reading a record, which performs the pending
+/// writes of the record, if any, on the calling thread. Writes of other records do not block it.
+class WriteBehindQueue
+{
+    public:
+    using Write = std::function<void()>;
+    /// Calls the given function which performs the pending writes to a target.
+    using Batch = std::function<void(const std::function<void()>&)>;
+
+    /// How a write is combined with pending writes of the same record.
+    enum class Coalesce
+    {
+        Replace, // The record is overwritten as a whole, so pending writes are dropped.
+        Append,  // The write updates a part of the record, so all the writes are performed.
+    };
+
+    struct Options
+    {
+        bool enabled;
+        std::chrono::milliseconds delay;
+        std::size_t max_pending;
+    };
+
+    /// Configured by MIOPEN_DEBUG_WRITE_BEHIND* environment variables. Flushed at process exit.
+    /// Starts empty in a child process created by fork(), the parent performs its pending writes.
+    static WriteBehindQueue& Instance();
+
+    WriteBehindQueue(const Options& options_);
+    WriteBehindQueue(const WriteBehindQueue&) = delete;
+    WriteBehindQueue& operator=(const WriteBehindQueue&) = delete;
+    /// Performs all the pending writes.
+    ~WriteBehindQueue();
+
+    bool IsEnabled() const { return options.enabled; }
+
+    /// Performs the write on the calling thread if the queue is disabled. Otherwise, errors of the
+    /// write are logged. The batch is used for all the writes of the target.
+    void Push(const std::string& target,
+              const std::string& key,
+              Write write,
+              Coalesce coalesce = Coalesce::Replace,
+              Batch batch       = {});
+
+    /// Returns when the writes of the record pushed before are completed.
+    void Flush(const std::string& target, const std::string& key);
+    /// Returns when all the writes pushed before are completed.
+    void Flush();
+
+    std::size_t GetPendingCount() const;
+
+    private:
+    struct Target
+    {
+        Batch batch;
+        std::map<std::string, std::vector<Write>> pending;
+        std::set<std::string> in_flight;
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    Options options;
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable written;
+    std::map<std::string, Target> targets;
+    std::size_t n_pending  = 0;
+    std::size_t n_flushing = 0;
+    std::size_t n_running  = 0; // Writes taken from the queue but not completed yet.
+    Clock::time_point oldest;
+    bool is_stopped = false;
+    std::unique_ptr<std::thread> worker;
+
+    void Work();
+    void Stop();
+    /// Called in the child process after fork() with the mutex locked by the parent.
+    void ResetInForkChild();
+    static void
+    Run(const std::string& target, const Batch& batch, const std::vector<Write>& writes);
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_WRITE_BEHIND_HPP_
@@ -26,84 +26,113 @@
 
 #include <miopen/invoker_cache.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/statistics.hpp>
+
+#include <boost/functional/hash.hpp>
 
 namespace miopen {
 
-boost::optional<const Invoker&> InvokerCache::operator[](const Key& key) const
+static StatCounter& Hits()
 {
-    const auto item = invokers.find(key.first);
-    if(item == invokers.end())
-        return boost::none;
-    const auto& item_invokers = item->second.invokers;
-    const auto invoker        = item_invokers.find(key.second);
-    if(invoker == item_invokers.end())
-        return boost::none;
-    return invoker->second;
+    static auto& hits = Statistics::Counter("invoker_cache.hits");
+    return hits;
 }
 
-boost::optional<const Invoker&> InvokerCache::GetFound1_0(const std::string& network_config,
-                                                          const std::string& algorithm) const
+static StatCounter& Misses()
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
-    {
-        MIOPEN_LOG_I2("No invokers found for " << network_config);
-        return boost::none;
-    }
-    if(item->second.found_1_0.empty())
+    static auto& misses = Statistics::Counter("invoker_cache.misses");
+    return misses;
+}
+
+static std::uint64_t GetSolverValue(const solver::Id& solver_id)
+{
+    return solver_id.IsValid() ? solver_id.Value() : solver::Id::invalid_value;
+}
+
+static std::uint64_t Hash(const NetworkConfig& config, std::uint64_t solver_id)
+{
+    auto hash = static_cast<std::size_t>(config.GetHash());
+    boost::hash_combine(hash, solver_id);
+    return hash;
+}
+
+static std::uint64_t Hash(const NetworkConfig& config, const AlgorithmName& algorithm)
+{
+    auto hash = static_cast<std::size_t>(config.GetHash());
+    boost::hash_combine(hash, algorithm.GetValue());
+    return hash;
+}
+
+boost::optional<const Invoker&> InvokerCache::GetInvoker(const NetworkConfig& config,
+                                                         const solver::Id& solver_id) const
+{
+    const auto solver = GetSolverValue(solver_id);
+    const auto invoker =
+        invokers->Find(Hash(config, solver), InvokerProbe{config.GetValue(), solver});
+    if(invoker == nullptr)
     {
-        MIOPEN_LOG_I2("Invokers found for " << network_config
-                                            << " but there is no find 1.0 result.");
+        ++Misses();
         return boost::none;
     }
-    const auto& item_invokers = item->second.invokers;
-    const auto& found_1_0_ids = item->second.found_1_0;
-    const auto found_1_0_id   = found_1_0_ids.find(algorithm);
-    if(found_1_0_id == found_1_0_ids.end())
+    ++Hits();
+    return *invoker;
+}
+
+boost::optional<const Invoker&> InvokerCache::GetFound1_0(const NetworkConfig& config,
+                                                          const AlgorithmName& algorithm) const
+{
+    const auto found = found_1_0->Find(Hash(config, algorithm),
+                                       Found1_0Probe{config.GetValue(), algorithm.GetValue()});
+    if(found == nullptr)
     {
-        MIOPEN_LOG_I2("Invokers found for " << network_config
-                                            << " but there is no one with an algorithm "
-                                            << algorithm);
+        ++Misses();
+        MIOPEN_LOG_I2("There is no find 1.0 result for " << config.ToString()
+                                                         << " with an algorithm "
+                                                         << algorithm.ToString());
         return boost::none;
     }
-    const auto invoker = item_invokers.find(found_1_0_id->second);
-    if(invoker == item_invokers.end())
-        MIOPEN_THROW("No invoker with solver_id of " + found_1_0_id->second +
-                     " was registered for " + network_config);
-    return invoker->second;
+
+    const auto solver = found->solver_id.load(std::memory_order_relaxed);
+    const auto invoker =
+        invokers->Find(Hash(config, solver), InvokerProbe{config.GetValue(), solver});
+    if(invoker == nullptr)
+        MIOPEN_THROW("No invoker with solver_id of " + solver::Id{solver}.ToString() +
+                     " was registered for " + config.ToString());
+    ++Hits();
+    return *invoker;
 }
 
-void InvokerCache::Register(const Key& key, const Invoker& invoker)
+void InvokerCache::Register(const NetworkConfig& config,
+                            const solver::Id& solver_id,
+                            const Invoker& invoker)
 {
-    auto it = invokers.find(key.first);
-    if(it != invokers.end())
-        it->second.invokers.insert({key.second, invoker});
-    auto& item = invokers.insert({key.first, Item{}}).first->second;
-    item.invokers.insert({key.second, invoker});
-    MIOPEN_LOG_I2("Invoker registered for algorithm " << key.first << " and solver " << key.second);
+    const auto solver = GetSolverValue(solver_id);
+    invokers->Insert(Hash(config, solver), InvokerKey{config.ToString(), solver}, invoker);
+    MIOPEN_LOG_I2("Invoker registered for algorithm " << config.ToString() << " and solver "
+                                                      << solver_id.ToString());
 }
 
-void InvokerCache::SetAsFound1_0(const std::string& network_config,
-                                 const std::string& algorithm,
-                                 const std::string& solver_id)
+void InvokerCache::SetAsFound1_0(const NetworkConfig& config,
+                                 const AlgorithmName& algorithm,
+                                 const solver::Id& solver_id)
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
-        MIOPEN_THROW("No invoker was registered for " + network_config);
+    const auto solver = GetSolverValue(solver_id);
 
-    {
-        // Validating at find time
-        const auto& item_invokers = item->second.invokers;
-        const auto invoker        = item_invokers.find(solver_id);
-        if(invoker == item_invokers.end())
-            MIOPEN_THROW("No invoker with solver_id of " + solver_id + " was registered for " +
-                         network_config);
-    }
+    // Validating at find time
+    if(invokers->Find(Hash(config, solver), InvokerProbe{config.GetValue(), solver}) == nullptr)
+        MIOPEN_THROW("No invoker with solver_id of " + solver_id.ToString() +
+                     " was registered for " + config.ToString());
 
-    item->second.found_1_0[algorithm] = solver_id;
-    MIOPEN_LOG_I2("Solver " << solver_id << " registered as find 1.0 best for " << algorithm
+    found_1_0->InsertOrUpdate(Hash(config, algorithm),
+                              Found1_0Key{config.ToString(), algorithm.ToString()},
+                              Found1_0{solver},
+                              [&](Found1_0& found) {
+                                  found.solver_id.store(solver, std::memory_order_relaxed);
+                              });
+    MIOPEN_LOG_I2("Solver " << solver_id.ToString() << " registered as find 1.0 best for "
+                            << algorithm.ToString()
                             << " in "
-                            << network_config);
+                            << config.ToString());
 }
 
 } // namespace miopen
@@ -24,13 +24,69 @@
  *
  *******************************************************************************/
 #include <miopen/kern_db.hpp>
+#include <miopen/env.hpp>
+
+#include <algorithm>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_KERN_DB_CODEC)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_KERN_DB_SIZE_LIMIT)
 
 namespace miopen {
+
+// Evictions free some room below the limit, so that they do not happen on each store.
+static constexpr std::uint64_t EvictionTargetPercent = 90;
+// Access times are only updated after this many seconds to avoid a write per lookup.
+static constexpr std::int64_t AccessTimeResolution = 3600;
+
+static const std::vector<KernDbCodec>& KernDbCodecs()
+{
+    // Never destroyed: used by the kernel writes performed at process exit.
+    static const auto& codecs = *new std::vector<KernDbCodec>{
+        {KernDbCodec::Bz2, "bz2", compress, decompress},
+        {KernDbCodec::Lz4,
+         "lz4",
+         [](const std::string& data, bool* compressed) { return Lz4Compress(data, compressed); },
+         [](const std::string& data, unsigned int size) { return Lz4Decompress(data, size); }},
+    };
+    return codecs;
+}
+
+const KernDbCodec* FindKernDbCodec(int id)
+{
+    const auto& codecs = KernDbCodecs();
+    const auto it      = std::find_if(
+        codecs.begin(), codecs.end(), [&](const KernDbCodec& codec) { return codec.id == id; });
+    return it != codecs.end() ? &*it : nullptr;
+}
+
+const KernDbCodec& GetKernDbCodec()
+{
+    static const KernDbCodec& codec = []() -> const KernDbCodec& {
+        const auto name = GetStringEnv(MIOPEN_DEBUG_KERN_DB_CODEC{});
+        if(name != nullptr)
+        {
+            for(const auto& candidate : KernDbCodecs())
+                if(candidate.name == name)
+                    return candidate;
+            MIOPEN_LOG_W("Unknown MIOPEN_DEBUG_KERN_DB_CODEC: " << name << ", using lz4");
+        }
+        return *FindKernDbCodec(KernDbCodec::Lz4);
+    }();
+    return codec;
+}
+
+static std::uint64_t GetDefaultSizeLimit()
+{
+    // In megabytes.
+    static const auto limit = Value(MIOPEN_KERN_DB_SIZE_LIMIT{}, 4096);
+    return static_cast<std::uint64_t>(limit) * 1024 * 1024;
+}
+
 KernDb::KernDb(const std::string& filename_,
                bool is_system,
                const std::string& arch_,
                const std::size_t num_cu_)
-    : KernDb(filename_, is_system, arch_, num_cu_, compress, decompress)
+    : KernDb(filename_, is_system, arch_, num_cu_, GetKernDbCodec())
 {
 }
 
@@ -40,9 +96,23 @@ KernDb::KernDb(const std::string& filename_,
                std::size_t _num_cu,
                std::function<std::string(std::string, bool*)> _compress_fn,
                std::function<std::string(std::string, unsigned int)> _decompress_fn)
+    : KernDb(filename_,
+             is_system,
+             _arch,
+             _num_cu,
+             KernDbCodec{KernDbCodec::Bz2, "custom", _compress_fn, _decompress_fn})
+{
+}
+
+KernDb::KernDb(const std::string& filename_,
+               bool is_system,
+               const std::string& _arch,
+               std::size_t _num_cu,
+               const KernDbCodec& codec_)
     : SQLiteBase(filename_, is_system, _arch, _num_cu),
-      compress_fn(_compress_fn),
-      decompress_fn(_decompress_fn)
+      codec(codec_),
+      read_only(is_system),
+      size_limit(is_system ? 0 : GetDefaultSizeLimit())
 {
     if(dbInvalid)
     {
@@ -54,6 +124,8 @@ KernDb::KernDb(const std::string& filename_,
     }
     if(!is_system)
     {
+        // Has effect for new databases only. Lets evictions shrink the file.
+        sql.Exec("PRAGMA auto_vacuum = INCREMENTAL;");
         const std::string create_table = KernelConfig::CreateQuery();
         sql.Exec(create_table);
         MIOPEN_LOG_I2("Database created successfully");
@@ -65,7 +137,138 @@ KernDb::KernDb(const std::string& filename_,
            << filename;
         MIOPEN_LOG_W(ss.str());
         dbInvalid = true;
+        return;
+    }
+
+    has_codec_fields =
+        CheckTableColumns(KernelConfig::table_name(), KernelConfig::CodecFieldNames());
+    if(!has_codec_fields && !is_system)
+    {
+        MIOPEN_LOG_I("Adding codec and access time columns to " << filename);
+        sql.Exec("ALTER TABLE `" + KernelConfig::table_name() +
+                 "` ADD COLUMN `codec` INT NOT NULL DEFAULT 0;"
+                 "ALTER TABLE `" +
+                 KernelConfig::table_name() +
+                 "` ADD COLUMN `last_access` INT NOT NULL DEFAULT 0;");
+        has_codec_fields = true;
+    }
+    if(!is_system)
+        sql.Exec(KernelConfig::CreateAccessIndexQuery());
+}
+
+std::int64_t KernDb::Now()
+{
+    return std::chrono::duration_cast<std::chrono::seconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+std::uint64_t KernDb::GetUsedSize() const
+{
+    if(dbInvalid)
+        return 0;
+
+    const auto pragma = [&](const std::string& name) {
+        auto stmt = SQLite::Statement{sql, "PRAGMA " + name + ";"};
+        if(stmt.Step(sql) != SQLITE_ROW)
+            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+        return static_cast<std::uint64_t>(stmt.ColumnInt64(0));
+    };
+
+    return (pragma("page_count") - pragma("freelist_count")) * pragma("page_size");
+}
+
+void KernDb::TouchUnsafe(std::int64_t id, std::int64_t last_access)
+{
+    const auto now = Now();
+    if(read_only || now - last_access < AccessTimeResolution)
+        return;
+
+    try
+    {
+        auto stmt = SQLite::Statement{
+            sql, "UPDATE `" + KernelConfig::table_name() + "` SET last_access = ? WHERE id = ?;"};
+        stmt.BindInt64(1, now);
+        stmt.BindInt64(2, id);
+        if(stmt.Step(sql) != SQLITE_DONE)
+            MIOPEN_LOG_I2("Unable to update the access time: " << sql.ErrorMessage());
+    }
+    catch(const Exception& ex)
+    {
+        // Not worth failing the lookup, e.g. if another process holds the database.
+        MIOPEN_LOG_I2("Unable to update the access time: " << ex.what());
+    }
+}
+
+void KernDb::EvictUnsafe()
+{
+    auto used         = GetUsedSize();
+    const auto target = size_limit / 100 * EvictionTargetPercent;
+    if(used <= size_limit)
+        return;
+
+    MIOPEN_LOG_I("Kernel database " << filename << " exceeds " << size_limit
+                                    << " bytes, evicting least recently used kernels");
+
+    // The kernel just stored is never evicted.
+    const auto newest = [&]() {
+        auto stmt = SQLite::Statement{sql, "SELECT last_insert_rowid();"};
+        stmt.Step(sql);
+        return stmt.ColumnInt64(0);
+    }();
+
+    // Both statements walk the last_access index from the oldest kernel and stop at the last
+    // victim, so an eviction does not sort the table.
+    const auto table        = "`" + KernelConfig::table_name() + "`";
+    const auto oldest       = std::string{" WHERE id != ? ORDER BY last_access ASC, id ASC"};
+    const auto select_query =
+        "SELECT length(kernel_blob) + length(kernel_args) FROM " + table + oldest + ";";
+    const auto evict_query =
+        "DELETE FROM " + table + " WHERE id IN (SELECT id FROM " + table + oldest + " LIMIT ?);";
+
+    sql.Exec("SAVEPOINT kern_db_eviction;");
+    try
+    {
+        auto n_evicted = std::int64_t{0};
+
+        while(used > target)
+        {
+            // Sizes of the rows are a lower estimate of the pages freed.
+            auto n_victims = std::int64_t{0};
+            auto to_free   = used - target;
+            {
+                auto select = SQLite::Statement{sql, select_query};
+                select.BindInt64(1, newest);
+                for(; to_free > 0 && select.Step(sql) == SQLITE_ROW; ++n_victims)
+                {
+                    const auto size = static_cast<std::uint64_t>(select.ColumnInt64(0));
+                    to_free -= std::min(to_free, size);
+                }
+            }
+
+            if(n_victims == 0)
+                break;
+
+            auto evict = SQLite::Statement{sql, evict_query};
+            evict.BindInt64(1, newest);
+            evict.BindInt64(2, n_victims);
+            if(evict.Step(sql) != SQLITE_DONE)
+                MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+
+            n_evicted += n_victims;
+            used = GetUsedSize();
+        }
+
+        sql.Exec("RELEASE kern_db_eviction;");
+        MIOPEN_LOG_I(n_evicted << " kernels evicted, " << used << " bytes in use");
+    }
+    catch(...)
+    {
+        sql.Exec("ROLLBACK TO kern_db_eviction; RELEASE kern_db_eviction;");
+        throw;
     }
+
+    sql.Exec("PRAGMA incremental_vacuum;");
 }
 
 } // namespace miopen
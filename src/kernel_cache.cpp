@@ -43,6 +43,7 @@
 #include <miopen/errors.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/statistics.hpp>
 #include <miopen/stringutils.hpp>
 
 #include <iostream>
@@ -132,14 +133,19 @@ const std::vector<Kernel>& KernelCache::GetKernels(const std::string& algorithm,
 
     std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
 
+    static auto& hits   = Statistics::Counter("kernel_cache.kernels.hits");
+    static auto& misses = Statistics::Counter("kernel_cache.kernels.misses");
+
     const auto it = kernel_map.find(key);
     if(it != kernel_map.end())
     {
+        ++hits;
         MIOPEN_LOG_I2(it->second.size() << " kernels for key: " << key.first << " \"" << key.second
                                         << '\"');
         return it->second;
     }
 
+    ++misses;
     static const std::vector<Kernel> empty{};
     MIOPEN_LOG_I2("0 kernels for key: " << key.first << " \"" << key.second << '\"');
     return empty;
@@ -193,15 +199,20 @@ Kernel KernelCache::AddKernel(const Handle& h,
     if(!network_config.empty() || !algorithm.empty()) // Don't log only _empty_ keys.
         MIOPEN_LOG_I2("Key: " << key.first << " \"" << key.second << '\"');
 
+    static auto& hits   = Statistics::Counter("kernel_cache.programs.hits");
+    static auto& misses = Statistics::Counter("kernel_cache.programs.misses");
+
     Program program;
 
     auto program_it = program_map.find(std::make_pair(program_name, params));
     if(program_it != program_map.end())
     {
+        ++hits;
         program = program_it->second;
     }
     else
     {
+        ++misses;
         if(!is_kernel_miopengemm_str) // default value
             is_kernel_miopengemm_str = algorithm.find("ImplicitGEMM") == std::string::npos &&
                                        algorithm.find("GEMM") != std::string::npos;
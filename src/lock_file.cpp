@@ -91,7 +91,7 @@ LockFile::LockFile(const char* path_, PassKey) : path(path_)
 
 LockFile& LockFile::Get(const char* path)
 {
-    static std::mutex mutex;
+    static auto& mutex = *new std::mutex{};
     std::lock_guard<std::mutex> lock(mutex);
 
     { // To guarantee that construction won't be called if not required.
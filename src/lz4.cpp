@@ -0,0 +1,239 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/lz4.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace miopen {
+
+// Parameters of the LZ4 block format.
+static constexpr std::size_t MinMatch     = 4;
+static constexpr std::size_t LastLiterals = 5;  // The last bytes of a block are always literals.
+static constexpr std::size_t MatchLimit   = 12; // No match starts within the last bytes.
+static constexpr std::size_t MaxOffset    = 65535;
+static constexpr unsigned RunMask         = 15;
+
+static constexpr int HashLog = 16;
+
+static std::uint32_t Read32(const char* at)
+{
+    std::uint32_t value;
+    std::memcpy(&value, at, sizeof(value));
+    return value;
+}
+
+static std::uint32_t Hash(std::uint32_t sequence)
+{
+    return (sequence * 2654435761u) >> (32 - HashLog);
+}
+
+static void WriteLength(std::string& out, std::size_t length)
+{
+    for(length -= RunMask; length >= 255; length -= 255)
+        out.push_back(static_cast<char>(255));
+    out.push_back(static_cast<char>(length));
+}
+
+static void WriteSequence(std::string& out,
+                          const char* literals,
+                          std::size_t n_literals,
+                          std::size_t offset,
+                          std::size_t match_length)
+{
+    const auto token_literals = n_literals < RunMask ? n_literals : RunMask;
+    auto token                = static_cast<unsigned>(token_literals << 4);
+
+    if(offset != 0)
+    {
+        const auto extra = match_length - MinMatch;
+        token |= extra < RunMask ? extra : RunMask;
+    }
+
+    out.push_back(static_cast<char>(token));
+    if(n_literals >= RunMask)
+        WriteLength(out, n_literals);
+    out.append(literals, n_literals);
+
+    // The last sequence only consists of literals.
+    if(offset == 0)
+        return;
+
+    out.push_back(static_cast<char>(offset & 0xff));
+    out.push_back(static_cast<char>(offset >> 8));
+    if(match_length - MinMatch >= RunMask)
+        WriteLength(out, match_length - MinMatch);
+}
+
+std::string Lz4Compress(const std::string& data, bool* compressed)
+{
+    const auto size = data.size();
+    const auto base = data.data();
+    auto out        = std::string{};
+    auto anchor     = std::size_t{0};
+    out.reserve(size);
+
+    if(size > MatchLimit)
+    {
+        // Positions of the last occurrences of 4-byte sequences. Candidates are verified, so
+        // stale or colliding entries only cost a comparison.
+        auto table            = std::vector<std::uint32_t>(std::size_t{1} << HashLog, 0);
+        const auto last_start = size - MatchLimit;
+        const auto last_end   = size - LastLiterals;
+        auto misses           = std::size_t{0};
+
+        for(auto ip = std::size_t{1}; ip < last_start;)
+        {
+            const auto sequence = Read32(base + ip);
+            auto& entry         = table[Hash(sequence)];
+            const auto ref      = std::size_t{entry};
+            entry               = static_cast<std::uint32_t>(ip);
+
+            if(ip - ref > MaxOffset || Read32(base + ref) != sequence)
+            {
+                // Incompressible data is skipped faster and faster.
+                ip += 1 + (misses++ >> 6);
+                continue;
+            }
+            misses = 0;
+
+            auto start     = ip;
+            auto ref_start = ref;
+            while(start > anchor && ref_start > 0 && base[start - 1] == base[ref_start - 1])
+            {
+                --start;
+                --ref_start;
+            }
+
+            auto end = ip + MinMatch;
+            while(end < last_end && base[end] == base[ref + (end - ip)])
+                ++end;
+
+            WriteSequence(out, base + anchor, start - anchor, ip - ref, end - start);
+            anchor = ip = end;
+
+            if(ip < last_start)
+                table[Hash(Read32(base + ip - 2))] = static_cast<std::uint32_t>(ip - 2);
+
+            if(out.size() >= size)
+                break;
+        }
+    }
+
+    WriteSequence(out, base + anchor, size - anchor, 0, 0);
+
+    if(out.size() >= size)
+    {
+        if(compressed == nullptr)
+            throw std::runtime_error("Lz4Compress failed: the data does not compress");
+        *compressed = false;
+        return data;
+    }
+
+    if(compressed != nullptr)
+        *compressed = true;
+    return out;
+}
+
+static std::size_t ReadLength(const std::string& data, std::size_t& ip)
+{
+    auto length = std::size_t{RunMask};
+    for(;;)
+    {
+        if(ip >= data.size())
+            throw std::runtime_error("Lz4Decompress failed: the compressed data ends unexpectedly");
+        const auto byte = static_cast<unsigned char>(data[ip++]);
+        length += byte;
+        if(byte != 255)
+            return length;
+    }
+}
+
+std::string Lz4Decompress(const std::string& data, std::size_t size)
+{
+    auto out = std::string(size, '\0');
+    auto ip  = std::size_t{0};
+    auto op  = std::size_t{0};
+
+    for(;;)
+    {
+        if(ip >= data.size())
+            throw std::runtime_error("Lz4Decompress failed: the compressed data ends unexpectedly");
+
+        const auto token = static_cast<unsigned char>(data[ip++]);
+        auto n_literals  = static_cast<std::size_t>(token >> 4u);
+        if(n_literals == RunMask)
+            n_literals = ReadLength(data, ip);
+
+        if(n_literals > data.size() - ip)
+            throw std::runtime_error("Lz4Decompress failed: the compressed data ends unexpectedly");
+        if(n_literals > size - op)
+            throw std::runtime_error("Lz4Decompress failed: the data exceeds the given size");
+
+        std::memcpy(&out[op], &data[ip], n_literals);
+        ip += n_literals;
+        op += n_literals;
+
+        if(ip == data.size())
+            break;
+
+        if(data.size() - ip < 2)
+            throw std::runtime_error("Lz4Decompress failed: the compressed data ends unexpectedly");
+        const auto offset = static_cast<std::size_t>(static_cast<unsigned char>(data[ip])) |
+                            static_cast<std::size_t>(static_cast<unsigned char>(data[ip + 1])) << 8;
+        ip += 2;
+
+        if(offset == 0 || offset > op)
+            throw std::runtime_error("Lz4Decompress failed: invalid match offset");
+
+        auto match_length = std::size_t{token & RunMask};
+        if(match_length == RunMask)
+            match_length = ReadLength(data, ip);
+        match_length += MinMatch;
+
+        if(match_length > size - op)
+            throw std::runtime_error("Lz4Decompress failed: the data exceeds the given size");
+
+        // Matches may overlap the output being produced, e.g. for runs of a repeated byte.
+        if(offset >= match_length)
+        {
+            std::memcpy(&out[op], &out[op - offset], match_length);
+        }
+        else
+        {
+            for(auto i = std::size_t{0}; i < match_length; ++i)
+                out[op + i] = out[op - offset + i];
+        }
+        op += match_length;
+    }
+
+    out.resize(op);
+    return out;
+}
+
+} // namespace miopen
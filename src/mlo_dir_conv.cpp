@@ -97,11 +97,12 @@ mlo_construct_direct2D_fusion::FindSolution(const std::vector<miopen::solver::An
 {
     miopen::solver::ConvSolution solution{miopenStatusUnknownError};
     std::string solver_id;
-    auto db = this->GetDb();
+    auto db             = this->GetDb();
+    const auto memo_key = miopen::solver::GetSolverMemoKey(_search_params);
     for(auto& solver : solvers)
     {
-        solution = solver.FindSolution(_search_params, db, invoke_ctx);
-        if(solution.Succeeded() && solver.IsApplicable(_search_params))
+        solution = solver.FindSolution(_search_params, db, invoke_ctx, memo_key);
+        if(solution.Succeeded() && solver.IsApplicable(_search_params, memo_key))
         {
             solver_id = miopen::solver::SolverDbId(solver);
             break;
@@ -116,7 +117,8 @@ mlo_construct_direct2D_fusion::FindSolution(const std::vector<miopen::solver::An
 
 static auto GetDirectSolvers()
 {
-    return miopen::solver::SolverContainer<miopen::solver::ConvAsm3x3U,
+    return miopen::solver::SolverContainer<miopen::solver::ConvDirectHost,
+                                           miopen::solver::ConvAsm3x3U,
                                            miopen::solver::ConvAsm1x1U,
                                            miopen::solver::ConvAsm1x1UV2,
                                            miopen::solver::ConvAsm5x10u2v2f1,
@@ -197,7 +199,8 @@ static auto GetWindogradWrWSolvers()
 
 static auto GetBwdWrW2DSolvers()
 {
-    return miopen::solver::SolverContainer<miopen::solver::ConvAsmBwdWrW1x1,
+    return miopen::solver::SolverContainer<miopen::solver::ConvDirectHost,
+                                           miopen::solver::ConvAsmBwdWrW1x1,
                                            miopen::solver::ConvAsmBwdWrW3x3,
                                            miopen::solver::ConvOclBwdWrW2<1>,
                                            miopen::solver::ConvOclBwdWrW2<2>,
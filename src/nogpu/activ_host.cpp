@@ -0,0 +1,226 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/host_primitives.hpp>
+
+#include <miopen/activ.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/tensor.hpp>
+
+#include "host_utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace miopen {
+namespace host {
+namespace {
+
+template <class F>
+void Forward(const TensorDescriptor& xDesc,
+             ConstData_t x,
+             const TensorDescriptor& yDesc,
+             Data_t y,
+             std::size_t xOffset,
+             std::size_t yOffset,
+             F f)
+{
+    const auto& x_str = xDesc.GetStrides();
+    const auto& y_str = yDesc.GetStrides();
+
+    VisitFloatingPoint(xDesc.GetType(), [&](auto as_float) {
+        const auto x_data = as_float(x) + xOffset;
+        const auto y_data = as_float(y) + yOffset;
+
+        ParForEachRow(xDesc.GetLengths(), [&](const Coords& coords, std::size_t n) {
+            const auto x_row = x_data + Offset(x_str, coords);
+            const auto y_row = y_data + Offset(y_str, coords);
+            for(auto i = std::size_t{0}; i < n; ++i)
+                y_row[i * y_str.back()] = as_float(f(static_cast<double>(x_row[i * x_str.back()])));
+        });
+    });
+}
+
+/// f(dy, x, y) is the input gradient.
+template <class F>
+void Backward(const TensorDescriptor& yDesc,
+              ConstData_t y,
+              const TensorDescriptor& dyDesc,
+              ConstData_t dy,
+              const TensorDescriptor& xDesc,
+              ConstData_t x,
+              const TensorDescriptor& dxDesc,
+              Data_t dx,
+              std::size_t yOffset,
+              std::size_t dyOffset,
+              std::size_t xOffset,
+              std::size_t dxOffset,
+              F f)
+{
+    const auto& y_str  = yDesc.GetStrides();
+    const auto& dy_str = dyDesc.GetStrides();
+    const auto& x_str  = xDesc.GetStrides();
+    const auto& dx_str = dxDesc.GetStrides();
+
+    VisitFloatingPoint(dxDesc.GetType(), [&](auto as_float) {
+        const auto y_data  = as_float(y) + yOffset;
+        const auto dy_data = as_float(dy) + dyOffset;
+        const auto x_data  = as_float(x) + xOffset;
+        const auto dx_data = as_float(dx) + dxOffset;
+
+        ParForEachRow(dxDesc.GetLengths(), [&](const Coords& coords, std::size_t n) {
+            const auto y_row  = y_data + Offset(y_str, coords);
+            const auto dy_row = dy_data + Offset(dy_str, coords);
+            const auto x_row  = x_data + Offset(x_str, coords);
+            const auto dx_row = dx_data + Offset(dx_str, coords);
+            for(auto i = std::size_t{0}; i < n; ++i)
+            {
+                const auto grad = f(static_cast<double>(dy_row[i * dy_str.back()]),
+                                    static_cast<double>(x_row[i * x_str.back()]),
+                                    static_cast<double>(y_row[i * y_str.back()]));
+                dx_row[i * dx_str.back()] = as_float(grad);
+            }
+        });
+    });
+}
+
+} // namespace
+
+void ActivationForward(const ActivationDescriptor& desc,
+                       const TensorDescriptor& xDesc,
+                       ConstData_t x,
+                       const TensorDescriptor& yDesc,
+                       Data_t y,
+                       std::size_t xOffset,
+                       std::size_t yOffset)
+{
+    const auto alpha = desc.GetAlpha();
+    const auto beta  = desc.GetBeta();
+    const auto gamma = desc.GetGamma();
+    const auto run   = [&](auto f) { Forward(xDesc, x, yDesc, y, xOffset, yOffset, f); };
+
+    switch(desc.GetMode())
+    {
+    case miopenActivationPASTHRU: run([](double v) { return v; }); break;
+    case miopenActivationLOGISTIC: run([](double v) { return 1 / (1 + std::exp(-v)); }); break;
+    case miopenActivationTANH: run([=](double v) { return beta * std::tanh(alpha * v); }); break;
+    case miopenActivationRELU: run([](double v) { return v > 0 ? v : 0; }); break;
+    case miopenActivationSOFTRELU: run([](double v) { return std::log1p(std::exp(v)); }); break;
+    case miopenActivationABS: run([](double v) { return std::abs(v); }); break;
+    case miopenActivationPOWER:
+        run([=](double v) {
+            const auto base = alpha + beta * v;
+            return base <= std::numeric_limits<double>::epsilon() ? 0 : std::pow(base, gamma);
+        });
+        break;
+    case miopenActivationCLIPPEDRELU:
+        run([=](double v) { return std::min(alpha, std::max(0.0, v)); });
+        break;
+    case miopenActivationLEAKYRELU: run([=](double v) { return v > 0 ? v : v * alpha; }); break;
+    case miopenActivationELU:
+        run([=](double v) { return v > 0 ? v : alpha * std::expm1(v); });
+        break;
+    default: MIOPEN_THROW(miopenStatusBadParm, "Unknown activation mode");
+    }
+}
+
+void ActivationBackward(const ActivationDescriptor& desc,
+                        const TensorDescriptor& yDesc,
+                        ConstData_t y,
+                        const TensorDescriptor& dyDesc,
+                        ConstData_t dy,
+                        const TensorDescriptor& xDesc,
+                        ConstData_t x,
+                        const TensorDescriptor& dxDesc,
+                        Data_t dx,
+                        std::size_t yOffset,
+                        std::size_t dyOffset,
+                        std::size_t xOffset,
+                        std::size_t dxOffset)
+{
+    const auto alpha = desc.GetAlpha();
+    const auto beta  = desc.GetBeta();
+    const auto gamma = desc.GetGamma();
+    const auto run   = [&](auto f) {
+        Backward(yDesc,
+                 y,
+                 dyDesc,
+                 dy,
+                 xDesc,
+                 x,
+                 dxDesc,
+                 dx,
+                 yOffset,
+                 dyOffset,
+                 xOffset,
+                 dxOffset,
+                 f);
+    };
+
+    switch(desc.GetMode())
+    {
+    case miopenActivationPASTHRU: run([](double d, double, double) { return d; }); break;
+    case miopenActivationLOGISTIC:
+        run([](double d, double, double v) { return d * v * (1 - v); });
+        break;
+    case miopenActivationTANH:
+        run([=](double d, double, double v) { return d * alpha * (beta - v * v / beta); });
+        break;
+    case miopenActivationRELU:
+        run([](double d, double u, double) { return u > 0 ? d : 0; });
+        break;
+    case miopenActivationSOFTRELU:
+        run([](double d, double u, double) {
+            const auto e = std::exp(std::min(u, 50.0));
+            return d * e / (e + 1);
+        });
+        break;
+    case miopenActivationABS:
+        run([](double d, double u, double) { return u > 0 ? d : -d; });
+        break;
+    case miopenActivationPOWER:
+        // As the kernels do, dy is not applied.
+        run([=](double, double u, double v) {
+            const auto base = alpha + beta * u;
+            return base <= std::numeric_limits<double>::epsilon() ? 0 : gamma * beta * v / base;
+        });
+        break;
+    case miopenActivationCLIPPEDRELU:
+        run([=](double d, double u, double) { return u > 0 && u <= alpha ? d : 0; });
+        break;
+    case miopenActivationLEAKYRELU:
+        run([=](double d, double u, double) { return u > 0 ? d : d * alpha; });
+        break;
+    case miopenActivationELU:
+        run([=](double d, double u, double v) { return u > 0 ? d : d * (v + alpha); });
+        break;
+    default: MIOPEN_THROW(miopenStatusBadParm, "Unknown activation mode");
+    }
+}
+
+} // namespace host
+} // namespace miopen
@@ -0,0 +1,335 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/host_primitives.hpp>
+
+#include <miopen/errors.hpp>
+#include <miopen/tensor.hpp>
+
+#include "host_utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace miopen {
+namespace host {
+namespace {
+
+/// The statistics are computed over the groups of the elements of packed N, C, spatial tensors:
+/// per channel over the batch and the spatial dimensions in the spatial mode, or per element of
+/// the image over the batch in the per-activation one.
+struct Layout
+{
+    Layout(miopenBatchNormMode_t bn_mode, const TensorDescriptor& xDesc)
+        : spatial(bn_mode == miopenBNSpatial),
+          c(xDesc.GetLengths()[1]),
+          hw(xDesc.GetElementSize() / (xDesc.GetLengths()[0] * c))
+    {
+        const auto n = xDesc.GetLengths()[0];
+        groups       = spatial ? c : c * hw;
+        size         = spatial ? n * hw : n;
+    }
+
+    std::size_t Offset(std::size_t group, std::size_t i) const
+    {
+        if(spatial)
+            return (i / hw * c + group) * hw + i % hw;
+        return i * c * hw + group;
+    }
+
+    template <class F>
+    void ParForEachGroup(F f) const
+    {
+        par_for(groups, min_grain{std::max<std::size_t>(1, 4096 / size)}, f);
+    }
+
+    bool spatial;
+    std::size_t c      = 0;
+    std::size_t hw     = 0;
+    std::size_t groups = 0;
+    std::size_t size   = 0;
+};
+
+void CheckPacked(const TensorDescriptor& desc)
+{
+    if(!desc.IsPacked())
+        MIOPEN_THROW(miopenStatusNotImplemented, "Only fully packed tensors supported.");
+}
+
+/// Scales, biases and statistics may be of a wider type than the data.
+std::vector<double> Load(const TensorDescriptor& desc, ConstData_t data, std::size_t size)
+{
+    auto values = std::vector<double>(size);
+    VisitFloatingPoint(desc.GetType(), [&](auto as_float) {
+        const auto typed = as_float(data);
+        for(auto i = std::size_t{0}; i < size; ++i)
+            values[i] = static_cast<double>(typed[i]);
+    });
+    return values;
+}
+
+void Store(const TensorDescriptor& desc, Data_t data, const std::vector<double>& values)
+{
+    VisitFloatingPoint(desc.GetType(), [&](auto as_float) {
+        const auto typed = as_float(data);
+        for(auto i = std::size_t{0}; i < values.size(); ++i)
+            typed[i] = as_float(values[i]);
+    });
+}
+
+/// Computes the means and the inverse standard deviations of x. The biased variances are
+/// returned too, for the running averages.
+void ComputeStatistics(const Layout& layout,
+                       const TensorDescriptor& xDesc,
+                       ConstData_t x,
+                       double epsilon,
+                       std::vector<double>& mean,
+                       std::vector<double>& inv_var,
+                       std::vector<double>& variance)
+{
+    mean.resize(layout.groups);
+    inv_var.resize(layout.groups);
+    variance.resize(layout.groups);
+
+    VisitFloatingPoint(xDesc.GetType(), [&](auto as_float) {
+        const auto x_data = as_float(x);
+
+        layout.ParForEachGroup([&](std::size_t group) {
+            auto sum = 0.0;
+            for(auto i = std::size_t{0}; i < layout.size; ++i)
+                sum += static_cast<double>(x_data[layout.Offset(group, i)]);
+            const auto group_mean = sum / layout.size;
+
+            auto squares = 0.0;
+            for(auto i = std::size_t{0}; i < layout.size; ++i)
+            {
+                const auto diff = static_cast<double>(x_data[layout.Offset(group, i)]) - group_mean;
+                squares += diff * diff;
+            }
+
+            mean[group]     = group_mean;
+            variance[group] = squares / layout.size;
+            inv_var[group]  = 1 / std::sqrt(variance[group] + epsilon);
+        });
+    });
+}
+
+/// y = scale * (x - mean) * inv_var + bias
+void Normalize(const Layout& layout,
+               const TensorDescriptor& xDesc,
+               ConstData_t x,
+               Data_t y,
+               const std::vector<double>& scale,
+               const std::vector<double>& bias,
+               const std::vector<double>& mean,
+               const std::vector<double>& inv_var)
+{
+    VisitFloatingPoint(xDesc.GetType(), [&](auto as_float) {
+        const auto x_data = as_float(x);
+        const auto y_data = as_float(y);
+
+        layout.ParForEachGroup([&](std::size_t group) {
+            const auto mul = scale[group] * inv_var[group];
+            const auto add = bias[group] - mean[group] * mul;
+            for(auto i = std::size_t{0}; i < layout.size; ++i)
+            {
+                const auto offset = layout.Offset(group, i);
+                y_data[offset]    = as_float(static_cast<double>(x_data[offset]) * mul + add);
+            }
+        });
+    });
+}
+
+} // namespace
+
+void BatchNormForwardTraining(miopenBatchNormMode_t bn_mode,
+                              const TensorDescriptor& xDesc,
+                              ConstData_t x,
+                              const TensorDescriptor& yDesc,
+                              Data_t y,
+                              const TensorDescriptor& bnScaleBiasMeanVarDesc,
+                              ConstData_t bnScale,
+                              ConstData_t bnBias,
+                              double expAvgFactor,
+                              Data_t resultRunningMean,
+                              Data_t resultRunningVariance,
+                              double epsilon,
+                              Data_t resultSaveMean,
+                              Data_t resultSaveInvVariance)
+{
+    CheckPacked(xDesc);
+    CheckPacked(yDesc);
+
+    const auto layout = Layout{bn_mode, xDesc};
+    const auto& pDesc = bnScaleBiasMeanVarDesc;
+    const auto scale  = Load(pDesc, bnScale, layout.groups);
+    const auto bias   = Load(pDesc, bnBias, layout.groups);
+
+    auto mean     = std::vector<double>{};
+    auto inv_var  = std::vector<double>{};
+    auto variance = std::vector<double>{};
+    ComputeStatistics(layout, xDesc, x, epsilon, mean, inv_var, variance);
+    Normalize(layout, xDesc, x, y, scale, bias, mean, inv_var);
+
+    if(resultRunningMean != nullptr && resultRunningVariance != nullptr)
+    {
+        auto running_mean     = Load(pDesc, resultRunningMean, layout.groups);
+        auto running_variance = Load(pDesc, resultRunningVariance, layout.groups);
+        // The running variance is the unbiased one.
+        const auto adjust = layout.size == 1 ? 1.0 : layout.size / (layout.size - 1.0);
+        for(auto group = std::size_t{0}; group < layout.groups; ++group)
+        {
+            running_mean[group] =
+                (1 - expAvgFactor) * running_mean[group] + expAvgFactor * mean[group];
+            running_variance[group] = (1 - expAvgFactor) * running_variance[group] +
+                                      expAvgFactor * adjust * variance[group];
+        }
+        Store(pDesc, resultRunningMean, running_mean);
+        Store(pDesc, resultRunningVariance, running_variance);
+    }
+
+    if(resultSaveMean != nullptr && resultSaveInvVariance != nullptr)
+    {
+        Store(pDesc, resultSaveMean, mean);
+        Store(pDesc, resultSaveInvVariance, inv_var);
+    }
+}
+
+void BatchNormForwardInference(miopenBatchNormMode_t bn_mode,
+                               const TensorDescriptor& xDesc,
+                               ConstData_t x,
+                               const TensorDescriptor& yDesc,
+                               Data_t y,
+                               const TensorDescriptor& bnScaleBiasMeanVarDesc,
+                               ConstData_t bnScale,
+                               ConstData_t bnBias,
+                               ConstData_t estimatedMean,
+                               ConstData_t estimatedVariance,
+                               double epsilon)
+{
+    CheckPacked(xDesc);
+    CheckPacked(yDesc);
+
+    const auto layout = Layout{bn_mode, xDesc};
+    const auto& pDesc = bnScaleBiasMeanVarDesc;
+    const auto mean   = Load(pDesc, estimatedMean, layout.groups);
+    auto inv_var      = Load(pDesc, estimatedVariance, layout.groups);
+    for(auto& value : inv_var)
+        value = 1 / std::sqrt(value + epsilon);
+
+    Normalize(layout,
+              xDesc,
+              x,
+              y,
+              Load(pDesc, bnScale, layout.groups),
+              Load(pDesc, bnBias, layout.groups),
+              mean,
+              inv_var);
+}
+
+void BatchNormBackward(miopenBatchNormMode_t bn_mode,
+                       const TensorDescriptor& xDesc,
+                       ConstData_t x,
+                       const TensorDescriptor& dyDesc,
+                       ConstData_t dy,
+                       const TensorDescriptor& dxDesc,
+                       Data_t dx,
+                       const TensorDescriptor& bnScaleBiasDiffDesc,
+                       ConstData_t bnScale,
+                       Data_t resultBnScaleDiff,
+                       Data_t resultBnBiasDiff,
+                       double epsilon,
+                       ConstData_t savedMean,
+                       ConstData_t savedInvVariance)
+{
+    CheckPacked(xDesc);
+    CheckPacked(dyDesc);
+    CheckPacked(dxDesc);
+
+    const auto layout = Layout{bn_mode, xDesc};
+    const auto& pDesc = bnScaleBiasDiffDesc;
+    const auto scale  = Load(pDesc, bnScale, layout.groups);
+
+    auto mean    = std::vector<double>{};
+    auto inv_var = std::vector<double>{};
+    if(savedMean != nullptr && savedInvVariance != nullptr)
+    {
+        mean    = Load(pDesc, savedMean, layout.groups);
+        inv_var = Load(pDesc, savedInvVariance, layout.groups);
+    }
+    else
+    {
+        auto variance = std::vector<double>{};
+        ComputeStatistics(layout, xDesc, x, epsilon, mean, inv_var, variance);
+    }
+
+    auto scale_diff = std::vector<double>(layout.groups);
+    auto bias_diff  = std::vector<double>(layout.groups);
+
+    VisitFloatingPoint(xDesc.GetType(), [&](auto as_float) {
+        const auto x_data  = as_float(x);
+        const auto dy_data = as_float(dy);
+        const auto dx_data = as_float(dx);
+
+        layout.ParForEachGroup([&](std::size_t group) {
+            const auto x_hat = [&](std::size_t offset) {
+                return (static_cast<double>(x_data[offset]) - mean[group]) * inv_var[group];
+            };
+
+            auto d_bias  = 0.0;
+            auto d_scale = 0.0;
+            for(auto i = std::size_t{0}; i < layout.size; ++i)
+            {
+                const auto offset = layout.Offset(group, i);
+                const auto grad   = static_cast<double>(dy_data[offset]);
+                d_bias += grad;
+                d_scale += grad * x_hat(offset);
+            }
+
+            // dx = scale * inv_var / N * (N * dy - sum(dy) - x_hat * sum(dy * x_hat))
+            const auto mul = scale[group] * inv_var[group] / layout.size;
+            for(auto i = std::size_t{0}; i < layout.size; ++i)
+            {
+                const auto offset = layout.Offset(group, i);
+                const auto grad   = static_cast<double>(dy_data[offset]);
+                dx_data[offset] =
+                    as_float(mul * (layout.size * grad - d_bias - x_hat(offset) * d_scale));
+            }
+
+            scale_diff[group] = d_scale;
+            bias_diff[group]  = d_bias;
+        });
+    });
+
+    if(resultBnScaleDiff != nullptr)
+        Store(pDesc, resultBnScaleDiff, scale_diff);
+    if(resultBnBiasDiff != nullptr)
+        Store(pDesc, resultBnBiasDiff, bias_diff);
+}
+
+} // namespace host
+} // namespace miopen
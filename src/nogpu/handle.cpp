@@ -0,0 +1,322 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/config.h>
+#include <miopen/handle.hpp>
+
+#include <miopen/device_name.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/invoker.hpp>
+#include <miopen/kernel_cache.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/null_device.hpp>
+
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+namespace miopen {
+
+// Properties of the null device. Name and number of CUs may be set by MIOPEN_DEVICE_ARCH and
+// MIOPEN_DEVICE_CU to select the kernels and configs of specific GPUs. In the host execution mode
+// these are "cpu" and the number of hardware threads, so find-db and perf-db records of the CPU
+// do not mix with the ones of GPUs.
+static const char* const NullDeviceName            = "gfx906";
+static constexpr std::size_t NullDeviceCUs         = 60;
+static constexpr std::size_t NullDeviceMemory      = std::size_t{16} << 30;
+static constexpr std::size_t NullDeviceLocalMemory = 65536;
+static constexpr std::size_t NullDeviceWavefront   = 64;
+
+void* default_allocator(void*, size_t sz) { return NullDevice::Get().Allocate(sz); }
+
+void default_deallocator(void*, void* mem) { NullDevice::Get().Deallocate(mem); }
+
+struct HandleImpl
+{
+    using StreamPtr = std::shared_ptr<typename std::remove_pointer<hipStream_t>::type>;
+
+    static StreamPtr reference_stream(hipStream_t s) { return StreamPtr{s, null_deleter{}}; }
+
+    void elapsed_time(hipEvent_t, hipEvent_t)
+    {
+        if(enable_profiling)
+            this->profiling_result = NullDevice::GetLastLaunchTime();
+    }
+
+    std::function<void(hipEvent_t, hipEvent_t)> elapsed_time_handler()
+    {
+        return std::bind(
+            &HandleImpl::elapsed_time, this, std::placeholders::_1, std::placeholders::_2);
+    }
+
+    bool enable_profiling  = false;
+    StreamPtr stream       = nullptr;
+    float profiling_result = 0.0;
+    int device             = 0;
+    Allocator allocator{};
+    KernelCache cache;
+};
+
+Handle::Handle(miopenAcceleratorQueue_t stream) : impl(new HandleImpl())
+{
+    this->impl->stream = HandleImpl::reference_stream(stream);
+    this->SetAllocator(nullptr, nullptr, nullptr);
+
+#if MIOPEN_USE_ROCBLAS
+    rhandle_ = CreateRocblasHandle();
+#endif
+    MIOPEN_LOG_NQI(*this);
+}
+
+Handle::Handle() : impl(new HandleImpl())
+{
+    this->impl->stream = HandleImpl::reference_stream(nullptr);
+    this->SetAllocator(nullptr, nullptr, nullptr);
+
+#if MIOPEN_USE_ROCBLAS
+    rhandle_ = CreateRocblasHandle();
+#endif
+    MIOPEN_LOG_NQI(*this);
+}
+
+Handle::~Handle() {}
+
+void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
+{
+    this->impl->stream = HandleImpl::reference_stream(streamID);
+
+#if MIOPEN_USE_ROCBLAS
+    rocblas_set_stream(this->rhandle_.get(), this->GetStream());
+#endif
+}
+
+miopenAcceleratorQueue_t Handle::GetStream() const { return impl->stream.get(); }
+
+void Handle::SetAllocator(miopenAllocatorFunction allocator,
+                          miopenDeallocatorFunction deallocator,
+                          void* allocatorContext) const
+{
+    this->impl->allocator.allocator   = allocator == nullptr ? default_allocator : allocator;
+    this->impl->allocator.deallocator = deallocator == nullptr ? default_deallocator : deallocator;
+
+    this->impl->allocator.context = allocatorContext;
+}
+
+void Handle::EnableProfiling(bool enable) const { this->impl->enable_profiling = enable; }
+
+float Handle::GetKernelTime() const { return this->impl->profiling_result; }
+
+Allocator::ManageDataPtr Handle::Create(std::size_t sz) const { return this->impl->allocator(sz); }
+
+Allocator::ManageDataPtr&
+Handle::WriteTo(const void* data, Allocator::ManageDataPtr& ddata, std::size_t sz) const
+{
+    std::memcpy(ddata.get(), data, sz);
+    return ddata;
+}
+
+void Handle::ReadTo(void* data, const Allocator::ManageDataPtr& ddata, std::size_t sz) const
+{
+    std::memcpy(data, ddata.get(), sz);
+}
+
+void Handle::Copy(ConstData_t src, Data_t dest, std::size_t size) const
+{
+    std::memmove(dest, src, size);
+}
+
+KernelInvoke Handle::AddKernel(const std::string& algorithm,
+                               const std::string& network_config,
+                               const std::string& program_name,
+                               const std::string& kernel_name,
+                               const std::vector<size_t>& vld,
+                               const std::vector<size_t>& vgd,
+                               const std::string& params,
+                               std::size_t cache_index,
+                               bool is_kernel_str,
+                               const std::string& kernel_src) const
+{
+
+    auto obj = this->impl->cache.AddKernel(*this,
+                                           algorithm,
+                                           network_config,
+                                           program_name,
+                                           kernel_name,
+                                           vld,
+                                           vgd,
+                                           params,
+                                           cache_index,
+                                           is_kernel_str,
+                                           kernel_src);
+    return this->Run(obj);
+}
+
+Invoker Handle::PrepareInvoker(const InvokerFactory& factory,
+                               const std::vector<solver::KernelInfo>& kernels) const
+{
+    std::vector<Kernel> built;
+    for(auto& k : kernels)
+    {
+        MIOPEN_LOG_I2("Preparing kernel: " << k.kernel_name);
+        const auto kernel = this->impl->cache.AddKernel(*this,
+                                                        "",
+                                                        "",
+                                                        k.kernel_file,
+                                                        k.kernel_name,
+                                                        k.l_wk,
+                                                        k.g_wk,
+                                                        k.comp_options,
+                                                        kernels.size());
+        built.push_back(kernel);
+    }
+    return MakeTracedInvoker(factory(built), kernels.empty() ? "" : kernels.front().kernel_name);
+}
+
+void Handle::ClearKernels(const std::string& algorithm, const std::string& network_config) const
+{
+    this->impl->cache.ClearKernels(algorithm, network_config);
+}
+
+const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
+                                                  const std::string& network_config) const
+{
+    return this->impl->cache.GetKernels(algorithm, network_config);
+}
+
+bool Handle::HasKernel(const std::string& algorithm, const std::string& network_config) const
+{
+    return this->impl->cache.HasKernels(algorithm, network_config);
+}
+
+KernelInvoke Handle::Run(Kernel k) const
+{
+    if(this->impl->enable_profiling || MIOPEN_GPU_SYNC)
+        return k.Invoke(this->GetStream(), this->impl->elapsed_time_handler());
+    else
+        return k.Invoke(this->GetStream());
+}
+
+Program Handle::LoadProgram(const std::string& program_name,
+                            std::string params,
+                            bool is_kernel_str,
+                            const std::string& kernel_src) const
+{
+    // Nothing to build or to cache, see NullDevice.
+    params += " -mcpu=" + this->GetDeviceName();
+    return HIPOCProgram{program_name, params, is_kernel_str, this->GetDeviceName(), kernel_src};
+}
+
+bool Handle::HasProgram(const std::string& program_name, const std::string& params) const
+{
+    return this->impl->cache.HasProgram(program_name, params);
+}
+
+void Handle::AddProgram(Program prog,
+                        const std::string& program_name,
+                        const std::string& params) const
+{
+    this->impl->cache.AddProgram(prog, program_name, params);
+}
+
+// Launches of the null device complete immediately.
+void Handle::Finish() const {}
+void Handle::Flush() const {}
+
+bool Handle::IsProfilingEnabled() const { return this->impl->enable_profiling; }
+
+void Handle::ResetKernelTime() const { this->impl->profiling_result = 0.0; }
+void Handle::AccumKernelTime(float curr_time) const { this->impl->profiling_result += curr_time; }
+
+std::size_t Handle::GetLocalMemorySize() const { return NullDeviceLocalMemory; }
+
+std::size_t Handle::GetGlobalMemorySize() const { return NullDeviceMemory; }
+
+std::size_t Handle::GetMaxComputeUnits() const
+{
+    const char* const num_cu = miopen::GetStringEnv(MIOPEN_DEVICE_CU{});
+    if(num_cu != nullptr && strlen(num_cu) > 0)
+    {
+        return boost::lexical_cast<std::size_t>(num_cu);
+    }
+    if(NullDevice::Get().IsHostExecution())
+        return std::max(std::thread::hardware_concurrency(), 1u);
+    return NullDeviceCUs;
+}
+
+std::size_t Handle::GetImage3dMaxWidth() const { return std::numeric_limits<int>::max(); }
+
+std::size_t Handle::GetWavefrontWidth() const { return NullDeviceWavefront; }
+
+std::size_t Handle::GetMaxMemoryAllocSize()
+{
+    if(m_MaxMemoryAllocSizeCached == 0)
+        m_MaxMemoryAllocSizeCached = floor(NullDeviceMemory * 0.85);
+
+    return m_MaxMemoryAllocSizeCached;
+}
+
+std::string Handle::GetDeviceName() const
+{
+    const char* const arch = miopen::GetStringEnv(MIOPEN_DEVICE_ARCH{});
+    if(arch != nullptr && strlen(arch) > 0)
+    {
+        return arch;
+    }
+    return NullDevice::Get().IsHostExecution() ? "cpu" : NullDeviceName;
+}
+
+std::ostream& Handle::Print(std::ostream& os) const
+{
+    os << "stream: " << this->impl->stream << ", device_id: null";
+    return os;
+}
+
+shared<Data_t> Handle::CreateSubBuffer(Data_t data, std::size_t offset, std::size_t)
+{
+    auto cdata = reinterpret_cast<char*>(data);
+    return {cdata + offset, null_deleter{}};
+}
+
+shared<ConstData_t> Handle::CreateSubBuffer(ConstData_t data, std::size_t offset, std::size_t)
+{
+    auto cdata = reinterpret_cast<const char*>(data);
+    return {cdata + offset, null_deleter{}};
+}
+
+#if MIOPEN_USE_ROCBLAS
+rocblas_handle_ptr Handle::CreateRocblasHandle() const
+{
+    rocblas_handle x = nullptr;
+    rocblas_create_handle(&x);
+    auto result = rocblas_handle_ptr{x};
+    rocblas_set_stream(result.get(), GetStream());
+    return result;
+}
+#endif
+} // namespace miopen
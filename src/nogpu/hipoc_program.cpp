@@ -0,0 +1,82 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/config.h>
+
+#include <miopen/hipoc_program.hpp>
+
+namespace miopen {
+
+/// Programs of the null device are neither built nor loaded: their kernels are only recorded
+/// when launched, see NullDevice.
+struct HIPOCProgramImpl
+{
+    HIPOCProgramImpl(const std::string& program_name) : program(program_name) {}
+    HIPOCProgramImpl(const std::string& program_name, const boost::filesystem::path& filespec)
+        : program(program_name), hsaco_file(filespec)
+    {
+    }
+    HIPOCProgramImpl(const std::string& program_name, const std::string& blob)
+        : program(program_name), binary(blob)
+    {
+    }
+
+    std::string program;
+    boost::filesystem::path hsaco_file;
+    std::string binary;
+};
+
+HIPOCProgram::HIPOCProgram() {}
+HIPOCProgram::HIPOCProgram(const std::string& program_name,
+                           std::string,
+                           bool,
+                           std::string,
+                           const std::string&)
+    : impl(std::make_shared<HIPOCProgramImpl>(program_name))
+{
+}
+
+HIPOCProgram::HIPOCProgram(const std::string& program_name, const boost::filesystem::path& hsaco)
+    : impl(std::make_shared<HIPOCProgramImpl>(program_name, hsaco))
+{
+}
+
+HIPOCProgram::HIPOCProgram(const std::string& program_name, const std::string& hsaco)
+    : impl(std::make_shared<HIPOCProgramImpl>(program_name, hsaco))
+{
+}
+
+hipModule_t HIPOCProgram::GetModule() const { return nullptr; }
+
+boost::filesystem::path HIPOCProgram::GetCodeObjectPathname() const { return impl->hsaco_file; }
+
+std::string HIPOCProgram::GetCodeObjectBlob() const
+{
+    return {impl->binary.data(), impl->binary.size()};
+}
+
+bool HIPOCProgram::IsCodeObjectInMemory() const { return !impl->binary.empty(); };
+
+} // namespace miopen
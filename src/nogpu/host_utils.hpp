@@ -0,0 +1,97 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_NOGPU_HOST_UTILS_HPP_
+#define GUARD_MIOPEN_NOGPU_HOST_UTILS_HPP_
+
+#include <miopen/errors.hpp>
+#include <miopen/par_for.hpp>
+#include <miopen/tensor.hpp>
+#include <miopen/visit_float.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace host {
+
+/// Reductions go up to 6 dimensions, the other primitives up to 5.
+constexpr std::size_t MaxDims = 6;
+using Coords                  = std::array<std::size_t, MaxDims>;
+
+inline std::size_t Offset(const std::vector<std::size_t>& strides, const Coords& coords)
+{
+    auto offset = std::size_t{0};
+    for(auto i = std::size_t{0}; i < strides.size(); ++i)
+        offset += coords[i] * strides[i];
+    return offset;
+}
+
+/// Calls f(coordinates of the first element, row length) for all the rows of a tensor, i.e. its
+/// slices along the last dimension, in parallel. Rows are grouped so a task is at least a few
+/// thousands of elements.
+template <class F>
+void ParForEachRow(const std::vector<std::size_t>& lens, F f)
+{
+    if(lens.size() > MaxDims)
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "Tensor dimension larger than " + std::to_string(MaxDims));
+
+    const auto row_length = lens.back();
+    auto rows             = std::size_t{1};
+    for(auto i = std::size_t{0}; i + 1 < lens.size(); ++i)
+        rows *= lens[i];
+    if(rows == 0 || row_length == 0)
+        return;
+
+    const auto grain = std::max<std::size_t>(1, 4096 / row_length);
+    par_for(rows, min_grain{grain}, [&](std::size_t row) {
+        auto coords = Coords{};
+        for(auto i = lens.size() - 1; i-- > 0;)
+        {
+            coords[i] = row % lens[i];
+            row /= lens[i];
+        }
+        f(coords, row_length);
+    });
+}
+
+/// Calls f(as_float) for the floating point types only.
+template <class F>
+void VisitFloatingPoint(miopenDataType_t type, F f)
+{
+    if(type != miopenFloat && type != miopenHalf && type != miopenBFloat16)
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "Only fp32, fp16 and bf16 are supported by the host execution");
+    visit_float(type, f);
+}
+
+} // namespace host
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_NOGPU_HOST_UTILS_HPP_
@@ -0,0 +1,198 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/host_primitives.hpp>
+
+#include <miopen/errors.hpp>
+#include <miopen/lrn.hpp>
+#include <miopen/tensor.hpp>
+
+#include "host_utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+namespace miopen {
+namespace host {
+namespace {
+
+struct Geometry
+{
+    Geometry(const LRNDescriptor& desc, const TensorDescriptor& xDesc)
+        : across(desc.GetMode() == miopenLRNCrossChannel),
+          area(desc.GetN()),
+          lower(static_cast<std::ptrdiff_t>((area - 1) / 2)),
+          upper(static_cast<std::ptrdiff_t>(area / 2))
+    {
+        std::tie(n, c, h, w) = tien<4>(xDesc.GetLengths());
+    }
+
+    /// Calls f(c, h, w) for the neighbours of (c, h, w) which are lower before and upper after
+    /// it, within the tensor.
+    template <class F>
+    void ForEachNeighbour(std::ptrdiff_t c_,
+                          std::ptrdiff_t h_,
+                          std::ptrdiff_t w_,
+                          std::ptrdiff_t before,
+                          std::ptrdiff_t after,
+                          F f) const
+    {
+        if(across)
+        {
+            const auto last = std::min(c_ + after + 1, c);
+            for(auto k = std::max<std::ptrdiff_t>(c_ - before, 0); k < last; ++k)
+                f(k, h_, w_);
+            return;
+        }
+        const auto h_last = std::min(h_ + after + 1, h);
+        const auto w_last = std::min(w_ + after + 1, w);
+        for(auto i = std::max<std::ptrdiff_t>(h_ - before, 0); i < h_last; ++i)
+            for(auto j = std::max<std::ptrdiff_t>(w_ - before, 0); j < w_last; ++j)
+                f(c_, i, j);
+    }
+
+    /// Calls f(c, h, w) for all the elements of the image, in parallel over the channels.
+    template <class F>
+    void ParForEach(F f) const
+    {
+        par_for(n * c, min_grain{1}, [&](std::size_t task) {
+            const auto plane = static_cast<std::ptrdiff_t>(task);
+            for(auto i = std::ptrdiff_t{0}; i < h; ++i)
+                for(auto j = std::ptrdiff_t{0}; j < w; ++j)
+                    f(plane / c, plane % c, i, j);
+        });
+    }
+
+    static std::size_t Offset(const TensorDescriptor& desc,
+                              std::ptrdiff_t n_,
+                              std::ptrdiff_t c_,
+                              std::ptrdiff_t h_,
+                              std::ptrdiff_t w_)
+    {
+        const auto& s = desc.GetStrides();
+        return n_ * s[0] + c_ * s[1] + h_ * s[2] + w_ * s[3];
+    }
+
+    /// The area of the within channel mode is the square of n.
+    double Area() const { return across ? area : static_cast<double>(area) * area; }
+
+    bool across;
+    unsigned int area;
+    std::ptrdiff_t lower;
+    std::ptrdiff_t upper;
+    std::ptrdiff_t n = 0;
+    std::ptrdiff_t c = 0;
+    std::ptrdiff_t h = 0;
+    std::ptrdiff_t w = 0;
+};
+
+} // namespace
+
+void LRNForward(const LRNDescriptor& desc,
+                const TensorDescriptor& xDesc,
+                ConstData_t x,
+                const TensorDescriptor& yDesc,
+                Data_t y,
+                bool do_backward,
+                Data_t workSpace)
+{
+    const auto g              = Geometry{desc, xDesc};
+    const auto alpha_per_area = desc.GetAlpha() / g.Area();
+    const auto beta           = desc.GetBeta();
+    const auto k              = desc.GetK();
+    const auto save_scale     = do_backward && workSpace != nullptr;
+
+    VisitFloatingPoint(xDesc.GetType(), [&](auto as_float) {
+        const auto x_data     = as_float(x);
+        const auto y_data     = as_float(y);
+        const auto scale_data = as_float(workSpace);
+
+        g.ParForEach([&](auto n, auto c, auto h, auto w) {
+            auto squares = 0.0;
+            g.ForEachNeighbour(c, h, w, g.lower, g.upper, [&](auto c_, auto h_, auto w_) {
+                const auto value = static_cast<double>(x_data[g.Offset(xDesc, n, c_, h_, w_)]);
+                squares += value * value;
+            });
+
+            const auto scale  = k + alpha_per_area * squares;
+            const auto x_val  = static_cast<double>(x_data[g.Offset(xDesc, n, c, h, w)]);
+            const auto offset = g.Offset(yDesc, n, c, h, w);
+            y_data[offset]    = as_float(x_val * std::pow(scale, -beta));
+            if(save_scale)
+                scale_data[offset] = as_float(scale);
+        });
+    });
+}
+
+void LRNBackward(const LRNDescriptor& desc,
+                 const TensorDescriptor& yDesc,
+                 ConstData_t y,
+                 const TensorDescriptor& dyDesc,
+                 ConstData_t dy,
+                 const TensorDescriptor& xDesc,
+                 ConstData_t x,
+                 const TensorDescriptor& dxDesc,
+                 Data_t dx,
+                 ConstData_t workSpace)
+{
+    if(workSpace == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm, "LRN backward needs the scales saved by the forward");
+
+    const auto g     = Geometry{desc, xDesc};
+    const auto beta  = desc.GetBeta();
+    const auto ratio = 2 * desc.GetAlpha() * beta / g.Area();
+
+    VisitFloatingPoint(xDesc.GetType(), [&](auto as_float) {
+        const auto y_data     = as_float(y);
+        const auto dy_data    = as_float(dy);
+        const auto x_data     = as_float(x);
+        const auto dx_data    = as_float(dx);
+        const auto scale_data = as_float(workSpace);
+
+        g.ParForEach([&](auto n, auto c, auto h, auto w) {
+            // The element is in the windows of the neighbours which are upper before and lower
+            // after it.
+            auto sum = 0.0;
+            g.ForEachNeighbour(c, h, w, g.upper, g.lower, [&](auto c_, auto h_, auto w_) {
+                const auto y_offset = g.Offset(yDesc, n, c_, h_, w_);
+                sum += static_cast<double>(y_data[y_offset]) *
+                       static_cast<double>(dy_data[g.Offset(dyDesc, n, c_, h_, w_)]) /
+                       static_cast<double>(scale_data[y_offset]);
+            });
+
+            const auto scale = static_cast<double>(scale_data[g.Offset(yDesc, n, c, h, w)]);
+            const auto grad  = static_cast<double>(dy_data[g.Offset(dyDesc, n, c, h, w)]);
+            const auto x_val = static_cast<double>(x_data[g.Offset(xDesc, n, c, h, w)]);
+            dx_data[g.Offset(dxDesc, n, c, h, w)] =
+                as_float(std::pow(scale, -beta) * grad - ratio * x_val * sum);
+        });
+    });
+}
+
+} // namespace host
+} // namespace miopen
@@ -0,0 +1,197 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/null_device.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_NOGPU_KERNEL_TIME_US)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_NOGPU_BANDWIDTH_GBPS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_NOGPU_LAUNCH_LOG_SIZE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_NOGPU_HOST_EXECUTION)
+
+namespace miopen {
+
+static float DefaultTime(const NullDeviceLaunch& launch)
+{
+    static const auto kernel_time_us = Value(MIOPEN_DEBUG_NOGPU_KERNEL_TIME_US{}, 10);
+    static const auto bandwidth_gbps = Value(MIOPEN_DEBUG_NOGPU_BANDWIDTH_GBPS{}, 1000);
+
+    auto time = kernel_time_us * 1e-3;
+    if(bandwidth_gbps != 0)
+        time += launch.bytes / (bandwidth_gbps * 1e6);
+    return static_cast<float>(time);
+}
+
+static thread_local float last_launch_time = 0.0f; // NOLINT
+
+NullDevice::NullDevice()
+    : log_size(Value(MIOPEN_DEBUG_NOGPU_LAUNCH_LOG_SIZE{}, 4096)),
+      host_execution(IsEnabled(MIOPEN_DEBUG_NOGPU_HOST_EXECUTION{}))
+{
+}
+
+NullDevice& NullDevice::Get()
+{
+    static NullDevice device;
+    return device;
+}
+
+void* NullDevice::Allocate(std::size_t size)
+{
+    // Zero-sized buffers still shall have distinct addresses.
+    const auto ptr = std::calloc(size == 0 ? 1 : size, 1);
+    if(ptr == nullptr)
+        MIOPEN_THROW(miopenStatusAllocFailed,
+                     "Null device failed to allocate buffer: " + std::to_string(size));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    allocations.emplace(static_cast<const char*>(ptr), size);
+    return ptr;
+}
+
+void NullDevice::Deallocate(void* ptr)
+{
+    if(ptr == nullptr)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        allocations.erase(static_cast<const char*>(ptr));
+    }
+    std::free(ptr);
+}
+
+std::size_t NullDevice::GetAllocatedSize() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto size = std::size_t{0};
+    for(const auto& allocation : allocations)
+        size += allocation.second;
+    return size;
+}
+
+std::size_t NullDevice::GetReferencedBytes(const void* args, std::size_t args_size) const
+{
+    // Kernel arguments are packed with natural alignment, so pointers may only be found at the
+    // offsets multiple of 8. Other arguments matching buffer addresses are counted as well,
+    // which is fine for an estimate.
+    auto bytes       = std::size_t{0};
+    auto referenced  = std::set<const char*>{};
+    const auto begin = static_cast<const char*>(args);
+
+    for(auto offset = std::size_t{0}; offset + sizeof(std::uintptr_t) <= args_size;
+        offset += sizeof(std::uintptr_t))
+    {
+        auto value = std::uintptr_t{0};
+        std::memcpy(&value, begin + offset, sizeof(value));
+        const auto ptr = reinterpret_cast<const char*>(value); // NOLINT
+
+        auto allocation = allocations.upper_bound(ptr);
+        if(allocation == allocations.begin())
+            continue;
+        --allocation;
+        const auto buffer_end = allocation->first + allocation->second;
+        if(ptr >= buffer_end || !referenced.insert(ptr).second)
+            continue;
+        bytes += buffer_end - ptr;
+    }
+
+    return bytes;
+}
+
+float NullDevice::Launch(const std::string& name,
+                         const std::array<std::size_t, 3>& ldims,
+                         const std::array<std::size_t, 3>& gdims,
+                         const void* args,
+                         std::size_t args_size)
+{
+    if(host_execution)
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "Kernel " + name + " cannot be executed in the host execution mode");
+
+    const auto args_begin = static_cast<const char*>(args);
+
+    auto launch  = NullDeviceLaunch{};
+    launch.name  = name;
+    launch.ldims = ldims;
+    launch.gdims = gdims;
+    launch.args.assign(args_begin, args_begin + args_size);
+
+    TimeModel model;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        launch.bytes = GetReferencedBytes(args, args_size);
+        model        = time_model;
+    }
+
+    // The model is called without the lock, so it may use the device.
+    launch.time      = model ? model(launch) : DefaultTime(launch);
+    last_launch_time = launch.time;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ++launch_count;
+    if(log_size == 0)
+        return launch.time;
+    if(launches.size() >= log_size)
+        launches.pop_front();
+    launches.push_back(launch);
+    return launch.time;
+}
+
+float NullDevice::GetLastLaunchTime() { return last_launch_time; }
+
+std::vector<NullDeviceLaunch> NullDevice::GetLaunches() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return {launches.begin(), launches.end()};
+}
+
+std::size_t NullDevice::GetLaunchCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return launch_count;
+}
+
+void NullDevice::ClearLaunches()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    launches.clear();
+    launch_count = 0;
+}
+
+void NullDevice::SetTimeModel(TimeModel model)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    time_model = std::move(model);
+}
+
+} // namespace miopen
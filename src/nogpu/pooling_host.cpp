@@ -0,0 +1,324 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/host_primitives.hpp>
+
+#include <miopen/errors.hpp>
+#include <miopen/pooling.hpp>
+#include <miopen/tensor.hpp>
+
+#include "host_utils.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace miopen {
+namespace host {
+namespace {
+
+using Dims3 = std::array<std::ptrdiff_t, 3>; // d, h, w
+using Dims5 = std::array<std::ptrdiff_t, 5>; // n, c, d, h, w
+
+/// 2D pooling is handled as 3D one of depth 1.
+Dims3 To3d(const std::vector<int>& v, int fill)
+{
+    if(v.size() == 3)
+        return {{v[0], v[1], v[2]}};
+    return {{fill, v[0], v[1]}};
+}
+
+Dims5 To5d(const std::vector<std::size_t>& v, std::size_t fill)
+{
+    const auto d = [&](std::size_t i) { return static_cast<std::ptrdiff_t>(v[i]); };
+    if(v.size() == 5)
+        return {{d(0), d(1), d(2), d(3), d(4)}};
+    return {{d(0), d(1), static_cast<std::ptrdiff_t>(fill), d(2), d(3)}};
+}
+
+struct Geometry
+{
+    Geometry(const PoolingDescriptor& desc,
+             const TensorDescriptor& xDesc,
+             const TensorDescriptor& yDesc)
+        : mode(desc.GetMode()),
+          index_mode(desc.GetWorkspaceIndexMode()),
+          index_type(desc.GetIndexType()),
+          kernel(To3d(desc.GetLengths(), 1)),
+          strides(To3d(desc.GetStrides(), 1)),
+          pads(To3d(desc.GetPads(), 0)),
+          x_strides(To5d(xDesc.GetStrides(), 0)),
+          y_strides(To5d(yDesc.GetStrides(), 0))
+    {
+        if(xDesc.GetSize() != 4 && xDesc.GetSize() != 5)
+            MIOPEN_THROW("Unsupported pooling dimension");
+
+        const auto x_lens = To5d(xDesc.GetLengths(), 1);
+        const auto y_lens = To5d(yDesc.GetLengths(), 1);
+        n                 = x_lens[0];
+        c                 = x_lens[1];
+        std::copy(x_lens.begin() + 2, x_lens.end(), x_size.begin());
+        std::copy(y_lens.begin() + 2, y_lens.end(), y_size.begin());
+    }
+
+    std::ptrdiff_t XPlane() const { return x_size[0] * x_size[1] * x_size[2]; }
+    std::ptrdiff_t YPlane() const { return y_size[0] * y_size[1] * y_size[2]; }
+
+    /// Unclipped window of the output position, start is the position of the kernel origin.
+    struct Window
+    {
+        Dims3 start;
+        Dims3 begin;
+        Dims3 end;
+        std::ptrdiff_t pool_size;
+    };
+
+    Window GetWindow(const Dims3& out) const
+    {
+        auto window        = Window{};
+        auto clipped_size  = std::ptrdiff_t{1};
+        auto kernel_volume = std::ptrdiff_t{1};
+        for(auto i = 0; i < 3; ++i)
+        {
+            window.start[i] = out[i] * strides[i] - pads[i];
+            window.begin[i] = std::max<std::ptrdiff_t>(window.start[i], 0);
+            window.end[i]   = std::min(window.start[i] + kernel[i], x_size[i]);
+            clipped_size *= std::max<std::ptrdiff_t>(window.end[i] - window.begin[i], 1);
+            kernel_volume *= kernel[i];
+        }
+        window.pool_size = mode == miopenPoolingAverageInclusive ? kernel_volume : clipped_size;
+        return window;
+    }
+
+    std::ptrdiff_t XIndex(std::ptrdiff_t n_, std::ptrdiff_t c_, const Dims3& pos) const
+    {
+        return n_ * x_strides[0] + c_ * x_strides[1] + pos[0] * x_strides[2] +
+               pos[1] * x_strides[3] + pos[2] * x_strides[4];
+    }
+
+    std::ptrdiff_t YIndex(std::ptrdiff_t n_, std::ptrdiff_t c_, const Dims3& pos) const
+    {
+        return n_ * y_strides[0] + c_ * y_strides[1] + pos[0] * y_strides[2] +
+               pos[1] * y_strides[3] + pos[2] * y_strides[4];
+    }
+
+    /// Position of the maximum as stored in the workspace.
+    std::size_t EncodeIndex(const Window& window, const Dims3& pos) const
+    {
+        if(index_mode == miopenPoolingWorkspaceIndexImage)
+            return (pos[0] * x_size[1] + pos[1]) * x_size[2] + pos[2];
+        return ((pos[0] - window.start[0]) * kernel[1] + pos[1] - window.start[1]) * kernel[2] +
+               pos[2] - window.start[2];
+    }
+
+    Dims3 DecodeIndex(const Window& window, std::size_t index) const
+    {
+        const auto i = static_cast<std::ptrdiff_t>(index);
+        if(index_mode == miopenPoolingWorkspaceIndexImage)
+            return {{i / (x_size[1] * x_size[2]), i / x_size[2] % x_size[1], i % x_size[2]}};
+        return {{window.start[0] + i / (kernel[1] * kernel[2]),
+                 window.start[1] + i / kernel[2] % kernel[1],
+                 window.start[2] + i % kernel[2]}};
+    }
+
+    bool IsInside(const Dims3& pos) const
+    {
+        for(auto i = 0; i < 3; ++i)
+            if(pos[i] < 0 || pos[i] >= x_size[i])
+                return false;
+        return true;
+    }
+
+    /// Calls f(output position, output index in the workspace) for the outputs of a plane.
+    template <class F>
+    void ForEachOutput(std::ptrdiff_t plane, F f) const
+    {
+        auto out   = Dims3{};
+        auto index = plane * YPlane();
+        for(out[0] = 0; out[0] < y_size[0]; ++out[0])
+            for(out[1] = 0; out[1] < y_size[1]; ++out[1])
+                for(out[2] = 0; out[2] < y_size[2]; ++out[2])
+                    f(out, index++);
+    }
+
+    miopenPoolingMode_t mode;
+    miopenPoolingWorkspaceIndexMode_t index_mode;
+    miopenIndexType_t index_type;
+    Dims3 kernel;
+    Dims3 strides;
+    Dims3 pads;
+    Dims5 x_strides;
+    Dims5 y_strides;
+    std::ptrdiff_t n = 0;
+    std::ptrdiff_t c = 0;
+    Dims3 x_size     = {};
+    Dims3 y_size     = {};
+};
+
+template <class F>
+void VisitIndex(miopenIndexType_t type, F f)
+{
+    switch(type)
+    {
+    case miopenIndexUint8: f(std::uint8_t{}); break;
+    case miopenIndexUint16: f(std::uint16_t{}); break;
+    case miopenIndexUint32: f(std::uint32_t{}); break;
+    case miopenIndexUint64: f(std::uint64_t{}); break;
+    }
+}
+
+template <class F>
+void ForEachWindowPosition(const Geometry::Window& window, F f)
+{
+    auto pos = Dims3{};
+    for(pos[0] = window.begin[0]; pos[0] < window.end[0]; ++pos[0])
+        for(pos[1] = window.begin[1]; pos[1] < window.end[1]; ++pos[1])
+            for(pos[2] = window.begin[2]; pos[2] < window.end[2]; ++pos[2])
+                f(pos);
+}
+
+} // namespace
+
+void PoolingForward(const PoolingDescriptor& desc,
+                    const TensorDescriptor& xDesc,
+                    ConstData_t x,
+                    const TensorDescriptor& yDesc,
+                    Data_t y,
+                    bool save_index,
+                    Data_t workSpace)
+{
+    const auto g = Geometry{desc, xDesc, yDesc};
+    save_index   = save_index && g.mode == miopenPoolingMax && workSpace != nullptr;
+
+    VisitFloatingPoint(xDesc.GetType(), [&](auto as_float) {
+        const auto x_data = as_float(x);
+        const auto y_data = as_float(y);
+
+        VisitIndex(g.index_type, [&](auto index_zero) {
+            using Index      = decltype(index_zero);
+            const auto index = static_cast<Index*>(workSpace);
+
+            par_for(g.n * g.c, min_grain{1}, [&](std::size_t task) {
+                const auto plane = static_cast<std::ptrdiff_t>(task);
+                const auto n     = plane / g.c;
+                const auto c     = plane % g.c;
+
+                g.ForEachOutput(plane, [&](const Dims3& out, std::ptrdiff_t y_index) {
+                    const auto window = g.GetWindow(out);
+                    auto result       = 0.0;
+
+                    if(g.mode == miopenPoolingMax)
+                    {
+                        auto max_pos = window.begin;
+                        result       = std::numeric_limits<double>::lowest();
+                        ForEachWindowPosition(window, [&](const Dims3& pos) {
+                            const auto value = static_cast<double>(x_data[g.XIndex(n, c, pos)]);
+                            if(value > result)
+                            {
+                                result  = value;
+                                max_pos = pos;
+                            }
+                        });
+                        if(save_index)
+                            index[y_index] = static_cast<Index>(g.EncodeIndex(window, max_pos));
+                    }
+                    else
+                    {
+                        ForEachWindowPosition(window, [&](const Dims3& pos) {
+                            result += static_cast<double>(x_data[g.XIndex(n, c, pos)]);
+                        });
+                        result /= window.pool_size;
+                    }
+
+                    y_data[g.YIndex(n, c, out)] = as_float(result);
+                });
+            });
+        });
+    });
+}
+
+void PoolingBackward(const PoolingDescriptor& desc,
+                     const TensorDescriptor& dyDesc,
+                     ConstData_t dy,
+                     const TensorDescriptor& dxDesc,
+                     Data_t dx,
+                     ConstData_t workSpace)
+{
+    const auto g = Geometry{desc, dxDesc, dyDesc};
+
+    if(g.mode == miopenPoolingMax && workSpace == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm, "Max pooling backward needs the workspace");
+
+    VisitFloatingPoint(dxDesc.GetType(), [&](auto as_float) {
+        const auto dy_data = as_float(dy);
+        const auto dx_data = as_float(dx);
+
+        VisitIndex(g.index_type, [&](auto index_zero) {
+            using Index      = decltype(index_zero);
+            const auto index = static_cast<const Index*>(workSpace);
+
+            // The windows overlap, so the gradients of a plane are accumulated by a single task.
+            par_for(g.n * g.c, min_grain{1}, [&](std::size_t task) {
+                const auto plane  = static_cast<std::ptrdiff_t>(task);
+                const auto n      = plane / g.c;
+                const auto c      = plane % g.c;
+                auto acc          = std::vector<double>(g.XPlane(), 0.0);
+                const auto acc_at = [&](const Dims3& pos) -> double& {
+                    return acc[(pos[0] * g.x_size[1] + pos[1]) * g.x_size[2] + pos[2]];
+                };
+
+                g.ForEachOutput(plane, [&](const Dims3& out, std::ptrdiff_t y_index) {
+                    const auto window = g.GetWindow(out);
+                    const auto grad   = static_cast<double>(dy_data[g.YIndex(n, c, out)]);
+
+                    if(g.mode == miopenPoolingMax)
+                    {
+                        const auto pos = g.DecodeIndex(window, index[y_index]);
+                        if(g.IsInside(pos))
+                            acc_at(pos) += grad;
+                    }
+                    else
+                    {
+                        ForEachWindowPosition(window, [&](const Dims3& pos) {
+                            acc_at(pos) += grad / window.pool_size;
+                        });
+                    }
+                });
+
+                auto pos = Dims3{};
+                for(pos[0] = 0; pos[0] < g.x_size[0]; ++pos[0])
+                    for(pos[1] = 0; pos[1] < g.x_size[1]; ++pos[1])
+                        for(pos[2] = 0; pos[2] < g.x_size[2]; ++pos[2])
+                            dx_data[g.XIndex(n, c, pos)] = as_float(acc_at(pos));
+            });
+        });
+    });
+}
+
+} // namespace host
+} // namespace miopen
@@ -0,0 +1,150 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/host_primitives.hpp>
+
+#include <miopen/errors.hpp>
+#include <miopen/float_equal.hpp>
+#include <miopen/reducetensor.hpp>
+#include <miopen/tensor.hpp>
+
+#include "host_utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace miopen {
+namespace host {
+
+void ReduceTensor(const ReduceTensorDescriptor& desc,
+                  Data_t indices,
+                  const void* alpha,
+                  const TensorDescriptor& aDesc,
+                  ConstData_t A,
+                  const void* beta,
+                  const TensorDescriptor& cDesc,
+                  Data_t C)
+{
+    const auto op      = desc.reduceTensorOp_;
+    const auto nan_opt = desc.reduceTensorNanOpt_;
+
+    if(aDesc.GetType() != cDesc.GetType())
+        MIOPEN_THROW(miopenStatusNotImplemented, "Conversions are not supported on the host");
+
+    auto init = 0.0;
+    switch(op)
+    {
+    case MIOPEN_REDUCE_TENSOR_ADD: init = 0; break;
+    case MIOPEN_REDUCE_TENSOR_MUL: init = 1; break;
+    case MIOPEN_REDUCE_TENSOR_MIN: init = std::numeric_limits<double>::max(); break;
+    case MIOPEN_REDUCE_TENSOR_MAX: init = std::numeric_limits<double>::lowest(); break;
+    default: MIOPEN_THROW(miopenStatusNotImplemented, "Unsupported reduction");
+    }
+
+    const auto need_indices = indices != nullptr &&
+                              desc.reduceTensorIndices_ == MIOPEN_REDUCE_TENSOR_FLATTENED_INDICES &&
+                              (op == MIOPEN_REDUCE_TENSOR_MIN || op == MIOPEN_REDUCE_TENSOR_MAX);
+
+    const auto& in_lens     = aDesc.GetLengths();
+    const auto& in_strides  = aDesc.GetStrides();
+    const auto& out_lens    = cDesc.GetLengths();
+    const auto& out_strides = cDesc.GetStrides();
+
+    auto invariant_dims = std::vector<std::size_t>{};
+    auto reduced_dims   = std::vector<std::size_t>{};
+    for(auto i = std::size_t{0}; i < in_lens.size(); ++i)
+        (out_lens[i] == in_lens[i] ? invariant_dims : reduced_dims).push_back(i);
+
+    const auto outputs = cDesc.GetElementSize();
+    const auto inputs  = aDesc.GetElementSize() / outputs;
+
+    VisitFloatingPoint(aDesc.GetType(), [&](auto as_float) {
+        const auto alpha_val = static_cast<double>(*as_float(alpha));
+        const auto beta_val  = static_cast<double>(*as_float(beta));
+        const auto use_beta  = !float_equal(beta_val, 0.0);
+        const auto a_data    = as_float(A);
+        const auto c_data    = as_float(C);
+        const auto index     = static_cast<int*>(indices);
+
+        par_for(outputs, min_grain{std::max<std::size_t>(1, 4096 / inputs)}, [&](std::size_t out) {
+            auto a_offset = std::size_t{0};
+            auto c_offset = std::size_t{0};
+            for(auto i = invariant_dims.size(); i-- > 0;)
+            {
+                const auto dim = invariant_dims[i];
+                a_offset += out % in_lens[dim] * in_strides[dim];
+                c_offset += out % in_lens[dim] * out_strides[dim];
+                out /= in_lens[dim];
+            }
+
+            // The reduced dimensions are traversed in the row-major order, so the index of an
+            // input is its position in this order.
+            auto acc       = init;
+            auto acc_index = 0;
+            auto counter   = Coords{};
+            for(auto input = 0; input < static_cast<int>(inputs); ++input)
+            {
+                const auto value = static_cast<double>(a_data[a_offset]);
+                if(nan_opt == MIOPEN_PROPAGATE_NAN && std::isnan(value))
+                {
+                    acc       = value;
+                    acc_index = input;
+                }
+                else if(op == MIOPEN_REDUCE_TENSOR_ADD)
+                    acc += value;
+                else if(op == MIOPEN_REDUCE_TENSOR_MUL)
+                    acc *= value;
+                else if(op == MIOPEN_REDUCE_TENSOR_MIN ? acc > value : acc < value)
+                {
+                    acc       = value;
+                    acc_index = input;
+                }
+
+                for(auto i = reduced_dims.size(); i-- > 0;)
+                {
+                    const auto dim = reduced_dims[i];
+                    a_offset += in_strides[dim];
+                    if(++counter[i] < in_lens[dim])
+                        break;
+                    a_offset -= counter[i] * in_strides[dim];
+                    counter[i] = 0;
+                }
+            }
+
+            acc *= alpha_val;
+            if(use_beta)
+                acc += beta_val * static_cast<double>(c_data[c_offset]);
+            c_data[c_offset] = as_float(acc);
+            if(need_indices)
+                index[c_offset] = acc_index;
+        });
+    });
+}
+
+} // namespace host
+} // namespace miopen
@@ -0,0 +1,181 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/host_primitives.hpp>
+
+#include <miopen/errors.hpp>
+#include <miopen/float_equal.hpp>
+#include <miopen/tensor.hpp>
+
+#include "host_utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+namespace miopen {
+namespace host {
+namespace {
+
+/// The softmax is computed over the vectors of the c*h*w elements of an image in the instance
+/// mode, or of the c elements of a pixel in the channel mode.
+struct Layout
+{
+    Layout(const TensorDescriptor& desc, miopenSoftmaxMode_t mode)
+        : instance(mode == MIOPEN_SOFTMAX_MODE_INSTANCE)
+    {
+        std::tie(n, c, h, w) = tien<4>(desc.GetLengths());
+        vectors              = instance ? n : n * h * w;
+        size                 = instance ? c * h * w : c;
+    }
+
+    /// Offset of the i-th element of a vector in a NCHW tensor of the given strides.
+    std::size_t Offset(const std::vector<std::size_t>& s, std::size_t vector, std::size_t i) const
+    {
+        if(instance)
+            return vector * s[0] + i / (h * w) * s[1] + i / w % h * s[2] + i % w * s[3];
+        return vector / (h * w) * s[0] + i * s[1] + vector / w % h * s[2] + vector % w * s[3];
+    }
+
+    template <class F>
+    void ParForEachVector(F f) const
+    {
+        par_for(vectors, min_grain{std::max<std::size_t>(1, 4096 / size)}, f);
+    }
+
+    bool instance;
+    std::size_t n       = 0;
+    std::size_t c       = 0;
+    std::size_t h       = 0;
+    std::size_t w       = 0;
+    std::size_t vectors = 0;
+    std::size_t size    = 0;
+};
+
+} // namespace
+
+void SoftmaxForward(float alpha,
+                    float beta,
+                    const TensorDescriptor& xDesc,
+                    ConstData_t x,
+                    const TensorDescriptor& yDesc,
+                    Data_t y,
+                    miopenSoftmaxAlgorithm_t algorithm,
+                    miopenSoftmaxMode_t mode,
+                    int x_offset,
+                    int y_offset)
+{
+    const auto layout   = Layout{yDesc, mode};
+    const auto use_beta = !float_equal(beta, 0.0f);
+
+    VisitFloatingPoint(yDesc.GetType(), [&](auto as_float) {
+        const auto x_data = as_float(x) + x_offset;
+        const auto y_data = as_float(y) + y_offset;
+
+        layout.ParForEachVector([&](std::size_t vector) {
+            const auto x_at = [&](std::size_t i) {
+                return static_cast<double>(x_data[layout.Offset(xDesc.GetStrides(), vector, i)]);
+            };
+
+            auto max = 0.0;
+            if(algorithm != MIOPEN_SOFTMAX_FAST)
+            {
+                max = std::numeric_limits<double>::lowest();
+                for(auto i = std::size_t{0}; i < layout.size; ++i)
+                    max = std::max(max, x_at(i));
+            }
+
+            auto sum = 0.0;
+            for(auto i = std::size_t{0}; i < layout.size; ++i)
+                sum += std::exp(x_at(i) - max);
+            const auto log_sum = std::log(sum);
+
+            for(auto i = std::size_t{0}; i < layout.size; ++i)
+            {
+                auto& y_val = y_data[layout.Offset(yDesc.GetStrides(), vector, i)];
+                auto value  = algorithm == MIOPEN_SOFTMAX_LOG ? x_at(i) - max - log_sum
+                                                             : std::exp(x_at(i) - max) / sum;
+                value *= alpha;
+                if(use_beta)
+                    value += beta * static_cast<double>(y_val);
+                y_val = as_float(value);
+            }
+        });
+    });
+}
+
+void SoftmaxBackward(float alpha,
+                     const TensorDescriptor& yDesc,
+                     ConstData_t y,
+                     const TensorDescriptor& dyDesc,
+                     ConstData_t dy,
+                     float beta,
+                     const TensorDescriptor& dxDesc,
+                     Data_t dx,
+                     miopenSoftmaxAlgorithm_t algorithm,
+                     miopenSoftmaxMode_t mode,
+                     int y_offset,
+                     int dy_offset,
+                     int dx_offset)
+{
+    const auto layout   = Layout{dxDesc, mode};
+    const auto use_beta = !float_equal(beta, 0.0f);
+
+    VisitFloatingPoint(dxDesc.GetType(), [&](auto as_float) {
+        const auto y_data  = as_float(y) + y_offset;
+        const auto dy_data = as_float(dy) + dy_offset;
+        const auto dx_data = as_float(dx) + dx_offset;
+
+        layout.ParForEachVector([&](std::size_t vector) {
+            const auto y_at = [&](std::size_t i) {
+                return static_cast<double>(y_data[layout.Offset(yDesc.GetStrides(), vector, i)]);
+            };
+            const auto dy_at = [&](std::size_t i) {
+                return static_cast<double>(dy_data[layout.Offset(dyDesc.GetStrides(), vector, i)]);
+            };
+
+            auto sum = 0.0;
+            for(auto i = std::size_t{0}; i < layout.size; ++i)
+                sum += algorithm == MIOPEN_SOFTMAX_LOG ? dy_at(i) : y_at(i) * dy_at(i);
+
+            for(auto i = std::size_t{0}; i < layout.size; ++i)
+            {
+                auto& dx_val = dx_data[layout.Offset(dxDesc.GetStrides(), vector, i)];
+                auto value   = algorithm == MIOPEN_SOFTMAX_LOG ? dy_at(i) - sum * std::exp(y_at(i))
+                                                              : y_at(i) * (dy_at(i) - sum);
+                value *= alpha;
+                if(use_beta)
+                    value += beta * static_cast<double>(dx_val);
+                dx_val = as_float(value);
+            }
+        });
+    });
+}
+
+} // namespace host
+} // namespace miopen
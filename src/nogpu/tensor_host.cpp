@@ -0,0 +1,216 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/host_primitives.hpp>
+
+#include <miopen/errors.hpp>
+#include <miopen/float_equal.hpp>
+#include <miopen/tensor.hpp>
+#include <miopen/visit_float.hpp>
+
+#include "host_utils.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace miopen {
+namespace host {
+
+void OpTensor(miopenTensorOp_t tensorOp,
+              const void* alpha0,
+              const TensorDescriptor& aTensorDesc,
+              ConstData_t ATensor,
+              const void* alpha1,
+              const TensorDescriptor& bTensorDesc,
+              ConstData_t BTensor,
+              const void* beta,
+              const TensorDescriptor& cTensorDesc,
+              Data_t CTensor,
+              std::size_t Aoffset,
+              std::size_t Boffset,
+              std::size_t Coffset)
+{
+    const auto& clens = cTensorDesc.GetLengths();
+    const auto& blens = bTensorDesc.GetLengths();
+
+    if(aTensorDesc.GetLengths() != clens || aTensorDesc.GetType() != cTensorDesc.GetType())
+        MIOPEN_THROW(miopenStatusNotImplemented, "A and C tensors of different shapes or types");
+
+    // B is broadcast along its dimensions of length 1.
+    auto b_strides = bTensorDesc.GetStrides();
+    for(auto i = std::size_t{0}; i < clens.size(); ++i)
+    {
+        if(blens[i] == 1)
+            b_strides[i] = 0;
+        else if(blens[i] != clens[i])
+            MIOPEN_THROW(miopenStatusNotImplemented, "B tensor is neither C-sized nor broadcast");
+    }
+
+    if(tensorOp != miopenTensorOpAdd && tensorOp != miopenTensorOpMul &&
+       tensorOp != miopenTensorOpMin && tensorOp != miopenTensorOpMax)
+        MIOPEN_THROW(miopenStatusBadParm, "Unknown tensor operation");
+
+    const auto apply = [tensorOp](float a, float b) {
+        switch(tensorOp)
+        {
+        case miopenTensorOpAdd: return a + b;
+        case miopenTensorOpMul: return a * b;
+        case miopenTensorOpMin: return std::min(a, b);
+        case miopenTensorOpMax: return std::max(a, b);
+        }
+        return a + b;
+    };
+
+    const auto a0_val   = *static_cast<const float*>(alpha0);
+    const auto a1_val   = *static_cast<const float*>(alpha1);
+    const auto beta_val = *static_cast<const float*>(beta);
+    const auto use_beta = !float_equal(beta_val, 0.0f);
+    const auto& a_str   = aTensorDesc.GetStrides();
+    const auto& c_str   = cTensorDesc.GetStrides();
+
+    VisitFloatingPoint(cTensorDesc.GetType(), [&](auto as_float) {
+        const auto a = as_float(ATensor) + Aoffset;
+        const auto b = as_float(BTensor) + Boffset;
+        const auto c = as_float(CTensor) + Coffset;
+
+        ParForEachRow(clens, [&](const Coords& coords, std::size_t n) {
+            const auto a_row = a + Offset(a_str, coords);
+            const auto b_row = b + Offset(b_strides, coords);
+            const auto c_row = c + Offset(c_str, coords);
+
+            for(auto i = std::size_t{0}; i < n; ++i)
+            {
+                auto& c_val = c_row[i * c_str.back()];
+                auto value  = apply(a0_val * static_cast<float>(a_row[i * a_str.back()]),
+                                   a1_val * static_cast<float>(b_row[i * b_strides.back()]));
+                if(use_beta)
+                    value += beta_val * static_cast<float>(c_val);
+                c_val = as_float(value);
+            }
+        });
+    });
+}
+
+void SetTensor(const TensorDescriptor& yDesc, Data_t y, const void* alpha, int offset)
+{
+    const auto& strides = yDesc.GetStrides();
+
+    visit_float(yDesc.GetType(), [&](auto as_float) {
+        const auto value = *as_float(alpha);
+        const auto data  = as_float(y) + offset;
+
+        ParForEachRow(yDesc.GetLengths(), [&](const Coords& coords, std::size_t n) {
+            const auto row = data + Offset(strides, coords);
+            for(auto i = std::size_t{0}; i < n; ++i)
+                row[i * strides.back()] = value;
+        });
+    });
+}
+
+void ScaleTensor(const TensorDescriptor& yDesc, Data_t y, const void* alpha, int offset)
+{
+    const auto& strides = yDesc.GetStrides();
+
+    visit_float(yDesc.GetType(), [&](auto as_float) {
+        const auto value = static_cast<float>(*as_float(alpha));
+        const auto data  = as_float(y) + offset;
+
+        ParForEachRow(yDesc.GetLengths(), [&](const Coords& coords, std::size_t n) {
+            const auto row = data + Offset(strides, coords);
+            for(auto i = std::size_t{0}; i < n; ++i)
+            {
+                auto& element = row[i * strides.back()];
+                element       = as_float(value * static_cast<float>(element));
+            }
+        });
+    });
+}
+
+void CopyTensor(const TensorDescriptor& srcDesc,
+                ConstData_t src,
+                const TensorDescriptor& dstDesc,
+                Data_t dst,
+                int srcOffset,
+                int dstOffset)
+{
+    const auto& src_str = srcDesc.GetStrides();
+    const auto& dst_str = dstDesc.GetStrides();
+
+    visit_float(srcDesc.GetType(), [&](auto as_float) {
+        const auto from = as_float(src) + srcOffset;
+        const auto to   = as_float(dst) + dstOffset;
+
+        ParForEachRow(srcDesc.GetLengths(), [&](const Coords& coords, std::size_t n) {
+            const auto from_row = from + Offset(src_str, coords);
+            const auto to_row   = to + Offset(dst_str, coords);
+            for(auto i = std::size_t{0}; i < n; ++i)
+                to_row[i * dst_str.back()] = from_row[i * src_str.back()];
+        });
+    });
+}
+
+void TransformTensor(const void* alpha,
+                     const TensorDescriptor& xDesc,
+                     ConstData_t x,
+                     const void* beta,
+                     const TensorDescriptor& yDesc,
+                     Data_t y,
+                     std::size_t Xoffset,
+                     std::size_t Yoffset)
+{
+    if(xDesc.GetType() != yDesc.GetType())
+        MIOPEN_THROW(miopenStatusNotImplemented, "Conversions are not supported on the host");
+
+    if(xDesc.GetLengths() != yDesc.GetLengths())
+        MIOPEN_THROW(miopenStatusBadParm, "Tensor x and y sizes do not match");
+
+    const auto& x_str = xDesc.GetStrides();
+    const auto& y_str = yDesc.GetStrides();
+
+    VisitFloatingPoint(yDesc.GetType(), [&](auto as_float) {
+        const auto alpha_val = static_cast<float>(*as_float(alpha));
+        const auto beta_val  = static_cast<float>(*as_float(beta));
+        const auto use_beta  = !float_equal(beta_val, 0.0f);
+        const auto from      = as_float(x) + Xoffset;
+        const auto to        = as_float(y) + Yoffset;
+
+        ParForEachRow(xDesc.GetLengths(), [&](const Coords& coords, std::size_t n) {
+            const auto x_row = from + Offset(x_str, coords);
+            const auto y_row = to + Offset(y_str, coords);
+            for(auto i = std::size_t{0}; i < n; ++i)
+            {
+                auto& y_val = y_row[i * y_str.back()];
+                auto value  = alpha_val * static_cast<float>(x_row[i * x_str.back()]);
+                if(use_beta)
+                    value += beta_val * static_cast<float>(y_val);
+                y_val = as_float(value);
+            }
+        });
+    });
+}
+
+} // namespace host
+} // namespace miopen
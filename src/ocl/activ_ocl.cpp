@@ -29,6 +29,11 @@
 #include <miopen/float_equal.hpp>
 #include <miopen/visit_float.hpp>
 
+#if MIOPEN_MODE_NOGPU
+#include <miopen/host_primitives.hpp>
+#include <miopen/null_device.hpp>
+#endif
+
 namespace miopen {
 
 miopenStatus_t ActivationDescriptor::Forward(Handle& handle,
@@ -46,6 +51,14 @@ miopenStatus_t ActivationDescriptor::Forward(Handle& handle,
     {
         MIOPEN_THROW("Only alpha=1 and beta=0 is supported");
     }
+#if MIOPEN_MODE_NOGPU
+    if(NullDevice::Get().IsHostExecution())
+    {
+        host::ActivationForward(*this, xDesc, x, yDesc, y, xOffset, yOffset);
+        return miopenStatusSuccess;
+    }
+#endif
+
     miopenStatus_t status = miopenStatusSuccess;
     mlo_construct_neuron construct_params(conv::Direction::Forward);
 
@@ -406,6 +419,26 @@ miopenStatus_t ActivationDescriptor::Backward(Handle& handle,
     {
         MIOPEN_THROW("Only alpha=1 and beta=0 is supported");
     }
+#if MIOPEN_MODE_NOGPU
+    if(NullDevice::Get().IsHostExecution())
+    {
+        host::ActivationBackward(*this,
+                                 yDesc,
+                                 y,
+                                 dyDesc,
+                                 dy,
+                                 xDesc,
+                                 x,
+                                 dxDesc,
+                                 dx,
+                                 yOffset,
+                                 dyOffset,
+                                 xOffset,
+                                 dxOffset);
+        return miopenStatusSuccess;
+    }
+#endif
+
     miopenStatus_t status = miopenStatusSuccess;
 
     mlo_construct_neuron construct_params(conv::Direction::BackwardData);
@@ -37,6 +37,11 @@
 #include <miopen/convolution.hpp>
 #include <miopen/mlo_internal.hpp>
 
+#if MIOPEN_MODE_NOGPU
+#include <miopen/host_primitives.hpp>
+#include <miopen/null_device.hpp>
+#endif
+
 #define WORKAROUND_SWDEV_253606 1
 #include <chrono>
 
@@ -99,6 +104,27 @@ void BatchNormForwardTraining(Handle& handle,
     {
         MIOPEN_THROW("Only alpha=1 and beta=0 is supported");
     }
+#if MIOPEN_MODE_NOGPU
+    if(NullDevice::Get().IsHostExecution())
+    {
+        host::BatchNormForwardTraining(bn_mode,
+                                       xDesc,
+                                       x,
+                                       yDesc,
+                                       y,
+                                       bnScaleBiasMeanVarDesc,
+                                       bnScale,
+                                       bnBias,
+                                       expAvgFactor,
+                                       resultRunningMean,
+                                       resultRunningVariance,
+                                       epsilon,
+                                       resultSaveMean,
+                                       resultSaveInvVariance);
+        return;
+    }
+#endif
+
     if(miopen::CheckNumericsEnabled())
     {
         miopen::checkNumericsInput(handle, xDesc, x);
@@ -686,6 +712,23 @@ void BatchNormForwardInference(Handle& handle,
             MIOPEN_LOG_E("Only alpha=1 and beta=0 is supported");
             MIOPEN_THROW(miopenStatusBadParm);
         }
+#if MIOPEN_MODE_NOGPU
+        if(NullDevice::Get().IsHostExecution())
+        {
+            host::BatchNormForwardInference(bn_mode,
+                                            xDesc,
+                                            x,
+                                            yDesc,
+                                            y,
+                                            bnScaleBiasMeanVarDesc,
+                                            bnScale,
+                                            bnBias,
+                                            estimatedMean,
+                                            estimatedVariance,
+                                            epsilon);
+            return;
+        }
+#endif
 
         bool bfpmixparm = false;
         bool bfp16parm  = false;
@@ -873,6 +916,26 @@ void BatchNormBackward(Handle& handle,
         MIOPEN_LOG_E("Only alphaParamDiff=1 and betaParamDiff=0 is supported");
         MIOPEN_THROW(miopenStatusBadParm);
     }
+#if MIOPEN_MODE_NOGPU
+    if(NullDevice::Get().IsHostExecution())
+    {
+        host::BatchNormBackward(bn_mode,
+                                xDesc,
+                                x,
+                                dyDesc,
+                                dy,
+                                dxDesc,
+                                dx,
+                                bnScaleBiasDiffDesc,
+                                bnScale,
+                                resultBnScaleDiff,
+                                resultBnBiasDiff,
+                                epsilon,
+                                savedMean,
+                                savedInvVariance);
+        return;
+    }
+#endif
 
     static const auto ctx = GetContext(handle);
 
@@ -39,6 +39,7 @@
 #include <miopen/invoker.hpp>
 #include <miopen/kernel.hpp>
 #include <miopen/solver.hpp>
+#include <miopen/solver_ranking.hpp>
 #include <miopen/tensor_ops.hpp>
 #include <miopen/tensor.hpp>
 #include <miopen/util.hpp>
@@ -54,6 +55,10 @@
 #include <miopen/gemm_v2.hpp>
 #endif
 
+#if MIOPEN_MODE_NOGPU
+#include <miopen/null_device.hpp>
+#endif
+
 #include <cassert>
 #include <type_traits>
 
@@ -69,6 +74,18 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_CONV_PRECISE_ROCBLAS_TIMING)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_FFT)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEVICE_ARCH)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMMED_FALLBACK)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMMED_FALLBACK_RANKING)
+
+/// GEMM kernels are launched by the BLAS libraries, which the host execution mode of the null
+/// device does not run, so GEMM is neither searched nor offered by the fallback then.
+static inline bool IsGemmDisabled()
+{
+#if MIOPEN_MODE_NOGPU
+    if(NullDevice::Get().IsHostExecution())
+        return true;
+#endif
+    return miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{});
+}
 
 #if MIOPEN_USE_GEMM
 #ifdef CPPCHECK
@@ -330,7 +347,7 @@ static void DirConvFindCore(Handle& handle,
     ValidateGroupCount(xDesc, wDesc, conv);
 
 #if MIOPEN_USE_GEMM
-    if(!use_winograd_only && !miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}) &&
+    if(!use_winograd_only && !IsGemmDisabled() &&
        !(IsAnyBufferBF16(xDesc, yDesc, wDesc) && !IsUseRocBlas))
     { // GEMM algo
         std::size_t in_n, in_c;
@@ -926,7 +943,7 @@ void ConvolutionDescriptor::ConvFwdGemm(Handle& handle,
                                         std::size_t workSpaceSize) const
 {
 #if MIOPEN_USE_GEMM
-    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}))
+    if(IsGemmDisabled())
     {
         MIOPEN_THROW("GEMM convolution is disabled");
     }
@@ -1346,7 +1363,134 @@ void ConvolutionDescriptor::ConvFwdGemm(Handle& handle,
 #endif
 }
 
-std::size_t ConvolutionDescriptor::GetFwdSolutionCountFallback(const TensorDescriptor& wDesc,
+static inline bool IsAlgorithmDisabled(const miopenConvAlgorithm_t algo)
+{
+    switch(algo)
+    { // clang-format off
+    case miopenConvolutionAlgoGEMM:
+        return IsGemmDisabled() || !MIOPEN_USE_GEMM;
+    case miopenConvolutionAlgoDirect:
+        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_DIRECT{});
+    case miopenConvolutionAlgoFFT:
+        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_FFT{});
+    case miopenConvolutionAlgoWinograd:
+        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_WINOGRAD{});
+    case miopenConvolutionAlgoImplicitGEMM:
+        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM{});
+    default: // Disable future algos by default to enforce explicit handling:
+        return true;
+    } // clang-format on
+}
+
+static int StringToConvolutionAlgo(const std::string& name, conv::Direction direction)
+{
+    switch(direction)
+    {
+    case conv::Direction::Forward: return StringToConvolutionFwdAlgo(name);
+    case conv::Direction::BackwardData: return StringToConvolutionBwdDataAlgo(name);
+    case conv::Direction::BackwardWeights: return StringToConvolutionBwdWeightsAlgo(name);
+    }
+    MIOPEN_THROW(miopenStatusInternalError);
+}
+
+/// On find-db miss, solvers are ranked by the model trained from the system find-db (see
+/// SolverRankingModel). Only the enabled and applicable ones which support immediate mode are
+/// returned, fastest first. GEMM is handled by the callers, its estimated time is returned via
+/// gemm_time (-1 if unknown).
+static std::vector<miopenConvSolution_t>
+GetRankedSolutionsFallback(Handle& handle, const ProblemDescription& problem, float& gemm_time)
+{
+    gemm_time = -1.0f;
+
+#if MIOPEN_MODE_NOGPU
+    // The model is trained on the GPU timings, which are meaningless for the host solver.
+    if(NullDevice::Get().IsHostExecution())
+    {
+        auto ctx = ConvolutionContext{problem};
+        ctx.SetStream(&handle);
+        const auto solver = solver::ConvDirectHost{};
+        if(IsAlgorithmDisabled(miopenConvolutionAlgoDirect) || !solver.IsApplicable(ctx))
+            return {};
+        const auto solver_id = solver::Id{solver::SolverDbId(solver)};
+        return {{-1.0f, 0, solver_id.Value(), miopenConvolutionAlgoDirect}};
+    }
+#endif
+
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK_RANKING{}))
+        return {};
+
+    const auto& model = GetSystemSolverRanking(handle);
+    if(model.IsEmpty())
+        return {};
+
+    const auto direction = problem.conv_problem.GetDirection();
+    const auto ranked    = model.Rank(problem.conv_problem.GetDbKey());
+    auto solutions       = std::vector<miopenConvSolution_t>{};
+
+    if(ranked.empty())
+        return solutions;
+
+    auto ctx = ConvolutionContext{problem};
+    ctx.SetStream(&handle);
+    ctx.DetectRocm();
+    const auto memo_key = solver::GetSolverMemoKey(ctx);
+
+    for(const auto& entry : ranked)
+    {
+        const auto solver_id = solver::Id{entry.solver};
+        if(!solver_id.IsValid())
+            continue;
+
+        if(solver_id == solver::Id::gemm())
+        {
+            gemm_time = entry.time;
+            continue;
+        }
+
+        const auto algo_name = solver_id.GetAlgo(direction);
+        const auto algo =
+            static_cast<miopenConvAlgorithm_t>(StringToConvolutionAlgo(algo_name, direction));
+        if(IsAlgorithmDisabled(algo) || !CheckInvokerSupport(algo_name))
+            continue;
+
+        const auto solver = solver_id.GetSolver();
+        if(solver.IsEmpty() || !solver.IsApplicable(ctx, memo_key))
+            continue;
+
+        MIOPEN_LOG_I("Fallback path, " << entry.solver << ", estimated time: " << entry.time);
+        solutions.push_back(
+            {entry.time, solver.GetWorkspaceSize(ctx, memo_key), solver_id.Value(), algo});
+    }
+
+    return solutions;
+}
+
+/// GEMM goes by its estimated time or last if there is none.
+static void AddGemmSolutionFallback(std::vector<miopenConvSolution_t>& solutions,
+                                    float gemm_time,
+                                    std::size_t workspace_size)
+{
+    const auto gemm = miopenConvSolution_t{
+        gemm_time, workspace_size, solver::Id::gemm().Value(), miopenConvolutionAlgoGEMM};
+    const auto is_slower = [&](const miopenConvSolution_t& s) { return s.time > gemm_time; };
+    const auto position =
+        gemm_time < 0 ? solutions.end()
+                      : std::find_if(solutions.begin(), solutions.end(), is_slower);
+    solutions.insert(position, gemm);
+}
+
+static void CopySolutionsFallback(const std::vector<miopenConvSolution_t>& interim,
+                                  const size_t maxSolutionCount,
+                                  size_t* const solutionCount,
+                                  miopenConvSolution_t* const solutions)
+{
+    const auto count = std::min(interim.size(), maxSolutionCount);
+    std::copy(interim.begin(), interim.begin() + count, solutions);
+    *solutionCount = count;
+}
+
+std::size_t ConvolutionDescriptor::GetFwdSolutionCountFallback(Handle& handle,
+                                                               const TensorDescriptor& wDesc,
                                                                const TensorDescriptor& xDesc,
                                                                const TensorDescriptor& yDesc) const
 {
@@ -1354,11 +1498,18 @@ std::size_t ConvolutionDescriptor::GetFwdSolutionCountFallback(const TensorDescr
     // Regular (find-db) path have been verified during Find().
     ValidateGroupCount(xDesc, wDesc, *this);
 
-    if(IsGemmApplicableFwd(wDesc, xDesc, yDesc) &&
-       !miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
+    if(!miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
     {
-        MIOPEN_LOG_I("Fallback path, GEMM");
-        return 1;
+        const auto problem =
+            ProblemDescription{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
+        auto gemm_time = -1.0f;
+        const auto n   = GetRankedSolutionsFallback(handle, problem, gemm_time).size() +
+                       (IsGemmApplicableFwd(wDesc, xDesc, yDesc) ? 1 : 0);
+        if(n > 0)
+        {
+            MIOPEN_LOG_I("Fallback path, " << n << " solution(s)");
+            return n;
+        }
     }
     MIOPEN_LOG_I("Fallback path, GEMM disabled");
     /// When count=0 the reason could be:
@@ -1376,17 +1527,25 @@ std::size_t ConvolutionDescriptor::GetFwdSolutionCountFallback(const TensorDescr
                  "Requested convolution is not supported or immedate mode fallback has failed.");
 }
 
-std::size_t ConvolutionDescriptor::GetBwdSolutionCountFallback(const TensorDescriptor& dyDesc,
+std::size_t ConvolutionDescriptor::GetBwdSolutionCountFallback(Handle& handle,
+                                                               const TensorDescriptor& dyDesc,
                                                                const TensorDescriptor& wDesc,
                                                                const TensorDescriptor& dxDesc) const
 {
     ValidateGroupCount(dxDesc, wDesc, *this); // See comment in Forward method.
 
-    if(IsGemmApplicableBwd(dyDesc, wDesc, dxDesc) &&
-       !miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
+    if(!miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
     {
-        MIOPEN_LOG_I("Fallback path, GEMM");
-        return 1;
+        const auto problem =
+            ProblemDescription{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
+        auto gemm_time = -1.0f;
+        const auto n   = GetRankedSolutionsFallback(handle, problem, gemm_time).size() +
+                       (IsGemmApplicableBwd(dyDesc, wDesc, dxDesc) ? 1 : 0);
+        if(n > 0)
+        {
+            MIOPEN_LOG_I("Fallback path, " << n << " solution(s)");
+            return n;
+        }
     }
     MIOPEN_LOG_I("Fallback path, GEMM disabled");
     // See comment in Forward method.
@@ -1399,7 +1558,7 @@ bool ConvolutionDescriptor::IsGemmApplicableWrw(const TensorDescriptor& dyDesc,
                                                 const TensorDescriptor& dwDesc) const
 {
 #if MIOPEN_USE_GEMM
-    if(!miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}) &&
+    if(!IsGemmDisabled() &&
        !(IsAnyBufferBF16(xDesc, dyDesc, dwDesc) && !IsUseRocBlas))
     {
         const std::size_t spatial_dim = GetSpatialDimension();
@@ -1431,7 +1590,7 @@ bool ConvolutionDescriptor::IsGemmApplicableFwd(const TensorDescriptor& wDesc,
                                                 const TensorDescriptor& yDesc) const
 {
 #if MIOPEN_USE_GEMM
-    return !miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}) &&
+    return !IsGemmDisabled() &&
            !(IsAnyBufferBF16(xDesc, yDesc, wDesc) && !IsUseRocBlas);
 #else
     std::ignore = wDesc;
@@ -1446,7 +1605,7 @@ bool ConvolutionDescriptor::IsGemmApplicableBwd(const TensorDescriptor& dyDesc,
                                                 const TensorDescriptor& dxDesc) const
 {
 #if MIOPEN_USE_GEMM
-    return !miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}) &&
+    return !IsGemmDisabled() &&
            !(IsAnyBufferBF16(dxDesc, dyDesc, wDesc) && !IsUseRocBlas);
 #else
     std::ignore = dyDesc;
@@ -1456,17 +1615,25 @@ bool ConvolutionDescriptor::IsGemmApplicableBwd(const TensorDescriptor& dyDesc,
 #endif
 }
 
-std::size_t ConvolutionDescriptor::GetWrwSolutionCountFallback(const TensorDescriptor& dyDesc,
+std::size_t ConvolutionDescriptor::GetWrwSolutionCountFallback(Handle& handle,
+                                                               const TensorDescriptor& dyDesc,
                                                                const TensorDescriptor& xDesc,
                                                                const TensorDescriptor& dwDesc) const
 {
     ValidateGroupCount(xDesc, dwDesc, *this); // See comment in Forward method.
 
-    if(IsGemmApplicableWrw(xDesc, dyDesc, dwDesc) &&
-       !miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
+    if(!miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
     {
-        MIOPEN_LOG_I("Fallback path, GEMM");
-        return 1;
+        const auto problem =
+            ProblemDescription{xDesc, dwDesc, dyDesc, *this, conv::Direction::BackwardWeights};
+        auto gemm_time = -1.0f;
+        const auto n   = GetRankedSolutionsFallback(handle, problem, gemm_time).size() +
+                       (IsGemmApplicableWrw(dyDesc, xDesc, dwDesc) ? 1 : 0);
+        if(n > 0)
+        {
+            MIOPEN_LOG_I("Fallback path, " << n << " solution(s)");
+            return n;
+        }
     }
     MIOPEN_LOG_I("Fallback path, GEMM disabled");
     // See comment in Forward method.
@@ -1492,26 +1659,7 @@ std::size_t ConvolutionDescriptor::GetForwardSolutionCount(Handle& handle,
     const auto n       = GetSolutionCount(handle, problem);
     if(n > 0)
         return n;
-    return GetFwdSolutionCountFallback(wDesc, xDesc, yDesc);
-}
-
-static inline bool IsAlgorithmDisabled(const miopenConvAlgorithm_t algo)
-{
-    switch(algo)
-    { // clang-format off
-    case miopenConvolutionAlgoGEMM:
-        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}) || !MIOPEN_USE_GEMM;
-    case miopenConvolutionAlgoDirect:
-        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_DIRECT{});
-    case miopenConvolutionAlgoFFT:
-        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_FFT{});
-    case miopenConvolutionAlgoWinograd:
-        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_WINOGRAD{});
-    case miopenConvolutionAlgoImplicitGEMM:
-        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM{});
-    default: // Disable future algos by default to enforce explicit handling:
-        return true;
-    } // clang-format on
+    return GetFwdSolutionCountFallback(handle, wDesc, xDesc, yDesc);
 }
 
 void GetSolutions(Handle& handle,
@@ -1530,7 +1678,6 @@ void GetSolutions(Handle& handle,
     }
 
     // Read all what we have, then sort and write out up to max asked.
-    // Fallback path currently returns only one solution, so no need to sort there.
     struct SortWrapper : miopenConvSolution_t // For emplace and sort.
     {
         SortWrapper(const float& t,
@@ -1553,6 +1700,7 @@ void GetSolutions(Handle& handle,
     auto ctx = ConvolutionContext{problem};
     ctx.SetStream(&handle);
     ctx.DetectRocm();
+    const auto memo_key = solver::GetSolverMemoKey(ctx);
 
     for(const auto& pair : fdb_record)
     {
@@ -1572,7 +1720,7 @@ void GetSolutions(Handle& handle,
         // gemm and fft are always applicable.
         // These can be disabled/enabled at algorithm level.
         if(solver_id != solver::Id::gemm())
-            if(!solver_id.GetSolver().IsApplicable(ctx))
+            if(!solver_id.GetSolver().IsApplicable(ctx, memo_key))
                 continue;
 
         interim.emplace_back(pair.second.time, pair.second.workspace, solver_id.Value(), algo);
@@ -1601,29 +1749,31 @@ void ConvolutionDescriptor::GetForwardSolutionsFallback(Handle& handle,
     // This check is needed on fallback path only.
     // Regular (find-db) path have been verified during Find().
     ValidateGroupCount(xDesc, wDesc, *this);
-    auto i = std::size_t{0};
 
-    if(IsGemmApplicableFwd(wDesc, xDesc, yDesc) &&
-       !miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
+    {
+        MIOPEN_LOG_I("Fallback path, GEMM disabled");
+        *solutionCount = 0;
+        return;
+    }
+
+    const auto problem = ProblemDescription{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
+    auto gemm_time     = -1.0f;
+    auto interim       = GetRankedSolutionsFallback(handle, problem, gemm_time);
+
+    if(IsGemmApplicableFwd(wDesc, xDesc, yDesc))
     {
         MIOPEN_LOG_I("Fallback path, GEMM");
-        if(i < maxSolutionCount)
-        {
-            solutions[i].algorithm = miopenConvolutionAlgoGEMM;
-            solutions[i].time      = -1.0; /// \todo Evaluate time.
-            solutions[i].workspace_size =
-                ForwardGetValidWorkSpaceSizeGemm(handle, wDesc, xDesc, yDesc);
-            solutions[i].solution_id = solver::Id::gemm().Value();
-            ++i;
-        }
+        AddGemmSolutionFallback(
+            interim, gemm_time, ForwardGetValidWorkSpaceSizeGemm(handle, wDesc, xDesc, yDesc));
     }
     else
         MIOPEN_LOG_I("Fallback path, GEMM disabled");
 
-    *solutionCount = i;
+    CopySolutionsFallback(interim, maxSolutionCount, solutionCount, solutions);
 }
 
-void ConvolutionDescriptor::GetBwdSolutionsFallback(Handle& /*handle*/,
+void ConvolutionDescriptor::GetBwdSolutionsFallback(Handle& handle,
                                                     const TensorDescriptor& dyDesc,
                                                     const TensorDescriptor& wDesc,
                                                     const TensorDescriptor& dxDesc,
@@ -1632,28 +1782,32 @@ void ConvolutionDescriptor::GetBwdSolutionsFallback(Handle& /*handle*/,
                                                     miopenConvSolution_t* const solutions) const
 {
     ValidateGroupCount(dxDesc, wDesc, *this);
-    auto i = std::size_t{0};
 
-    if(IsGemmApplicableBwd(dyDesc, wDesc, dxDesc) &&
-       !miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
+    {
+        MIOPEN_LOG_I("Fallback path, GEMM disabled");
+        *solutionCount = 0;
+        return;
+    }
+
+    const auto problem =
+        ProblemDescription{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
+    auto gemm_time = -1.0f;
+    auto interim   = GetRankedSolutionsFallback(handle, problem, gemm_time);
+
+    if(IsGemmApplicableBwd(dyDesc, wDesc, dxDesc))
     {
         MIOPEN_LOG_I("Fallback path, GEMM");
-        if(i < maxSolutionCount)
-        {
-            solutions[i].algorithm      = miopenConvolutionAlgoGEMM;
-            solutions[i].time           = -1.0; /// \todo Evaluate time.
-            solutions[i].workspace_size = BackwardGetValidWorkSpaceSizeGemm(dyDesc, wDesc, dxDesc);
-            solutions[i].solution_id    = solver::Id::gemm().Value();
-            ++i;
-        }
+        AddGemmSolutionFallback(
+            interim, gemm_time, BackwardGetValidWorkSpaceSizeGemm(dyDesc, wDesc, dxDesc));
     }
     else
         MIOPEN_LOG_I("Fallback path, GEMM disabled");
 
-    *solutionCount = i;
+    CopySolutionsFallback(interim, maxSolutionCount, solutionCount, solutions);
 }
 
-void ConvolutionDescriptor::GetWrwSolutionsFallback(Handle& /*handle*/,
+void ConvolutionDescriptor::GetWrwSolutionsFallback(Handle& handle,
                                                     const TensorDescriptor& dyDesc,
                                                     const TensorDescriptor& xDesc,
                                                     const TensorDescriptor& dwDesc,
@@ -1662,25 +1816,29 @@ void ConvolutionDescriptor::GetWrwSolutionsFallback(Handle& /*handle*/,
                                                     miopenConvSolution_t* const solutions) const
 {
     ValidateGroupCount(xDesc, dwDesc, *this);
-    auto i = std::size_t{0};
 
-    if(IsGemmApplicableWrw(dyDesc, xDesc, dwDesc) &&
-       !miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
+    {
+        MIOPEN_LOG_I("Fallback path, GEMM disabled");
+        *solutionCount = 0;
+        return;
+    }
+
+    const auto problem =
+        ProblemDescription{xDesc, dwDesc, dyDesc, *this, conv::Direction::BackwardWeights};
+    auto gemm_time = -1.0f;
+    auto interim   = GetRankedSolutionsFallback(handle, problem, gemm_time);
+
+    if(IsGemmApplicableWrw(dyDesc, xDesc, dwDesc))
     {
         MIOPEN_LOG_I("Fallback path, GEMM");
-        if(i < maxSolutionCount)
-        {
-            solutions[i].algorithm      = miopenConvolutionAlgoGEMM;
-            solutions[i].time           = -1.0; /// \todo Evaluate time.
-            solutions[i].workspace_size = WrwGetValidWorkSpaceSizeGemm(dyDesc, xDesc, dwDesc);
-            solutions[i].solution_id    = solver::Id::gemm().Value();
-            ++i;
-        }
+        AddGemmSolutionFallback(
+            interim, gemm_time, WrwGetValidWorkSpaceSizeGemm(dyDesc, xDesc, dwDesc));
     }
     else
         MIOPEN_LOG_I("Fallback path, GEMM disabled");
 
-    *solutionCount = i;
+    CopySolutionsFallback(interim, maxSolutionCount, solutionCount, solutions);
 }
 
 void ConvolutionDescriptor::GetForwardSolutions(Handle& handle,
@@ -1789,8 +1947,9 @@ std::size_t ConvolutionDescriptor::GetForwardSolutionWorkspaceSize(Handle& handl
         auto ctx = ConvolutionContext{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
         ctx.SetStream(&handle);
         ctx.DetectRocm();
-        if(sol.IsApplicable(ctx))
-            return sol.GetWorkspaceSize(ctx);
+        const auto memo_key = solver::GetSolverMemoKey(ctx);
+        if(sol.IsApplicable(ctx, memo_key))
+            return sol.GetWorkspaceSize(ctx, memo_key);
         else
         {
             MIOPEN_THROW(miopenStatusBadParm,
@@ -2076,7 +2235,7 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
             }
 
 #if MIOPEN_USE_GEMM
-            if(!use_winograd_only && !miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}) &&
+            if(!use_winograd_only && !IsGemmDisabled() &&
                !(IsAnyBufferBF16(dxDesc, dyDesc, wDesc) && !IsUseRocBlas))
             { // GEMM based
                 ValidateGroupCount(dxDesc, wDesc, *this);
@@ -2403,7 +2562,7 @@ void ConvolutionDescriptor::ConvBwdGemm(Handle& handle,
                                         std::size_t workSpaceSize) const
 {
 #if MIOPEN_USE_GEMM
-    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}))
+    if(IsGemmDisabled())
     {
         MIOPEN_THROW("GEMM convolution is disabled");
     }
@@ -2699,7 +2858,7 @@ std::size_t ConvolutionDescriptor::GetBackwardSolutionCount(Handle& handle,
     const auto count = GetSolutionCount(handle, problem);
     if(count > 0)
         return count;
-    return GetBwdSolutionCountFallback(dyDesc, wDesc, dxDesc);
+    return GetBwdSolutionCountFallback(handle, dyDesc, wDesc, dxDesc);
 }
 
 void ConvolutionDescriptor::GetBackwardSolutions(Handle& handle,
@@ -2760,8 +2919,9 @@ std::size_t ConvolutionDescriptor::GetBackwardSolutionWorkspaceSize(Handle& hand
         auto ctx = ConvolutionContext{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
         ctx.SetStream(&handle);
         ctx.DetectRocm();
-        if(sol.IsApplicable(ctx))
-            return sol.GetWorkspaceSize(ctx);
+        const auto memo_key = solver::GetSolverMemoKey(ctx);
+        if(sol.IsApplicable(ctx, memo_key))
+            return sol.GetWorkspaceSize(ctx, memo_key);
         else
         {
             MIOPEN_THROW(miopenStatusBadParm,
@@ -2881,7 +3041,7 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
     {
         perf_db = UserFindDbRecord::TryLoad(handle, problem, [&](DbRecord& record) {
 #if MIOPEN_USE_GEMM
-            if(!miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}) &&
+            if(!IsGemmDisabled() &&
                !(IsAnyBufferBF16(xDesc, dyDesc, dwDesc) && !IsUseRocBlas))
             {
                 const bool time_precision = (!IsDisabled(MIOPEN_CONV_PRECISE_ROCBLAS_TIMING{}));
@@ -3153,7 +3313,7 @@ void ConvolutionDescriptor::BackwardWeightsGemm(Handle& handle,
                                                 std::size_t workSpaceSize) const
 {
 #if MIOPEN_USE_GEMM
-    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}))
+    if(IsGemmDisabled())
     {
         MIOPEN_THROW("GEMM convolution is disabled");
     }
@@ -3371,7 +3531,7 @@ std::size_t ConvolutionDescriptor::GetWrwSolutionCount(Handle& handle,
     const auto count   = GetSolutionCount(handle, problem);
     if(count > 0)
         return count;
-    return GetWrwSolutionCountFallback(dyDesc, xDesc, dwDesc);
+    return GetWrwSolutionCountFallback(handle, dyDesc, xDesc, dwDesc);
 }
 
 void ConvolutionDescriptor::GetWrwSolutions(Handle& handle,
@@ -3432,8 +3592,9 @@ std::size_t ConvolutionDescriptor::GetWrwSolutionWorkspaceSize(Handle& handle,
         auto ctx = ConvolutionContext{problem};
         ctx.SetStream(&handle);
         ctx.DetectRocm();
-        if(sol.IsApplicable(ctx))
-            return sol.GetWorkspaceSize(ctx);
+        const auto memo_key = solver::GetSolverMemoKey(ctx);
+        if(sol.IsApplicable(ctx, memo_key))
+            return sol.GetWorkspaceSize(ctx, memo_key);
         else
         {
             MIOPEN_THROW(miopenStatusBadParm,
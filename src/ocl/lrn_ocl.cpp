@@ -28,6 +28,11 @@
 #include <miopen/float_equal.hpp>
 #include <miopen/visit_float.hpp>
 
+#if MIOPEN_MODE_NOGPU
+#include <miopen/host_primitives.hpp>
+#include <miopen/null_device.hpp>
+#endif
+
 namespace miopen {
 
 miopenStatus_t LRNDescriptor::Forward(Handle& handle,
@@ -43,6 +48,14 @@ miopenStatus_t LRNDescriptor::Forward(Handle& handle,
     if(!(xDesc.IsPacked() && yDesc.IsPacked()))
         MIOPEN_THROW("Only support packed tensors");
 
+#if MIOPEN_MODE_NOGPU
+    if(NullDevice::Get().IsHostExecution())
+    {
+        host::LRNForward(*this, xDesc, x, yDesc, y, do_backward, workSpace);
+        return miopenStatusSuccess;
+    }
+#endif
+
     miopenStatus_t status = miopenStatusSuccess;
     mlo_construct_norm construct_params(conv::Direction::Forward);
 
@@ -190,6 +203,14 @@ miopenStatus_t LRNDescriptor::Backward(Handle& handle,
                                        Data_t dx,
                                        ConstData_t workSpace) const
 {
+#if MIOPEN_MODE_NOGPU
+    if(NullDevice::Get().IsHostExecution())
+    {
+        host::LRNBackward(*this, yDesc, y, dyDesc, dy, xDesc, x, dxDesc, dx, workSpace);
+        return miopenStatusSuccess;
+    }
+#endif
+
     miopenStatus_t status = miopenStatusSuccess;
     mlo_construct_norm construct_params(conv::Direction::BackwardData);
 
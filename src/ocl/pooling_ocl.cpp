@@ -30,6 +30,11 @@
 #include <miopen/check_numerics.hpp>
 #include <miopen/datatype.hpp>
 
+#if MIOPEN_MODE_NOGPU
+#include <miopen/host_primitives.hpp>
+#include <miopen/null_device.hpp>
+#endif
+
 namespace miopen {
 
 // get the previous (less or equal to v) power of 2
@@ -105,6 +110,14 @@ miopenStatus_t PoolingDescriptor::Forward(Handle& handle,
     {
         MIOPEN_THROW("Only alpha=1 and beta=0 is supported");
     }
+#if MIOPEN_MODE_NOGPU
+    if(NullDevice::Get().IsHostExecution())
+    {
+        host::PoolingForward(*this, xDesc, x, yDesc, y, save_index, workSpace);
+        return miopenStatusSuccess;
+    }
+#endif
+
     if(miopen::CheckNumericsEnabled())
     {
         miopen::checkNumericsInput(handle, xDesc, x);
@@ -389,6 +402,14 @@ miopenStatus_t PoolingDescriptor::Backward(Handle& handle,
     {
         MIOPEN_THROW("Only alpha=1 and beta=0 is supported");
     }
+#if MIOPEN_MODE_NOGPU
+    if(NullDevice::Get().IsHostExecution())
+    {
+        host::PoolingBackward(*this, dyDesc, dy, dxDesc, dx, workSpace);
+        return miopenStatusSuccess;
+    }
+#endif
+
     if(miopen::CheckNumericsEnabled())
     {
         // miopen::checkNumericsInput(handle, yDesc, y); // not actually used?
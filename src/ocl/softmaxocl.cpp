@@ -29,6 +29,11 @@
 #include <miopen/check_numerics.hpp>
 #include <miopen/tensor.hpp>
 
+#if MIOPEN_MODE_NOGPU
+#include <miopen/host_primitives.hpp>
+#include <miopen/null_device.hpp>
+#endif
+
 namespace miopen {
 
 int nextPow2(int v)
@@ -78,6 +83,23 @@ miopenStatus_t SoftmaxForward(const Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm, "Tensor dimension lengths do not match.");
     }
 
+#if MIOPEN_MODE_NOGPU
+    if(NullDevice::Get().IsHostExecution())
+    {
+        host::SoftmaxForward(*(static_cast<const float*>(alpha)),
+                             *(static_cast<const float*>(beta)),
+                             xDesc,
+                             x,
+                             yDesc,
+                             y,
+                             algorithm,
+                             mode,
+                             x_offset,
+                             y_offset);
+        return miopenStatusSuccess;
+    }
+#endif
+
     int n, c, h, w;
     std::tie(n, c, h, w) = tien<4>(yDesc.GetLengths());
 
@@ -348,6 +370,26 @@ miopenStatus_t SoftmaxBackward(const Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm, "Tensor dimension lengths do not match.");
     }
 
+#if MIOPEN_MODE_NOGPU
+    if(NullDevice::Get().IsHostExecution())
+    {
+        host::SoftmaxBackward(*(static_cast<const float*>(alpha)),
+                              yDesc,
+                              y,
+                              dyDesc,
+                              dy,
+                              *(static_cast<const float*>(beta)),
+                              dxDesc,
+                              dx,
+                              algorithm,
+                              mode,
+                              y_offset,
+                              dy_offset,
+                              dx_offset);
+        return miopenStatusSuccess;
+    }
+#endif
+
     if(miopen::CheckNumericsEnabled())
     {
         miopen::checkNumericsInput(handle, yDesc, y);
@@ -31,6 +31,12 @@
 #include <miopen/datatype.hpp>
 #include <miopen/visit_float.hpp>
 #include <miopen/util.hpp>
+
+#if MIOPEN_MODE_NOGPU
+#include <miopen/host_primitives.hpp>
+#include <miopen/null_device.hpp>
+#endif
+
 #include <algorithm>
 #include <cassert>
 #include <numeric>
@@ -1292,6 +1298,26 @@ void OpTensor(const Handle& handle,
         }
     }
 
+#if MIOPEN_MODE_NOGPU
+    if(NullDevice::Get().IsHostExecution())
+    {
+        host::OpTensor(tensorOp,
+                       alpha0,
+                       aTensorDesc,
+                       ATensor,
+                       alpha1,
+                       bTensorDesc,
+                       BTensor,
+                       beta,
+                       cTensorDesc,
+                       CTensor,
+                       Aoffset,
+                       Boffset,
+                       Coffset);
+        return;
+    }
+#endif
+
     auto bsize = blens.size();
     if(bsize == 3)
     {
@@ -1404,6 +1430,14 @@ void SetTensor(const Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm);
     }
 
+#if MIOPEN_MODE_NOGPU
+    if(NullDevice::Get().IsHostExecution())
+    {
+        host::SetTensor(yDesc, y, alpha, offset);
+        return;
+    }
+#endif
+
     const TensorDescriptor yDesc_flat = GetFlattenedTensorDescriptor(yDesc);
 
 #ifndef NDEBUG
@@ -1563,6 +1597,14 @@ void ScaleTensor(const Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm);
     }
 
+#if MIOPEN_MODE_NOGPU
+    if(NullDevice::Get().IsHostExecution())
+    {
+        host::ScaleTensor(yDesc, y, alpha, offset);
+        return;
+    }
+#endif
+
     const TensorDescriptor yDesc_flat = GetFlattenedTensorDescriptor(yDesc);
 
 #ifndef NDEBUG
@@ -1741,6 +1783,14 @@ void CopyTensor(const Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm, "Tensor dimension lengths do not match.");
     }
 
+#if MIOPEN_MODE_NOGPU
+    if(NullDevice::Get().IsHostExecution())
+    {
+        host::CopyTensor(srcDesc, src, dstDesc, dst, srcOffset, dstOffset);
+        return;
+    }
+#endif
+
     auto flat_descriptors = GetConsistentFlattenedTensorDescriptors(srcDesc, dstDesc);
     const TensorDescriptor& srcDesc_flat = std::get<0>(flat_descriptors);
     const TensorDescriptor& dstDesc_flat = std::get<1>(flat_descriptors);
@@ -2174,6 +2224,14 @@ void TransformTensor(const Handle& handle,
         MIOPEN_THROW("Tensor x and y batch sizes do not match");
     }
 
+#if MIOPEN_MODE_NOGPU
+    if(NullDevice::Get().IsHostExecution())
+    {
+        host::TransformTensor(alpha, xDesc, x, beta, yDesc, y, Xoffset, Yoffset);
+        return;
+    }
+#endif
+
     if(xDesc.GetType() == miopenInt8 && yDesc.GetType() == miopenInt8 && x_len.size() >= 3)
     {
         if(x_len[1] <= y_len[1])
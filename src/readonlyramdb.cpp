@@ -25,7 +25,9 @@
  *******************************************************************************/
 
 #include <miopen/readonlyramdb.hpp>
+#include <miopen/env.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/statistics.hpp>
 #include <miopen/errors.hpp>
 
 #if MIOPEN_EMBED_DB
@@ -34,28 +36,61 @@
 
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/path.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <iterator>
 #include <mutex>
 #include <sstream>
-#include <map>
 
 namespace miopen {
 extern boost::optional<std::string>&
 testing_find_db_path_override(); /// \todo Remove when #1723 is resolved.
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_FIND_DB_BINARY)
+
+/// Precompiled binary dbs are used instead of text ones when available unless disabled.
+static bool IsBinaryEnabled() { return !miopen::IsDisabled(MIOPEN_DEBUG_FIND_DB_BINARY{}); }
+
+ReadonlyRamDb::ReadonlyRamDb(std::string path) : db_path(path) {}
+
+ReadonlyRamDb::~ReadonlyRamDb() = default;
+
+std::atomic<ReadonlyRamDb*>& ReadonlyRamDb::Instances()
+{
+    static std::atomic<ReadonlyRamDb*> instances{nullptr};
+    return instances;
+}
+
+ReadonlyRamDb* ReadonlyRamDb::FindInstance(ReadonlyRamDb* head, const std::string& path)
+{
+    for(auto instance = head; instance != nullptr; instance = instance->next)
+        if(instance->db_path == path)
+            return instance;
+    return nullptr;
+}
+
 ReadonlyRamDb& ReadonlyRamDb::GetCached(const std::string& path,
                                         bool warn_if_unreadable,
                                         const std::string& /*arch*/,
                                         const std::size_t /*num_cu*/)
 {
+    // Instances are published fully loaded and never change afterwards, so once an instance is
+    // created it can be found without a lock.
+    const auto found = FindInstance(Instances().load(std::memory_order_acquire), path);
+    if(found != nullptr)
+        return *found;
+
     static std::mutex mutex;
     const std::lock_guard<std::mutex> lock{mutex};
 
-    static auto instances = std::map<std::string, ReadonlyRamDb*>{};
-    const auto it         = instances.find(path);
-
-    if(it != instances.end())
-        return *it->second;
+    const auto head     = Instances().load(std::memory_order_acquire);
+    const auto existing = FindInstance(head, path);
+    if(existing != nullptr)
+        return *existing;
 
     // The ReadonlyRamDb objects allocated here by "new" shall be alive during
     // the calling app lifetime. Size of each is very small, and there couldn't
@@ -65,14 +100,17 @@ ReadonlyRamDb& ReadonlyRamDb::GetCached(const std::string& path,
     // these objects thus avoiding bothering with MP/MT syncronization.
     // These will be destroyed altogether with heap.
     auto instance = new ReadonlyRamDb{path};
-    instances.emplace(path, instance);
     instance->Prefetch(path, warn_if_unreadable);
+    instance->next = head;
+    Instances().store(instance, std::memory_order_release);
     return *instance;
 }
 
 template <class TFunc>
-static auto Measure(const std::string& funcName, TFunc&& func)
+static auto Measure(const char* funcName, TFunc&& func)
 {
+    MIOPEN_TRACE_SPAN("db", funcName);
+
     if(!miopen::IsLogging(LoggingLevel::Info))
         return func();
 
@@ -82,42 +120,171 @@ static auto Measure(const std::string& funcName, TFunc&& func)
     MIOPEN_LOG_I("Db::" << funcName << " time: " << (end - start).count() * .000001f << " ms");
 }
 
-void ReadonlyRamDb::ParseAndLoadDb(std::istream& input_stream,
-                                   const std::string& path,
-                                   bool warn_if_unreadable)
+void ReadonlyRamDb::Parse(const std::string& path)
 {
-    if(!input_stream)
+    const auto end = data + size;
+    auto n_line    = 0;
+
+    for(auto line_begin = data; line_begin < end;)
     {
-        const auto log_level = (warn_if_unreadable && !MIOPEN_DISABLE_SYSDB) ? LoggingLevel::Warning
-                                                                             : LoggingLevel::Info;
-        MIOPEN_LOG(log_level, "File is unreadable: " << path);
-        return;
+        const auto eol =
+            static_cast<const char*>(std::memchr(line_begin, '\n', end - line_begin));
+        const auto line_end  = eol != nullptr ? eol : end;
+        const auto next_line = eol != nullptr ? eol + 1 : end;
+        ++n_line;
+
+        if(line_end != line_begin)
+        {
+            const auto key_end =
+                static_cast<const char*>(std::memchr(line_begin, '=', line_end - line_begin));
+
+            if(key_end == nullptr || key_end == line_begin)
+            {
+                MIOPEN_LOG_E("Ill-formed record: key not found: " << path << "#" << n_line);
+            }
+            else
+            {
+                entries.push_back({static_cast<std::size_t>(line_begin - data),
+                                   static_cast<std::uint32_t>(key_end - line_begin),
+                                   static_cast<std::uint32_t>(line_end - key_end - 1),
+                                   n_line});
+            }
+        }
+
+        line_begin = next_line;
     }
 
-    auto line   = std::string{};
-    auto n_line = 0;
+    // Stable sort keeps records with the same key in file order, and the first one is used.
+    std::stable_sort(entries.begin(), entries.end(), [&](const Entry& l, const Entry& r) {
+        return Compare(l, data + r.line_begin, r.key_size) < 0;
+    });
+}
 
-    while(std::getline(input_stream, line))
-    {
-        ++n_line;
+int ReadonlyRamDb::Compare(const Entry& entry, const char* key, std::size_t key_size) const
+{
+    const auto common = std::min<std::size_t>(entry.key_size, key_size);
+    const auto cmp    = std::memcmp(data + entry.line_begin, key, common);
+    if(cmp != 0)
+        return cmp;
+    return entry.key_size < key_size ? -1 : (entry.key_size > key_size ? 1 : 0);
+}
 
-        if(line.empty())
-            continue;
+boost::optional<DbRecord> ReadonlyRamDb::FindRecord(const std::string& problem) const
+{
+    static auto& hits   = Statistics::Counter("readonly_ram_db.hits");
+    static auto& misses = Statistics::Counter("readonly_ram_db.misses");
 
-        const auto key_size = line.find('=');
-        const bool is_key   = (key_size != std::string::npos && key_size != 0);
+    MIOPEN_LOG_I2("Looking for key " << problem << " in file " << db_path);
 
-        if(!is_key)
+    if(binary.IsOpen())
+    {
+        auto match = BinaryDbView::Match{};
+        if(!binary.Find(problem, match))
         {
-            MIOPEN_LOG_E("Ill-formed record: key not found: " << path << "#" << n_line);
-            continue;
+            ++misses;
+            return boost::none;
         }
+        ++hits;
+        return MakeRecord(problem, match.contents_begin, match.contents_end, match.n_line);
+    }
 
-        const auto key      = line.substr(0, key_size);
-        const auto contents = line.substr(key_size + 1);
+    const auto it = std::lower_bound(
+        entries.begin(), entries.end(), problem, [&](const Entry& entry, const std::string& key) {
+            return Compare(entry, key.data(), key.size()) < 0;
+        });
 
-        cache.emplace(key, CacheItem{n_line, contents});
+    if(it == entries.end() || Compare(*it, problem.data(), problem.size()) != 0)
+    {
+        ++misses;
+        return boost::none;
     }
+
+    ++hits;
+    const auto contents_begin = data + it->line_begin + it->key_size + 1;
+    const auto contents_end   = contents_begin + it->contents_size;
+    return MakeRecord(problem, contents_begin, contents_end, it->n_line);
+}
+
+boost::optional<DbRecord> ReadonlyRamDb::MakeRecord(const std::string& problem,
+                                                    const char* contents_begin,
+                                                    const char* contents_end,
+                                                    int n_line) const
+{
+    auto record = DbRecord{problem};
+
+    if(!record.ParseContents(contents_begin, contents_end))
+    {
+        MIOPEN_LOG_E("Error parsing payload under the key: " << problem << " form file "
+                                                             << db_path
+                                                             << "#"
+                                                             << n_line);
+        MIOPEN_LOG_E("Contents: " << std::string(contents_begin, contents_end));
+        return boost::none;
+    }
+
+    return record;
+}
+
+// The text db may have been edited or replaced since the binary one has been generated. Its
+// contents are only hashed when the modification time differs, e.g. after installation. The binary
+// db is used on its own when the text one is missing.
+bool ReadonlyRamDb::IsBinaryActual(const std::string& path) const
+{
+    auto error           = boost::system::error_code{};
+    const auto text_size = boost::filesystem::file_size(path, error);
+    if(error)
+        return true;
+    if(text_size != binary.GetSourceSize())
+        return false;
+
+    const auto text_time = boost::filesystem::last_write_time(path, error);
+    if(!error && text_time == binary.GetSourceTime())
+        return true;
+
+    auto file = std::ifstream{path, std::ios::binary};
+    if(!file)
+        return false;
+    const auto text = std::string{std::istreambuf_iterator<char>{file}, {}};
+    return binary.IsSource(text.data(), text.size());
+}
+
+bool ReadonlyRamDb::OpenBinary(const std::string& path)
+{
+    const auto binary_path = GetBinaryDbPath(path);
+    auto error             = boost::system::error_code{};
+
+    if(!boost::filesystem::exists(binary_path, error))
+        return false;
+
+    try
+    {
+        namespace bip = boost::interprocess;
+        const auto mapping = bip::file_mapping{binary_path.c_str(), bip::read_only};
+        region             = std::make_unique<bip::mapped_region>(mapping, bip::read_only);
+    }
+    catch(const boost::interprocess::interprocess_exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to map file " << binary_path << ": " << ex.what());
+        return false;
+    }
+
+    if(!binary.Open(static_cast<const char*>(region->get_address()), region->get_size()))
+    {
+        MIOPEN_LOG_W("Unsupported binary db: " << binary_path);
+        region.reset();
+        return false;
+    }
+
+    if(!IsBinaryActual(path))
+    {
+        MIOPEN_LOG_I("Binary db is out of date, using the text one: " << binary_path);
+        binary = BinaryDbView{};
+        region.reset();
+        return false;
+    }
+
+    MIOPEN_LOG_I2("Using binary db: " << binary_path);
+    return true;
 }
 
 void ReadonlyRamDb::Prefetch(const std::string& path, bool warn_if_unreadable)
@@ -129,22 +296,54 @@ void ReadonlyRamDb::Prefetch(const std::string& path, bool warn_if_unreadable)
         {
 #if MIOPEN_EMBED_DB
             boost::filesystem::path filepath(path);
+
+            // Both forms are embedded from the same source, so the binary one is always actual.
+            if(IsBinaryEnabled())
+            {
+                const auto& it_b =
+                    miopen_data().find(GetBinaryDbPath(filepath.filename().string()) + ".o");
+                if(it_b != miopen_data().end() &&
+                   binary.Open(it_b->second.first, it_b->second.second - it_b->second.first))
+                {
+                    MIOPEN_LOG_I2("Using In Memory binary db: " << filepath);
+                    return;
+                }
+            }
+
             const auto& it_p = miopen_data().find(filepath.filename().string() + ".o");
             if(it_p == miopen_data().end())
                 MIOPEN_THROW(miopenStatusInternalError,
                              "Unknown database: " + filepath.string() + " in internal filesystem");
 
             const auto& p = it_p->second;
-            ptrdiff_t sz  = p.second - p.first;
             MIOPEN_LOG_I2("Loading In Memory file: " << filepath);
-            auto input_stream = std::stringstream(std::string(p.first, sz));
-            ParseAndLoadDb(input_stream, path, warn_if_unreadable);
+            // Embedded data lives as long as the library, so it is used in place.
+            data = p.first;
+            size = p.second - p.first;
+            Parse(path);
 #endif
         }
         else
         {
-            auto input_stream = std::ifstream{path};
-            ParseAndLoadDb(input_stream, path, warn_if_unreadable);
+            if(IsBinaryEnabled() && OpenBinary(path))
+                return;
+
+            auto input_stream = std::ifstream{path, std::ios::binary};
+
+            if(!input_stream)
+            {
+                const auto log_level = (warn_if_unreadable && !MIOPEN_DISABLE_SYSDB)
+                                           ? LoggingLevel::Warning
+                                           : LoggingLevel::Info;
+                MIOPEN_LOG(log_level, "File is unreadable: " << path);
+                return;
+            }
+
+            storage.assign(std::istreambuf_iterator<char>{input_stream},
+                           std::istreambuf_iterator<char>{});
+            data = storage.data();
+            size = storage.size();
+            Parse(path);
         }
 
     });
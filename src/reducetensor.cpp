@@ -31,6 +31,11 @@
 #include <miopen/handle.hpp>
 #include <miopen/reducetensor.hpp>
 
+#if MIOPEN_MODE_NOGPU
+#include <miopen/host_primitives.hpp>
+#include <miopen/null_device.hpp>
+#endif
+
 #include <cassert>
 #include <cstddef>
 #include <algorithm>
@@ -405,6 +410,14 @@ void ReduceTensorDescriptor::ReduceTensor(const Handle& handle,
     if(indices_sizeInBytes > indicesSizeInBytes)
         MIOPEN_THROW("The indices size allocated is not enough!");
 
+#if MIOPEN_MODE_NOGPU
+    if(NullDevice::Get().IsHostExecution())
+    {
+        host::ReduceTensor(*this, indices, alpha, aDesc, A, beta, cDesc, C);
+        return;
+    }
+#endif
+
     // void* ws_buf1_global = static_cast<void*>(workspace);
     Data_t ws_buf1_global     = workspace;
     long ws_buf2_bytes_offset = 0;
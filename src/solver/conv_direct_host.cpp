@@ -0,0 +1,71 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/solver.hpp>
+
+#include <miopen/config.h>
+#include <miopen/errors.hpp>
+
+#if MIOPEN_MODE_NOGPU
+#include <miopen/conv/invokers/direct_host.hpp>
+#include <miopen/null_device.hpp>
+#endif
+
+namespace miopen {
+namespace solver {
+
+bool ConvDirectHost::IsApplicable(const ConvolutionContext& ctx) const
+{
+#if MIOPEN_MODE_NOGPU
+    if(!NullDevice::Get().IsHostExecution())
+        return false;
+    return (ctx.Is2d() || ctx.Is3d()) && ctx.IsFp32() && ctx.IsLayoutDefault();
+#else
+    (void)ctx;
+    return false;
+#endif
+}
+
+ConvSolution ConvDirectHost::GetSolution(const ConvolutionContext& ctx) const
+{
+#if !MIOPEN_MODE_NOGPU
+    // The invoker is only built for the null device, see IsApplicable().
+    (void)ctx;
+    MIOPEN_THROW(miopenStatusNotImplemented, "ConvDirectHost requires the HIPNOGPU backend");
+#else
+    const auto& conv     = ctx.conv_problem.GetConv();
+    const auto direction = ctx.conv_problem.GetDirection();
+
+    auto solution            = ConvSolution{miopenStatusSuccess};
+    solution.workspce_sz     = 0;
+    solution.invoker_factory = [conv, direction](const std::vector<Kernel>&) {
+        return conv::MakeDirectHostInvoker(conv, direction);
+    };
+    return solution;
+#endif
+}
+
+} // namespace solver
+} // namespace miopen
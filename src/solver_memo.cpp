@@ -0,0 +1,117 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/solver_memo.hpp>
+
+#include <miopen/conv/context.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+
+#include <sstream>
+
+namespace miopen {
+namespace solver {
+
+SolverMemo& SolverMemo::Instance()
+{
+    // Leaked, as solvers may be queried from destructors of other statics.
+    static auto& instance = *new SolverMemo{miopen::Value(MIOPEN_DEBUG_SOLVER_MEMO_SIZE{}, 4096)};
+    return instance;
+}
+
+SolverMemo::SolverMemo(std::size_t capacity_) : capacity(capacity_) {}
+
+StatCounter& SolverMemo::Hits()
+{
+    static auto& hits = Statistics::Counter("solver_memo.hits");
+    return hits;
+}
+
+StatCounter& SolverMemo::Misses()
+{
+    static auto& misses = Statistics::Counter("solver_memo.misses");
+    return misses;
+}
+
+void SolverMemo::Invalidate()
+{
+    const std::lock_guard<std::mutex> lock{mutex};
+    ++epoch;
+    entries.clear();
+    lru.clear();
+}
+
+SolverMemo::Entry* SolverMemo::FindUnsafe(const std::string& entry_key)
+{
+    const auto it = entries.find(entry_key);
+    if(it == entries.end())
+        return nullptr;
+    lru.splice(lru.begin(), lru, it->second);
+    return &*it->second;
+}
+
+SolverMemo::Entry& SolverMemo::InsertUnsafe(const std::string& entry_key)
+{
+    const auto entry = FindUnsafe(entry_key);
+    if(entry != nullptr)
+        return *entry;
+
+    lru.push_front(Entry{entry_key, {}, {}, {}});
+    entries.emplace(entry_key, lru.begin());
+
+    while(entries.size() > capacity)
+    {
+        entries.erase(lru.back().key);
+        lru.pop_back();
+    }
+
+    return lru.front();
+}
+
+std::string GetSolverMemoKey(const ConvolutionContext& ctx)
+{
+    auto& memo = SolverMemo::Instance();
+    if(!memo.IsEnabled())
+        return {};
+
+    // The packed key of the problem covers everything solvers check, including the strides of
+    // tensors and the trailing pads. It has fixed size and goes first, so that the text part
+    // need not be delimited. The legacy fields of the context are added too, as some callers
+    // modify them after construction.
+    const auto& key = ctx.conv_problem.GetKey();
+    std::ostringstream ss;
+    ss.write(reinterpret_cast<const char*>(&key), sizeof(key));
+    ctx.Serialize(ss);
+    ss << '|' << ctx.GetStream().GetDbBasename() << '|' << ctx.rmv.getValue() << '|'
+       << ctx.do_search << ctx.save_srch_req << ctx.use_asm_kernels << ctx.use_hip_kernels
+       << ctx.use_opencl_convolutions << ctx.use_binaries << ctx.disable_search_enforce
+       << ctx.disable_perfdb_access
+       << ctx.skip_solutions_that_take_long_time_to_build_and_have_narrow_coverage
+       << ctx.use_dynamic_solutions_only << '|' << ctx.general_compile_options;
+    return ss.str();
+}
+
+} // namespace solver
+} // namespace miopen
@@ -0,0 +1,611 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/solver_ranking.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <tuple>
+#include <unordered_map>
+
+namespace miopen {
+
+constexpr std::size_t SolverRankingProblem::feature_count;
+constexpr std::size_t SolverRankingModel::default_neighbours;
+
+struct SolverRankingHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint32_t feature_count;
+    std::uint32_t solver_count;
+    std::uint32_t category_count;
+    std::uint32_t sample_count;
+    std::uint32_t entry_count;
+    std::uint32_t names_size;
+};
+
+static const char SolverRankingMagic[8]               = {'M', 'I', 'O', 'P', 'E', 'N', 'R', 'K'};
+static constexpr std::uint32_t SolverRankingVersion   = 1;
+static constexpr std::uint32_t SolverRankingByteOrder = 0x01020304;
+
+/// Features are stored as fixed point numbers with 8 fractional bits.
+static constexpr double FeatureScale = 256;
+
+static std::vector<std::string> Split(const std::string& text, char separator)
+{
+    auto parts = std::vector<std::string>{};
+    auto begin = std::size_t{0};
+
+    while(true)
+    {
+        const auto end = text.find(separator, begin);
+        if(end == std::string::npos)
+        {
+            parts.push_back(text.substr(begin));
+            return parts;
+        }
+        parts.push_back(text.substr(begin, end - begin));
+        begin = end + 1;
+    }
+}
+
+static bool ParseUnsigned(const std::string& text, std::uint64_t& value)
+{
+    if(text.empty() || text.size() > 18 ||
+       !std::all_of(text.begin(), text.end(), [](char c) { return c >= '0' && c <= '9'; }))
+        return false;
+    value = std::strtoull(text.c_str(), nullptr, 10);
+    return true;
+}
+
+/// Parses "AxB" or "AxBxC" into the last values of a 3-element array.
+static bool ParseDims(const std::string& text, std::size_t spatial_dims, std::uint64_t* values)
+{
+    const auto parts = Split(text, 'x');
+    if(parts.size() != spatial_dims)
+        return false;
+    for(auto i = std::size_t{0}; i < spatial_dims; ++i)
+        if(!ParseUnsigned(parts[i], values[3 - spatial_dims + i]))
+            return false;
+    return true;
+}
+
+bool ParseSolverRankingProblem(const std::string& db_key, SolverRankingProblem& problem)
+{
+    // 2d: C-H-W-YxX-K-oH-oW-N-PxQ-UxV-LxJ-bias-layout(s)-type-direction[_gG]
+    // 3d: C-D-H-W-ZxYxX-K-oD-oH-oW-N-PxQxR-UxVxW-LxJxK-bias-layout(s)-type-direction[_gG]
+    const auto tokens = Split(db_key, '-');
+    const auto filter = std::find_if(tokens.begin(), tokens.end(), [](const std::string& token) {
+                            return token.find('x') != std::string::npos;
+                        }) -
+                        tokens.begin();
+
+    if(filter != 3 && filter != 4)
+        return false;
+
+    const auto spatial_dims = static_cast<std::size_t>(filter - 1);
+    const auto dims_count   = 2 * spatial_dims + 8; // Up to bias.
+
+    // One layout for the default ones, three otherwise.
+    if(tokens.size() != dims_count + 3 && tokens.size() != dims_count + 5)
+        return false;
+
+    // Depth of 2d problems is 1.
+    std::uint64_t in[3]        = {1, 1, 1};
+    std::uint64_t wei[3]       = {1, 1, 1};
+    std::uint64_t out[3]       = {1, 1, 1};
+    std::uint64_t pads[3]      = {0, 0, 0};
+    std::uint64_t strides[3]   = {1, 1, 1};
+    std::uint64_t dilations[3] = {1, 1, 1};
+    auto c = std::uint64_t{0};
+    auto k = std::uint64_t{0};
+    auto n = std::uint64_t{0};
+    auto bias = std::uint64_t{0};
+    auto at   = std::size_t{0};
+
+    const auto parse_spatial = [&](std::uint64_t* values) {
+        for(auto i = std::size_t{0}; i < spatial_dims; ++i)
+            if(!ParseUnsigned(tokens[at++], values[3 - spatial_dims + i]))
+                return false;
+        return true;
+    };
+
+    if(!ParseUnsigned(tokens[at++], c) || !parse_spatial(in) ||
+       !ParseDims(tokens[at++], spatial_dims, wei) || !ParseUnsigned(tokens[at++], k) ||
+       !parse_spatial(out) || !ParseUnsigned(tokens[at++], n) ||
+       !ParseDims(tokens[at++], spatial_dims, pads) ||
+       !ParseDims(tokens[at++], spatial_dims, strides) ||
+       !ParseDims(tokens[at++], spatial_dims, dilations) || !ParseUnsigned(tokens[at++], bias))
+        return false;
+
+    const auto& direction = tokens.back();
+    if(direction.empty() || (direction[0] != 'F' && direction[0] != 'B' && direction[0] != 'W') ||
+       (direction.size() > 1 && direction[1] != '_'))
+        return false;
+
+    // Optional part of the key. Unknown entries are ignored.
+    auto group = std::uint64_t{1};
+    for(const auto& option : Split(direction.substr(1), '_'))
+        if(option.size() > 1 && option[0] == 'g' && !ParseUnsigned(option.substr(1), group))
+            return false;
+    if(group == 0)
+        return false;
+
+    problem.category.clear();
+    for(; at < tokens.size() - 1; ++at)
+        problem.category += tokens[at] + '-';
+    problem.category += direction[0];
+    problem.category += spatial_dims == 3 ? "-3d" : "-2d";
+    if(group != 1)
+        problem.category += "-g";
+
+    // clang-format off
+    const std::array<std::uint64_t, SolverRankingProblem::feature_count> values = {{
+        c, in[0], in[1], in[2], wei[0], wei[1], wei[2], k, out[0], out[1], out[2], n,
+        pads[0], pads[1], pads[2], strides[0], strides[1], strides[2],
+        dilations[0], dilations[1], dilations[2], group}};
+    // clang-format on
+
+    for(auto i = std::size_t{0}; i < values.size(); ++i)
+        problem.features[i] = static_cast<float>(std::log2(1.0 + static_cast<double>(values[i])));
+
+    // Output of the forward convolution is the input of the backward ones.
+    const auto& fwd_out = direction[0] == 'F' ? out : in;
+    problem.flops       = 2.0 * static_cast<double>(n) * static_cast<double>(c) *
+                    static_cast<double>(k) / static_cast<double>(group) *
+                    static_cast<double>(wei[0] * wei[1] * wei[2]) *
+                    static_cast<double>(fwd_out[0] * fwd_out[1] * fwd_out[2]);
+    return true;
+}
+
+std::vector<SolverRankingSample> ParseSolverRankingSamples(const std::string& text,
+                                                           std::size_t& ill_formed)
+{
+    auto samples = std::vector<SolverRankingSample>{};
+    auto stream  = std::istringstream{text};
+    auto line    = std::string{};
+    ill_formed   = 0;
+
+    while(std::getline(stream, line))
+    {
+        if(!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if(line.empty())
+            continue;
+
+        const auto key_end = line.find('=');
+        if(key_end == std::string::npos || key_end == 0)
+        {
+            ++ill_formed;
+            continue;
+        }
+
+        auto sample = SolverRankingSample{line.substr(0, key_end), {}};
+        auto is_ok  = true;
+
+        // algorithm:solver,time,workspace,algorithm name,kernel cache key
+        for(const auto& item : Split(line.substr(key_end + 1), ';'))
+        {
+            const auto id_end = item.find(':');
+            const auto values = id_end != std::string::npos ? Split(item.substr(id_end + 1), ',')
+                                                            : std::vector<std::string>{};
+            if(values.size() < 2 || values[0].empty() || values[1].empty())
+            {
+                is_ok = false;
+                break;
+            }
+
+            char* time_end  = nullptr;
+            const auto time = std::strtof(values[1].c_str(), &time_end);
+            if(*time_end != '\0')
+            {
+                is_ok = false;
+                break;
+            }
+            sample.times.emplace_back(values[0], time);
+        }
+
+        if(is_ok && !sample.times.empty())
+            samples.push_back(std::move(sample));
+        else
+            ++ill_formed;
+    }
+
+    return samples;
+}
+
+template <std::size_t N>
+static std::array<std::int16_t, N> Quantize(const std::array<float, N>& features)
+{
+    auto quantized = std::array<std::int16_t, N>{};
+    for(auto i = std::size_t{0}; i < N; ++i)
+        quantized[i] = static_cast<std::int16_t>(std::lround(features[i] * FeatureScale));
+    return quantized;
+}
+
+SolverRankingModel SolverRankingModel::Train(const std::vector<SolverRankingSample>& input)
+{
+    struct Parsed
+    {
+        SolverRankingProblem problem;
+        std::vector<Entry> entries;
+    };
+
+    auto model       = SolverRankingModel{};
+    auto by_category = std::map<std::string, std::vector<Parsed>>{};
+    auto solver_ids  = std::unordered_map<std::string, std::uint32_t>{};
+
+    for(const auto& sample : input)
+    {
+        auto parsed = Parsed{};
+        if(!ParseSolverRankingProblem(sample.db_key, parsed.problem) || !(parsed.problem.flops > 0))
+            continue;
+
+        for(const auto& time : sample.times)
+        {
+            // Failed or not measured.
+            if(!(time.second > 0) || !std::isfinite(time.second))
+                continue;
+
+            const auto id = solver_ids.emplace(time.first, model.solvers.size());
+            if(id.second)
+                model.solvers.push_back(time.first);
+
+            const auto value =
+                static_cast<float>(std::log2(time.second / parsed.problem.flops));
+            const auto solver = id.first->second;
+            const auto same   = std::find_if(
+                parsed.entries.begin(), parsed.entries.end(), [&](const Entry& entry) {
+                    return entry.solver == solver;
+                });
+
+            if(same == parsed.entries.end())
+                parsed.entries.push_back({solver, value});
+            else
+                same->log2_time_per_flop = std::min(same->log2_time_per_flop, value);
+        }
+
+        if(!parsed.entries.empty())
+            by_category[parsed.problem.category].push_back(std::move(parsed));
+    }
+
+    for(const auto& category : by_category)
+    {
+        model.category_names.push_back(category.first);
+        model.categories.push_back({static_cast<std::uint32_t>(model.samples.size()),
+                                    static_cast<std::uint32_t>(category.second.size())});
+
+        for(const auto& parsed : category.second)
+        {
+            model.samples.push_back({Quantize(parsed.problem.features),
+                                     static_cast<std::uint32_t>(model.entries.size()),
+                                     static_cast<std::uint32_t>(parsed.entries.size())});
+            model.entries.insert(model.entries.end(), parsed.entries.begin(), parsed.entries.end());
+        }
+    }
+
+    return model;
+}
+
+std::vector<RankedSolver> SolverRankingModel::Rank(const std::string& db_key,
+                                                   std::size_t neighbours) const
+{
+    auto problem = SolverRankingProblem{};
+    if(!ParseSolverRankingProblem(db_key, problem))
+        return {};
+    return Rank(problem, neighbours);
+}
+
+std::vector<RankedSolver> SolverRankingModel::Rank(const SolverRankingProblem& problem,
+                                                   std::size_t neighbours) const
+{
+    const auto name =
+        std::lower_bound(category_names.begin(), category_names.end(), problem.category);
+    if(name == category_names.end() || *name != problem.category || !(problem.flops > 0))
+        return {};
+
+    const auto& category = categories[name - category_names.begin()];
+    const auto query     = Quantize(problem.features);
+    auto distances       = std::vector<std::pair<std::int64_t, std::uint32_t>>{};
+    distances.reserve(category.sample_count);
+
+    for(auto i = category.first_sample; i < category.first_sample + category.sample_count; ++i)
+    {
+        auto distance = std::int64_t{0};
+        for(auto f = std::size_t{0}; f < query.size(); ++f)
+            distance += std::abs(static_cast<std::int64_t>(query[f]) - samples[i].features[f]);
+        distances.emplace_back(distance, i);
+    }
+
+    auto k = std::min(neighbours, distances.size());
+    std::partial_sort(distances.begin(), distances.begin() + k, distances.end());
+
+    // Measurements of the very same problem are not blurred by the others.
+    if(k > 0 && distances[0].first == 0)
+        k = std::count_if(distances.begin(),
+                          distances.begin() + k,
+                          [](const std::pair<std::int64_t, std::uint32_t>& d) {
+                              return d.first == 0;
+                          });
+
+    struct Estimate
+    {
+        double sum    = 0;
+        double weight = 0;
+    };
+
+    auto estimates = std::map<std::uint32_t, Estimate>{};
+    for(auto i = std::size_t{0}; i < k; ++i)
+    {
+        const auto distance = static_cast<double>(distances[i].first) / FeatureScale;
+        const auto weight   = 1.0 / ((1.0 + distance) * (1.0 + distance));
+        const auto& sample  = samples[distances[i].second];
+
+        for(auto e = sample.first_entry; e < sample.first_entry + sample.entry_count; ++e)
+        {
+            auto& estimate = estimates[entries[e].solver];
+            estimate.sum += weight * entries[e].log2_time_per_flop;
+            estimate.weight += weight;
+        }
+    }
+
+    const auto log2_flops = std::log2(problem.flops);
+    auto ranked           = std::vector<RankedSolver>{};
+    ranked.reserve(estimates.size());
+
+    for(const auto& estimate : estimates)
+    {
+        const auto log2_time = estimate.second.sum / estimate.second.weight + log2_flops;
+        ranked.push_back({solvers[estimate.first], static_cast<float>(std::exp2(log2_time))});
+    }
+
+    std::sort(ranked.begin(), ranked.end(), [](const RankedSolver& l, const RankedSolver& r) {
+        return std::tie(l.time, l.solver) < std::tie(r.time, r.solver);
+    });
+    return ranked;
+}
+
+void SolverRankingModel::Save(std::ostream& stream) const
+{
+    auto names = std::string{};
+    for(const auto& solver : solvers)
+        names.append(solver).push_back('\0');
+    for(const auto& category : category_names)
+        names.append(category).push_back('\0');
+
+    auto header = SolverRankingHeader{};
+    std::memcpy(header.magic, SolverRankingMagic, sizeof(SolverRankingMagic));
+    header.version        = SolverRankingVersion;
+    header.byte_order     = SolverRankingByteOrder;
+    header.feature_count  = SolverRankingProblem::feature_count;
+    header.solver_count   = static_cast<std::uint32_t>(solvers.size());
+    header.category_count = static_cast<std::uint32_t>(categories.size());
+    header.sample_count   = static_cast<std::uint32_t>(samples.size());
+    header.entry_count    = static_cast<std::uint32_t>(entries.size());
+    header.names_size     = static_cast<std::uint32_t>(names.size());
+
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    stream.write(names.data(), names.size());
+    stream.write(reinterpret_cast<const char*>(categories.data()),
+                 categories.size() * sizeof(Category));
+    stream.write(reinterpret_cast<const char*>(samples.data()), samples.size() * sizeof(Sample));
+    stream.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(Entry));
+}
+
+// Embedded data is not guaranteed to be aligned, so all the reads are done by copying.
+template <class T>
+static void Read(const char*& at, std::size_t count, std::vector<T>& values)
+{
+    values.resize(count);
+    if(count != 0)
+        std::memcpy(values.data(), at, count * sizeof(T));
+    at += count * sizeof(T);
+}
+
+bool SolverRankingModel::Load(const char* data, std::size_t size)
+{
+    *this = SolverRankingModel{};
+
+    if(data == nullptr || size < sizeof(SolverRankingHeader))
+        return false;
+
+    auto header = SolverRankingHeader{};
+    std::memcpy(&header, data, sizeof(header));
+
+    if(std::memcmp(header.magic, SolverRankingMagic, sizeof(SolverRankingMagic)) != 0 ||
+       header.version != SolverRankingVersion || header.byte_order != SolverRankingByteOrder ||
+       header.feature_count != SolverRankingProblem::feature_count)
+        return false;
+
+    const auto expected_size = sizeof(header) + std::uint64_t{header.names_size} +
+                               header.category_count * std::uint64_t{sizeof(Category)} +
+                               header.sample_count * std::uint64_t{sizeof(Sample)} +
+                               header.entry_count * std::uint64_t{sizeof(Entry)};
+    if(expected_size != size)
+        return false;
+
+    auto model = SolverRankingModel{};
+    auto at    = data + sizeof(header);
+    auto names = Split(std::string(at, header.names_size), '\0');
+    at += header.names_size;
+
+    // The blob ends with a separator, so the last part is empty.
+    if(names.size() != std::size_t{header.solver_count} + header.category_count + 1 ||
+       !names.back().empty())
+        return false;
+
+    model.solvers.assign(names.begin(), names.begin() + header.solver_count);
+    model.category_names.assign(names.begin() + header.solver_count, names.end() - 1);
+    Read(at, header.category_count, model.categories);
+    Read(at, header.sample_count, model.samples);
+    Read(at, header.entry_count, model.entries);
+
+    if(!std::is_sorted(model.category_names.begin(), model.category_names.end()))
+        return false;
+
+    for(const auto& category : model.categories)
+        if(std::uint64_t{category.first_sample} + category.sample_count > header.sample_count)
+            return false;
+
+    for(const auto& sample : model.samples)
+        if(std::uint64_t{sample.first_entry} + sample.entry_count > header.entry_count)
+            return false;
+
+    for(const auto& entry : model.entries)
+        if(entry.solver >= header.solver_count)
+            return false;
+
+    *this = std::move(model);
+    return true;
+}
+
+/// FNV-1a. The split shall be stable between runs and platforms.
+static std::uint64_t Hash(const std::string& text)
+{
+    auto hash = std::uint64_t{14695981039346656037ull};
+    for(const auto c : text)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+SolverRankingAccuracy EvaluateSolverRanking(const std::vector<SolverRankingSample>& samples,
+                                            unsigned holdout_percent,
+                                            std::size_t neighbours)
+{
+    auto train = std::vector<SolverRankingSample>{};
+    auto test  = std::vector<const SolverRankingSample*>{};
+
+    for(const auto& sample : samples)
+    {
+        if(Hash(sample.db_key) % 100 < holdout_percent)
+            test.push_back(&sample);
+        else
+            train.push_back(sample);
+    }
+
+    const auto model  = SolverRankingModel::Train(train);
+    auto accuracy     = SolverRankingAccuracy{};
+    auto log_slowdown = 0.0;
+    auto log_gemm     = 0.0;
+    accuracy.train_samples = train.size();
+
+    for(const auto sample : test)
+    {
+        auto problem = SolverRankingProblem{};
+        if(!ParseSolverRankingProblem(sample->db_key, problem))
+            continue;
+
+        auto measured = std::map<std::string, float>{};
+        for(const auto& time : sample->times)
+        {
+            if(!(time.second > 0) || !std::isfinite(time.second))
+                continue;
+            const auto it = measured.emplace(time.first, time.second);
+            it.first->second = std::min(it.first->second, time.second);
+        }
+        if(measured.empty())
+            continue;
+
+        const auto best = std::min_element(
+            measured.begin(),
+            measured.end(),
+            [](const std::pair<const std::string, float>& l,
+               const std::pair<const std::string, float>& r) { return l.second < r.second; });
+
+        ++accuracy.test_samples;
+
+        const auto gemm = measured.find("gemm");
+        if(gemm != measured.end())
+        {
+            ++accuracy.gemm_samples;
+            log_gemm += std::log(gemm->second / best->second);
+        }
+
+        auto position   = std::size_t{0};
+        auto best_rank  = std::size_t{0};
+        auto first_time = -1.0f;
+        auto found      = false;
+
+        for(const auto& ranked : model.Rank(problem, neighbours))
+        {
+            const auto it = measured.find(ranked.solver);
+            if(it == measured.end())
+                continue;
+            if(first_time < 0)
+                first_time = it->second;
+            if(it == best)
+            {
+                best_rank = position;
+                found     = true;
+            }
+            ++position;
+        }
+
+        if(first_time < 0)
+        {
+            ++accuracy.unranked;
+            continue;
+        }
+
+        log_slowdown += std::log(first_time / best->second);
+        if(found && best_rank < 1)
+            ++accuracy.top1;
+        if(found && best_rank < 3)
+            ++accuracy.top3;
+    }
+
+    const auto ranked = accuracy.test_samples - accuracy.unranked;
+    if(ranked > 0)
+        accuracy.slowdown = std::exp(log_slowdown / static_cast<double>(ranked));
+    if(accuracy.gemm_samples > 0)
+        accuracy.gemm_slowdown = std::exp(log_gemm / static_cast<double>(accuracy.gemm_samples));
+    return accuracy;
+}
+
+std::string GetSolverRankingPath(const std::string& find_db_path)
+{
+    static const std::string find_db_extension = ".fdb.txt";
+
+    if(find_db_path.size() >= find_db_extension.size() &&
+       find_db_path.compare(find_db_path.size() - find_db_extension.size(),
+                            find_db_extension.size(),
+                            find_db_extension) == 0)
+        return find_db_path.substr(0, find_db_path.size() - find_db_extension.size()) +
+               ".rank.bin";
+
+    return find_db_path + ".rank.bin";
+}
+
+} // namespace miopen
@@ -42,20 +42,29 @@
 
 #include <memory>
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <cstdio>
 #include <fstream>
 #include <ios>
+#include <map>
 #include <mutex>
 #include <shared_mutex>
 #include <string>
+#include <unordered_map>
 
 extern "C" {
 int miopen_sqlite3_memvfs_init(sqlite3* db, char** pzErrMsg, const sqlite3_api_routines* pApi);
 }
 namespace miopen {
 
+using sqlite3_stmt_ptr = MIOPEN_MANAGE_PTR(sqlite3_stmt*, sqlite3_finalize);
+
+/// Prepared statements are kept per connection for reuse, while the number of distinct queries
+/// is small. Queries with inlined values would make it grow unbounded, so it is limited.
+static constexpr std::size_t MaxCachedStatements() { return 64; }
+
 class SQLite::impl
 {
     struct SQLiteCloser
@@ -161,8 +170,35 @@ class SQLite::impl
     }
 
     public:
+    /// Connections are shared by all the dbs of the same file in the process, so that the record
+    /// cache generations of SQLitePerfDb are comparable between the dbs, see
+    /// SQLitePerfDb::GetCacheGeneration().
+    static std::shared_ptr<impl> Open(const std::string& filename_, bool is_system)
+    {
+        // Never destroyed: the connections are used by the writes performed at process exit.
+        static auto& mutex = *new std::mutex{};
+        static auto& connections =
+            *new std::map<std::pair<std::string, bool>, std::weak_ptr<impl>>{};
+
+        const std::lock_guard<std::mutex> lock{mutex};
+        auto& connection = connections[{filename_, is_system}];
+        auto shared      = connection.lock();
+
+        if(shared == nullptr)
+        {
+            shared = std::make_shared<impl>(filename_, is_system);
+            if(shared->isValid)
+                connection = shared;
+        }
+
+        return shared;
+    }
+
     impl(const std::string& filename_, bool is_system)
     {
+        static std::atomic<std::uint64_t> connections{0};
+        id = ++connections;
+
         boost::filesystem::path filepath(filename_);
         int rc = 0;
 #if MIOPEN_EMBED_DB
@@ -174,8 +210,37 @@ class SQLite::impl
         isValid = (rc == 0);
     }
 
+    /// Returns a cached prepared statement for the query, if any. The statement is owned by
+    /// the caller until it is given back by ReturnStatement().
+    sqlite3_stmt_ptr TakeStatement(const std::string& query)
+    {
+        const std::lock_guard<std::mutex> lock{statements_mutex};
+        const auto it = statements.find(query);
+        if(it == statements.end())
+            return nullptr;
+        auto stmt = std::move(it->second);
+        statements.erase(it);
+        return stmt;
+    }
+
+    void ReturnStatement(const std::string& query, sqlite3_stmt_ptr stmt)
+    {
+        // Resetting also ends the read transaction the statement may hold.
+        sqlite3_reset(stmt.get());
+        sqlite3_clear_bindings(stmt.get());
+
+        const std::lock_guard<std::mutex> lock{statements_mutex};
+        if(statements.size() < MaxCachedStatements())
+            statements.emplace(query, std::move(stmt));
+    }
+
     sqlite3_ptr ptrDb = nullptr;
     bool isValid;
+    std::uint64_t id; // Unique in the process, as data_version is only comparable per connection.
+    std::mutex statements_mutex;
+    std::mutex transaction_mutex;
+    // Declared after ptrDb, as statements shall be finalized before the connection is closed.
+    std::unordered_map<std::string, sqlite3_stmt_ptr> statements;
 };
 
 static int find_callback(void* _res, int argc, char** argv, char** azColName)
@@ -233,6 +298,24 @@ int SQLite::Retry(std::function<int()> f) const
 
 int SQLite::Changes() const { return sqlite3_changes(pImpl->ptrDb.get()); }
 
+std::unique_lock<std::mutex> SQLite::LockTransaction() const
+{
+    return std::unique_lock<std::mutex>{pImpl->transaction_mutex};
+}
+
+std::uint64_t SQLite::ConnectionId() const { return pImpl->id; }
+
+std::int64_t SQLite::TotalChanges() const { return sqlite3_total_changes(pImpl->ptrDb.get()); }
+
+std::int64_t SQLite::DataVersion() const
+{
+    auto stmt     = Statement{*this, "PRAGMA data_version;"};
+    const auto rc = stmt.Step(*this);
+    if(rc != SQLITE_ROW)
+        MIOPEN_THROW(miopenStatusInternalError, ErrorMessage());
+    return stmt.ColumnInt64(0);
+}
+
 std::string SQLite::ErrorMessage() const
 {
     std::string errMsg = "Internal error while accessing SQLite database: ";
@@ -242,9 +325,12 @@ bool SQLite::Valid() const { return pImpl->isValid; }
 
 class SQLite::Statement::impl
 {
-    using sqlite3_stmt_ptr = MIOPEN_MANAGE_PTR(sqlite3_stmt*, sqlite3_finalize);
     sqlite3_stmt_ptr Prepare(const SQLite& sql, const std::string& query)
     {
+        auto cached = sql.pImpl->TakeStatement(query);
+        if(cached)
+            return cached;
+
         sqlite3_stmt* ptr = nullptr;
         MIOPEN_LOG_I2(query);
         auto rc =
@@ -257,9 +343,16 @@ class SQLite::Statement::impl
         return sqlite3_stmt_ptr{ptr};
     }
 
+    SQLite::impl* connection;
+    std::string query;
+
     public:
-    impl(const SQLite& sql, const std::string& query) { ptrStmt = Prepare(sql, query); }
-    impl(const SQLite& sql, const std::string& query, const std::vector<std::string>& vals)
+    impl(const SQLite& sql, const std::string& query_) : connection(sql.pImpl.get()), query(query_)
+    {
+        ptrStmt = Prepare(sql, query);
+    }
+    impl(const SQLite& sql, const std::string& query_, const std::vector<std::string>& vals)
+        : connection(sql.pImpl.get()), query(query_)
     {
         ptrStmt = Prepare(sql, query);
         int cnt = 1;
@@ -273,11 +366,20 @@ class SQLite::Statement::impl
         MIOPEN_LOG_I2("[" << JoinStrings(vals, ",") << "]");
     }
 
+    impl(const impl&) = delete;
+    impl& operator=(const impl&) = delete;
+
+    ~impl()
+    {
+        if(ptrStmt)
+            connection->ReturnStatement(query, std::move(ptrStmt));
+    }
+
     sqlite3_stmt_ptr ptrStmt = nullptr;
 };
 
 SQLite::SQLite(const std::string& filename_, bool is_system)
-    : pImpl{std::make_unique<impl>(filename_, is_system)}
+    : pImpl{impl::Open(filename_, is_system)}
 {
 }
 
@@ -0,0 +1,176 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/statistics.hpp>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+
+namespace miopen {
+
+constexpr std::size_t StatHistogram::BucketCount;
+
+void StatHistogram::Add(std::chrono::nanoseconds duration)
+{
+    const auto ns =
+        static_cast<std::uint64_t>(std::max<std::chrono::nanoseconds::rep>(duration.count(), 0));
+
+    auto bucket = std::size_t{0};
+    for(auto us = ns / 1000; us != 0 && bucket < BucketCount - 1; us /= 2)
+        ++bucket;
+
+    count.fetch_add(1, std::memory_order_relaxed);
+    total_ns.fetch_add(ns, std::memory_order_relaxed);
+    buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+
+    auto min = min_ns.load(std::memory_order_relaxed);
+    while(ns < min && !min_ns.compare_exchange_weak(min, ns, std::memory_order_relaxed))
+    {
+    }
+    auto max = max_ns.load(std::memory_order_relaxed);
+    while(ns > max && !max_ns.compare_exchange_weak(max, ns, std::memory_order_relaxed))
+    {
+    }
+}
+
+void StatHistogram::Reset()
+{
+    count    = 0;
+    total_ns = 0;
+    min_ns   = std::numeric_limits<std::uint64_t>::max();
+    max_ns   = 0;
+    for(auto& bucket : buckets)
+        bucket = 0;
+}
+
+void StatHistogram::Write(std::ostream& os) const
+{
+    const auto n   = count.load();
+    const auto min = min_ns.load();
+
+    os << "{\"count\":" << n << ",\"total_ns\":" << total_ns.load()
+       << ",\"min_ns\":" << (n == 0 ? std::uint64_t{0} : min) << ",\"max_ns\":" << max_ns.load()
+       << ",\"buckets\":[";
+    for(auto i = std::size_t{0}; i < BucketCount; ++i)
+        os << (i == 0 ? "" : ",") << buckets[i].load();
+    os << "]}";
+}
+
+namespace {
+
+struct Registry
+{
+    std::mutex mutex;
+    std::map<std::string, std::unique_ptr<StatCounter>> counters;
+    std::map<std::string, std::unique_ptr<StatHistogram>> histograms;
+};
+
+Registry& GetRegistry()
+{
+    // Leaked, so the references stay valid while the statics of other files are destroyed.
+    static auto& registry = *new Registry{};
+    return registry;
+}
+
+void WriteName(std::ostream& os, const std::string& name)
+{
+    os << '"';
+    for(const auto c : name)
+    {
+        if(c == '"' || c == '\\')
+            os << '\\';
+        os << c;
+    }
+    os << "\":";
+}
+
+} // namespace
+
+StatCounter& Statistics::Counter(const std::string& name)
+{
+    auto& registry = GetRegistry();
+    const std::lock_guard<std::mutex> lock{registry.mutex};
+    auto& counter = registry.counters[name];
+    if(!counter)
+        counter = std::make_unique<StatCounter>(0);
+    return *counter;
+}
+
+StatHistogram& Statistics::Histogram(const std::string& name)
+{
+    auto& registry = GetRegistry();
+    const std::lock_guard<std::mutex> lock{registry.mutex};
+    auto& histogram = registry.histograms[name];
+    if(!histogram)
+        histogram = std::make_unique<StatHistogram>();
+    return *histogram;
+}
+
+std::string Statistics::Snapshot()
+{
+    auto& registry = GetRegistry();
+    const std::lock_guard<std::mutex> lock{registry.mutex};
+    std::ostringstream ss;
+
+    ss << "{\"counters\":{";
+    auto first = true;
+    for(const auto& counter : registry.counters)
+    {
+        ss << (first ? "" : ",");
+        WriteName(ss, counter.first);
+        ss << counter.second->load();
+        first = false;
+    }
+
+    ss << "},\"histograms\":{";
+    first = true;
+    for(const auto& histogram : registry.histograms)
+    {
+        ss << (first ? "" : ",");
+        WriteName(ss, histogram.first);
+        histogram.second->Write(ss);
+        first = false;
+    }
+
+    ss << "}}";
+    return ss.str();
+}
+
+void Statistics::Reset()
+{
+    auto& registry = GetRegistry();
+    const std::lock_guard<std::mutex> lock{registry.mutex};
+
+    for(const auto& counter : registry.counters)
+        *counter.second = 0;
+    for(const auto& histogram : registry.histograms)
+        histogram.second->Reset();
+}
+
+} // namespace miopen
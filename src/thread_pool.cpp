@@ -0,0 +1,261 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/thread_pool.hpp>
+
+#include <miopen/env.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+
+namespace miopen {
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_THREAD_POOL_SIZE)
+
+namespace {
+
+struct CurrentWorker
+{
+    const ThreadPool* pool = nullptr;
+    std::size_t index      = 0;
+};
+
+thread_local CurrentWorker current_worker;
+
+} // namespace
+
+struct ThreadPool::Loop
+{
+    const std::size_t n;
+    const std::size_t min_grain;
+    const std::size_t participants;
+    /// Not called once all the ranges are taken, so it is not used after the loop is completed.
+    const std::function<void(std::size_t, std::size_t)>& f;
+
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> done{0};
+    std::atomic<bool> failed{false};
+    std::mutex mutex;
+    std::condition_variable completed;
+    std::exception_ptr error;
+
+    Loop(std::size_t n_,
+         std::size_t min_grain_,
+         std::size_t participants_,
+         const std::function<void(std::size_t, std::size_t)>& f_)
+        : n(n_), min_grain(min_grain_), participants(participants_), f(f_)
+    {
+    }
+
+    bool IsCompleted() const { return done.load(std::memory_order_acquire) == n; }
+
+    void Run()
+    {
+        while(true)
+        {
+            auto begin = next.load(std::memory_order_relaxed);
+            auto end   = begin;
+
+            // Guided scheduling: ranges shrink as the work runs out, so that the participants
+            // finish at about the same time even if the cost of iterations varies a lot.
+            do
+            {
+                if(begin >= n)
+                    return;
+                const auto remaining = n - begin;
+                const auto grain     = std::max(min_grain, remaining / (2 * participants));
+                end                  = begin + std::min(remaining, grain);
+            } while(!next.compare_exchange_weak(begin, end, std::memory_order_relaxed));
+
+            if(!failed.load(std::memory_order_relaxed))
+            {
+                try
+                {
+                    f(begin, end);
+                }
+                catch(...)
+                {
+                    const std::lock_guard<std::mutex> lock(mutex);
+                    if(!error)
+                        error = std::current_exception();
+                    failed = true;
+                }
+            }
+
+            if(done.fetch_add(end - begin, std::memory_order_acq_rel) + (end - begin) == n)
+            {
+                const std::lock_guard<std::mutex> lock(mutex);
+                completed.notify_all();
+            }
+        }
+    }
+};
+
+ThreadPool& ThreadPool::Instance()
+{
+    // Leaked, as loops may be run while the statics of other files are destroyed.
+    static auto& instance = *new ThreadPool{[]() {
+        const auto n_threads = std::max(std::thread::hardware_concurrency(), 1u);
+        return static_cast<std::size_t>(Value(MIOPEN_DEBUG_THREAD_POOL_SIZE{}, n_threads - 1));
+    }()};
+    return instance;
+}
+
+ThreadPool::ThreadPool(std::size_t n_workers)
+{
+    for(auto i = std::size_t{0}; i < n_workers + 1; ++i)
+        queues.emplace_back(std::make_unique<Queue>());
+
+    workers.reserve(n_workers);
+    for(auto i = std::size_t{0}; i < n_workers; ++i)
+        workers.emplace_back([this, i]() { Work(i); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        is_stopped = true;
+    }
+    wake.notify_all();
+
+    for(auto& worker : workers)
+        worker.join();
+}
+
+void ThreadPool::ParallelFor(std::size_t n,
+                             std::size_t max_parallelism,
+                             std::size_t min_grain,
+                             const std::function<void(std::size_t, std::size_t)>& f)
+{
+    if(n == 0)
+        return;
+
+    min_grain = std::max<std::size_t>(min_grain, 1);
+
+    const auto participants =
+        std::min({max_parallelism, workers.size() + 1, (n + min_grain - 1) / min_grain});
+
+    if(participants <= 1)
+    {
+        f(0, n);
+        return;
+    }
+
+    const auto loop = std::make_shared<Loop>(n, min_grain, participants, f);
+    for(auto i = std::size_t{1}; i < participants; ++i)
+        Push([loop]() { loop->Run(); });
+
+    loop->Run();
+
+    const auto queue_index = GetQueueIndex();
+    while(!loop->IsCompleted())
+    {
+        if(TryRun(queue_index))
+            continue;
+
+        std::unique_lock<std::mutex> lock(loop->mutex);
+        // Wakes up from time to time to help with the tasks queued meanwhile, e.g. by nested
+        // loops of the other participants.
+        loop->completed.wait_for(
+            lock, std::chrono::milliseconds{1}, [&]() { return loop->IsCompleted(); });
+    }
+
+    if(loop->error)
+        std::rethrow_exception(loop->error);
+}
+
+std::size_t ThreadPool::GetQueueIndex() const
+{
+    return current_worker.pool == this ? current_worker.index : queues.size() - 1;
+}
+
+void ThreadPool::Push(Task task)
+{
+    {
+        auto& queue = *queues[GetQueueIndex()];
+        const std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        ++n_queued;
+    }
+    wake.notify_one();
+}
+
+bool ThreadPool::TryRun(std::size_t queue_index)
+{
+    if(n_queued.load() == 0)
+        return false;
+
+    auto task = Task{};
+    {
+        auto& queue = *queues[queue_index];
+        const std::lock_guard<std::mutex> lock(queue.mutex);
+        if(!queue.tasks.empty())
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+    }
+
+    for(auto i = std::size_t{1}; !task && i < queues.size(); ++i)
+    {
+        auto& queue = *queues[(queue_index + i) % queues.size()];
+        const std::lock_guard<std::mutex> lock(queue.mutex);
+        if(!queue.tasks.empty())
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+    }
+
+    if(!task)
+        return false;
+
+    --n_queued;
+    task();
+    return true;
+}
+
+void ThreadPool::Work(std::size_t index)
+{
+    current_worker = {this, index};
+
+    while(true)
+    {
+        if(TryRun(index))
+            continue;
+
+        std::unique_lock<std::mutex> lock(mutex);
+        wake.wait(lock, [&]() { return is_stopped || n_queued > 0; });
+        if(is_stopped && n_queued == 0)
+            return;
+    }
+}
+
+} // namespace miopen
@@ -0,0 +1,269 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/trace.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <vector>
+
+#include <unistd.h>
+
+namespace miopen {
+namespace trace {
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TRACE_FILE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TRACE_BUFFER_SIZE)
+
+namespace {
+
+struct Event
+{
+    const char* category;
+    const char* name;
+    std::string detail;
+    std::uint64_t begin;
+    std::uint64_t end;
+};
+
+/// Ring buffer of a thread. Owned by the registry as well, so the events survive the thread.
+struct ThreadBuffer
+{
+    std::mutex mutex; // Only contended while the trace is written.
+    std::vector<Event> events;
+    std::size_t next     = 0; // The oldest event once the buffer is full.
+    std::uint64_t dropped = 0;
+    int tid               = 0;
+};
+
+struct Registry
+{
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::size_t capacity = 0;
+    int next_tid         = 0;
+};
+
+Registry& GetRegistry()
+{
+    // Leaked to keep the events of all the threads available to the exit handler.
+    static auto& registry = *[] {
+        auto ret      = new Registry{};
+        ret->capacity = std::max<std::size_t>(Value(MIOPEN_TRACE_BUFFER_SIZE{}, 1 << 16), 1);
+        return ret;
+    }();
+    return registry;
+}
+
+ThreadBuffer& GetThreadBuffer()
+{
+    thread_local const auto buffer = [] {
+        auto& registry = GetRegistry();
+        auto ret       = std::make_shared<ThreadBuffer>();
+        const std::lock_guard<std::mutex> lock{registry.mutex};
+        ret->tid = ++registry.next_tid;
+        ret->events.reserve(std::min<std::size_t>(registry.capacity, 1024));
+        registry.buffers.push_back(ret);
+        return ret;
+    }();
+    return *buffer;
+}
+
+void WriteString(std::ostream& os, const char* str)
+{
+    os << '"';
+    for(; *str != '\0'; ++str)
+    {
+        const auto c = *str;
+        if(c == '"' || c == '\\')
+        {
+            os << '\\' << c;
+        }
+        else if(static_cast<unsigned char>(c) < 0x20)
+        {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+            os << escaped;
+        }
+        else
+        {
+            os << c;
+        }
+    }
+    os << '"';
+}
+
+void WriteAtExit()
+{
+    const auto path = GetStringEnv(MIOPEN_TRACE_FILE{});
+    if(path == nullptr || !Write(std::string{path}))
+        return;
+    MIOPEN_LOG_I("Trace has been written to " << path);
+}
+
+bool Init()
+{
+    const auto path = GetStringEnv(MIOPEN_TRACE_FILE{});
+    if(path == nullptr || *path == '\0')
+        return false;
+    std::atexit(&WriteAtExit);
+    return true;
+}
+
+} // namespace
+
+namespace detail {
+
+std::atomic<bool> enabled{Init()};
+
+std::uint64_t Now()
+{
+    static const auto start = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                start)
+        .count();
+}
+
+void Record(const char* category, const char* name, std::string detail, std::uint64_t begin)
+{
+    const auto end  = Now();
+    auto& buffer    = GetThreadBuffer();
+    const auto size = GetRegistry().capacity;
+    const std::lock_guard<std::mutex> lock{buffer.mutex};
+
+    if(buffer.events.size() < size)
+    {
+        buffer.events.push_back({category, name, std::move(detail), begin, end});
+        return;
+    }
+
+    buffer.events[buffer.next] = {category, name, std::move(detail), begin, end};
+    buffer.next                = (buffer.next + 1) % size;
+    ++buffer.dropped;
+}
+
+} // namespace detail
+
+void SetEnabled(bool enabled) { detail::enabled = enabled; }
+
+void Write(std::ostream& os)
+{
+    auto& registry = GetRegistry();
+    auto buffers   = std::vector<std::shared_ptr<ThreadBuffer>>{};
+    {
+        const std::lock_guard<std::mutex> lock{registry.mutex};
+        buffers = registry.buffers;
+    }
+
+    const auto pid = ::getpid();
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    auto first = true;
+
+    for(const auto& buffer : buffers)
+    {
+        const std::lock_guard<std::mutex> lock{buffer->mutex};
+
+        ss << (first ? "\n" : ",\n");
+        first = false;
+        ss << R"({"name":"thread_name","ph":"M","pid":)" << pid << ",\"tid\":" << buffer->tid
+           << R"(,"args":{"name":"thread )" << buffer->tid << R"("}})";
+
+        const auto& events = buffer->events;
+        for(auto i = std::size_t{0}; i < events.size(); ++i)
+        {
+            const auto& event = events[(buffer->next + i) % events.size()];
+            ss << ",\n{\"name\":";
+            WriteString(ss, event.name);
+            ss << ",\"cat\":";
+            WriteString(ss, event.category);
+            ss << ",\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << buffer->tid
+               << ",\"ts\":" << event.begin / 1000.0
+               << ",\"dur\":" << (event.end - event.begin) / 1000.0;
+            if(!event.detail.empty())
+            {
+                ss << ",\"args\":{\"detail\":";
+                WriteString(ss, event.detail.c_str());
+                ss << '}';
+            }
+            ss << '}';
+        }
+
+        if(buffer->dropped != 0)
+        {
+            MIOPEN_LOG_W("Trace buffer of thread " << buffer->tid << " has overflowed, "
+                                                   << buffer->dropped << " events are lost.");
+        }
+    }
+
+    ss << "\n]}\n";
+    os << ss.str();
+}
+
+bool Write(const std::string& path)
+{
+    std::ofstream file{path};
+    if(!file)
+    {
+        MIOPEN_LOG_E("Unable to open the trace file: " << path);
+        return false;
+    }
+    Write(file);
+    if(!file)
+    {
+        MIOPEN_LOG_E("Unable to write the trace file: " << path);
+        return false;
+    }
+    return true;
+}
+
+void Clear()
+{
+    auto& registry = GetRegistry();
+    const std::lock_guard<std::mutex> registry_lock{registry.mutex};
+
+    for(const auto& buffer : registry.buffers)
+    {
+        const std::lock_guard<std::mutex> lock{buffer->mutex};
+        buffer->events.clear();
+        buffer->next    = 0;
+        buffer->dropped = 0;
+    }
+}
+
+} // namespace trace
+} // namespace miopen
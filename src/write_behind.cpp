@@ -0,0 +1,318 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/write_behind.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/trace.hpp>
+
+#include <cstdlib>
+#include <exception>
+#include <utility>
+
+#include <pthread.h>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_WRITE_BEHIND)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_WRITE_BEHIND_DELAY_MS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_WRITE_BEHIND_MAX_PENDING)
+
+namespace miopen {
+
+WriteBehindQueue& WriteBehindQueue::Instance()
+{
+    // Never destroyed, but stopped by an exit handler instead. The queue may be created before
+    // the objects used by the writes (e.g. cached db connections), so these are never destroyed
+    // either.
+    static WriteBehindQueue* const instance = []() {
+        const auto delay = Value(MIOPEN_DEBUG_WRITE_BEHIND_DELAY_MS{}, 1000);
+        const auto queue = new WriteBehindQueue{
+            {!IsDisabled(MIOPEN_DEBUG_WRITE_BEHIND{}),
+             std::chrono::milliseconds{delay},
+             static_cast<std::size_t>(Value(MIOPEN_DEBUG_WRITE_BEHIND_MAX_PENDING{}, 256))}};
+        std::atexit([]() { Instance().Stop(); });
+        pthread_atfork([]() { Instance().mutex.lock(); },
+                       []() { Instance().mutex.unlock(); },
+                       []() { Instance().ResetInForkChild(); });
+        return queue;
+    }();
+    return *instance;
+}
+
+WriteBehindQueue::WriteBehindQueue(const Options& options_) : options(options_) {}
+
+WriteBehindQueue::~WriteBehindQueue() { Stop(); }
+
+void WriteBehindQueue::Push(const std::string& target,
+                            const std::string& key,
+                            Write write,
+                            Coalesce coalesce,
+                            Batch batch)
+{
+    if(!options.enabled)
+    {
+        write();
+        return;
+    }
+
+    auto notify = false;
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        if(is_stopped)
+        {
+            // E.g. a record stored by a destructor of a static object.
+            lock.unlock();
+            Run(target, {}, {std::move(write)});
+            return;
+        }
+
+        auto& state = targets[target];
+        if(!state.batch)
+            state.batch = std::move(batch);
+
+        auto& writes = state.pending[key];
+        if(writes.empty())
+        {
+            if(n_pending++ == 0)
+                oldest = Clock::now();
+        }
+        else if(coalesce == Coalesce::Replace)
+        {
+            writes.clear();
+        }
+        writes.push_back(std::move(write));
+
+        if(worker == nullptr)
+            worker = std::make_unique<std::thread>([this]() { Work(); });
+
+        notify = n_pending >= options.max_pending;
+    }
+
+    if(notify)
+        wake.notify_one();
+}
+
+void WriteBehindQueue::Flush(const std::string& target, const std::string& key)
+{
+    if(!options.enabled)
+        return;
+
+    auto writes = std::vector<Write>{};
+    Target* state;
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        const auto it = targets.find(target);
+        if(it == targets.end())
+            return;
+
+        state = &it->second;
+        written.wait(lock, [&]() { return state->in_flight.count(key) == 0; });
+
+        const auto pending = state->pending.find(key);
+        if(pending == state->pending.end())
+            return;
+
+        writes = std::move(pending->second);
+        state->pending.erase(pending);
+        state->in_flight.insert(key);
+        --n_pending;
+        ++n_running;
+    }
+
+    Run(target, {}, writes);
+
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        state->in_flight.erase(key);
+        --n_running;
+    }
+
+    written.notify_all();
+    wake.notify_one();
+}
+
+void WriteBehindQueue::Flush()
+{
+    if(!options.enabled)
+        return;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    ++n_flushing;
+    wake.notify_one();
+    written.wait(lock, [&]() { return n_pending == 0 && n_running == 0; });
+    --n_flushing;
+}
+
+std::size_t WriteBehindQueue::GetPendingCount() const
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+    return n_pending;
+}
+
+void WriteBehindQueue::Stop()
+{
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        if(is_stopped)
+            return;
+        is_stopped = true;
+    }
+
+    wake.notify_one();
+    if(worker != nullptr && worker->joinable())
+        worker->join();
+}
+
+void WriteBehindQueue::ResetInForkChild()
+{
+    // Only the forking thread is copied to the child, so the worker is gone, and the writes taken
+    // by it are never completed. The pending writes are left to the parent, which performs them.
+    static_cast<void>(worker.release());
+    targets.clear();
+    n_pending  = 0;
+    n_flushing = 0;
+    n_running  = 0;
+    mutex.unlock();
+}
+
+void WriteBehindQueue::Work()
+{
+    struct Taken
+    {
+        const std::string* target;
+        Target* state;
+        std::vector<std::string> keys;
+        std::vector<Write> writes;
+    };
+
+    std::unique_lock<std::mutex> lock(mutex);
+    auto is_blocked = false; // All the pending records are being written by readers.
+
+    while(true)
+    {
+        const auto is_due = [&]() {
+            return n_pending > 0 && !is_blocked &&
+                   (is_stopped || n_flushing > 0 || n_pending >= options.max_pending ||
+                    Clock::now() >= oldest + options.delay);
+        };
+
+        while(!is_due())
+        {
+            if(is_stopped && n_pending == 0)
+                return;
+            if(n_pending == 0 || is_blocked)
+                wake.wait(lock);
+            else
+                wake.wait_until(lock, oldest + options.delay);
+            is_blocked = false;
+        }
+
+        auto taken = std::vector<Taken>{};
+
+        for(auto& item : targets)
+        {
+            auto& state = item.second;
+            auto batch  = Taken{&item.first, &state, {}, {}};
+
+            for(auto it = state.pending.begin(); it != state.pending.end();)
+            {
+                if(state.in_flight.count(it->first) != 0)
+                {
+                    ++it;
+                    continue;
+                }
+
+                state.in_flight.insert(it->first);
+                batch.keys.push_back(it->first);
+                for(auto& write : it->second)
+                    batch.writes.push_back(std::move(write));
+                it = state.pending.erase(it);
+                --n_pending;
+            }
+
+            if(!batch.keys.empty())
+                taken.push_back(std::move(batch));
+        }
+
+        if(taken.empty())
+        {
+            is_blocked = true;
+            continue;
+        }
+
+        // The rest are the records which have been pushed again while being written.
+        oldest = Clock::now();
+        ++n_running;
+        lock.unlock();
+
+        for(const auto& batch : taken)
+            Run(*batch.target, batch.state->batch, batch.writes);
+
+        lock.lock();
+        for(const auto& batch : taken)
+            for(const auto& key : batch.keys)
+                batch.state->in_flight.erase(key);
+        --n_running;
+        written.notify_all();
+    }
+}
+
+void WriteBehindQueue::Run(const std::string& target,
+                           const Batch& batch,
+                           const std::vector<Write>& writes)
+{
+    MIOPEN_TRACE_SPAN_DETAIL("cache", "WriteBehind", target);
+
+    const auto run = [&]() {
+        for(const auto& write : writes)
+        {
+            try
+            {
+                write();
+            }
+            catch(const std::exception& ex)
+            {
+                MIOPEN_LOG_E("Write to <" << target << "> failed: " << ex.what());
+            }
+        }
+    };
+
+    try
+    {
+        if(batch)
+            batch(run);
+        else
+            run();
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_E("Batch of writes to <" << target << "> failed: " << ex.what());
+    }
+}
+
+} // namespace miopen
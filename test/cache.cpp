@@ -31,6 +31,8 @@
 #include <miopen/md5.hpp>
 #include "test.hpp"
 
+#include <boost/filesystem.hpp>
+
 #if MIOPEN_ENABLE_SQLITE
 std::string random_string(size_t length)
 {
@@ -83,6 +85,157 @@ void check_bz2_decompress()
     EXPECT(decompressed_str == miopen::decompress(compressed_str, orig_str.size() + 10));
 }
 
+// Instructions of code objects are drawn from a small vocabulary, so they compress well.
+std::string code_object_like_string(size_t length)
+{
+    std::vector<std::string> instructions;
+    for(auto i = 0; i < 64; ++i)
+        instructions.push_back(random_string(8));
+    std::string str;
+    while(str.size() < length)
+        str += rand() % 8 == 0 ? random_string(8) : instructions[rand() % instructions.size()];
+    str.resize(length);
+    return str;
+}
+
+void check_lz4()
+{
+    bool success = false;
+    CHECK(throws([&]() { miopen::Lz4Compress(std::string{}); }));
+    EXPECT(miopen::Lz4Compress(std::string{}, &success).empty());
+    EXPECT(!success);
+
+    std::vector<std::string> strs;
+    for(auto size : {1, 4, 12, 13, 14, 15, 16, 17, 100, 270, 4096, 65536 + 100, 1 << 20})
+    {
+        strs.push_back(std::string(size, 'a'));
+        strs.push_back(random_string(size));
+        strs.push_back(code_object_like_string(size));
+    }
+    // Matches at the largest offset.
+    const auto far = random_string(65535);
+    strs.push_back(far + far.substr(0, 1000));
+
+    for(const auto& str : strs)
+    {
+        const auto compressed = miopen::Lz4Compress(str, &success);
+        if(!success)
+        {
+            EXPECT(compressed == str);
+            continue;
+        }
+        EXPECT(compressed.size() < str.size());
+        EXPECT(miopen::Lz4Decompress(compressed, str.size()) == str);
+        EXPECT(miopen::Lz4Decompress(compressed, str.size() + 10) == str);
+        CHECK(throws([&]() { miopen::Lz4Decompress(compressed, str.size() - 1); }));
+        CHECK(throws([&]() {
+            miopen::Lz4Decompress(compressed.substr(0, compressed.size() - 1), str.size());
+        }));
+    }
+
+    const auto str = code_object_like_string(4096);
+    CHECK(miopen::Lz4Compress(str, nullptr).size() < str.size() * 3 / 4);
+    CHECK(throws([&]() { miopen::Lz4Decompress(std::string{}, 10); }));
+    // Match offset beyond the start of the data.
+    CHECK(throws([&]() { miopen::Lz4Decompress(std::string{"\x10" "a" "\x02\x00", 4}, 100); }));
+}
+
+void check_kern_db_codecs()
+{
+    const auto& bz2 = *miopen::FindKernDbCodec(miopen::KernDbCodec::Bz2);
+    const auto& lz4 = *miopen::FindKernDbCodec(miopen::KernDbCodec::Lz4);
+    CHECK(bz2.name == "bz2");
+    CHECK(lz4.name == "lz4");
+    CHECK(miopen::FindKernDbCodec(100) == nullptr);
+
+    std::vector<miopen::KernelConfig> cfgs(4);
+    for(auto i = std::size_t{0}; i < cfgs.size(); ++i)
+    {
+        cfgs[i].kernel_name = "kernel" + std::to_string(i);
+        cfgs[i].kernel_args = random_string(64);
+        cfgs[i].kernel_blob = code_object_like_string(8192);
+    }
+
+    // Kernels stored by different codecs are all readable.
+    miopen::TempFile temp_file("tmp-kerndb");
+    {
+        miopen::KernDb bz2_db(std::string(temp_file), false, "gfx906", 60, bz2);
+        CHECK(bz2_db.StoreRecordUnsafe(cfgs[0]));
+        CHECK(bz2_db.StoreRecordUnsafe(cfgs[1]));
+    }
+    {
+        miopen::KernDb lz4_db(std::string(temp_file), false, "gfx906", 60, lz4);
+        CHECK(lz4_db.StoreRecordUnsafe(cfgs[2]));
+        CHECK(lz4_db.StoreRecordUnsafe(cfgs[3]));
+        for(const auto& cfg : cfgs)
+            CHECK(lz4_db.FindRecordUnsafe(cfg).get() == cfg.kernel_blob);
+
+        // Kernels written by an unknown codec are misses.
+        lz4_db.sql.Exec("UPDATE kern_db SET codec = 100 WHERE kernel_name = 'kernel0';");
+        CHECK(!lz4_db.FindRecordUnsafe(cfgs[0]));
+    }
+    {
+        miopen::KernDb bz2_db(std::string(temp_file), false, "gfx906", 60, bz2);
+        for(auto i = std::size_t{1}; i < cfgs.size(); ++i)
+            CHECK(bz2_db.FindRecordUnsafe(cfgs[i]).get() == cfgs[i].kernel_blob);
+    }
+
+    // Databases created before the codec column are migrated.
+    miopen::TempFile old_file("tmp-kerndb");
+    {
+        miopen::KernDb old_db(std::string(old_file), false, "gfx906", 60, bz2);
+        CHECK(old_db.StoreRecordUnsafe(cfgs[0]));
+        old_db.sql.Exec("CREATE TABLE old AS SELECT id, kernel_name, kernel_args, kernel_blob, "
+                        "kernel_hash, uncompressed_size FROM kern_db;"
+                        "DROP TABLE kern_db; ALTER TABLE old RENAME TO kern_db;");
+    }
+    {
+        miopen::KernDb old_db(std::string(old_file), false, "gfx906", 60, lz4);
+        CHECK(old_db.FindRecordUnsafe(cfgs[0]).get() == cfgs[0].kernel_blob);
+        CHECK(old_db.StoreRecordUnsafe(cfgs[1]));
+        CHECK(old_db.FindRecordUnsafe(cfgs[1]).get() == cfgs[1].kernel_blob);
+    }
+}
+
+void check_kern_db_eviction()
+{
+    std::vector<miopen::KernelConfig> cfgs(16);
+    for(auto i = std::size_t{0}; i < cfgs.size(); ++i)
+    {
+        cfgs[i].kernel_name = "kernel" + std::to_string(i);
+        cfgs[i].kernel_args = random_string(64);
+        cfgs[i].kernel_blob = random_string(16384);
+    }
+
+    miopen::TempFile temp_file("tmp-kerndb");
+    miopen::KernDb db(std::string(temp_file), false, "gfx906", 60);
+    const auto limit = std::uint64_t{256 * 1024};
+    db.SetSizeLimit(limit);
+
+    for(auto i = 0; i < 8; ++i)
+        CHECK(db.StoreRecordUnsafe(cfgs[i]));
+    CHECK(db.GetUsedSize() <= limit);
+
+    // Make the first kernel the most recently used one.
+    db.sql.Exec("UPDATE kern_db SET last_access = 1;");
+    CHECK(db.FindRecordUnsafe(cfgs[0]));
+
+    for(auto i = std::size_t{8}; i < cfgs.size(); ++i)
+    {
+        CHECK(db.StoreRecordUnsafe(cfgs[i]));
+        CHECK(db.GetUsedSize() <= limit);
+        CHECK(db.FindRecordUnsafe(cfgs[i]));
+    }
+
+    CHECK(db.FindRecordUnsafe(cfgs[0]));
+    CHECK(!db.FindRecordUnsafe(cfgs[1]));
+    for(auto i = std::size_t{8}; i < cfgs.size(); ++i)
+        CHECK(db.FindRecordUnsafe(cfgs[i]));
+
+    // Evictions shrink the file.
+    CHECK(boost::filesystem::file_size(std::string(temp_file)) < 2 * limit);
+}
+
 void check_kern_db()
 {
     miopen::KernelConfig cfg0;
@@ -153,5 +306,8 @@ int main()
     check_bz2_compress();
     check_bz2_decompress();
     check_kern_db();
+    check_lz4();
+    check_kern_db_codecs();
+    check_kern_db_eviction();
 #endif
 }
@@ -0,0 +1,368 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+
+#include <miopen/config.h>
+
+#if MIOPEN_MODE_NOGPU
+#include <miopen/convolution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/null_device.hpp>
+#include <miopen/solver.hpp>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+struct HostConvCase
+{
+    std::vector<std::size_t> x_lens;
+    std::vector<std::size_t> w_lens;
+    std::vector<int> pads;
+    std::vector<int> strides;
+    std::vector<int> dilations;
+    int groups;
+};
+
+/// Naive convolution in the forward sense. 2D problems are handled as 3D ones of depth 1.
+class ReferenceConv
+{
+    public:
+    ReferenceConv(const HostConvCase& test_case, const TensorDescriptor& y_desc)
+        : x(To5d(test_case.x_lens)),
+          w(To5d(test_case.w_lens)),
+          y(To5d(y_desc.GetLengths())),
+          pads(To3d(test_case.pads, 0)),
+          strides(To3d(test_case.strides, 1)),
+          dilations(To3d(test_case.dilations, 1)),
+          groups(test_case.groups)
+    {
+    }
+
+    /// Calls f(x index, w index, y index) for all the products contributing to the outputs.
+    template <class F>
+    void ForEach(F f) const
+    {
+        const auto c_per_group = x[1] / groups;
+        const auto k_per_group = y[1] / groups;
+
+        for(auto n = 0; n < y[0]; ++n)
+            for(auto k = 0; k < y[1]; ++k)
+                for(auto c = 0; c < c_per_group; ++c)
+                    for(auto o_index = 0; o_index < y[2] * y[3] * y[4]; ++o_index)
+                        for(auto f_index = 0; f_index < w[2] * w[3] * w[4]; ++f_index)
+                        {
+                            const auto o  = Unravel(o_index, y);
+                            const auto fp = Unravel(f_index, w);
+                            auto in       = Pos{};
+                            auto inside   = true;
+                            for(auto i = 0; i < 3; ++i)
+                            {
+                                in[i]  = o[i] * strides[i] + fp[i] * dilations[i] - pads[i];
+                                inside = inside && in[i] >= 0 && in[i] < x[i + 2];
+                            }
+                            if(!inside)
+                                continue;
+                            const auto x_c = k / k_per_group * c_per_group + c;
+                            f(Index(x, n, x_c, in), Index(w, k, c, fp), Index(y, n, k, o));
+                        }
+    }
+
+    private:
+    using Pos   = std::array<int, 3>;
+    using Dims5 = std::array<int, 5>;
+
+    static Dims5 To5d(const std::vector<std::size_t>& v)
+    {
+        const auto d = [&](std::size_t i) { return static_cast<int>(v[i]); };
+        if(v.size() == 5)
+            return {{d(0), d(1), d(2), d(3), d(4)}};
+        return {{d(0), d(1), 1, d(2), d(3)}};
+    }
+
+    static Pos To3d(const std::vector<int>& v, int fill)
+    {
+        if(v.size() == 3)
+            return {{v[0], v[1], v[2]}};
+        return {{fill, v[0], v[1]}};
+    }
+
+    static Pos Unravel(int index, const Dims5& lens)
+    {
+        return {{index / (lens[3] * lens[4]), index / lens[4] % lens[3], index % lens[4]}};
+    }
+
+    static std::size_t Index(const Dims5& lens, int n, int c, const Pos& pos)
+    {
+        auto index = static_cast<std::size_t>(n) * lens[1] + c;
+        for(auto i = 0; i < 3; ++i)
+            index = index * lens[i + 2] + pos[i];
+        return index;
+    }
+
+    Dims5 x;
+    Dims5 w;
+    Dims5 y;
+    Pos pads;
+    Pos strides;
+    Pos dilations;
+    int groups;
+};
+
+class ConvDirectHostTest
+{
+    public:
+    void Run() const
+    {
+        NullDevice::Get().SetHostExecution(true);
+
+        // Output channels are computed in blocks of 4, so 6 checks the partial block.
+        Check({{2, 4, 9, 8}, {6, 4, 3, 3}, {1, 1}, {1, 1}, {1, 1}, 1});
+        Check({{1, 6, 11, 10}, {4, 3, 3, 2}, {2, 0}, {2, 3}, {2, 1}, 2});
+        Check({{2, 2, 5, 6, 7}, {3, 2, 2, 3, 3}, {1, 1, 0}, {1, 2, 1}, {1, 1, 2}, 1});
+
+        NullDevice::Get().SetHostExecution(false);
+    }
+
+    private:
+    static std::vector<float> MakeData(std::size_t size, int seed)
+    {
+        auto data = std::vector<float>(size);
+        for(auto i = std::size_t{0}; i < size; ++i)
+            data[i] = static_cast<float>(static_cast<int>((i * 37 + seed) % 17) - 8) / 8;
+        return data;
+    }
+
+    static void Compare(const std::vector<float>& result, const std::vector<double>& expected)
+    {
+        EXPECT_EQUAL(result.size(), expected.size());
+        for(auto i = std::size_t{0}; i < expected.size(); ++i)
+        {
+            const auto tolerance = 1e-4 * std::max(1.0, std::abs(expected[i]));
+            EXPECT(std::abs(result[i] - expected[i]) <= tolerance);
+        }
+    }
+
+    static void Check(const HostConvCase& test_case)
+    {
+        const auto spatial_dims = test_case.x_lens.size() - 2;
+        const auto conv         = ConvolutionDescriptor{spatial_dims,
+                                                miopenConvolution,
+                                                miopenPaddingDefault,
+                                                test_case.pads,
+                                                test_case.strides,
+                                                test_case.dilations,
+                                                std::vector<int>(spatial_dims, 0),
+                                                test_case.groups};
+        const auto x_desc       = TensorDescriptor{miopenFloat, test_case.x_lens};
+        const auto w_desc       = TensorDescriptor{miopenFloat, test_case.w_lens};
+        const auto y_desc       = conv.GetForwardOutputTensor(x_desc, w_desc);
+        const auto reference    = ReferenceConv{test_case, y_desc};
+        const auto solver_id    = solver::Id{solver::SolverDbId(solver::ConvDirectHost{})};
+
+        const auto x  = MakeData(x_desc.GetElementSize(), 1);
+        const auto w  = MakeData(w_desc.GetElementSize(), 2);
+        const auto dy = MakeData(y_desc.GetElementSize(), 3);
+
+        auto y_ref  = std::vector<double>(y_desc.GetElementSize(), 0.0);
+        auto dx_ref = std::vector<double>(x_desc.GetElementSize(), 0.0);
+        auto dw_ref = std::vector<double>(w_desc.GetElementSize(), 0.0);
+        reference.ForEach([&](std::size_t xi, std::size_t wi, std::size_t yi) {
+            y_ref[yi] += static_cast<double>(x[xi]) * w[wi];
+            dx_ref[xi] += static_cast<double>(dy[yi]) * w[wi];
+            dw_ref[wi] += static_cast<double>(dy[yi]) * x[xi];
+        });
+
+        Handle handle{};
+        auto x_dev  = handle.Write(x);
+        auto w_dev  = handle.Write(w);
+        auto dy_dev = handle.Write(dy);
+        auto y_dev  = handle.Create<float>(y_ref.size());
+        auto dx_dev = handle.Create<float>(dx_ref.size());
+        auto dw_dev = handle.Create<float>(dw_ref.size());
+
+        auto count    = std::size_t{0};
+        auto solution = miopenConvSolution_t{};
+
+        conv.GetForwardSolutions(handle, w_desc, x_desc, y_desc, 1, &count, &solution);
+        EXPECT_EQUAL(count, std::size_t{1});
+        EXPECT_EQUAL(solution.solution_id, solver_id.Value());
+        conv.CompileForwardSolution(handle, w_desc, x_desc, y_desc, solver_id);
+        conv.ConvolutionForwardImmediate(handle,
+                                         w_desc,
+                                         w_dev.get(),
+                                         x_desc,
+                                         x_dev.get(),
+                                         y_desc,
+                                         y_dev.get(),
+                                         nullptr,
+                                         0,
+                                         solver_id);
+        Compare(handle.Read<float>(y_dev, y_ref.size()), y_ref);
+
+        conv.GetBackwardSolutions(handle, y_desc, w_desc, x_desc, 1, &count, &solution);
+        EXPECT_EQUAL(count, std::size_t{1});
+        EXPECT_EQUAL(solution.solution_id, solver_id.Value());
+        conv.CompileBackwardSolution(handle, y_desc, w_desc, x_desc, solver_id);
+        conv.ConvolutionBackwardImmediate(handle,
+                                          y_desc,
+                                          dy_dev.get(),
+                                          w_desc,
+                                          w_dev.get(),
+                                          x_desc,
+                                          dx_dev.get(),
+                                          nullptr,
+                                          0,
+                                          solver_id);
+        Compare(handle.Read<float>(dx_dev, dx_ref.size()), dx_ref);
+
+        conv.GetWrwSolutions(handle, y_desc, x_desc, w_desc, 1, &count, &solution);
+        EXPECT_EQUAL(count, std::size_t{1});
+        EXPECT_EQUAL(solution.solution_id, solver_id.Value());
+        conv.CompileWrwSolution(handle, y_desc, x_desc, w_desc, solver_id);
+        conv.ConvolutionWrwImmediate(handle,
+                                     y_desc,
+                                     dy_dev.get(),
+                                     x_desc,
+                                     x_dev.get(),
+                                     w_desc,
+                                     dw_dev.get(),
+                                     nullptr,
+                                     0,
+                                     solver_id);
+        Compare(handle.Read<float>(dw_dev, dw_ref.size()), dw_ref);
+
+        // Find-db path: the host solver is found, stored and then used by the regular calls.
+        const auto alpha = 1.0f;
+        const auto beta  = 0.0f;
+        auto found       = 0;
+        auto perf        = miopenConvAlgoPerf_t{};
+
+        conv.FindConvFwdAlgorithm(handle,
+                                  x_desc,
+                                  x_dev.get(),
+                                  w_desc,
+                                  w_dev.get(),
+                                  y_desc,
+                                  y_dev.get(),
+                                  1,
+                                  &found,
+                                  &perf,
+                                  nullptr,
+                                  0,
+                                  false);
+        EXPECT_EQUAL(found, 1);
+        EXPECT(perf.fwd_algo == miopenConvolutionFwdAlgoDirect);
+        y_dev = handle.Create<float>(y_ref.size());
+        conv.ConvolutionForward(handle,
+                                &alpha,
+                                x_desc,
+                                x_dev.get(),
+                                w_desc,
+                                w_dev.get(),
+                                perf.fwd_algo,
+                                &beta,
+                                y_desc,
+                                y_dev.get(),
+                                nullptr,
+                                0);
+        Compare(handle.Read<float>(y_dev, y_ref.size()), y_ref);
+
+        conv.FindConvBwdDataAlgorithm(handle,
+                                      y_desc,
+                                      dy_dev.get(),
+                                      w_desc,
+                                      w_dev.get(),
+                                      x_desc,
+                                      dx_dev.get(),
+                                      1,
+                                      &found,
+                                      &perf,
+                                      nullptr,
+                                      0,
+                                      false);
+        EXPECT_EQUAL(found, 1);
+        EXPECT(perf.bwd_data_algo == miopenConvolutionBwdDataAlgoDirect);
+        dx_dev = handle.Create<float>(dx_ref.size());
+        conv.ConvolutionBackwardData(handle,
+                                     &alpha,
+                                     y_desc,
+                                     dy_dev.get(),
+                                     w_desc,
+                                     w_dev.get(),
+                                     perf.bwd_data_algo,
+                                     &beta,
+                                     x_desc,
+                                     dx_dev.get(),
+                                     nullptr,
+                                     0);
+        Compare(handle.Read<float>(dx_dev, dx_ref.size()), dx_ref);
+
+        conv.FindConvBwdWeightsAlgorithm(handle,
+                                         y_desc,
+                                         dy_dev.get(),
+                                         x_desc,
+                                         x_dev.get(),
+                                         w_desc,
+                                         dw_dev.get(),
+                                         1,
+                                         &found,
+                                         &perf,
+                                         nullptr,
+                                         0,
+                                         false);
+        EXPECT_EQUAL(found, 1);
+        EXPECT(perf.bwd_weights_algo == miopenConvolutionBwdWeightsAlgoDirect);
+        dw_dev = handle.Create<float>(dw_ref.size());
+        conv.ConvolutionBackwardWeights(handle,
+                                        &alpha,
+                                        y_desc,
+                                        dy_dev.get(),
+                                        x_desc,
+                                        x_dev.get(),
+                                        perf.bwd_weights_algo,
+                                        &beta,
+                                        w_desc,
+                                        dw_dev.get(),
+                                        nullptr,
+                                        0);
+        Compare(handle.Read<float>(dw_dev, dw_ref.size()), dw_ref);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::ConvDirectHostTest().Run(); }
+#else
+int main() {}
+#endif
@@ -0,0 +1,172 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include "serialize.hpp"
+#include "tensor_holder.hpp"
+#include "cpu_conv.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+struct CpuConvCase
+{
+    std::vector<std::size_t> in_lens;
+    std::vector<std::size_t> wei_lens;
+    std::vector<int> pads;
+    std::vector<int> strides;
+    std::vector<int> dilations;
+    std::size_t group_count;
+    bool channels_last;
+};
+
+/// The im2col and GEMM reference convolutions shall match the naive ones.
+class CpuConvTest
+{
+    public:
+    void Run() const
+    {
+        Check({{2, 4, 9, 8}, {6, 4, 3, 3}, {1, 1}, {1, 1}, {1, 1}, 1, false});
+        Check({{1, 6, 11, 10}, {4, 3, 3, 2}, {2, 0}, {2, 3}, {2, 1}, 2, false});
+        Check({{2, 8, 7, 7}, {8, 1, 3, 3}, {1, 1}, {2, 2}, {1, 1}, 8, false});
+        Check({{2, 5, 6, 7}, {3, 5, 1, 1}, {0, 0}, {1, 1}, {1, 1}, 1, true});
+        Check({{3, 4, 13}, {2, 4, 4}, {2}, {3}, {1}, 1, false});
+        Check({{2, 2, 5, 6, 7}, {3, 2, 2, 3, 3}, {1, 1, 0}, {1, 2, 1}, {1, 1, 2}, 1, false});
+    }
+
+    private:
+    static tensor<float> MakeTensor(const std::vector<std::size_t>& lens, bool channels_last)
+    {
+        if(!channels_last)
+            return tensor<float>{lens};
+
+        // NHWC-like strides: channels are the innermost dimension.
+        auto strides = std::vector<std::size_t>(lens.size());
+        auto stride  = lens[1];
+        strides[1]   = 1;
+        for(auto i = lens.size() - 1; i >= 2; --i)
+        {
+            strides[i] = stride;
+            stride *= lens[i];
+        }
+        strides[0] = stride;
+        return tensor<float>{miopen::TensorDescriptor{miopenFloat, lens, strides}};
+    }
+
+    static void Fill(tensor<float>& t, int seed)
+    {
+        for(auto i = std::size_t{0}; i < t.data.size(); ++i)
+            t.data[i] = static_cast<float>(static_cast<int>((i * 37 + seed) % 17) - 8) / 8;
+    }
+
+    static void Compare(const tensor<float>& result, const tensor<float>& expected)
+    {
+        EXPECT_EQUAL(result.data.size(), expected.data.size());
+        for(auto i = std::size_t{0}; i < expected.data.size(); ++i)
+        {
+            const auto tolerance = 1e-5f * std::max(1.0f, std::abs(expected.data[i]));
+            EXPECT(std::abs(result.data[i] - expected.data[i]) <= tolerance);
+        }
+    }
+
+    static void Check(const CpuConvCase& test_case)
+    {
+        const auto& t      = test_case;
+        const auto conv_dim = t.in_lens.size() - 2;
+
+        auto out_lens = std::vector<std::size_t>{t.in_lens[0], t.wei_lens[0]};
+        for(auto i = std::size_t{0}; i < conv_dim; ++i)
+        {
+            const auto window = (t.wei_lens[i + 2] - 1) * t.dilations[i] + 1;
+            out_lens.push_back((t.in_lens[i + 2] + 2 * t.pads[i] - window) / t.strides[i] + 1);
+        }
+
+        auto in  = MakeTensor(t.in_lens, t.channels_last);
+        auto wei = MakeTensor(t.wei_lens, t.channels_last);
+        auto out = MakeTensor(out_lens, t.channels_last);
+        Fill(in, 1);
+        Fill(wei, 2);
+        Fill(out, 3);
+
+        auto naive_out = out;
+        auto gemm_out  = out;
+        auto naive_in  = in;
+        auto gemm_in   = in;
+        auto naive_wei = wei;
+        auto gemm_wei  = wei;
+
+        switch(conv_dim)
+        {
+        case 1:
+            Naive<1>(t, in, wei, out, naive_in, naive_wei, naive_out);
+            break;
+        case 2:
+            Naive<2>(t, in, wei, out, naive_in, naive_wei, naive_out);
+            break;
+        case 3:
+            Naive<3>(t, in, wei, out, naive_in, naive_wei, naive_out);
+            break;
+        default: MIOPEN_THROW("Unsupported number of dimensions");
+        }
+
+        cpu_convolution_forward_gemm(
+            in, wei, gemm_out, t.pads, t.strides, t.dilations, t.group_count);
+        cpu_convolution_backward_data_gemm(
+            gemm_in, wei, out, t.pads, t.strides, t.dilations, t.group_count);
+        cpu_convolution_backward_weight_gemm(
+            in, gemm_wei, out, t.pads, t.strides, t.dilations, t.group_count);
+
+        Compare(gemm_out, naive_out);
+        Compare(gemm_in, naive_in);
+        Compare(gemm_wei, naive_wei);
+    }
+
+    template <std::size_t ConvDim>
+    static void Naive(const CpuConvCase& t,
+                      const tensor<float>& in,
+                      const tensor<float>& wei,
+                      const tensor<float>& out,
+                      tensor<float>& naive_in,
+                      tensor<float>& naive_wei,
+                      tensor<float>& naive_out)
+    {
+        cpu_convolution_forward_impl<ConvDim>(
+            in, wei, naive_out, t.pads, t.strides, t.dilations, t.group_count);
+        cpu_convolution_backward_data_impl<ConvDim>(
+            naive_in, wei, out, t.pads, t.strides, t.dilations, t.group_count);
+        cpu_convolution_backward_weight_impl<ConvDim>(
+            in, naive_wei, out, t.pads, t.strides, t.dilations, t.group_count);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::CpuConvTest().Run(); }
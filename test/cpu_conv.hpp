@@ -37,8 +37,17 @@
 #include <utility>
 
 #include "tensor_holder.hpp"
-#include <miopen/stringutils.hpp>
+#include <miopen/env.hpp>
 #include <miopen/functional.hpp>
+#include <miopen/host_gemm.hpp>
+#include <miopen/par_for.hpp>
+#include <miopen/stringutils.hpp>
+
+#include <numeric>
+#include <vector>
+
+/// Use the direct loops instead of im2col and GEMM for the reference convolutions.
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_VERIFY_NAIVE_CONV)
 
 template <class T, class... Ts>
 static constexpr auto make_array(T x, Ts... xs)
@@ -294,6 +303,316 @@ void cpu_convolution_backward_weight_impl(const tensor<Tin>& in,
     });
 }
 
+/// im2col form of a convolution in the forward sense, for tensors with any strides. Rows of the
+/// column matrix are pairs (input channel within the group, filter position), columns are output
+/// positions. Spatial positions are enumerated in the row-major order of their lengths.
+struct cpu_convolution_im2col
+{
+    template <typename Range>
+    cpu_convolution_im2col(const miopen::TensorDescriptor& in_desc,
+                           const miopen::TensorDescriptor& wei_desc,
+                           const miopen::TensorDescriptor& out_desc,
+                           const Range& pads_,
+                           const Range& strides_,
+                           const Range& dilations_,
+                           std::size_t group_count)
+        : conv_dim(in_desc.GetLengths().size() - 2),
+          in_c_stride(in_desc.GetStrides()[1]),
+          in_len(in_desc.GetLengths().begin() + 2, in_desc.GetLengths().end()),
+          in_strides(in_desc.GetStrides().begin() + 2, in_desc.GetStrides().end()),
+          pads(pads_.begin(), pads_.end()),
+          strides(strides_.begin(), strides_.end()),
+          dilations(dilations_.begin(), dilations_.end()),
+          in_offsets(spatial_offsets(in_desc)),
+          wei_offsets(spatial_offsets(wei_desc)),
+          out_offsets(spatial_offsets(out_desc)),
+          wei_positions(spatial_positions(wei_desc)),
+          out_positions(spatial_positions(out_desc))
+    {
+        c_per_group = wei_desc.GetLengths()[1];
+        k_per_group = wei_desc.GetLengths()[0] / group_count;
+        rows        = c_per_group * wei_offsets.size();
+        cols        = out_offsets.size();
+    }
+
+    /// Calls f(row, column, input offset) for the elements of the column matrix which are within
+    /// the input. The offset is relative to the first channel of the group. Channels are
+    /// processed in parallel, so f may accumulate into the input.
+    template <class F>
+    void for_each(F f) const
+    {
+        miopen::par_for(c_per_group, 1, [&](std::size_t c) {
+            for(std::size_t w = 0; w < wei_offsets.size(); ++w)
+            {
+                const auto row = c * wei_offsets.size() + w;
+                for(std::size_t col = 0; col < cols; ++col)
+                {
+                    auto offset = static_cast<std::ptrdiff_t>(c * in_c_stride);
+                    auto inside = true;
+                    for(std::size_t i = 0; i < conv_dim; ++i)
+                    {
+                        const auto in_id = out_positions[col * conv_dim + i] * strides[i] +
+                                           wei_positions[w * conv_dim + i] * dilations[i] -
+                                           pads[i];
+                        inside = inside && in_id >= 0 && in_id < in_len[i];
+                        offset += in_id * in_strides[i];
+                    }
+                    if(inside)
+                        f(row, col, static_cast<std::size_t>(offset));
+                }
+            }
+        });
+    }
+
+    std::size_t conv_dim;
+    std::size_t in_c_stride;
+    std::size_t c_per_group = 0;
+    std::size_t k_per_group = 0;
+    std::size_t rows        = 0;
+    std::size_t cols        = 0;
+    std::vector<std::ptrdiff_t> in_len;
+    std::vector<std::ptrdiff_t> in_strides;
+    std::vector<std::ptrdiff_t> pads;
+    std::vector<std::ptrdiff_t> strides;
+    std::vector<std::ptrdiff_t> dilations;
+    std::vector<std::size_t> in_offsets;
+    std::vector<std::size_t> wei_offsets;
+    std::vector<std::size_t> out_offsets;
+    std::vector<std::ptrdiff_t> wei_positions; // conv_dim coordinates per filter position.
+    std::vector<std::ptrdiff_t> out_positions; // conv_dim coordinates per output position.
+
+    private:
+    static std::vector<std::ptrdiff_t> spatial_positions(const miopen::TensorDescriptor& desc)
+    {
+        const auto& lens  = desc.GetLengths();
+        const auto dims   = lens.size() - 2;
+        const auto points = std::accumulate(
+            lens.begin() + 2, lens.end(), std::size_t{1}, std::multiplies<std::size_t>());
+        auto positions = std::vector<std::ptrdiff_t>(points * dims);
+        for(std::size_t p = 0; p < points; ++p)
+        {
+            auto rest = p;
+            for(auto i = dims; i > 0; --i)
+            {
+                positions[p * dims + i - 1] = rest % lens[i + 1];
+                rest /= lens[i + 1];
+            }
+        }
+        return positions;
+    }
+
+    static std::vector<std::size_t> spatial_offsets(const miopen::TensorDescriptor& desc)
+    {
+        const auto dims      = desc.GetLengths().size() - 2;
+        const auto positions = spatial_positions(desc);
+        auto offsets         = std::vector<std::size_t>(positions.size() / dims);
+        for(std::size_t p = 0; p < offsets.size(); ++p)
+            for(std::size_t i = 0; i < dims; ++i)
+                offsets[p] += positions[p * dims + i] * desc.GetStrides()[i + 2];
+        return offsets;
+    }
+};
+
+/// Weights of all the groups as k x (c, filter position) row-major matrices.
+template <typename Twei>
+std::vector<double> cpu_convolution_weight_matrix(const tensor<Twei>& wei,
+                                                  const cpu_convolution_im2col& im2col)
+{
+    const auto& wei_strides = wei.desc.GetStrides();
+    const auto k_len        = wei.desc.GetLengths()[0];
+    const auto filter_size  = im2col.wei_offsets.size();
+    auto matrix             = std::vector<double>(k_len * im2col.rows);
+    for(std::size_t k = 0; k < k_len; ++k)
+        for(std::size_t c = 0; c < im2col.c_per_group; ++c)
+            for(std::size_t w = 0; w < filter_size; ++w)
+                matrix[k * im2col.rows + c * filter_size + w] = double(
+                    wei.data[k * wei_strides[0] + c * wei_strides[1] + im2col.wei_offsets[w]]);
+    return matrix;
+}
+
+/// The k x (output positions) matrix of an output image of the group.
+template <typename Tout>
+void cpu_convolution_out_matrix(const tensor<Tout>& out,
+                                const cpu_convolution_im2col& im2col,
+                                std::size_t n,
+                                std::size_t group,
+                                std::vector<double>& matrix)
+{
+    const auto& out_strides = out.desc.GetStrides();
+    miopen::par_for(im2col.k_per_group, 1, [&](std::size_t k) {
+        const auto base =
+            n * out_strides[0] + (group * im2col.k_per_group + k) * out_strides[1];
+        for(std::size_t col = 0; col < im2col.cols; ++col)
+            matrix[k * im2col.cols + col] = double(out.data[base + im2col.out_offsets[col]]);
+    });
+}
+
+/// Same as cpu_convolution_forward_impl, computed by im2col and GEMM in double.
+template <typename Tin, typename Twei, typename Tout, typename Range>
+void cpu_convolution_forward_gemm(const tensor<Tin>& in,
+                                  const tensor<Twei>& wei,
+                                  tensor<Tout>& out,
+                                  const Range& pads,
+                                  const Range& strides,
+                                  const Range& dilations,
+                                  std::size_t group_count)
+{
+    const auto im2col = cpu_convolution_im2col{
+        in.desc, wei.desc, out.desc, pads, strides, dilations, group_count};
+    const auto weights     = cpu_convolution_weight_matrix(wei, im2col);
+    const auto& in_strides = in.desc.GetStrides();
+    const auto& out_strides = out.desc.GetStrides();
+    auto columns           = std::vector<double>(im2col.rows * im2col.cols);
+    auto result            = std::vector<double>(im2col.k_per_group * im2col.cols);
+
+    for(std::size_t n = 0; n < in.desc.GetLengths()[0]; ++n)
+    {
+        for(std::size_t group = 0; group < group_count; ++group)
+        {
+            const auto in_base = n * in_strides[0] + group * im2col.c_per_group * in_strides[1];
+            std::fill(columns.begin(), columns.end(), 0.0);
+            im2col.for_each([&](std::size_t row, std::size_t col, std::size_t offset) {
+                columns[row * im2col.cols + col] = double(in.data[in_base + offset]);
+            });
+
+            miopen::HostGemm<double>(false,
+                                     false,
+                                     im2col.k_per_group,
+                                     im2col.cols,
+                                     im2col.rows,
+                                     1.0,
+                                     weights.data() + group * im2col.k_per_group * im2col.rows,
+                                     im2col.rows,
+                                     columns.data(),
+                                     im2col.cols,
+                                     0.0,
+                                     result.data(),
+                                     im2col.cols);
+
+            miopen::par_for(im2col.k_per_group, 1, [&](std::size_t k) {
+                const auto base =
+                    n * out_strides[0] + (group * im2col.k_per_group + k) * out_strides[1];
+                for(std::size_t col = 0; col < im2col.cols; ++col)
+                    out.data[base + im2col.out_offsets[col]] =
+                        static_cast<Tout>(result[k * im2col.cols + col]);
+            });
+        }
+    }
+}
+
+/// Same as cpu_convolution_backward_data_impl, computed by GEMM in double and col2im.
+template <typename Tin, typename Twei, typename Tout, typename Range>
+void cpu_convolution_backward_data_gemm(tensor<Tin>& in,
+                                        const tensor<Twei>& wei,
+                                        const tensor<Tout>& out,
+                                        const Range& pads,
+                                        const Range& strides,
+                                        const Range& dilations,
+                                        std::size_t group_count)
+{
+    const auto im2col = cpu_convolution_im2col{
+        in.desc, wei.desc, out.desc, pads, strides, dilations, group_count};
+    const auto weights     = cpu_convolution_weight_matrix(wei, im2col);
+    const auto& in_strides = in.desc.GetStrides();
+    const auto in_size     = im2col.in_offsets.size();
+    auto out_matrix        = std::vector<double>(im2col.k_per_group * im2col.cols);
+    auto columns           = std::vector<double>(im2col.rows * im2col.cols);
+    // Accumulated by the offsets within the image.
+    auto image_space = std::size_t{1};
+    for(std::size_t i = 1; i < in.desc.GetLengths().size(); ++i)
+        image_space += (in.desc.GetLengths()[i] - 1) * in_strides[i];
+    auto acc = std::vector<double>(image_space);
+
+    for(std::size_t n = 0; n < in.desc.GetLengths()[0]; ++n)
+    {
+        for(std::size_t group = 0; group < group_count; ++group)
+        {
+            cpu_convolution_out_matrix(out, im2col, n, group, out_matrix);
+            miopen::HostGemm<double>(true,
+                                     false,
+                                     im2col.rows,
+                                     im2col.cols,
+                                     im2col.k_per_group,
+                                     1.0,
+                                     weights.data() + group * im2col.k_per_group * im2col.rows,
+                                     im2col.rows,
+                                     out_matrix.data(),
+                                     im2col.cols,
+                                     0.0,
+                                     columns.data(),
+                                     im2col.cols);
+
+            const auto acc_base = group * im2col.c_per_group * in_strides[1];
+            for(std::size_t c = 0; c < im2col.c_per_group; ++c)
+                for(std::size_t i = 0; i < in_size; ++i)
+                    acc[acc_base + c * in_strides[1] + im2col.in_offsets[i]] = 0.0;
+            im2col.for_each([&](std::size_t row, std::size_t col, std::size_t offset) {
+                acc[acc_base + offset] += columns[row * im2col.cols + col];
+            });
+            miopen::par_for(im2col.c_per_group, 1, [&](std::size_t c) {
+                const auto base = acc_base + c * in_strides[1];
+                for(std::size_t i = 0; i < in_size; ++i)
+                    in.data[n * in_strides[0] + base + im2col.in_offsets[i]] =
+                        static_cast<Tin>(acc[base + im2col.in_offsets[i]]);
+            });
+        }
+    }
+}
+
+/// Same as cpu_convolution_backward_weight_impl, computed by im2col and GEMM in double.
+template <typename Tin, typename Twei, typename Tout, typename Range>
+void cpu_convolution_backward_weight_gemm(const tensor<Tin>& in,
+                                          tensor<Twei>& wei,
+                                          const tensor<Tout>& out,
+                                          const Range& pads,
+                                          const Range& strides,
+                                          const Range& dilations,
+                                          std::size_t group_count)
+{
+    const auto im2col = cpu_convolution_im2col{
+        in.desc, wei.desc, out.desc, pads, strides, dilations, group_count};
+    const auto& in_strides  = in.desc.GetStrides();
+    const auto& wei_strides = wei.desc.GetStrides();
+    const auto filter_size  = im2col.wei_offsets.size();
+    auto out_matrix         = std::vector<double>(im2col.k_per_group * im2col.cols);
+    auto columns            = std::vector<double>(im2col.rows * im2col.cols);
+    auto weights = std::vector<double>(wei.desc.GetLengths()[0] * im2col.rows, 0.0);
+
+    for(std::size_t n = 0; n < in.desc.GetLengths()[0]; ++n)
+    {
+        for(std::size_t group = 0; group < group_count; ++group)
+        {
+            const auto in_base = n * in_strides[0] + group * im2col.c_per_group * in_strides[1];
+            std::fill(columns.begin(), columns.end(), 0.0);
+            im2col.for_each([&](std::size_t row, std::size_t col, std::size_t offset) {
+                columns[row * im2col.cols + col] = double(in.data[in_base + offset]);
+            });
+            cpu_convolution_out_matrix(out, im2col, n, group, out_matrix);
+
+            miopen::HostGemm<double>(false,
+                                     true,
+                                     im2col.k_per_group,
+                                     im2col.rows,
+                                     im2col.cols,
+                                     1.0,
+                                     out_matrix.data(),
+                                     im2col.cols,
+                                     columns.data(),
+                                     im2col.cols,
+                                     1.0,
+                                     weights.data() + group * im2col.k_per_group * im2col.rows,
+                                     im2col.rows);
+        }
+    }
+
+    miopen::par_for(wei.desc.GetLengths()[0], 1, [&](std::size_t k) {
+        for(std::size_t c = 0; c < im2col.c_per_group; ++c)
+            for(std::size_t w = 0; w < filter_size; ++w)
+                wei.data[k * wei_strides[0] + c * wei_strides[1] + im2col.wei_offsets[w]] =
+                    static_cast<Twei>(weights[k * im2col.rows + c * filter_size + w]);
+    });
+}
+
 template <typename Tin, typename Twei, typename Tout, typename Range>
 void cpu_convolution_forward(std::size_t spatial_dim,
                              const tensor<Tin>& in,
@@ -304,6 +623,12 @@ void cpu_convolution_forward(std::size_t spatial_dim,
                              const Range& dilations,
                              std::size_t group_count)
 {
+    if(!miopen::IsEnabled(MIOPEN_VERIFY_NAIVE_CONV{}))
+    {
+        cpu_convolution_forward_gemm(in, wei, out, pads, strides, dilations, group_count);
+        return;
+    }
+
     switch(spatial_dim)
     {
     case 1:
@@ -341,6 +666,12 @@ void cpu_convolution_backward_data(std::size_t spatial_dim,
                                    const Range& dilations,
                                    std::size_t group_count)
 {
+    if(!miopen::IsEnabled(MIOPEN_VERIFY_NAIVE_CONV{}))
+    {
+        cpu_convolution_backward_data_gemm(in, wei, out, pads, strides, dilations, group_count);
+        return;
+    }
+
     switch(spatial_dim)
     {
     case 1:
@@ -378,6 +709,12 @@ void cpu_convolution_backward_weight(std::size_t spatial_dim,
                                      const Range& dilations,
                                      std::size_t group_count)
 {
+    if(!miopen::IsEnabled(MIOPEN_VERIFY_NAIVE_CONV{}))
+    {
+        cpu_convolution_backward_weight_gemm(in, wei, out, pads, strides, dilations, group_count);
+        return;
+    }
+
     switch(spatial_dim)
     {
     case 1:
@@ -27,9 +27,14 @@
 #define GUARD_CPU_REDUCE_UTIL_HPP
 
 #include <half.hpp>
+#include <algorithm>
 #include <limits>
 #include <cmath>
+#include <cstddef>
+#include <functional>
+#include <vector>
 #include <miopen/miopen.h>
+#include <miopen/par_for.hpp>
 #include <miopen/reduce_common.hpp>
 
 #include <miopen/bfloat16.hpp>
@@ -214,7 +219,7 @@ inline bool float_equal_zero<half_float::half>(half_float::half x)
 
 template <typename compType>
 static inline void binop_with_nan_check(miopenNanPropagation_t nanOpt,
-                                        std::function<void(compType&, compType)> opReduce,
+                                        const std::function<void(compType&, compType)>& opReduce,
                                         compType& accuVal,
                                         compType currVal)
 {
@@ -230,12 +235,13 @@ static inline void binop_with_nan_check(miopenNanPropagation_t nanOpt,
 };
 
 template <typename compType>
-static inline void binop_with_nan_check2(miopenNanPropagation_t nanOpt,
-                                         std::function<void(compType&, compType, bool&)> opReduce,
-                                         compType& accuVal,
-                                         compType currVal,
-                                         int& accuIndex,
-                                         int currIndex)
+static inline void
+binop_with_nan_check2(miopenNanPropagation_t nanOpt,
+                      const std::function<void(compType&, compType, bool&)>& opReduce,
+                      compType& accuVal,
+                      compType currVal,
+                      int& accuIndex,
+                      int currIndex)
 {
     if(nanOpt == MIOPEN_NOT_PROPAGATE_NAN)
     {
@@ -265,6 +271,101 @@ static inline void binop_with_nan_check2(miopenNanPropagation_t nanOpt,
     };
 };
 
+// Index space of a reduction, traversed without materializing the indexes of the input. The
+// invariant dimensions enumerate the output elements and the reduced dimensions enumerate the
+// inputs of each of them, both in the row-major order.
+struct reduce_index_space
+{
+    template <typename Lengths, typename Strides, typename Dims>
+    reduce_index_space(const Lengths& inLengths,
+                       const Strides& inStrides,
+                       const Strides& outStrides,
+                       const Dims& invariantDims,
+                       const Dims& toReduceDims)
+    {
+        for(const auto dim : invariantDims)
+        {
+            invariantLengths.push_back(inLengths[dim]);
+            invariantInStrides.push_back(inStrides[dim]);
+            invariantOutStrides.push_back(outStrides[dim]);
+            outputSize *= inLengths[dim];
+        };
+
+        for(const auto dim : toReduceDims)
+        {
+            toReduceLengths.push_back(inLengths[dim]);
+            toReduceStrides.push_back(inStrides[dim]);
+            reduceSize *= inLengths[dim];
+        };
+    };
+
+    // Calls f(in_offset, out_offset) for every output element, in parallel. in_offset is the
+    // offset of the first input reduced into the element.
+    template <typename F>
+    void for_each_output(F f) const
+    {
+        // Let a task do a few thousand reduction steps when the reduced dimensions are short.
+        const auto grain = std::max<std::size_t>(1, 4096 / std::max<std::size_t>(1, reduceSize));
+
+        miopen::par_for(outputSize, miopen::min_grain{grain}, [&](std::size_t i) {
+            std::size_t in_offset  = 0;
+            std::size_t out_offset = 0;
+
+            for(auto dim = invariantLengths.size(); dim-- > 0;)
+            {
+                const auto index = i % invariantLengths[dim];
+                i /= invariantLengths[dim];
+                in_offset += index * invariantInStrides[dim];
+                out_offset += index * invariantOutStrides[dim];
+            };
+
+            f(in_offset, out_offset);
+        });
+    };
+
+    // Calls f(in_offset, index) for every input reduced into the output element, which starts at
+    // in_offset. index is the flattened position of the input within the reduced dimensions.
+    // The innermost reduced dimension is walked by the stride, the outer ones are carried once
+    // per its row.
+    template <typename F>
+    void for_each_reduced(std::size_t in_offset, F f) const
+    {
+        if(toReduceLengths.empty())
+        {
+            f(in_offset, std::size_t{0});
+            return;
+        };
+
+        const auto innerLength = toReduceLengths.back();
+        const auto innerStride = toReduceStrides.back();
+        const auto outerSize   = reduceSize / innerLength;
+
+        for(std::size_t outer = 0; outer < outerSize; outer++)
+        {
+            auto row_offset = in_offset;
+            auto rest       = outer;
+
+            for(auto dim = toReduceLengths.size() - 1; dim-- > 0;)
+            {
+                row_offset += rest % toReduceLengths[dim] * toReduceStrides[dim];
+                rest /= toReduceLengths[dim];
+            };
+
+            for(std::size_t inner = 0; inner < innerLength; inner++)
+                f(row_offset + inner * innerStride, outer * innerLength + inner);
+        };
+    };
+
+    private:
+    std::vector<std::size_t> invariantLengths;
+    std::vector<std::size_t> invariantInStrides;
+    std::vector<std::size_t> invariantOutStrides;
+    std::vector<std::size_t> toReduceLengths;
+    std::vector<std::size_t> toReduceStrides;
+    std::size_t outputSize = 1;
+    std::size_t reduceSize = 1;
+};
+
 }; // end of namespace reduce
 
 #endif
@@ -0,0 +1,607 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+
+#include <miopen/db.hpp>
+#include <miopen/generic_search.hpp>
+#include <miopen/tmp_dir.hpp>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+struct MockContext
+{
+    int n_configs;
+    int failed_compile; // Config which fails to compile.
+    int failed_run;     // Config which fails to run.
+
+    void Serialize(std::ostream& stream) const { stream << n_configs; }
+};
+
+struct MockConfig
+{
+    int value;
+
+    MockConfig() : value(-1) {}
+    MockConfig(bool) : value(0) {}
+    MockConfig(int value_) : value(value_) {}
+
+    bool SetNextValue()
+    {
+        ++value;
+        return value < 64;
+    }
+
+    // Odd values are invalid.
+    bool IsValid(const MockContext& context) const
+    {
+        return value % 2 == 0 && value < 2 * context.n_configs;
+    }
+
+    bool operator==(const MockConfig& other) const { return value == other.value; }
+
+    void Serialize(std::ostream& stream) const { stream << value; }
+
+    bool Deserialize(const std::string& str)
+    {
+        std::istringstream ss{str};
+        return !(ss >> value).fail();
+    }
+
+    float GetTime() const { return 1.0f + std::abs(value - 10) * 0.5f; }
+
+    friend std::ostream& operator<<(std::ostream& os, const MockConfig& config)
+    {
+        return os << config.value;
+    }
+};
+
+/// Compiles on the CPU by sleeping, and measures with a fake timer: the time of a config only
+/// depends on its value, and it is the best for the config 10.
+class MockSolver
+{
+    public:
+    struct Program
+    {
+        int value;
+    };
+
+    MockSolver(const MockContext& context_) : context(context_) {}
+
+    Program Compile(const MockConfig& config) const
+    {
+        const auto now = ++compiling;
+        auto max       = max_compiling.load();
+        while(now > max && !max_compiling.compare_exchange_weak(max, now))
+        {
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        --compiling;
+
+        if(config.value == context.failed_compile)
+            throw std::runtime_error("Compilation failed");
+
+        ++outstanding;
+        return {config.value};
+    }
+
+    std::function<float()> Start(const MockConfig& config, const Program& program) const
+    {
+        max_outstanding = std::max(max_outstanding, outstanding.load());
+        --outstanding;
+
+        // Configs are measured in order.
+        EXPECT_EQUAL(program.value, config.value);
+        EXPECT(config.value > last_run);
+        last_run = config.value;
+
+        if(config.value == context.failed_run)
+            throw std::runtime_error("Run failed");
+
+        return [config]() { return config.GetTime(); };
+    }
+
+    int GetMaxCompiling() const { return max_compiling; }
+    int GetMaxOutstanding() const { return max_outstanding; }
+
+    private:
+    MockContext context;
+    mutable std::atomic<int> compiling{0};
+    mutable std::atomic<int> max_compiling{0};
+    mutable std::atomic<int> outstanding{0}; // Compiled but not yet measured.
+    mutable int max_outstanding = 0;
+    mutable int last_run        = -1;
+};
+
+class GenericSearchTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing serial search..." << std::endl;
+        Search({16, -1, -1}, 0, 0);
+        std::cout << "Testing pipelined search..." << std::endl;
+        Search({16, -1, -1}, 4, 8);
+        Search({16, -1, -1}, 3, 1);
+        std::cout << "Testing pipelined search with failures..." << std::endl;
+        Search({16, 10, -1}, 4, 8, 1, 8);
+        Search({16, -1, 10}, 4, 8, 1, 8);
+        std::cout << "Testing failed search..." << std::endl;
+        Search({1, 0, -1}, 4, 8, 1);
+        Search({0, -1, -1}, 4, 8, 0);
+        std::cout << "Testing search checkpoints..." << std::endl;
+        TestCheckpoints();
+        TestCrashingCompile();
+    }
+
+    private:
+    static void Search(const MockContext& context,
+                       std::size_t n_workers,
+                       std::size_t lookahead,
+                       int n_failed = 0,
+                       int expected_best = 10)
+    {
+        const solver::ComputedContainer<MockConfig, MockContext> configs(context);
+        const MockSolver solver{context};
+        auto best_config = MockConfig{};
+        auto best_time   = 0.0f;
+
+        const auto is_passed = solver::SearchBestConfig(
+            configs,
+            context.n_configs,
+            n_workers,
+            lookahead,
+            [&](const MockConfig& config) { return solver.Compile(config); },
+            [&](const MockConfig& config, const MockSolver::Program& program) {
+                return solver.Start(config, program);
+            },
+            best_config,
+            best_time);
+
+        EXPECT_EQUAL(is_passed, context.n_configs > n_failed);
+
+        if(is_passed)
+        {
+            EXPECT_EQUAL(best_config.value, expected_best);
+            EXPECT_EQUAL(best_time, 1.0f + std::abs(expected_best - 10) * 0.5f);
+        }
+
+        const auto max_outstanding = std::max<std::size_t>(lookahead, 1);
+        EXPECT(solver.GetMaxOutstanding() <= static_cast<int>(max_outstanding));
+        if(n_workers > 1 && lookahead > 1 && context.n_configs > 1)
+            EXPECT(solver.GetMaxCompiling() > 1);
+        else
+            EXPECT(solver.GetMaxCompiling() <= 1);
+    }
+
+    using Checkpointer = solver::SearchCheckpointer<MockConfig, MockContext>;
+
+    static Checkpointer MakeCheckpointer(const std::string& path, const MockContext& context)
+    {
+        return {path, context, "MockSolver", 16, std::chrono::seconds(0)};
+    }
+
+    /// Interrupts the search after the given configs, with progress saved after each of them.
+    static void Interrupt(const std::string& path, const std::vector<int>& values)
+    {
+        const MockContext context{16, -1, -1};
+        auto checkpointer = MakeCheckpointer(path, context);
+        auto best_config  = MockConfig{};
+        auto best_time    = std::numeric_limits<float>::max();
+        checkpointer.Resume(best_config, best_time);
+
+        for(const auto value : values)
+        {
+            const auto config = MockConfig{value};
+            if(config.GetTime() < best_time)
+            {
+                best_config = config;
+                best_time   = config.GetTime();
+            }
+            checkpointer.OnConsumed(false, best_config, best_time);
+        }
+    }
+
+    /// Returns the value of the first config measured by the resumed search.
+    static int Resume(const std::string& path, int expected_best)
+    {
+        const MockContext context{16, -1, -1};
+        const solver::ComputedContainer<MockConfig, MockContext> configs(context);
+        const MockSolver solver{context};
+        auto checkpointer = MakeCheckpointer(path, context);
+        auto best_config  = MockConfig{};
+        auto best_time    = 0.0f;
+        auto first        = -1;
+
+        const auto is_passed = solver::SearchWithCheckpoints(
+            checkpointer,
+            solver::SearchOptions{},
+            configs,
+            context.n_configs,
+            2,
+            4,
+            [&](const MockConfig& config) { return solver.Compile(config); },
+            [&](const MockConfig& config, const MockSolver::Program& program) {
+                if(first < 0)
+                    first = config.value;
+                return solver.Start(config, program);
+            },
+            best_config,
+            best_time);
+
+        EXPECT(is_passed);
+        EXPECT_EQUAL(best_config.value, expected_best);
+        EXPECT_EQUAL(best_time, MockConfig{expected_best}.GetTime());
+        return first;
+    }
+
+    static void TestCheckpoints()
+    {
+        const TmpDir dir{"generic_search"};
+        const auto path = (dir.path / "search.ckpt.txt").string();
+
+        // A search without a checkpoint starts from the beginning and removes its checkpoint.
+        EXPECT_EQUAL(Resume(path, 10), 0);
+        EXPECT_EQUAL(Resume(path, 10), 0);
+
+        // The search is resumed after the last measured config.
+        Interrupt(path, {0, 2, 4});
+        EXPECT_EQUAL(Resume(path, 10), 6);
+
+        // The best config found before the interruption is kept.
+        Interrupt(path, {0, 2, 4, 6, 8, 10, 12});
+        EXPECT_EQUAL(Resume(path, 10), 14);
+        EXPECT_EQUAL(Resume(path, 10), 0);
+
+        // The config which interrupts each resumed search is skipped.
+        Interrupt(path, {0, 2});
+        const MockContext context{16, -1, -1};
+        for(const auto expected : {2, 2, 3})
+        {
+            auto checkpointer = MakeCheckpointer(path, context);
+            auto best_config  = MockConfig{};
+            auto best_time    = std::numeric_limits<float>::max();
+            EXPECT_EQUAL(checkpointer.Resume(best_config, best_time), expected);
+            EXPECT_EQUAL(best_config.value, 2);
+        }
+        EXPECT_EQUAL(Resume(path, 10), 6);
+
+        // A checkpoint of a different search space is ignored.
+        Interrupt(path, {0, 2});
+        auto checkpointer = Checkpointer{path, context, "MockSolver", 17, std::chrono::seconds(0)};
+        auto best_config  = MockConfig{};
+        auto best_time    = std::numeric_limits<float>::max();
+        EXPECT_EQUAL(checkpointer.Resume(best_config, best_time), 0);
+        checkpointer.Finish();
+    }
+
+    /// Runs the resumed search in a child process, which exits with the status 2 when the given
+    /// config is compiled, as a crash of the compiler would do. Returns the exit status.
+    static int RunCrashing(const std::string& path, int crashing)
+    {
+        const auto pid = fork();
+        EXPECT(pid >= 0);
+
+        if(pid == 0)
+        {
+            alarm(60);
+            const MockContext context{16, -1, -1};
+            const solver::ComputedContainer<MockConfig, MockContext> configs(context);
+            const MockSolver solver{context};
+            auto checkpointer = MakeCheckpointer(path, context);
+            auto best_config  = MockConfig{};
+            auto best_time    = 0.0f;
+
+            const auto is_passed = solver::SearchWithCheckpoints(
+                checkpointer,
+                solver::SearchOptions{},
+                configs,
+                context.n_configs,
+                2,
+                4,
+                [&](const MockConfig& config) {
+                    if(config.value == crashing)
+                        std::_Exit(2);
+                    return solver.Compile(config);
+                },
+                [&](const MockConfig& config, const MockSolver::Program& program) {
+                    return solver.Start(config, program);
+                },
+                best_config,
+                best_time);
+
+            std::_Exit(is_passed && best_config.value == 10 ? 0 : 1);
+        }
+
+        auto status = 0;
+        EXPECT(waitpid(pid, &status, 0) == pid);
+        EXPECT(WIFEXITED(status));
+        return WEXITSTATUS(status);
+    }
+
+    static void TestCrashingCompile()
+    {
+        std::cout << "Testing search checkpoints with a config crashing ahead..." << std::endl;
+
+        const TmpDir dir{"generic_search"};
+        const auto path = (dir.path / "search.ckpt.txt").string();
+        const MockContext context{16, -1, -1};
+
+        // The config 6 (#3) crashes the search while the previous ones are measured. It shall be
+        // the only one skipped, as suspect searches do not compile ahead.
+        auto n_runs = 0;
+        for(; n_runs < 16; ++n_runs)
+        {
+            const auto status = RunCrashing(path, 6);
+            if(status != 2)
+            {
+                EXPECT_EQUAL(status, 0);
+                break;
+            }
+
+            auto checkpoint = solver::SearchCheckpoint<MockConfig>{};
+            EXPECT(PlainTextDb{path}.Load(context, "MockSolver", checkpoint));
+            for(const auto failed : checkpoint.failed)
+                EXPECT_EQUAL(failed, std::size_t{3});
+        }
+        EXPECT(n_runs < 16);
+    }
+};
+
+struct GridContext
+{
+};
+
+/// Two-dimensional config, the time of which is the best for the config (3, 5).
+struct GridConfig
+{
+    int x;
+    int y;
+
+    GridConfig() : x(-1), y(-1) {}
+    GridConfig(int x_, int y_) : x(x_), y(y_) {}
+    GridConfig(bool) : x(0), y(0) {}
+
+    bool SetNextValue()
+    {
+        if(++x < 8)
+            return true;
+        x = 0;
+        return ++y < 8;
+    }
+
+    bool IsValid(const GridContext&) const { return true; }
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.x, "x");
+        f(self.y, "y");
+    }
+
+    float GetTime() const { return 1.0f + (x - 3) * (x - 3) + (y - 5) * (y - 5); }
+
+    bool operator==(const GridConfig& other) const { return x == other.x && y == other.y; }
+
+    friend std::ostream& operator<<(std::ostream& os, const GridConfig& config)
+    {
+        return os << config.x << ',' << config.y;
+    }
+};
+
+class SearchStrategyTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing search strategies..." << std::endl;
+        solver::SearchOptions options;
+        const auto exhaustive = Search(options);
+        EXPECT_EQUAL(exhaustive.trials, 64);
+        EXPECT(exhaustive.best == GridConfig(3, 5));
+        EXPECT(!exhaustive.is_limited);
+
+        options.strategy = solver::SearchStrategy::CoordinateDescent;
+        const auto descent = Search(options);
+        EXPECT(descent.best == GridConfig(3, 5));
+        EXPECT(descent.trials < exhaustive.trials);
+        EXPECT(descent.is_limited);
+
+        options.strategy = solver::SearchStrategy::Halving;
+        const auto halving = Search(options);
+        EXPECT(halving.best == GridConfig(3, 5));
+        EXPECT_EQUAL(halving.trials, 64);
+        EXPECT(!halving.is_limited);
+
+        std::cout << "Testing search budget..." << std::endl;
+        options.max_trials = 10;
+        for(const auto strategy : {solver::SearchStrategy::Exhaustive,
+                                   solver::SearchStrategy::Random,
+                                   solver::SearchStrategy::Halving,
+                                   solver::SearchStrategy::CoordinateDescent})
+        {
+            options.strategy  = strategy;
+            const auto result = Search(options);
+            EXPECT_EQUAL(result.trials, 10);
+            EXPECT(result.is_limited);
+        }
+
+        // The first 10 configs are the row y = 0, (0, 1) and (1, 1), which is the best of them.
+        options.strategy = solver::SearchStrategy::Exhaustive;
+        EXPECT(Search(options).best == GridConfig(1, 1));
+        TestHalvingTime();
+
+        std::cout << "Testing search trace..." << std::endl;
+        TestTrace();
+    }
+
+    private:
+    struct Result
+    {
+        GridConfig best;
+        float time;
+        std::size_t trials; // Configs measured, each one is counted once.
+        bool is_limited;
+    };
+
+    static Result Search(const solver::SearchOptions& options)
+    {
+        const solver::ComputedContainer<GridConfig, GridContext> configs(GridContext{});
+        auto result  = Result{{}, 0.0f, 0, false};
+        auto started = std::set<std::pair<int, int>>{};
+
+        const auto is_passed = solver::RunSearchStrategy(
+            options,
+            configs,
+            64,
+            GridConfig{0, 0},
+            2,
+            4,
+            [](const GridConfig& config) { return config; },
+            [&](const GridConfig& config, const GridConfig&) {
+                started.insert(std::make_pair(config.x, config.y));
+                return [config]() { return config.GetTime(); };
+            },
+            result.best,
+            result.time);
+
+        EXPECT(is_passed);
+        result.trials = started.size();
+        EXPECT_EQUAL(result.time, result.best.GetTime());
+        result.is_limited = solver::IsLastSearchLimited();
+        return result;
+    }
+
+    /// Each re-measurement of halving takes 100 ms, so its rounds after the first one would take
+    /// seconds without the time budget. Invokers shall not outlive their measurements.
+    static void TestHalvingTime()
+    {
+        solver::SearchOptions options;
+        options.strategy = solver::SearchStrategy::Halving;
+        options.max_time = 1;
+
+        const solver::ComputedContainer<GridConfig, GridContext> configs(GridContext{});
+        auto best_config = GridConfig{};
+        auto best_time   = 0.0f;
+        auto n_started   = std::map<std::pair<int, int>, int>{};
+        auto invoker     = std::make_shared<int>(0);
+        auto max_alive   = 0L;
+        const auto begin = std::chrono::steady_clock::now();
+
+        const auto is_passed = solver::RunSearchStrategy(
+            options,
+            configs,
+            64,
+            GridConfig{0, 0},
+            2,
+            4,
+            [](const GridConfig& config) { return config; },
+            [&](const GridConfig& config, const GridConfig&) {
+                max_alive       = std::max(max_alive, invoker.use_count() - 1);
+                const auto slow = n_started[std::make_pair(config.x, config.y)]++ > 0;
+                return [config, slow, invoker]() {
+                    if(slow)
+                        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                    return config.GetTime();
+                };
+            },
+            best_config,
+            best_time);
+
+        EXPECT(is_passed);
+        EXPECT(solver::IsLastSearchLimited());
+        EXPECT(std::chrono::steady_clock::now() - begin < std::chrono::seconds(3));
+        // The first round is complete, and the re-measured configs keep their times.
+        EXPECT(best_config == GridConfig(3, 5));
+        EXPECT_EQUAL(max_alive, 0);
+    }
+
+    static void TestTrace()
+    {
+        auto trace = solver::SearchTrace{"GridSolver", {}, {}};
+        for(auto y = 0; y < 8; ++y)
+            for(auto x = 0; x < 8; ++x)
+                trace.Add(GridConfig{x, y}, GridConfig{x, y}.GetTime());
+
+        std::stringstream ss;
+        trace.Write(ss);
+        trace.Write(ss);
+        const auto traces = solver::SearchTrace::Read(ss);
+        EXPECT_EQUAL(traces.size(), 2);
+        EXPECT_EQUAL(traces[1].solver, "GridSolver");
+        EXPECT_EQUAL(traces[1].configs.size(), 64);
+        EXPECT(traces[1].configs[11] == trace.configs[11]);
+        EXPECT_EQUAL(traces[1].times[11], trace.times[11]);
+
+        solver::SearchOptions options;
+        const auto exhaustive = solver::EvaluateSearchStrategy(traces[1], options);
+        EXPECT_EQUAL(exhaustive.trials, 64);
+        EXPECT_EQUAL(exhaustive.GetRegret(), 0.0f);
+        EXPECT(exhaustive.best_config == trace.configs[5 * 8 + 3]);
+
+        options.strategy   = solver::SearchStrategy::Random;
+        options.max_trials = 16;
+        const auto random  = solver::EvaluateSearchStrategy(traces[1], options);
+        EXPECT_EQUAL(random.trials, 16);
+        EXPECT(random.GetRegret() >= 0.0f);
+
+        options.strategy   = solver::SearchStrategy::CoordinateDescent;
+        options.max_trials = 0;
+        const auto descent = solver::EvaluateSearchStrategy(traces[1], options);
+        EXPECT(descent.trials < 64);
+        EXPECT_EQUAL(descent.GetRegret(), 0.0f);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main()
+{
+    miopen::tests::GenericSearchTest().Run();
+    miopen::tests::SearchStrategyTest().Run();
+}
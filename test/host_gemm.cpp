@@ -0,0 +1,157 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+
+#include <miopen/host_gemm.hpp>
+
+#include <half.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+struct HostGemmCase
+{
+    bool trans_a;
+    bool trans_b;
+    std::size_t m;
+    std::size_t n;
+    std::size_t k;
+    double alpha;
+    double beta;
+};
+
+class HostGemmTest
+{
+    public:
+    void Run() const
+    {
+        // Sizes cross the boundaries of micro-kernels, tiles and panels, see HostGemmMC etc.
+        const std::size_t sizes[][3] = {
+            {1, 1, 1}, {3, 17, 5}, {70, 270, 300}, {1, 1024, 96}, {129, 5, 513}, {8, 8, 0}};
+        const double scales[][2] = {{1.0, 0.0}, {1.0, 1.0}, {-0.5, 2.0}};
+
+        for(const auto& size : sizes)
+        {
+            for(const auto& scale : scales)
+            {
+                for(auto trans = 0; trans < 4; ++trans)
+                {
+                    const auto test_case = HostGemmCase{(trans & 1) != 0,
+                                                        (trans & 2) != 0,
+                                                        size[0],
+                                                        size[1],
+                                                        size[2],
+                                                        scale[0],
+                                                        scale[1]};
+                    Check<float, double>(test_case, 1e-6);
+                    Check<float, float>(test_case, 1e-5);
+                    Check<double, double>(test_case, 1e-12);
+                    Check<half_float::half, float>(test_case, 1e-3);
+                    Check<half_float::half, half_float::half>(test_case, 1e-1);
+                }
+            }
+        }
+    }
+
+    private:
+    /// Row-major matrix of rows x cols with padded rows.
+    template <class T>
+    struct Matrix
+    {
+        Matrix(std::size_t rows_, std::size_t cols_, int seed)
+            : rows(rows_), cols(cols_), ld(cols_ + 3), data(rows_ * ld)
+        {
+            for(auto i = std::size_t{0}; i < data.size(); ++i)
+                data[i] = static_cast<T>(static_cast<float>((i * 37 + seed) % 19) / 8 - 1);
+        }
+
+        double operator()(std::size_t row, std::size_t col, bool trans) const
+        {
+            return static_cast<double>(trans ? data[col * ld + row] : data[row * ld + col]);
+        }
+
+        std::size_t rows;
+        std::size_t cols;
+        std::size_t ld;
+        std::vector<T> data;
+    };
+
+    /// Checks against the naive product, with the error relative to the sum of the magnitudes.
+    template <class T, class Acc>
+    static void Check(const HostGemmCase& test_case, double tolerance)
+    {
+        const auto& t = test_case;
+        const auto a  = t.trans_a ? Matrix<T>{t.k, t.m, 1} : Matrix<T>{t.m, t.k, 1};
+        const auto b  = t.trans_b ? Matrix<T>{t.n, t.k, 2} : Matrix<T>{t.k, t.n, 2};
+        auto c        = Matrix<T>{t.m, t.n, 3};
+        const auto c0 = c;
+
+        HostGemm<Acc>(t.trans_a,
+                      t.trans_b,
+                      t.m,
+                      t.n,
+                      t.k,
+                      t.alpha,
+                      a.data.data(),
+                      a.ld,
+                      b.data.data(),
+                      b.ld,
+                      t.beta,
+                      c.data.data(),
+                      c.ld);
+
+        for(auto i = std::size_t{0}; i < t.m; ++i)
+        {
+            for(auto j = std::size_t{0}; j < t.n; ++j)
+            {
+                auto sum       = 0.0;
+                auto magnitude = std::abs(t.beta * c0(i, j, false));
+                for(auto p = std::size_t{0}; p < t.k; ++p)
+                {
+                    const auto product = a(i, p, t.trans_a) * b(p, j, t.trans_b);
+                    sum += product;
+                    magnitude += std::abs(t.alpha * product);
+                }
+                const auto expected = t.alpha * sum + t.beta * c0(i, j, false);
+                const auto error    = std::abs(c(i, j, false) - expected);
+                EXPECT(error <= tolerance * std::max(magnitude, 1.0));
+            }
+            // Padding is not written.
+            for(auto j = t.n; j < c.ld; ++j)
+                EXPECT(c(i, j, false) == c0(i, j, false));
+        }
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::HostGemmTest().Run(); }
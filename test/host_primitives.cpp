@@ -0,0 +1,529 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+
+#include <miopen/config.h>
+
+#if MIOPEN_MODE_NOGPU
+#include <miopen/activ.hpp>
+#include <miopen/batch_norm.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/lrn.hpp>
+#include <miopen/null_device.hpp>
+#include <miopen/pooling.hpp>
+#include <miopen/reducetensor.hpp>
+#include <miopen/softmax.hpp>
+#include <miopen/tensor.hpp>
+#include <miopen/tensor_ops.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+/// Checks the host execution of the non-convolution primitives against naive references. All
+/// the tensors are packed NCHW fp32 ones, so (n, c, h, w) maps to ((n * C + c) * H + h) * W + w.
+class HostPrimitivesTest
+{
+    public:
+    void Run() const
+    {
+        NullDevice::Get().SetHostExecution(true);
+
+        CheckElementwise();
+        CheckActivation();
+        CheckPooling();
+        CheckSoftmax();
+        CheckBatchNorm();
+        CheckLRN();
+        CheckReduction();
+
+        NullDevice::Get().SetHostExecution(false);
+    }
+
+    private:
+    static constexpr std::size_t N = 2;
+    static constexpr std::size_t C = 3;
+    static constexpr std::size_t H = 4;
+    static constexpr std::size_t W = 5;
+
+    static std::size_t Index(std::size_t n, std::size_t c, std::size_t h, std::size_t w)
+    {
+        return ((n * C + c) * H + h) * W + w;
+    }
+
+    static std::vector<float> MakeData(std::size_t size, int seed)
+    {
+        auto data = std::vector<float>(size);
+        for(auto i = std::size_t{0}; i < size; ++i)
+            data[i] = static_cast<float>(static_cast<int>((i * 37 + seed) % 17) - 8) / 8;
+        return data;
+    }
+
+    /// Pairwise distinct values, so the maximums do not depend on the traversal order.
+    static std::vector<float> MakeDistinctData(std::size_t size)
+    {
+        auto data = std::vector<float>(size);
+        for(auto i = std::size_t{0}; i < size; ++i)
+            data[i] = static_cast<float>(static_cast<int>(i * 7919 % 1000) - 500) / 100;
+        return data;
+    }
+
+    static void Compare(const std::vector<float>& result, const std::vector<double>& expected)
+    {
+        EXPECT_EQUAL(result.size(), expected.size());
+        for(auto i = std::size_t{0}; i < expected.size(); ++i)
+        {
+            const auto tolerance = 1e-4 * std::max(1.0, std::abs(expected[i]));
+            EXPECT(std::abs(result[i] - expected[i]) <= tolerance);
+        }
+    }
+
+    static void CheckElementwise()
+    {
+        Handle handle{};
+        const auto desc   = TensorDescriptor{miopenFloat, {N, C, H, W}};
+        const auto b_desc = TensorDescriptor{miopenFloat, {1, C, 1, 1}};
+        const auto x      = MakeData(desc.GetElementSize(), 1);
+        const auto b      = MakeData(b_desc.GetElementSize(), 2);
+        auto x_dev        = handle.Write(x);
+        auto b_dev        = handle.Write(b);
+        auto y_dev        = handle.Create<float>(x.size());
+
+        // y = x + 2 * b, with b broadcast over n, h and w.
+        const auto one  = 1.0f;
+        const auto two  = 2.0f;
+        const auto zero = 0.0f;
+        OpTensor(handle,
+                 miopenTensorOpAdd,
+                 &one,
+                 desc,
+                 x_dev.get(),
+                 &two,
+                 b_desc,
+                 b_dev.get(),
+                 &zero,
+                 desc,
+                 y_dev.get());
+        auto expected = std::vector<double>(x.size());
+        for(auto i = std::size_t{0}; i < x.size(); ++i)
+            expected[i] = x[i] + 2.0 * b[i / (H * W) % C];
+        Compare(handle.Read<float>(y_dev, x.size()), expected);
+
+        const auto half  = 0.5f;
+        const auto three = 3.0f;
+        SetTensor(handle, desc, y_dev.get(), &half);
+        ScaleTensor(handle, desc, y_dev.get(), &three);
+        Compare(handle.Read<float>(y_dev, x.size()), std::vector<double>(x.size(), 1.5));
+
+        // y = 2 * x + 3 * y on top of a copy of x.
+        CopyTensor(handle, desc, x_dev.get(), desc, y_dev.get());
+        Compare(handle.Read<float>(y_dev, x.size()), {x.begin(), x.end()});
+        TransformTensor(handle, &two, desc, x_dev.get(), &three, desc, y_dev.get());
+        std::transform(x.begin(), x.end(), expected.begin(), [](float v) { return 5.0 * v; });
+        Compare(handle.Read<float>(y_dev, x.size()), expected);
+    }
+
+    static void CheckActivation()
+    {
+        Handle handle{};
+        const auto desc = TensorDescriptor{miopenFloat, {N, C, H, W}};
+        const auto x    = MakeData(desc.GetElementSize(), 3);
+        const auto dy   = MakeData(desc.GetElementSize(), 4);
+        auto x_dev      = handle.Write(x);
+        auto dy_dev     = handle.Write(dy);
+        auto y_dev      = handle.Create<float>(x.size());
+        auto dx_dev     = handle.Create<float>(x.size());
+
+        const auto slope = 0.25;
+        const auto one   = 1.0f;
+        const auto zero  = 0.0f;
+        auto activ       = ActivationDescriptor{miopenActivationLEAKYRELU, slope, 0.0, 0.0};
+        activ.Forward(handle, &one, desc, x_dev.get(), &zero, desc, y_dev.get());
+        activ.Backward(handle,
+                       &one,
+                       desc,
+                       y_dev.get(),
+                       desc,
+                       dy_dev.get(),
+                       desc,
+                       x_dev.get(),
+                       &zero,
+                       desc,
+                       dx_dev.get());
+
+        auto y_ref  = std::vector<double>(x.size());
+        auto dx_ref = std::vector<double>(x.size());
+        for(auto i = std::size_t{0}; i < x.size(); ++i)
+        {
+            y_ref[i]  = x[i] > 0 ? x[i] : slope * x[i];
+            dx_ref[i] = x[i] > 0 ? dy[i] : slope * dy[i];
+        }
+        Compare(handle.Read<float>(y_dev, x.size()), y_ref);
+        Compare(handle.Read<float>(dx_dev, x.size()), dx_ref);
+    }
+
+    static void CheckPooling()
+    {
+        // 2x2 windows with the stride of 2 and the padding of 1 clip the borders.
+        const auto x_desc = TensorDescriptor{miopenFloat, {N, C, H, W}};
+        const auto x      = MakeDistinctData(x_desc.GetElementSize());
+        for(auto mode : {miopenPoolingMax, miopenPoolingAverage})
+        {
+            Handle handle{};
+            const auto pooling =
+                PoolingDescriptor{mode, miopenPaddingDefault, {2, 2}, {2, 2}, {1, 1}};
+            const auto y_desc = pooling.GetForwardOutputTensor(x_desc);
+            const auto& y_len = y_desc.GetLengths();
+            const auto dy     = MakeData(y_desc.GetElementSize(), 5);
+            auto x_dev        = handle.Write(x);
+            auto dy_dev       = handle.Write(dy);
+            auto y_dev        = handle.Create<float>(dy.size());
+            auto dx_dev       = handle.Create<float>(x.size());
+            auto ws_dev       = handle.Create(pooling.GetWorkSpaceSize(y_desc));
+
+            auto y_ref  = std::vector<double>(dy.size());
+            auto dx_ref = std::vector<double>(x.size(), 0.0);
+            auto y_i    = std::size_t{0};
+            for(auto nc = std::size_t{0}; nc < N * C; ++nc)
+                for(auto oh = std::size_t{0}; oh < y_len[2]; ++oh)
+                    for(auto ow = std::size_t{0}; ow < y_len[3]; ++ow, ++y_i)
+                    {
+                        auto inputs = std::vector<std::size_t>{};
+                        for(auto h = oh * 2; h < oh * 2 + 2; ++h)
+                            for(auto w = ow * 2; w < ow * 2 + 2; ++w)
+                                if(h >= 1 && h <= H && w >= 1 && w <= W)
+                                    inputs.push_back(Index(0, nc, h - 1, w - 1));
+
+                        if(mode == miopenPoolingMax)
+                        {
+                            const auto arg = *std::max_element(
+                                inputs.begin(), inputs.end(), [&](auto l, auto r) {
+                                    return x[l] < x[r];
+                                });
+                            y_ref[y_i] = x[arg];
+                            dx_ref[arg] += dy[y_i];
+                            continue;
+                        }
+                        y_ref[y_i] = 0;
+                        for(auto i : inputs)
+                            y_ref[y_i] += x[i] / static_cast<double>(inputs.size());
+                        for(auto i : inputs)
+                            dx_ref[i] += dy[y_i] / static_cast<double>(inputs.size());
+                    }
+
+            const auto one  = 1.0f;
+            const auto zero = 0.0f;
+            pooling.Forward(handle,
+                            &one,
+                            x_desc,
+                            x_dev.get(),
+                            &zero,
+                            y_desc,
+                            y_dev.get(),
+                            true,
+                            ws_dev.get(),
+                            pooling.GetWorkSpaceSize(y_desc));
+            pooling.Backward(handle,
+                             &one,
+                             y_desc,
+                             y_dev.get(),
+                             y_desc,
+                             dy_dev.get(),
+                             x_desc,
+                             x_dev.get(),
+                             &zero,
+                             x_desc,
+                             dx_dev.get(),
+                             ws_dev.get());
+            Compare(handle.Read<float>(y_dev, dy.size()), y_ref);
+            Compare(handle.Read<float>(dx_dev, x.size()), dx_ref);
+        }
+    }
+
+    static void CheckSoftmax()
+    {
+        Handle handle{};
+        const auto desc = TensorDescriptor{miopenFloat, {N, C, H, W}};
+        const auto x    = MakeData(desc.GetElementSize(), 6);
+        const auto dy   = MakeData(desc.GetElementSize(), 7);
+        auto x_dev      = handle.Write(x);
+        auto dy_dev     = handle.Write(dy);
+        auto y_dev      = handle.Create<float>(x.size());
+        auto dx_dev     = handle.Create<float>(x.size());
+
+        const auto one  = 1.0f;
+        const auto zero = 0.0f;
+        SoftmaxForward(handle,
+                       &one,
+                       &zero,
+                       desc,
+                       x_dev.get(),
+                       desc,
+                       y_dev.get(),
+                       MIOPEN_SOFTMAX_ACCURATE,
+                       MIOPEN_SOFTMAX_MODE_CHANNEL);
+        SoftmaxBackward(handle,
+                        &one,
+                        desc,
+                        y_dev.get(),
+                        desc,
+                        dy_dev.get(),
+                        &zero,
+                        desc,
+                        dx_dev.get(),
+                        MIOPEN_SOFTMAX_ACCURATE,
+                        MIOPEN_SOFTMAX_MODE_CHANNEL);
+
+        auto y_ref  = std::vector<double>(x.size());
+        auto dx_ref = std::vector<double>(x.size());
+        for(auto n = std::size_t{0}; n < N; ++n)
+            for(auto hw = std::size_t{0}; hw < H * W; ++hw)
+            {
+                const auto at = [&](std::size_t c) { return Index(n, c, 0, 0) + hw; };
+                auto sum      = 0.0;
+                for(auto c = std::size_t{0}; c < C; ++c)
+                    sum += std::exp(static_cast<double>(x[at(c)]));
+                auto dot = 0.0;
+                for(auto c = std::size_t{0}; c < C; ++c)
+                {
+                    y_ref[at(c)] = std::exp(static_cast<double>(x[at(c)])) / sum;
+                    dot += y_ref[at(c)] * dy[at(c)];
+                }
+                for(auto c = std::size_t{0}; c < C; ++c)
+                    dx_ref[at(c)] = y_ref[at(c)] * (dy[at(c)] - dot);
+            }
+        Compare(handle.Read<float>(y_dev, x.size()), y_ref);
+        Compare(handle.Read<float>(dx_dev, x.size()), dx_ref);
+    }
+
+    static void CheckBatchNorm()
+    {
+        Handle handle{};
+        const auto desc   = TensorDescriptor{miopenFloat, {N, C, H, W}};
+        const auto p_desc = TensorDescriptor{miopenFloat, {1, C, 1, 1}};
+        const auto x      = MakeData(desc.GetElementSize(), 8);
+        const auto dy     = MakeData(desc.GetElementSize(), 9);
+        const auto scale  = std::vector<float>{0.5f, 1.0f, 2.0f};
+        const auto bias   = std::vector<float>{-1.0f, 0.0f, 1.0f};
+        const auto eps    = 1e-5;
+        auto x_dev        = handle.Write(x);
+        auto dy_dev       = handle.Write(dy);
+        auto scale_dev    = handle.Write(scale);
+        auto bias_dev     = handle.Write(bias);
+        auto run_mean_dev = handle.Write(std::vector<float>(C, 0.0f));
+        auto run_var_dev  = handle.Write(std::vector<float>(C, 1.0f));
+        auto mean_dev     = handle.Create<float>(C);
+        auto inv_var_dev  = handle.Create<float>(C);
+        auto y_dev        = handle.Create<float>(x.size());
+        auto dx_dev       = handle.Create<float>(x.size());
+        auto dscale_dev   = handle.Create<float>(C);
+        auto dbias_dev    = handle.Create<float>(C);
+
+        const auto one  = 1.0f;
+        const auto zero = 0.0f;
+        BatchNormForwardTraining(handle,
+                                 miopenBNSpatial,
+                                 &one,
+                                 &zero,
+                                 desc,
+                                 x_dev.get(),
+                                 desc,
+                                 y_dev.get(),
+                                 p_desc,
+                                 scale_dev.get(),
+                                 bias_dev.get(),
+                                 1.0,
+                                 run_mean_dev.get(),
+                                 run_var_dev.get(),
+                                 eps,
+                                 mean_dev.get(),
+                                 inv_var_dev.get());
+        BatchNormBackward(handle,
+                          miopenBNSpatial,
+                          &one,
+                          &zero,
+                          &one,
+                          &zero,
+                          desc,
+                          x_dev.get(),
+                          desc,
+                          dy_dev.get(),
+                          desc,
+                          dx_dev.get(),
+                          p_desc,
+                          scale_dev.get(),
+                          dscale_dev.get(),
+                          dbias_dev.get(),
+                          eps,
+                          mean_dev.get(),
+                          inv_var_dev.get());
+
+        const auto size = static_cast<double>(N * H * W);
+        auto mean       = std::vector<double>(C, 0.0);
+        auto variance   = std::vector<double>(C, 0.0);
+        auto inv_var    = std::vector<double>(C);
+        auto run_var    = std::vector<double>(C);
+        auto dscale     = std::vector<double>(C, 0.0);
+        auto dbias      = std::vector<double>(C, 0.0);
+        auto y_ref      = std::vector<double>(x.size());
+        auto dx_ref     = std::vector<double>(x.size());
+        for(auto i = std::size_t{0}; i < x.size(); ++i)
+            mean[i / (H * W) % C] += x[i] / size;
+        for(auto i = std::size_t{0}; i < x.size(); ++i)
+            variance[i / (H * W) % C] += std::pow(x[i] - mean[i / (H * W) % C], 2) / size;
+        for(auto c = std::size_t{0}; c < C; ++c)
+        {
+            inv_var[c] = 1 / std::sqrt(variance[c] + eps);
+            run_var[c] = variance[c] * size / (size - 1);
+        }
+        for(auto i = std::size_t{0}; i < x.size(); ++i)
+        {
+            const auto c    = i / (H * W) % C;
+            const auto xhat = (x[i] - mean[c]) * inv_var[c];
+            y_ref[i]        = scale[c] * xhat + bias[c];
+            dbias[c] += dy[i];
+            dscale[c] += dy[i] * xhat;
+        }
+        for(auto i = std::size_t{0}; i < x.size(); ++i)
+        {
+            const auto c    = i / (H * W) % C;
+            const auto xhat = (x[i] - mean[c]) * inv_var[c];
+            dx_ref[i] = scale[c] * inv_var[c] / size * (size * dy[i] - dbias[c] - xhat * dscale[c]);
+        }
+
+        Compare(handle.Read<float>(y_dev, x.size()), y_ref);
+        Compare(handle.Read<float>(mean_dev, C), mean);
+        Compare(handle.Read<float>(inv_var_dev, C), inv_var);
+        Compare(handle.Read<float>(run_mean_dev, C), mean);
+        Compare(handle.Read<float>(run_var_dev, C), run_var);
+        Compare(handle.Read<float>(dx_dev, x.size()), dx_ref);
+        Compare(handle.Read<float>(dscale_dev, C), dscale);
+        Compare(handle.Read<float>(dbias_dev, C), dbias);
+    }
+
+    static void CheckLRN()
+    {
+        Handle handle{};
+        const auto desc = TensorDescriptor{miopenFloat, {N, C, H, W}};
+        const auto x    = MakeData(desc.GetElementSize(), 10);
+        const auto lrn  = LRNDescriptor{miopenLRNCrossChannel, 3, {0.5, 0.75, 2.0}};
+        auto x_dev      = handle.Write(x);
+        auto y_dev      = handle.Create<float>(x.size());
+
+        const auto one  = 1.0f;
+        const auto zero = 0.0f;
+        lrn.Forward(handle, &one, desc, x_dev.get(), &zero, desc, y_dev.get(), false, nullptr);
+
+        auto y_ref = std::vector<double>(x.size());
+        for(auto n = std::size_t{0}; n < N; ++n)
+            for(auto c = std::size_t{0}; c < C; ++c)
+                for(auto hw = std::size_t{0}; hw < H * W; ++hw)
+                {
+                    auto sum = 0.0;
+                    for(auto c_ = std::max<std::size_t>(c, 1) - 1; c_ <= std::min(c + 1, C - 1);
+                        ++c_)
+                        sum += std::pow(x[Index(n, c_, 0, 0) + hw], 2);
+                    const auto i = Index(n, c, 0, 0) + hw;
+                    y_ref[i]     = x[i] * std::pow(2.0 + 0.5 / 3 * sum, -0.75);
+                }
+        Compare(handle.Read<float>(y_dev, x.size()), y_ref);
+    }
+
+    static void CheckReduction()
+    {
+        Handle handle{};
+        const auto a_desc = TensorDescriptor{miopenFloat, {N, C, H, W}};
+        const auto a      = MakeDistinctData(a_desc.GetElementSize());
+        auto a_dev        = handle.Write(a);
+
+        const auto one  = 1.0f;
+        const auto zero = 0.0f;
+        const auto reduce =
+            [&](miopenReduceTensorOp_t op, const TensorDescriptor& c_desc, bool with_indices) {
+                const auto desc = ReduceTensorDescriptor{
+                    op,
+                    miopenFloat,
+                    MIOPEN_PROPAGATE_NAN,
+                    with_indices ? MIOPEN_REDUCE_TENSOR_FLATTENED_INDICES
+                                 : MIOPEN_REDUCE_TENSOR_NO_INDICES,
+                    MIOPEN_32BIT_INDICES};
+                const auto ws_size      = desc.GetWorkspaceSize(handle, a_desc, c_desc);
+                const auto indices_size = desc.GetIndicesSize(a_desc, c_desc);
+                auto ws_dev             = handle.Create(std::max<std::size_t>(ws_size, 1));
+                auto indices_dev        = handle.Create(std::max<std::size_t>(indices_size, 1));
+                auto c_dev              = handle.Create<float>(c_desc.GetElementSize());
+                desc.ReduceTensor(handle,
+                                  indices_dev.get(),
+                                  indices_size,
+                                  ws_dev.get(),
+                                  ws_size,
+                                  &one,
+                                  a_desc,
+                                  a_dev.get(),
+                                  &zero,
+                                  c_desc,
+                                  c_dev.get());
+                const auto result = handle.Read<float>(c_dev, c_desc.GetElementSize());
+                const auto indices =
+                    with_indices ? handle.Read<int>(indices_dev, c_desc.GetElementSize())
+                                 : std::vector<int>{};
+                return std::make_pair(result, indices);
+            };
+
+        // The maximum over h and w, with its position in the h * w plane.
+        const auto max = reduce(MIOPEN_REDUCE_TENSOR_MAX, {miopenFloat, {N, C, 1, 1}}, true);
+        auto max_ref   = std::vector<double>(N * C);
+        for(auto nc = std::size_t{0}; nc < N * C; ++nc)
+        {
+            const auto first = a.begin() + nc * H * W;
+            const auto arg   = std::max_element(first, first + H * W);
+            max_ref[nc]      = *arg;
+            EXPECT_EQUAL(max.second[nc], static_cast<int>(arg - first));
+        }
+        Compare(max.first, max_ref);
+
+        // The sum over n.
+        const auto sum = reduce(MIOPEN_REDUCE_TENSOR_ADD, {miopenFloat, {1, C, H, W}}, false);
+        auto sum_ref   = std::vector<double>(C * H * W, 0.0);
+        for(auto i = std::size_t{0}; i < a.size(); ++i)
+            sum_ref[i % (C * H * W)] += a[i];
+        Compare(sum.first, sum_ref);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::HostPrimitivesTest().Run(); }
+#else
+int main() {}
+#endif
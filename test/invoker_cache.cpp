@@ -0,0 +1,161 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+
+#include <miopen/invoker_cache.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+class InvokerCacheTest
+{
+    public:
+    void Run() const
+    {
+        TestLookups();
+        TestFound1_0();
+        TestConcurrentReads();
+    }
+
+    private:
+    static const solver::Id& SolverA()
+    {
+        static const auto id = solver::Id{"ConvAsm3x3U"};
+        return id;
+    }
+
+    static const solver::Id& SolverB()
+    {
+        static const auto id = solver::Id{"ConvAsm1x1U"};
+        return id;
+    }
+
+    /// Invoker identified by the value it has been registered with.
+    struct MockInvoker
+    {
+        int value;
+        void operator()(const Handle&, const AnyInvokeParams&) const {}
+    };
+
+    static int GetValue(const boost::optional<const Invoker&>& invoker)
+    {
+        if(!invoker)
+            return -1;
+        const auto mock = invoker->target<MockInvoker>();
+        return mock != nullptr ? mock->value : -1;
+    }
+
+    static NetworkConfig Config(int i) { return NetworkConfig{"config-" + std::to_string(i)}; }
+
+    static void TestLookups()
+    {
+        std::cout << "Testing lookups..." << std::endl;
+        auto cache = InvokerCache{};
+
+        EXPECT(!cache.GetInvoker(Config(0), SolverA()));
+
+        // Enough configs for the table to grow several times.
+        for(auto i = 0; i < 1000; ++i)
+            cache.Register(Config(i), SolverA(), MockInvoker{i});
+        cache.Register(Config(0), SolverB(), MockInvoker{-2});
+
+        for(auto i = 0; i < 1000; ++i)
+        {
+            EXPECT_EQUAL(GetValue(cache.GetInvoker(Config(i), SolverA())), i);
+        }
+
+        EXPECT_EQUAL(GetValue(cache.GetInvoker(Config(0), SolverB())), -2);
+        EXPECT(!cache.GetInvoker(Config(1), SolverB()));
+        EXPECT(!cache.GetInvoker(Config(1000), SolverA()));
+
+        // The first registered invoker is kept.
+        cache.Register(Config(1), SolverA(), MockInvoker{-3});
+        EXPECT_EQUAL(GetValue(cache.GetInvoker(Config(1), SolverA())), 1);
+    }
+
+    static void TestFound1_0()
+    {
+        std::cout << "Testing find 1.0 results..." << std::endl;
+        auto cache           = InvokerCache{};
+        const auto algorithm = AlgorithmName{"miopenConvolutionFwdAlgoDirect"};
+
+        cache.Register(Config(0), SolverA(), MockInvoker{1});
+        cache.Register(Config(0), SolverB(), MockInvoker{2});
+        EXPECT(!cache.GetFound1_0(Config(0), algorithm));
+        EXPECT(throws([&]() { cache.SetAsFound1_0(Config(1), algorithm, SolverA()); }));
+
+        cache.SetAsFound1_0(Config(0), algorithm, SolverA());
+        EXPECT_EQUAL(GetValue(cache.GetFound1_0(Config(0), algorithm)), 1);
+        EXPECT(!cache.GetFound1_0(Config(0), AlgorithmName{"miopenConvolutionFwdAlgoGEMM"}));
+
+        cache.SetAsFound1_0(Config(0), algorithm, SolverB());
+        EXPECT_EQUAL(GetValue(cache.GetFound1_0(Config(0), algorithm)), 2);
+    }
+
+    static void TestConcurrentReads()
+    {
+        std::cout << "Testing concurrent reads..." << std::endl;
+        const auto n_configs = 4000;
+        auto cache           = InvokerCache{};
+        std::atomic<int> registered{0};
+        std::atomic<int> n_failed{0};
+
+        // Readers look up configs which have been registered, while the table grows.
+        auto readers = std::vector<std::thread>{};
+        for(auto t = 0; t < 4; ++t)
+        {
+            readers.emplace_back([&]() {
+                while(registered.load() < n_configs)
+                {
+                    const auto n = registered.load();
+                    for(auto i = 0; i < n; i += 7)
+                        if(GetValue(cache.GetInvoker(Config(i), SolverA())) != i)
+                            ++n_failed;
+                }
+            });
+        }
+
+        for(auto i = 0; i < n_configs; ++i)
+        {
+            cache.Register(Config(i), SolverA(), MockInvoker{i});
+            ++registered;
+        }
+
+        for(auto& reader : readers)
+            reader.join();
+        EXPECT_EQUAL(n_failed.load(), 0);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::InvokerCacheTest().Run(); }
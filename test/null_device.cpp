@@ -0,0 +1,134 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+
+#include <miopen/config.h>
+
+#if MIOPEN_MODE_NOGPU
+#include <miopen/handle.hpp>
+#include <miopen/kernel.hpp>
+#include <miopen/null_device.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+class NullDeviceTest
+{
+    public:
+    void Run() const
+    {
+        Buffers();
+        Launches();
+        Profiling();
+    }
+
+    private:
+    static Kernel MakeKernel()
+    {
+        return {HIPOCProgram{"test.cl", "", false, "", ""}, "TestKernel", {64, 2}, {1024, 4}};
+    }
+
+    static void Buffers()
+    {
+        Handle handle{};
+        const auto data = std::vector<float>{1.0f, 2.0f, 3.0f, 4.0f};
+        auto read       = std::vector<float>(data.size());
+        auto copy       = std::vector<float>(data.size());
+
+        auto buffer       = handle.Write(data);
+        auto other_buffer = handle.Create<float>(data.size());
+        handle.ReadTo(read.data(), buffer, read.size() * sizeof(float));
+        EXPECT(read == data);
+
+        handle.Copy(buffer.get(), other_buffer.get(), data.size() * sizeof(float));
+        handle.ReadTo(copy.data(), other_buffer, copy.size() * sizeof(float));
+        EXPECT(copy == data);
+    }
+
+    static void Launches()
+    {
+        Handle handle{};
+        auto& device = NullDevice::Get();
+        auto buffer  = handle.Create(256);
+        device.ClearLaunches();
+
+        handle.Run(MakeKernel())(buffer.get(), 1.0f, static_cast<char*>(buffer.get()) + 64);
+        handle.Run(MakeKernel())(1, 2);
+
+        const auto launches = device.GetLaunches();
+        EXPECT_EQUAL(device.GetLaunchCount(), std::size_t{2});
+        EXPECT_EQUAL(launches.size(), std::size_t{2});
+        EXPECT_EQUAL(launches[0].name, "TestKernel");
+        EXPECT(launches[0].ldims == (std::array<std::size_t, 3>{64, 2, 1}));
+        EXPECT(launches[0].gdims == (std::array<std::size_t, 3>{1024, 4, 1}));
+        EXPECT(launches[0].args.size() >= sizeof(void*));
+        auto first_arg = static_cast<void*>(nullptr);
+        std::memcpy(&first_arg, launches[0].args.data(), sizeof(first_arg));
+        EXPECT(first_arg == buffer.get());
+        // Both pointers are counted, from the pointed byte to the end of the buffer.
+        EXPECT_EQUAL(launches[0].bytes, std::size_t{256 + 256 - 64});
+        EXPECT_EQUAL(launches[1].bytes, std::size_t{0});
+        EXPECT(launches[0].time > launches[1].time);
+
+        device.ClearLaunches();
+        EXPECT_EQUAL(device.GetLaunchCount(), std::size_t{0});
+        EXPECT(device.GetLaunches().empty());
+    }
+
+    static void Profiling()
+    {
+        Handle handle{};
+        auto& device = NullDevice::Get();
+        device.SetTimeModel([](const NullDeviceLaunch& launch) {
+            return static_cast<float>(launch.gdims[0]) / 256;
+        });
+
+        handle.EnableProfiling(true);
+        handle.Run(MakeKernel())(1);
+        EXPECT(std::abs(handle.GetKernelTime() - 4.0f) < 1e-6f);
+        EXPECT(std::abs(NullDevice::GetLastLaunchTime() - 4.0f) < 1e-6f);
+
+        handle.ResetKernelTime();
+        handle.EnableProfiling(false);
+        handle.Run(MakeKernel())(1);
+        EXPECT(std::abs(handle.GetKernelTime()) < 1e-6f);
+
+        device.SetTimeModel(nullptr);
+        device.ClearLaunches();
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::NullDeviceTest().Run(); }
+#else
+int main() {}
+#endif
@@ -28,20 +28,27 @@
 #include "driver.hpp"
 
 #include <miopen/db.hpp>
+#include <miopen/db_index.hpp>
 #include <miopen/db_record.hpp>
+#include <miopen/db_record_cache.hpp>
 #include <miopen/lock_file.hpp>
+#include <miopen/readonlyramdb.hpp>
 #include <miopen/temp_file.hpp>
 
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
 #include <boost/optional.hpp>
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
+#include <iterator>
 #include <mutex>
 #include <random>
+#include <sstream>
 #include <string>
 #include <thread>
 #include <vector>
@@ -179,6 +186,12 @@ class DbTest
 
     void ResetDb() const { (void)std::ofstream(temp_file); }
 
+    static std::string ReadFile(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    }
+
     static const TestData& key()
     {
         static const TestData data(1, 2);
@@ -487,6 +500,455 @@ class DbOperationsTest : public DbTest
     }
 };
 
+class DbExternalModificationTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing db for reading a file modified by other means..." << std::endl;
+
+        ResetDb();
+        RawWrite(temp_file, key(), common_data());
+
+        PlainTextDb db(temp_file);
+        ValidateSingleEntry(key(), common_data(), db);
+
+        // Values are of different length, so the file is changed in place but its size is not
+        // the same anymore. Lookup shall not be served from the index of the previous contents.
+        const std::array<std::pair<const std::string, TestData>, 2> data{{
+            {id1(), TestData(500, 600)}, {id0(), TestData(300, 400)},
+        }};
+        RawWrite(temp_file, key(), data);
+        ValidateSingleEntry(key(), data, db);
+
+        (void)std::ofstream(temp_file);
+        EXPECT(!db.FindRecord(key()));
+    }
+};
+
+class DbRecordCacheTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing db record cache..." << std::endl;
+
+        ResetDb();
+        RawWrite(temp_file, key(), common_data());
+
+        const auto is_enabled = DbRecordCache<DbFileStamp>::Instance().IsEnabled();
+        const auto hits       = DbRecordCacheStats::Hits().load();
+
+        PlainTextDb db0(temp_file);
+        PlainTextDb db1(temp_file);
+        ValidateSingleEntry(key(), common_data(), db0);
+        ValidateSingleEntry(key(), common_data(), db1);
+
+        if(is_enabled)
+            EXPECT_EQUAL(DbRecordCacheStats::Hits().load(), hits + 1);
+
+        // Changes made through the db are visible to other instances without rereading the file.
+        EXPECT(db0.Update(key(), id1(), value2()));
+        EXPECT(db0.Remove(key(), id0()));
+
+        const std::array<std::pair<const std::string, TestData>, 1> data{{{id1(), value2()}}};
+        ValidateSingleEntry(key(), data, db1);
+
+        if(is_enabled)
+            EXPECT_EQUAL(DbRecordCacheStats::Hits().load(), hits + 2);
+
+        TestData read;
+        EXPECT(!db1.Load(key(), id0(), read));
+
+        EXPECT(db0.RemoveRecord(key()));
+        EXPECT(!db1.FindRecord(key()));
+    }
+};
+
+class DbReadonlyRamDbTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing readonly RAM db..." << std::endl;
+
+        ResetDb();
+        RawWrite(temp_file, key(), common_data());
+
+        const TestData other_key(9, 10);
+        const std::array<std::pair<const std::string, TestData>, 1> other_data{{
+            {id2(), value2()},
+        }};
+        const std::array<std::pair<const std::string, TestData>, 1> duplicate_data{{
+            {id0(), value2()},
+        }};
+
+        (void)(std::ofstream(temp_file, std::ios::app) << std::endl);
+        AppendRaw(temp_file, other_key, other_data);
+        // Only the first record with a key is used.
+        AppendRaw(temp_file, key(), duplicate_data);
+
+        const std::string path = temp_file;
+        auto instances         = std::vector<const ReadonlyRamDb*>(8, nullptr);
+        auto threads           = std::vector<std::thread>{};
+
+        for(auto& instance : instances)
+            threads.emplace_back(
+                [&path, &instance]() { instance = &ReadonlyRamDb::GetCached(path, false); });
+        for(auto& thread : threads)
+            thread.join();
+
+        for(const auto instance : instances)
+            EXPECT(instance == instances.front());
+
+        const auto& db = *instances.front();
+        ValidateSingleEntry<const ReadonlyRamDb&>(key(), common_data(), db);
+        ValidateSingleEntry<const ReadonlyRamDb&>(other_key, other_data, db);
+        EXPECT(!db.FindRecord(value0()));
+    }
+
+    protected:
+    template <class TKey, class TValue, size_t count>
+    static void AppendRaw(const std::string& db_path,
+                          const TKey& key,
+                          const std::array<std::pair<const std::string, TValue>, count> values)
+    {
+        const auto temp = db_path + ".raw";
+        RawWrite(temp, key, values);
+        {
+            std::ifstream from(temp);
+            std::ofstream(db_path, std::ios::app) << from.rdbuf();
+        }
+        std::remove(temp.c_str());
+    }
+};
+
+class DbBinaryDbTest : public DbReadonlyRamDbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing binary db..." << std::endl;
+
+        ResetDb();
+        RawWrite(temp_file, key(), common_data());
+
+        const TestData other_key(9, 10);
+        const std::array<std::pair<const std::string, TestData>, 1> other_data{{
+            {id2(), value2()},
+        }};
+        const std::array<std::pair<const std::string, TestData>, 1> duplicate_data{{
+            {id0(), value2()},
+        }};
+
+        AppendRaw(temp_file, other_key, other_data);
+        AppendRaw(temp_file, key(), duplicate_data);
+
+        const std::string path = temp_file;
+        const auto binary_path = GetBinaryDbPath(path);
+        const auto text        = ReadFile(path);
+        const auto stats       = Convert(path);
+
+        EXPECT_EQUAL(stats.records, 2);
+        EXPECT(stats.duplicate_lines.size() == 1);
+        EXPECT(stats.ill_formed_lines.empty());
+
+        const auto binary = ReadFile(binary_path);
+        auto view         = BinaryDbView{};
+        auto match        = BinaryDbView::Match{};
+
+        EXPECT(!view.Open(text.data(), text.size()));
+        EXPECT(view.Open(binary.data(), binary.size()));
+        EXPECT_EQUAL(view.GetSize(), 2);
+        EXPECT_EQUAL(view.GetSourceSize(), text.size());
+        EXPECT_EQUAL(view.GetSourceTime(), boost::filesystem::last_write_time(path));
+        EXPECT(view.IsSource(text.data(), text.size()));
+        EXPECT(!view.Find(KeyOf(value0()), match));
+        EXPECT(view.Find(KeyOf(key()), match));
+        EXPECT_EQUAL(match.n_line, 1);
+
+        // The binary db is used on its own when the text one is missing.
+        std::remove(path.c_str());
+        {
+            const auto& db = ReadonlyRamDb::GetCached(path, false);
+            ValidateSingleEntry<const ReadonlyRamDb&>(key(), common_data(), db);
+            ValidateSingleEntry<const ReadonlyRamDb&>(other_key, other_data, db);
+            EXPECT(!db.FindRecord(value0()));
+        }
+        std::remove(binary_path.c_str());
+
+        // A binary db generated from another version of the text db is ignored.
+        const TempFile stale_file{"miopen.tests.perfdb"};
+        const std::string stale_path = stale_file;
+        RawWrite(stale_path, key(), common_data());
+        Convert(stale_path);
+        AppendRaw(stale_path, other_key, other_data);
+        {
+            const auto& db = ReadonlyRamDb::GetCached(stale_path, false);
+            ValidateSingleEntry<const ReadonlyRamDb&>(key(), common_data(), db);
+            ValidateSingleEntry<const ReadonlyRamDb&>(other_key, other_data, db);
+        }
+        std::remove(GetBinaryDbPath(stale_path).c_str());
+
+        // The same goes for an edit which keeps the size of the text db.
+        const TempFile edited_file{"miopen.tests.perfdb"};
+        const std::string edited_path = edited_file;
+        const std::array<std::pair<const std::string, TestData>, 1> old_data{{
+            {id0(), TestData{1, 2}},
+        }};
+        const std::array<std::pair<const std::string, TestData>, 1> new_data{{
+            {id0(), TestData{3, 4}},
+        }};
+        RawWrite(edited_path, key(), old_data);
+        Convert(edited_path);
+        const auto edited_time = boost::filesystem::last_write_time(edited_path);
+        RawWrite(edited_path, key(), new_data);
+        boost::filesystem::last_write_time(edited_path, edited_time + 1);
+        {
+            const auto& db = ReadonlyRamDb::GetCached(edited_path, false);
+            ValidateSingleEntry<const ReadonlyRamDb&>(key(), new_data, db);
+        }
+        std::remove(GetBinaryDbPath(edited_path).c_str());
+    }
+
+    private:
+    static std::string KeyOf(const TestData& data)
+    {
+        std::ostringstream ss;
+        data.Serialize(ss);
+        return ss.str();
+    }
+
+    static BinaryDbStats Convert(const std::string& path)
+    {
+        const auto text = ReadFile(path);
+        std::ofstream file(GetBinaryDbPath(path), std::ios::binary);
+        return WriteBinaryDb(
+            text.data(), text.size(), boost::filesystem::last_write_time(path), file);
+    }
+};
+
+class DbCompactTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing db for compacting after many updates..." << std::endl;
+
+        ResetDb();
+
+        {
+            PlainTextDb db(temp_file);
+
+            for(auto i = 0; i < 16; ++i)
+            {
+                EXPECT(db.Update(key(), id0(), TestData(i, i)));
+                EXPECT(db.Update(key(), id1(), TestData(i, -i)));
+            }
+
+            EXPECT(db.Update(key(), id0(), value0()));
+            EXPECT(db.Update(key(), id1(), value1()));
+            EXPECT(db.Update(key(), id2(), value2()));
+            EXPECT(db.Remove(key(), id2()));
+
+            const TestData other_key(9, 10);
+            EXPECT(db.Update(other_key, id0(), value0()));
+            EXPECT(db.RemoveRecord(other_key));
+            EXPECT(!db.FindRecord(other_key));
+
+            ValidateSingleEntry(key(), common_data(), db);
+            EXPECT(db.Compact());
+        }
+
+        std::ifstream file(temp_file);
+        std::string line;
+        auto lines = 0;
+        while(std::getline(file, line))
+            ++lines;
+        EXPECT_EQUAL(lines, 1);
+
+        ValidateSingleEntry(key(), common_data(), PlainTextDb(temp_file));
+    }
+};
+
+class DbIndexAppendTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing db index for extending after appends..." << std::endl;
+
+        const std::string initial  = "a=0:1\nb=0:2\n\nill-formed\nc=0:3\n";
+        const std::string appended = "b=0:4\nd=0:5\nc=\nd=0:6\n";
+
+        std::ofstream(temp_file) << initial;
+        const auto before = DbIndex::Get(temp_file);
+        EXPECT_EQUAL(before->GetParsedBytes(), initial.size());
+        EXPECT_EQUAL(before->GetDeadBytes(), std::string("\nill-formed\n").size());
+        EXPECT_EQUAL(before->GetSupersededBytes(), std::uint64_t{0});
+
+        // Only the appended lines are parsed, and the result is the same as of a full parse.
+        std::ofstream(temp_file, std::ios::app) << appended;
+        const auto after = DbIndex::Get(temp_file);
+        EXPECT_EQUAL(after->GetParsedBytes(), appended.size());
+
+        const DbIndex full{temp_file, DbFileStamp::Get(temp_file)};
+        EXPECT_EQUAL(full.GetParsedBytes(), initial.size() + appended.size());
+        EXPECT_EQUAL(after->GetSize(), full.GetSize());
+        EXPECT_EQUAL(after->GetDeadBytes(), full.GetDeadBytes());
+        EXPECT_EQUAL(after->GetSupersededBytes(), full.GetSupersededBytes());
+        EXPECT_EQUAL(after->GetSupersededBytes(), std::string("b=0:2\nc=0:3\nd=0:5\nc=\n").size());
+
+        const std::array<std::pair<std::string, std::string>, 4> expected{{
+            {"a", "0:1"}, {"b", "0:4"}, {"c", ""}, {"d", "0:6"},
+        }};
+
+        for(const auto& key_contents : expected)
+        {
+            auto match       = DbIndex::Match{};
+            auto full_match  = DbIndex::Match{};
+            const auto found = after->Find(key_contents.first, match);
+            EXPECT_EQUAL(found, !key_contents.second.empty());
+            EXPECT_EQUAL(full.Find(key_contents.first, full_match), found);
+            if(!found)
+                continue;
+            EXPECT_EQUAL(std::string(match.contents_begin, match.contents_end),
+                         key_contents.second);
+            EXPECT_EQUAL(match.line_begin, full_match.line_begin);
+            EXPECT_EQUAL(match.n_line, full_match.n_line);
+        }
+
+        // A rewritten file is parsed as a whole, even if it starts with the same lines.
+        const auto temp_name = temp_file.Path() + ".temp";
+        std::ofstream(temp_name) << initial << appended << "e=0:7\n";
+        std::rename(temp_name.c_str(), temp_file.Path().c_str());
+        EXPECT_EQUAL(DbIndex::Get(temp_file)->GetParsedBytes(),
+                     initial.size() + appended.size() + std::string("e=0:7\n").size());
+    }
+};
+
+class DbCompactionThresholdTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing db for bounded size after many updates..." << std::endl;
+
+        ResetDb();
+
+        // Records of about 1 KiB, so the updates write 4 times the journal compaction threshold
+        // of 64 KiB. The file is rewritten in place or compacted on the way.
+        const auto id       = std::string(1024, 'x');
+        const auto max_size = 64 * 1024 + 2 * (id.size() + 32);
+        const auto updates  = 256;
+        auto largest_size   = std::uintmax_t{0};
+        PlainTextDb db(temp_file);
+
+        for(auto i = 0; i < updates; ++i)
+        {
+            EXPECT(db.Update(key(), id, TestData(i, i)));
+            largest_size = std::max(largest_size, boost::filesystem::file_size(temp_file.Path()));
+        }
+
+        EXPECT(largest_size < max_size);
+
+        TestData read;
+        EXPECT(db.Load(key(), id, read));
+        EXPECT_EQUAL(read, TestData(updates - 1, updates - 1));
+        EXPECT(PlainTextDb(temp_file).Load(key(), id, read));
+        EXPECT_EQUAL(read, TestData(updates - 1, updates - 1));
+    }
+};
+
+class DbIllFormedLinesTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing db for keeping blank and ill-formed lines on updates..." << std::endl;
+
+        const std::string prefix = "\nill-formed\n";
+        std::ofstream(temp_file) << prefix << key().x << ',' << key().y << "=1:5,6;0:3,4\n";
+
+        // There is nothing superseded, so the record is updated without compacting the file.
+        PlainTextDb db(temp_file);
+        EXPECT(db.Update(key(), id0(), value2()));
+
+        const std::array<std::pair<const std::string, TestData>, 2> data{{
+            {id1(), value1()}, {id0(), value2()},
+        }};
+        ValidateSingleEntry(key(), data, db);
+        EXPECT_EQUAL(ReadFile(temp_file).compare(0, prefix.size(), prefix), 0);
+    }
+};
+
+class DbSimilarRecordsTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing db for finding records of similar problems..." << std::endl;
+
+        // Keys differ from the requested one in batch size, spatial size and direction.
+        const std::string problem  = "64-56-56-3x3-64-56-56-16-1x1-1x1-1x1-0-NCHW-FP32-F";
+        const std::string batch32  = "64-56-56-3x3-64-56-56-32-1x1-1x1-1x1-0-NCHW-FP32-F";
+        const std::string batch128 = "64-56-56-3x3-64-56-56-128-1x1-1x1-1x1-0-NCHW-FP32-F";
+        const std::string batch4k  = "64-56-56-3x3-64-56-56-4096-1x1-1x1-1x1-0-NCHW-FP32-F";
+        const std::string spatial  = "64-28-28-3x3-64-28-28-16-1x1-1x1-1x1-0-NCHW-FP32-F";
+        const std::string backward = "64-56-56-3x3-64-56-56-16-1x1-1x1-1x1-0-NCHW-FP32-B";
+        const std::string removed  = "64-56-56-3x3-64-56-56-17-1x1-1x1-1x1-0-NCHW-FP32-F";
+
+        ResetDb();
+        {
+            std::ofstream file(temp_file);
+            file << batch128 << "=0:5,6;1:7,8" << std::endl;
+            file << batch32 << "=0:3,4" << std::endl;
+            file << batch4k << "=0:1,1" << std::endl;
+            file << spatial << "=1:5,6" << std::endl;
+            file << backward << "=0:7,8;1:7,8" << std::endl;
+            file << removed << "=0:9,9" << std::endl;
+            file << removed << "=" << std::endl;
+            file << "1,2=0:1,2" << std::endl;
+        }
+
+        PlainTextDb db(temp_file);
+        EXPECT(!db.FindRecord(problem));
+
+        const auto keys = [](const std::vector<SimilarDbRecord>& records) {
+            auto ret = std::vector<std::string>{};
+            for(const auto& record : records)
+                ret.push_back(record.record.GetKey());
+            return ret;
+        };
+
+        auto records = db.FindSimilarRecords(problem, id0(), 8, 6);
+        EXPECT(keys(records) == std::vector<std::string>{batch32, batch128});
+        EXPECT(records[0].distance > 0.9f && records[0].distance < 1.f);
+        EXPECT(records[0].distance < records[1].distance);
+
+        TestData read;
+        EXPECT(records[0].record.GetValues(id0(), read));
+        EXPECT_EQUAL(read, value0());
+
+        EXPECT(keys(db.FindSimilarRecords(problem, id0(), 1, 6)) ==
+               std::vector<std::string>{batch32});
+        EXPECT(keys(db.FindSimilarRecords(problem, id0(), 8, 10)) ==
+               std::vector<std::string>{batch32, batch128, batch4k});
+        EXPECT(keys(db.FindSimilarRecords(problem, id1(), 8, 6)) ==
+               std::vector<std::string>{batch128, spatial});
+        EXPECT(db.FindSimilarRecords(problem, missing_id(), 8, 6).empty());
+        EXPECT(db.FindSimilarRecords(std::string{"1,2"}, id0(), 8, 6).empty());
+
+        // Changes of the file are seen.
+        const std::string batch20 = "64-56-56-3x3-64-56-56-20-1x1-1x1-1x1-0-NCHW-FP32-F";
+        std::ofstream(temp_file, std::ios::app) << batch20 << "=0:7,8" << std::endl;
+        records = db.FindSimilarRecords(problem, id0(), 1, 6);
+        EXPECT(keys(records) == std::vector<std::string>{batch20});
+        EXPECT(records[0].record.GetValues(id0(), read));
+        EXPECT_EQUAL(read, value2());
+    }
+};
+
 class DbParallelTest : public DbTest
 {
     public:
@@ -1298,6 +1760,15 @@ struct PerfDbDriver : test_driver
         DbReadTest().Run();
         DbWriteTest().Run();
         DbOperationsTest().Run();
+        DbExternalModificationTest().Run();
+        DbRecordCacheTest().Run();
+        DbReadonlyRamDbTest().Run();
+        DbBinaryDbTest().Run();
+        DbCompactTest().Run();
+        DbIndexAppendTest().Run();
+        DbCompactionThresholdTest().Run();
+        DbIllFormedLinesTest().Run();
+        DbSimilarRecordsTest().Run();
         DbParallelTest().Run();
 
         DbMultiThreadedReadTest().Run();
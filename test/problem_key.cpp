@@ -0,0 +1,135 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/db_record.hpp>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+class ProblemKeyTest
+{
+    public:
+    void Run() const
+    {
+        TextForms();
+        Keys();
+        Hashes();
+        SharedCache();
+    }
+
+    private:
+    static conv::ProblemDescription MakeProblem(std::size_t batch,
+                                                const std::vector<std::size_t>& in_strides = {})
+    {
+        const auto in      = in_strides.empty()
+                                 ? TensorDescriptor{miopenFloat, {batch, 576, 4, 4}}
+                                 : TensorDescriptor{miopenFloat, {batch, 576, 4, 4}, in_strides};
+        const auto weights = TensorDescriptor{miopenFloat, {192, 576, 1, 1}};
+        const auto out     = TensorDescriptor{miopenFloat, {batch, 192, 4, 4}};
+        return {in, weights, out, ConvolutionDescriptor{}, conv::Direction::Forward};
+    }
+
+    static void TextForms()
+    {
+        const auto problem = MakeProblem(8);
+
+        std::ostringstream ss;
+        problem.Serialize(ss);
+        EXPECT_EQUAL(ss.str(), "576-4-4-1x1-192-4-4-8-0x0-1x1-1x1-0-NCHW-FP32-F");
+        EXPECT_EQUAL(problem.GetDbKey(), ss.str());
+        EXPECT_EQUAL(DbRecord{problem}.GetKey(), ss.str());
+
+        EXPECT_EQUAL(problem.BuildConfKey().ToString(),
+                     "576x4x4x1x1x192x4x4x8xNCHWxFP32x0x0x1x1x1x1x1xF");
+        std::string conf_key;
+        problem.BuildConfKey(conf_key);
+        EXPECT_EQUAL(conf_key, problem.BuildConfKey().ToString());
+        EXPECT_EQUAL(problem.BuildConfKey().GetHash(), NetworkConfig{conf_key}.GetHash());
+    }
+
+    static void Keys()
+    {
+        const auto problem = MakeProblem(8);
+        EXPECT(problem.GetKey() == MakeProblem(8).GetKey());
+        EXPECT(problem.GetKey().Hash() == MakeProblem(8).GetKey().Hash());
+        EXPECT(problem.GetKey() != MakeProblem(16).GetKey());
+
+        // The text forms do not distinguish strides, the packed key does.
+        const auto strided = MakeProblem(8, {576 * 32, 32, 8, 1});
+        EXPECT_EQUAL(strided.GetDbKey(), problem.GetDbKey());
+        EXPECT(strided.GetKey() != problem.GetKey());
+        EXPECT(strided.GetKey().Hash() != problem.GetKey().Hash());
+
+        EXPECT(problem.GetKey().in_layout == conv::LayoutId::NCHW);
+        EXPECT_EQUAL(problem.GetKey().in_lengths[0], std::uint64_t{8});
+        EXPECT_EQUAL(problem.GetKey().in_lengths[4], std::uint64_t{0});
+    }
+
+    static void Hashes()
+    {
+        auto hashes = std::unordered_set<std::uint64_t>{};
+        auto low    = std::unordered_set<std::uint64_t>{};
+        for(auto batch = std::size_t{1}; batch <= 1024; ++batch)
+        {
+            const auto hash = MakeProblem(batch).GetKey().Hash();
+            hashes.insert(hash);
+            low.insert(hash & 0xffff);
+        }
+        EXPECT_EQUAL(hashes.size(), std::size_t{1024});
+        // Nearby problems shall spread over buckets of hash tables.
+        EXPECT_OP(low.size(), >, std::size_t{1000});
+    }
+
+    static void SharedCache()
+    {
+        const auto problem = MakeProblem(8);
+        const auto copy    = problem;
+
+        auto threads = std::vector<std::thread>{};
+        auto keys    = std::vector<const std::string*>(4);
+        for(auto i = std::size_t{0}; i < keys.size(); ++i)
+            threads.emplace_back([&, i]() { keys[i] = &copy.GetDbKey(); });
+        for(auto& thread : threads)
+            thread.join();
+
+        for(const auto key : keys)
+            EXPECT(key == &problem.GetDbKey());
+        EXPECT(&problem.GetNetworkConfig() == &copy.GetNetworkConfig());
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::ProblemKeyTest().Run(); }
@@ -40,82 +40,6 @@
 
 #include "cpu_reduce_util.hpp"
 
-static void get_all_indexes(const std::vector<std::size_t>& dimLengths,
-                            int dim,
-                            std::vector<std::vector<std::size_t>>& indexes)
-{
-    if(dim < dimLengths.size())
-    {
-        std::vector<std::vector<std::size_t>> updated_indexes;
-
-        if(dim == 0)
-        {
-            assert(indexes.size() == 0);
-            assert(dimLengths[dim] > 0);
-            for(std::size_t i = 0; i < dimLengths[dim]; i++)
-            {
-                std::vector<std::size_t> index = {i};
-
-                updated_indexes.push_back(index);
-            };
-        }
-        else
-        {
-            // go through all the current indexes
-            for(const auto& index : indexes)
-                for(std::size_t i = 0; i < dimLengths[dim]; i++)
-                {
-                    auto index_new = index;
-                    index_new.push_back(i);
-
-                    updated_indexes.push_back(index_new);
-                };
-        };
-
-        // update to the indexes (output)
-        indexes = updated_indexes;
-
-        // further to construct the indexes from the updated status
-        get_all_indexes(dimLengths, dim + 1, indexes);
-    };
-};
-
-static std::size_t get_offset_from_index(const std::vector<std::size_t>& strides,
-                                         const std::vector<std::size_t>& index)
-{
-    std::size_t offset = 0;
-
-    assert(strides.size() == index.size());
-
-    for(int i = 0; i < index.size(); i++)
-        offset += strides[i] * index[i];
-
-    return (offset);
-};
-
-static std::size_t get_flatten_offset(const std::vector<std::size_t>& lengths,
-                                      const std::vector<std::size_t>& index)
-{
-    std::size_t offset = 0;
-
-    assert(lengths.size() == index.size() && lengths.size() > 0);
-
-    int len            = lengths.size();
-    std::size_t stride = 1;
-
-    // for len==1, the loop is not executed
-    for(int i = len - 1; i > 0; i--)
-    {
-        offset += stride * index[i];
-
-        stride *= lengths[i];
-    };
-
-    offset += stride * index[0];
-
-    return (offset);
-};
-
 template <class T, bool toVerifyData>
 struct verify_reduce_with_indices
 {
@@ -253,6 +177,7 @@ struct verify_reduce_with_indices
         using reduce::convert_type;
         using reduce::binop_with_nan_check;
         using reduce::binop_with_nan_check2;
+        using reduce::reduce_index_space;
 
         auto inLengths  = input.desc.GetLengths();
         auto outLengths = output.desc.GetLengths();
@@ -263,9 +188,6 @@ struct verify_reduce_with_indices
         auto res         = output;
         auto res_indices = indices;
 
-        std::vector<std::size_t> invariantLengths;
-        std::vector<std::size_t> toReduceLengths;
-
         std::vector<int> invariantDims;
         std::vector<int> toReduceDims;
 
@@ -275,37 +197,28 @@ struct verify_reduce_with_indices
             else
                 toReduceDims.push_back(i);
 
-        invariantLengths.resize(invariantDims.size());
-        for(int i               = 0; i < invariantDims.size(); i++)
-            invariantLengths[i] = inLengths[invariantDims[i]];
-
-        toReduceLengths.resize(toReduceDims.size());
-        for(int i              = 0; i < toReduceDims.size(); i++)
-            toReduceLengths[i] = inLengths[toReduceDims[i]];
-
-        bool reduceAllDims = invariantDims.empty();
-
         auto opReduce = ReduceOpFn2<compType>(reduceOp);
 
-        if(reduceAllDims)
-        {
-            std::vector<std::vector<std::size_t>> indexes_1;
-
-            get_all_indexes(inLengths, 0, indexes_1);
+        const reduce_index_space indexSpace(
+            inLengths, inStrides, outStrides, invariantDims, toReduceDims);
 
+        // go through the output elements, each of them reduces its own part of the input
+        indexSpace.for_each_output([&](std::size_t first_offset, std::size_t dst_offset) {
             compType accuVal = ReduceOpZeroVal<compType>(reduceOp);
             int accuIndex    = 0;
 
-            // go through indexes of the invariant dimensions
-            for(const auto& src_index : indexes_1)
-            {
-                auto src_offset = get_offset_from_index(inStrides, src_index);
-
-                auto currVal = convert_type<compType>(input.data[src_offset]);
+            // go through the inputs along the toReduce dimensions
+            indexSpace.for_each_reduced(
+                first_offset, [&](std::size_t src_offset, std::size_t currIndex) {
+                    auto currVal = convert_type<compType>(input.data[src_offset]);
 
-                int currIndex = get_flatten_offset(inLengths, src_index);
-                binop_with_nan_check2(nanOpt, opReduce, accuVal, currVal, accuIndex, currIndex);
-            };
+                    binop_with_nan_check2(nanOpt,
+                                          opReduce,
+                                          accuVal,
+                                          currVal,
+                                          accuIndex,
+                                          static_cast<int>(currIndex));
+                });
 
             // scale the accumulated value
             if(!float_equal_one(alpha))
@@ -313,72 +226,12 @@ struct verify_reduce_with_indices
 
             // scale the prior dst value and add it to the accumulated value
             if(!float_equal_zero(beta))
-            {
-                accuVal += convert_type<compType>(output.data[0] * beta);
-            };
+                accuVal += convert_type<compType>(output.data[dst_offset] * beta);
 
             // store the reduced value to dst location
-            res.data[0]         = convert_type<T>(accuVal);
-            res_indices.data[0] = accuIndex;
-        }
-        else
-        {
-            std::vector<std::vector<std::size_t>> indexes_1, indexes_2;
-
-            get_all_indexes(invariantLengths, 0, indexes_1);
-            get_all_indexes(toReduceLengths, 0, indexes_2);
-
-            // go through indexes of the invariant dimensions
-            for(const auto& index_1 : indexes_1)
-            {
-                std::vector<std::size_t> src_index;
-                std::vector<std::size_t> dst_index;
-
-                src_index.resize(inLengths.size());
-                dst_index.resize(inLengths.size());
-
-                std::fill(dst_index.begin(), dst_index.end(), 0);
-
-                for(int k                       = 0; k < invariantDims.size(); k++)
-                    dst_index[invariantDims[k]] = index_1[k];
-
-                int dst_offset = get_offset_from_index(outStrides, dst_index);
-
-                // generate the part of the index belonging to the invariant dims
-                for(int k                       = 0; k < invariantDims.size(); k++)
-                    src_index[invariantDims[k]] = index_1[k];
-
-                compType accuVal = ReduceOpZeroVal<compType>(reduceOp);
-                int accuIndex    = 0;
-
-                // go through indexes of the toReduce dimensions
-                for(const auto& index_2 : indexes_2)
-                {
-                    // generate the part of the index belonging to the toReduce dims
-                    for(int k                      = 0; k < toReduceDims.size(); k++)
-                        src_index[toReduceDims[k]] = index_2[k];
-
-                    auto src_offset = get_offset_from_index(inStrides, src_index);
-
-                    auto currVal = convert_type<compType>(input.data[src_offset]);
-
-                    auto currIndex = get_flatten_offset(toReduceLengths, index_2);
-                    binop_with_nan_check2(nanOpt, opReduce, accuVal, currVal, accuIndex, currIndex);
-                };
-
-                // scale the accumulated value
-                if(!float_equal_one(alpha))
-                    accuVal *= convert_type<compType>(alpha);
-
-                // scale the prior dst value and add it to the accumulated value
-                if(!float_equal_zero(beta))
-                    accuVal += convert_type<compType>(output.data[dst_offset] * beta);
-
-                // store the reduced value to dst location
-                res.data[dst_offset]         = convert_type<T>(accuVal);
-                res_indices.data[dst_offset] = accuIndex; // store the index
-            };
-        };
+            res.data[dst_offset]         = convert_type<T>(accuVal);
+            res_indices.data[dst_offset] = accuIndex; // store the index
+        });
 
         return (std::make_tuple(res, res_indices));
     }
@@ -508,6 +361,7 @@ struct verify_reduce_no_indices
         using reduce::convert_type;
         using reduce::binop_with_nan_check;
         using reduce::binop_with_nan_check2;
+        using reduce::reduce_index_space;
 
         auto inLengths  = input.desc.GetLengths();
         auto outLengths = output.desc.GetLengths();
@@ -517,9 +371,6 @@ struct verify_reduce_no_indices
         // replicate
         auto res = output;
 
-        std::vector<std::size_t> invariantLengths;
-        std::vector<std::size_t> toReduceLengths;
-
         std::vector<int> invariantDims;
         std::vector<int> toReduceDims;
 
@@ -529,102 +380,33 @@ struct verify_reduce_no_indices
             else
                 toReduceDims.push_back(i);
 
-        invariantLengths.resize(invariantDims.size());
-        for(int i               = 0; i < invariantDims.size(); i++)
-            invariantLengths[i] = inLengths[invariantDims[i]];
-
-        toReduceLengths.resize(toReduceDims.size());
-        for(int i              = 0; i < toReduceDims.size(); i++)
-            toReduceLengths[i] = inLengths[toReduceDims[i]];
-
-        bool reduceAllDims = invariantDims.empty();
-
         auto opReduce = ReduceOpFn<compType>(reduceOp);
 
-        if(reduceAllDims)
-        {
-            std::vector<std::vector<std::size_t>> indexes_1;
-
-            get_all_indexes(inLengths, 0, indexes_1);
+        const reduce_index_space indexSpace(
+            inLengths, inStrides, outStrides, invariantDims, toReduceDims);
 
+        // go through the output elements, each of them reduces its own part of the input
+        indexSpace.for_each_output([&](std::size_t first_offset, std::size_t dst_offset) {
             compType accuVal = ReduceOpZeroVal<compType>(reduceOp);
 
-            // go through indexes of the invariant dimensions
-            for(const auto& src_index : indexes_1)
-            {
-                auto src_offset = get_offset_from_index(inStrides, src_index);
-
+            // go through the inputs along the toReduce dimensions
+            indexSpace.for_each_reduced(first_offset, [&](std::size_t src_offset, std::size_t) {
                 auto currVal = convert_type<compType>(input.data[src_offset]);
 
                 binop_with_nan_check(nanOpt, opReduce, accuVal, currVal);
-            };
+            });
 
             // scale the accumulated value
             if(!float_equal_one(alpha))
                 accuVal *= convert_type<compType>(alpha);
 
             // scale the prior dst value and add it to the accumulated value
-            if(!float_equal_one(beta))
-                accuVal += convert_type<compType>(output.data[0] * beta);
+            if(!float_equal_zero(beta))
+                accuVal += convert_type<compType>(output.data[dst_offset] * beta);
 
             // store the reduced value to dst location
-            res.data[0] = convert_type<T>(accuVal);
-        }
-        else
-        {
-            std::vector<std::vector<std::size_t>> indexes_1, indexes_2;
-
-            get_all_indexes(invariantLengths, 0, indexes_1);
-            get_all_indexes(toReduceLengths, 0, indexes_2);
-
-            // go through indexes of the invariant dimensions
-            for(const auto& index_1 : indexes_1)
-            {
-                std::vector<std::size_t> src_index;
-                std::vector<std::size_t> dst_index;
-
-                src_index.resize(inLengths.size());
-                dst_index.resize(inLengths.size());
-
-                std::fill(dst_index.begin(), dst_index.end(), 0);
-
-                for(int k                       = 0; k < invariantDims.size(); k++)
-                    dst_index[invariantDims[k]] = index_1[k];
-
-                int dst_offset = get_offset_from_index(outStrides, dst_index);
-
-                // generate the part of the index belonging to the invariant dims
-                for(int k                       = 0; k < invariantDims.size(); k++)
-                    src_index[invariantDims[k]] = index_1[k];
-
-                compType accuVal = ReduceOpZeroVal<compType>(reduceOp);
-
-                // go through indexes of the toReduce dimensions
-                for(const auto& index_2 : indexes_2)
-                {
-                    // generate the part of the index belonging to the toReduce dims
-                    for(int k                      = 0; k < toReduceDims.size(); k++)
-                        src_index[toReduceDims[k]] = index_2[k];
-
-                    auto src_offset = get_offset_from_index(inStrides, src_index);
-
-                    auto currVal = convert_type<compType>(input.data[src_offset]);
-
-                    binop_with_nan_check(nanOpt, opReduce, accuVal, currVal);
-                };
-
-                // scale the accumulated value
-                if(!float_equal_one(alpha))
-                    accuVal *= convert_type<compType>(alpha);
-
-                // scale the prior dst value and add it to the accumulated value
-                if(!float_equal_zero(beta))
-                    accuVal += convert_type<compType>(output.data[dst_offset] * beta);
-
-                // store the reduced value to dst location
-                res.data[dst_offset] = convert_type<T>(accuVal);
-            };
-        };
+            res.data[dst_offset] = convert_type<T>(accuVal);
+        });
 
         return (res);
     }
@@ -34,8 +34,10 @@
 
 #include <cstdlib>
 #include <functional>
+#include <limits>
 #include <sstream>
 #include <typeinfo>
+#include <vector>
 
 #include "get_handle.hpp"
 #include "test.hpp"
@@ -128,6 +130,16 @@ static solver::ConvSolution FindSolution(const ConvolutionContext& ctx, const st
     return solvers.SearchForAllSolutions(ctx, db, {}, 1).front();
 }
 
+static std::vector<solver::ConvSolution>
+FindSolutionsParallel(const ConvolutionContext& ctx, const std::string& db_path, std::size_t limit)
+{
+    PlainTextDb db(db_path);
+
+    const auto solvers = solver::SolverContainer<TrivialTestSolver, SearchableTestSolver>{};
+
+    return solvers.SearchForAllSolutionsParallel(ctx, db, {}, limit);
+}
+
 class SolverTest
 {
     public:
@@ -187,6 +199,17 @@ class SolverTest
 
         EXPECT_OP(sol.construction_params.size(), >, 0);
         EXPECT_EQUAL(sol.construction_params[0].kernel_file, expected_kernel);
+
+        // Parallel evaluation of solvers shall give the same solutions in the same order.
+        const auto first = FindSolutionsParallel(ctx, db_path, 1);
+        EXPECT_EQUAL(first.size(), std::size_t{1});
+        EXPECT_EQUAL(first[0].construction_params[0].kernel_file, expected_kernel);
+
+        const auto all =
+            FindSolutionsParallel(ctx, db_path, std::numeric_limits<std::size_t>::max());
+        EXPECT_OP(all.size(), >=, std::size_t{1});
+        EXPECT_EQUAL(all[0].construction_params[0].kernel_file, expected_kernel);
+        EXPECT_EQUAL(all.size(), ctx.in_width == 1 ? std::size_t{2} : std::size_t{1});
     }
 };
 } // namespace tests
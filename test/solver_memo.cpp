@@ -0,0 +1,140 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+
+#include <miopen/solver_memo.hpp>
+
+#include <string>
+
+namespace miopen {
+namespace tests {
+
+class SolverMemoTest
+{
+    public:
+    void Run() const
+    {
+        auto& memo = solver::SolverMemo::Instance();
+        if(!memo.IsEnabled())
+            return;
+
+        Memoization(memo);
+        Invalidation(memo);
+        Eviction(memo);
+    }
+
+    private:
+    static void Memoization(solver::SolverMemo& memo)
+    {
+        auto calls            = 0;
+        const auto applicable = [&]() {
+            ++calls;
+            return true;
+        };
+        const auto workspace = [&]() {
+            ++calls;
+            return std::size_t{42};
+        };
+
+        EXPECT(memo.IsApplicable("problem", "solver", applicable));
+        EXPECT(memo.IsApplicable("problem", "solver", applicable));
+        EXPECT_EQUAL(calls, 1);
+
+        EXPECT_EQUAL(memo.GetWorkspaceSize("problem", "solver", workspace), std::size_t{42});
+        EXPECT_EQUAL(memo.GetWorkspaceSize("problem", "solver", workspace), std::size_t{42});
+        EXPECT_EQUAL(calls, 2);
+
+        // Other solvers and problems have own entries, empty keys are not memoized.
+        EXPECT(memo.IsApplicable("problem", "other_solver", applicable));
+        EXPECT(memo.IsApplicable("other_problem", "solver", applicable));
+        EXPECT(memo.IsApplicable("", "solver", applicable));
+        EXPECT(memo.IsApplicable("", "solver", applicable));
+        EXPECT_EQUAL(calls, 6);
+
+        auto solution_calls = 0;
+        const auto solution = [&]() {
+            ++solution_calls;
+            auto ret      = solver::ConvSolution{};
+            ret.solver_id = "solver";
+            return ret;
+        };
+
+        EXPECT_EQUAL(memo.GetSolution("problem", "solver", solution).solver_id, "solver");
+        EXPECT_EQUAL(memo.GetSolution("problem", "solver", solution).solver_id, "solver");
+        EXPECT_EQUAL(solution_calls, 1);
+    }
+
+    static void Invalidation(solver::SolverMemo& memo)
+    {
+        auto calls            = 0;
+        const auto applicable = [&]() {
+            ++calls;
+            return false;
+        };
+
+        EXPECT(!memo.IsApplicable("invalidated", "solver", applicable));
+        memo.Invalidate();
+        EXPECT(!memo.IsApplicable("invalidated", "solver", applicable));
+        EXPECT_EQUAL(calls, 2);
+
+        // Results computed while the memo is being invalidated are not stored.
+        const auto invalidating = [&]() {
+            ++calls;
+            memo.Invalidate();
+            return false;
+        };
+        EXPECT(!memo.IsApplicable("invalidating", "solver", invalidating));
+        EXPECT(!memo.IsApplicable("invalidating", "solver", applicable));
+        EXPECT_EQUAL(calls, 4);
+    }
+
+    static void Eviction(solver::SolverMemo& memo)
+    {
+        auto calls            = 0;
+        const auto applicable = [&]() {
+            ++calls;
+            return true;
+        };
+
+        const auto capacity = Value(MIOPEN_DEBUG_SOLVER_MEMO_SIZE{}, 4096);
+        memo.Invalidate();
+
+        EXPECT(memo.IsApplicable("evicted", "solver", applicable));
+        for(auto i = std::size_t{0}; i < capacity; ++i)
+            EXPECT(memo.IsApplicable(std::to_string(i), "solver", applicable));
+        EXPECT(memo.IsApplicable("evicted", "solver", applicable));
+        EXPECT_EQUAL(calls, static_cast<int>(capacity + 2));
+
+        // The most recently used entries are kept.
+        EXPECT(memo.IsApplicable(std::to_string(capacity - 1), "solver", applicable));
+        EXPECT_EQUAL(calls, static_cast<int>(capacity + 2));
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::SolverMemoTest().Run(); }
@@ -0,0 +1,229 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+
+#include <miopen/solver_ranking.hpp>
+
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+class SolverRankingTest
+{
+    public:
+    void Run() const
+    {
+        Parsing();
+        Ranking();
+        Serialization();
+        Evaluation();
+    }
+
+    private:
+    static std::string Record(const std::string& key,
+                              float winograd,
+                              float direct,
+                              float gemm,
+                              const std::string& direction = "Fwd")
+    {
+        const auto algo = "miopenConvolution" + direction + "Algo";
+        std::ostringstream ss;
+        ss << key << '=';
+        if(winograd > 0)
+            ss << algo << "Winograd:ConvBinWinogradRxSf3x2," << winograd << ",0," << algo
+               << "Winograd,<unused>;";
+        if(direct > 0)
+            ss << algo << "Direct:ConvAsm1x1U," << direct << ",0," << algo << "Direct,<unused>;";
+        ss << algo << "GEMM:gemm," << gemm << ",1024,MIOpenGEMM,1_0_12544";
+        return ss.str();
+    }
+
+    static std::string Key(int c, int hw, int filter, int k, int n, const std::string& tail)
+    {
+        const auto pad = filter / 2;
+        std::ostringstream ss;
+        ss << c << '-' << hw << '-' << hw << '-' << filter << 'x' << filter << '-' << k << '-'
+           << hw << '-' << hw << '-' << n << '-' << pad << 'x' << pad << "-1x1-1x1-0-" << tail;
+        return ss.str();
+    }
+
+    static bool Near(double value, double expected)
+    {
+        return std::abs(value - expected) <= 1e-3 * std::abs(expected);
+    }
+
+    static void Parsing()
+    {
+        auto problem = SolverRankingProblem{};
+
+        EXPECT(ParseSolverRankingProblem("64-56-56-3x3-128-28-28-32-1x1-2x2-1x1-0-NCHW-FP32-F",
+                                         problem));
+        EXPECT_EQUAL(problem.category, "NCHW-FP32-F-2d");
+        EXPECT(Near(problem.flops, 2.0 * 32 * 64 * 128 * 3 * 3 * 28 * 28));
+        EXPECT(Near(problem.features[0], std::log2(65.0)));
+
+        // Output of the forward convolution is the input of the backward ones.
+        EXPECT(ParseSolverRankingProblem(
+            "64-8-56-56-3x3x3-64-8-56-56-32-1x1x1-1x1x1-1x1x1-0-NCDHW-FP32-B_g2", problem));
+        EXPECT_EQUAL(problem.category, "NCDHW-FP32-B-3d-g");
+        EXPECT(Near(problem.flops, 2.0 * 32 * 64 * 64 / 2 * 27 * 8 * 56 * 56));
+
+        EXPECT(ParseSolverRankingProblem(
+            "64-56-56-1x1-64-56-56-32-0x0-1x1-1x1-0-NHWC-NCHW-NHWC-FP16-W", problem));
+        EXPECT_EQUAL(problem.category, "NHWC-NCHW-NHWC-FP16-W-2d");
+
+        EXPECT(!ParseSolverRankingProblem("", problem));
+        EXPECT(!ParseSolverRankingProblem("64-56-56-3x3-64", problem));
+        EXPECT(!ParseSolverRankingProblem("64-56-56-3x3-64-56-56-32-1x1-1x1-1x1-0-NCHW-FP32-X",
+                                          problem));
+        EXPECT(!ParseSolverRankingProblem("64-56-56-3x3-64-56-a-32-1x1-1x1-1x1-0-NCHW-FP32-F",
+                                          problem));
+
+        const auto text = Record(Key(64, 56, 3, 64, 32, "NCHW-FP32-F"), 1, 0, 3) +
+                          "\n\ngarbage\nkey=bad\n" +
+                          Record(Key(64, 56, 1, 64, 32, "NCHW-FP32-F"), 0, 0.5f, 0.8f) + "\r\n";
+        auto ill_formed    = std::size_t{0};
+        const auto samples = ParseSolverRankingSamples(text, ill_formed);
+
+        EXPECT_EQUAL(samples.size(), std::size_t{2});
+        EXPECT_EQUAL(ill_formed, std::size_t{2});
+        EXPECT_EQUAL(samples[0].times.size(), std::size_t{2});
+        EXPECT_EQUAL(samples[0].times[0].first, "ConvBinWinogradRxSf3x2");
+        EXPECT(Near(samples[0].times[0].second, 1));
+        EXPECT_EQUAL(samples[1].times[1].first, "gemm");
+        EXPECT(Near(samples[1].times[1].second, 0.8));
+    }
+
+    static SolverRankingModel TrainSmall()
+    {
+        const auto text = Record(Key(64, 56, 3, 64, 32, "NCHW-FP32-F"), 1, 0, 3) + "\n" +
+                          Record(Key(64, 56, 1, 64, 32, "NCHW-FP32-F"), 0, 0.5f, 0.8f) + "\n";
+        auto ill_formed = std::size_t{0};
+        return SolverRankingModel::Train(ParseSolverRankingSamples(text, ill_formed));
+    }
+
+    static void Ranking()
+    {
+        const auto model = TrainSmall();
+        EXPECT_EQUAL(model.GetSampleCount(), std::size_t{2});
+
+        // The very same problem gets the measured times.
+        const auto exact = model.Rank(Key(64, 56, 3, 64, 32, "NCHW-FP32-F"));
+        EXPECT_EQUAL(exact.size(), std::size_t{2});
+        EXPECT_EQUAL(exact[0].solver, "ConvBinWinogradRxSf3x2");
+        EXPECT(Near(exact[0].time, 1));
+        EXPECT_EQUAL(exact[1].solver, "gemm");
+        EXPECT(Near(exact[1].time, 3));
+
+        // Times are scaled by the flops. Winograd has been measured on one of the neighbours.
+        const auto scaled = model.Rank(Key(64, 56, 3, 64, 64, "NCHW-FP32-F"));
+        EXPECT_EQUAL(scaled.size(), std::size_t{3});
+        EXPECT_EQUAL(scaled[0].solver, "ConvBinWinogradRxSf3x2");
+        EXPECT(Near(scaled[0].time, 2));
+        for(auto i = std::size_t{1}; i < scaled.size(); ++i)
+            EXPECT_OP(scaled[i - 1].time, <=, scaled[i].time);
+
+        // Problems of other categories are never compared.
+        EXPECT(model.Rank(Key(64, 56, 3, 64, 32, "NCHW-FP16-F")).empty());
+        EXPECT(model.Rank(Key(64, 56, 3, 64, 32, "NCHW-FP32-B")).empty());
+        EXPECT(model.Rank("garbage").empty());
+        EXPECT(SolverRankingModel{}.Rank(Key(64, 56, 3, 64, 32, "NCHW-FP32-F")).empty());
+    }
+
+    static void Serialization()
+    {
+        const auto model = TrainSmall();
+        std::ostringstream stream;
+        model.Save(stream);
+        const auto data = stream.str();
+
+        auto loaded = SolverRankingModel{};
+        EXPECT(loaded.Load(data.data(), data.size()));
+        EXPECT_EQUAL(loaded.GetSampleCount(), model.GetSampleCount());
+
+        const auto key      = Key(48, 40, 3, 96, 16, "NCHW-FP32-F");
+        const auto expected = model.Rank(key);
+        const auto actual   = loaded.Rank(key);
+        EXPECT_EQUAL(actual.size(), expected.size());
+        for(auto i = std::size_t{0}; i < actual.size() && i < expected.size(); ++i)
+        {
+            EXPECT_EQUAL(actual[i].solver, expected[i].solver);
+            EXPECT(Near(actual[i].time, expected[i].time));
+        }
+
+        EXPECT(!loaded.Load(data.data(), data.size() - 1));
+        EXPECT(loaded.IsEmpty());
+
+        auto corrupted = data;
+        corrupted[0]   = 'X';
+        EXPECT(!loaded.Load(corrupted.data(), corrupted.size()));
+        EXPECT(!loaded.Load(nullptr, 0));
+
+        EXPECT_EQUAL(GetSolverRankingPath("/db/gfx906_60.HIP.fdb.txt"),
+                     "/db/gfx906_60.HIP.rank.bin");
+        EXPECT_EQUAL(GetSolverRankingPath("/db/model"), "/db/model.rank.bin");
+    }
+
+    static void Evaluation()
+    {
+        // Winograd wins on 3x3 filters and 1x1 solver on 1x1 ones, all scale with flops.
+        auto samples = std::vector<SolverRankingSample>{};
+        for(auto c = 16; c <= 512; c *= 2)
+        {
+            for(auto hw = 7; hw <= 112; hw *= 2)
+            {
+                for(auto n : {1, 16, 64})
+                {
+                    const auto work = 1e-9f * static_cast<float>(c) * c * hw * hw * n;
+                    samples.push_back(
+                        {Key(c, hw, 3, c, n, "NCHW-FP32-F"),
+                         {{"ConvBinWinogradRxSf3x2", 4 * work}, {"gemm", 27 * work}}});
+                    samples.push_back({Key(c, hw, 1, c, n, "NCHW-FP32-F"),
+                                       {{"ConvAsm1x1U", work}, {"gemm", 2 * work}}});
+                }
+            }
+        }
+
+        const auto accuracy = EvaluateSolverRanking(samples, 30, 3);
+        EXPECT_OP(accuracy.test_samples, >, std::size_t{0});
+        EXPECT_EQUAL(accuracy.train_samples + accuracy.test_samples, samples.size());
+        EXPECT_EQUAL(accuracy.unranked, std::size_t{0});
+        EXPECT_EQUAL(accuracy.top1, accuracy.test_samples);
+        EXPECT_EQUAL(accuracy.top3, accuracy.test_samples);
+        EXPECT(Near(accuracy.slowdown, 1));
+        EXPECT_EQUAL(accuracy.gemm_samples, accuracy.test_samples);
+        EXPECT_OP(accuracy.gemm_slowdown, >, 2.0);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::SolverRankingTest().Run(); }
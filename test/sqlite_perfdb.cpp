@@ -30,7 +30,9 @@
 #include <miopen/problem_description.hpp>
 #include <miopen/sqlite_db.hpp>
 #include <miopen/db.hpp>
+#include <miopen/db_index.hpp>
 #include <miopen/db_record.hpp>
+#include <miopen/db_record_cache.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/temp_file.hpp>
 
@@ -384,6 +386,93 @@ class DbFindTest : public DbTest
     }
 };
 
+class DbFindRecordsTest : public DbTest
+{
+    public:
+    void Run()
+    {
+        std::cout << "Testing batched lookup..." << std::endl;
+        ResetDb();
+
+        const ProblemData p0(1);
+        const ProblemData p1(2);
+        const ProblemData missing(3);
+
+        EXPECT(db_inst.UpdateUnsafe(p0, id0(), value0()));
+        EXPECT(db_inst.UpdateUnsafe(p1, id0(), value1()));
+        EXPECT(db_inst.UpdateUnsafe(p1, id1(), value2()));
+
+        const auto records = db_inst.FindRecords(std::vector<ProblemData>{p1, missing, p0});
+        EXPECT(records.size() == 3);
+        EXPECT(records[0]);
+        EXPECT(!records[1]);
+        EXPECT(records[2]);
+
+        SolverData read;
+        EXPECT(records[0]->GetValues(id0(), read));
+        EXPECT_EQUAL(read, value1());
+        EXPECT(records[0]->GetValues(id1(), read));
+        EXPECT_EQUAL(read, value2());
+        EXPECT(records[2]->GetValues(id0(), read));
+        EXPECT_EQUAL(read, value0());
+        EXPECT(!records[2]->GetValues(id1(), read));
+
+        // The transaction shall be over, so the db is writable again.
+        EXPECT(db_inst.UpdateUnsafe(missing, id0(), value0()));
+        EXPECT(db_inst.FindRecord(missing));
+    }
+};
+
+class DbFindSimilarRecordsTest : public DbTest
+{
+    public:
+    void Run()
+    {
+        std::cout << "Testing lookup of similar problems..." << std::endl;
+        ResetDb();
+
+        const auto with_batch = [](int batch) {
+            auto problem          = ProblemData(1);
+            problem.prob.batch_sz = batch;
+            return problem;
+        };
+
+        const auto problem = with_batch(16);
+        auto other_bias    = with_batch(16);
+        auto grouped       = with_batch(16);
+
+        other_bias.prob.bias      = 0;
+        grouped.prob.group_counts = 2;
+
+        EXPECT(db_inst.UpdateUnsafe(with_batch(128), id0(), value1()));
+        EXPECT(db_inst.UpdateUnsafe(with_batch(128), id1(), value2()));
+        EXPECT(db_inst.UpdateUnsafe(with_batch(32), id0(), value0()));
+        EXPECT(db_inst.UpdateUnsafe(with_batch(4096), id0(), value2()));
+        EXPECT(db_inst.UpdateUnsafe(other_bias, id0(), value2()));
+        EXPECT(db_inst.UpdateUnsafe(grouped, id0(), value2()));
+
+        auto records = db_inst.FindSimilarRecords(problem, id0(), 8, 6);
+        EXPECT(records.size() == 2);
+        EXPECT(records[0].distance > 0.9f && records[0].distance < 1.f);
+        EXPECT(records[0].distance < records[1].distance);
+
+        SolverData read;
+        EXPECT(records[0].record.GetValues(id0(), read));
+        EXPECT_EQUAL(read, value0());
+        EXPECT(records[1].record.GetValues(id0(), read));
+        EXPECT_EQUAL(read, value1());
+
+        EXPECT(db_inst.FindSimilarRecords(problem, id0(), 1, 6).size() == 1);
+        EXPECT(db_inst.FindSimilarRecords(problem, id0(), 8, 10).size() == 3);
+        EXPECT(db_inst.FindSimilarRecords(problem, missing_id(), 8, 6).empty());
+
+        records = db_inst.FindSimilarRecords(problem, id1(), 8, 6);
+        EXPECT(records.size() == 1);
+        EXPECT(records[0].record.GetValues(id1(), read));
+        EXPECT_EQUAL(read, value2());
+    }
+};
+
 class DbOperationsTest : public DbTest
 {
     public:
@@ -458,6 +547,50 @@ class DbOperationsTest : public DbTest
     }
 };
 
+class DbRecordCacheTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing db record cache shared by the dbs of one file..." << std::endl;
+
+        ProblemData p;
+        {
+            SQLitePerfDb db(std::string(temp_file), false, "gfx906", 64);
+            EXPECT(db.Update(p, id0(), value0()));
+        }
+
+        // All the record caches have the same capacity.
+        const auto is_enabled = DbRecordCache<DbFileStamp>::Instance().IsEnabled();
+        const auto hits       = DbRecordCacheStats::Hits().load();
+
+        // The dbs are constructed for each query, as miopen::GetDb() does.
+        {
+            SQLitePerfDb db(std::string(temp_file), false, "gfx906", 64);
+            EXPECT(db.FindRecord(p));
+        }
+        {
+            SQLitePerfDb db(std::string(temp_file), false, "gfx906", 64);
+            EXPECT(db.FindRecord(p));
+        }
+
+        if(is_enabled)
+            EXPECT_EQUAL(DbRecordCacheStats::Hits().load(), hits + 1);
+
+        // Changes made through one db are visible to the others.
+        {
+            SQLitePerfDb db0(std::string(temp_file), false, "gfx906", 64);
+            SQLitePerfDb db1(std::string(temp_file), false, "gfx906", 64);
+            EXPECT(db0.FindRecord(p));
+            EXPECT(db1.Update(p, id1(), value1()));
+
+            SolverData read;
+            EXPECT(db0.Load(p, id1(), read));
+            EXPECT_EQUAL(read, value1());
+        }
+    }
+};
+
 class DbParallelTest : public DbTest
 {
     public:
@@ -1246,7 +1379,10 @@ struct PerfDbDriver : test_driver
             return;
         }
         DbFindTest().Run();
+        DbFindRecordsTest().Run();
+        DbFindSimilarRecordsTest().Run();
         DbOperationsTest().Run();
+        DbRecordCacheTest().Run();
         DbParallelTest().Run();
         DbMultiThreadedTest().Run();
         DbMultiThreadedReadTest().Run();
@@ -0,0 +1,155 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+
+#include <miopen/miopen.h>
+#include <miopen/statistics.hpp>
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+class StatisticsTest
+{
+    public:
+    void Run() const
+    {
+        Counters();
+        Histograms();
+        Snapshot();
+        Api();
+    }
+
+    private:
+    static void Counters()
+    {
+        const auto n_threads = std::size_t{4};
+        const auto n_adds    = std::size_t{10000};
+
+        auto& counter = Statistics::Counter("test.counter");
+        EXPECT(&counter == &Statistics::Counter("test.counter"));
+        EXPECT(&counter != &Statistics::Counter("test.other_counter"));
+        counter = 0;
+
+        auto threads = std::vector<std::thread>{};
+        for(auto i = std::size_t{0}; i < n_threads; ++i)
+        {
+            threads.emplace_back([&]() {
+                for(auto j = std::size_t{0}; j < n_adds; ++j)
+                    ++Statistics::Counter("test.counter");
+            });
+        }
+        for(auto& thread : threads)
+            thread.join();
+
+        EXPECT_EQUAL(counter.load(), n_threads * n_adds);
+    }
+
+    static void Histograms()
+    {
+        using std::chrono::microseconds;
+        using std::chrono::nanoseconds;
+
+        auto& histogram = Statistics::Histogram("test.histogram");
+        histogram.Reset();
+        histogram.Add(nanoseconds{500});
+        histogram.Add(microseconds{1});
+        histogram.Add(microseconds{3});
+        histogram.Add(microseconds{1000});
+
+        std::ostringstream ss;
+        histogram.Write(ss);
+        EXPECT(ss.str().find("\"count\":4,\"total_ns\":1004500,\"min_ns\":500,"
+                             "\"max_ns\":1000000,") != std::string::npos);
+        // 500ns falls into [0, 1), 1us into [1, 2), 3us into [2, 4), 1ms into [512, 1024).
+        EXPECT(ss.str().find("\"buckets\":[1,1,1,0,0,0,0,0,0,0,1,0,") != std::string::npos);
+
+        {
+            const StatTimer timer{histogram};
+        }
+        std::ostringstream().swap(ss);
+        histogram.Write(ss);
+        EXPECT(ss.str().find("\"count\":5,") != std::string::npos);
+
+        histogram.Reset();
+        std::ostringstream().swap(ss);
+        histogram.Write(ss);
+        EXPECT(ss.str().find("\"count\":0,\"total_ns\":0,\"min_ns\":0,\"max_ns\":0,") !=
+               std::string::npos);
+    }
+
+    static void Snapshot()
+    {
+        Statistics::Counter("test.snapshot") = 42;
+        Statistics::Histogram("test.snapshot").Add(std::chrono::microseconds{1});
+
+        auto snapshot = Statistics::Snapshot();
+        EXPECT(snapshot.front() == '{' && snapshot.back() == '}');
+        EXPECT(snapshot.find("\"test.snapshot\":42") != std::string::npos);
+        EXPECT(snapshot.find("\"test.snapshot\":{\"count\":1,") != std::string::npos);
+
+        Statistics::Reset();
+        snapshot = Statistics::Snapshot();
+        EXPECT(snapshot.find("\"test.snapshot\":0") != std::string::npos);
+        EXPECT(snapshot.find("\"test.snapshot\":{\"count\":0,") != std::string::npos);
+    }
+
+    static void Api()
+    {
+        miopenHandle_t handle{};
+        EXPECT(miopenCreate(&handle) == miopenStatusSuccess);
+        Statistics::Counter("test.api") = 7;
+
+        auto size = std::size_t{0};
+        EXPECT(miopenGetStatistics(handle, nullptr, &size) == miopenStatusSuccess);
+        EXPECT(size > 1);
+
+        auto small      = std::vector<char>(size - 1);
+        auto small_size = small.size();
+        EXPECT(miopenGetStatistics(handle, small.data(), &small_size) == miopenStatusBadParm);
+        EXPECT_EQUAL(small_size, size);
+
+        auto buffer = std::vector<char>(size + 256);
+        size        = buffer.size();
+        EXPECT(miopenGetStatistics(handle, buffer.data(), &size) == miopenStatusSuccess);
+        EXPECT(std::string{buffer.data()}.find("\"test.api\":7") != std::string::npos);
+
+        EXPECT(miopenResetStatistics(handle) == miopenStatusSuccess);
+        EXPECT_EQUAL(Statistics::Counter("test.api").load(), std::uint64_t{0});
+        EXPECT(miopenGetStatistics(nullptr, nullptr, &size) != miopenStatusSuccess);
+        miopenDestroy(handle);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::StatisticsTest().Run(); }
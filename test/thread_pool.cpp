@@ -0,0 +1,181 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+
+#include <miopen/par_for.hpp>
+#include <miopen/thread_pool.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+class ThreadPoolTest
+{
+    public:
+    void Run() const
+    {
+        Coverage();
+        Parallelism();
+        Nested();
+        Exceptions();
+        ConcurrentCallers();
+        ParFor();
+    }
+
+    private:
+    static void Coverage()
+    {
+        ThreadPool pool{3};
+        EXPECT_EQUAL(pool.GetWorkerCount(), std::size_t{3});
+
+        for(const auto n : {0, 1, 7, 1000, 100003})
+        {
+            for(const auto grain : {1, 16})
+            {
+                auto hits = std::vector<std::atomic<int>>(n);
+                std::atomic<int> short_ranges{0};
+                pool.ParallelFor(n, 4, grain, [&](std::size_t begin, std::size_t end) {
+                    EXPECT(begin < end && end <= static_cast<std::size_t>(n));
+                    if(end - begin < static_cast<std::size_t>(grain))
+                        ++short_ranges;
+                    for(auto i = begin; i < end; ++i)
+                        ++hits[i];
+                });
+                for(const auto& hit : hits)
+                    EXPECT_EQUAL(hit.load(), 1);
+                // Only the last range may be shorter than the grain.
+                EXPECT(short_ranges.load() <= 1);
+            }
+        }
+    }
+
+    static void Parallelism()
+    {
+        ThreadPool pool{3};
+        std::mutex mutex;
+        auto threads = std::set<std::thread::id>{};
+
+        const auto run = [&](std::size_t max_parallelism) {
+            threads.clear();
+            pool.ParallelFor(64, max_parallelism, 1, [&](std::size_t, std::size_t) {
+                std::this_thread::sleep_for(std::chrono::milliseconds{1});
+                const std::lock_guard<std::mutex> lock(mutex);
+                threads.insert(std::this_thread::get_id());
+            });
+            return threads.size();
+        };
+
+        EXPECT_EQUAL(run(1), std::size_t{1});
+        EXPECT(*threads.begin() == std::this_thread::get_id());
+        EXPECT(run(2) <= 2);
+        EXPECT(run(100) <= 4);
+    }
+
+    static void Nested()
+    {
+        ThreadPool pool{2};
+        const auto n = std::size_t{50};
+        auto sums    = std::vector<std::atomic<std::size_t>>(n);
+
+        pool.ParallelFor(n, 3, 1, [&](std::size_t begin, std::size_t end) {
+            for(auto i = begin; i < end; ++i)
+            {
+                pool.ParallelFor(i, 3, 1, [&](std::size_t inner_begin, std::size_t inner_end) {
+                    for(auto j = inner_begin; j < inner_end; ++j)
+                        sums[i] += j;
+                });
+            }
+        });
+
+        for(auto i = std::size_t{0}; i < n; ++i)
+            EXPECT_EQUAL(sums[i].load(), i * (i - (i > 0 ? 1 : 0)) / 2);
+    }
+
+    static void Exceptions()
+    {
+        ThreadPool pool{2};
+        std::atomic<int> n_calls{0};
+
+        EXPECT(throws([&]() {
+            pool.ParallelFor(1000, 3, 1, [&](std::size_t begin, std::size_t) {
+                ++n_calls;
+                if(begin == 0)
+                    throw std::runtime_error("test");
+                std::this_thread::sleep_for(std::chrono::microseconds{100});
+            });
+        }));
+
+        // The pool is usable after a failure.
+        std::atomic<std::size_t> n{0};
+        pool.ParallelFor(100, 3, 1, [&](std::size_t begin, std::size_t end) { n += end - begin; });
+        EXPECT_EQUAL(n.load(), std::size_t{100});
+    }
+
+    static void ConcurrentCallers()
+    {
+        ThreadPool pool{2};
+        std::atomic<std::size_t> n{0};
+        auto callers = std::vector<std::thread>{};
+
+        for(auto i = 0; i < 4; ++i)
+        {
+            callers.emplace_back([&]() {
+                for(auto j = 0; j < 20; ++j)
+                    pool.ParallelFor(
+                        100, 3, 4, [&](std::size_t begin, std::size_t end) { n += end - begin; });
+            });
+        }
+        for(auto& caller : callers)
+            caller.join();
+
+        EXPECT_EQUAL(n.load(), std::size_t{4 * 20 * 100});
+    }
+
+    static void ParFor()
+    {
+        const auto n = std::size_t{10000};
+        auto hits    = std::vector<std::atomic<int>>(n);
+
+        par_for(n, [&](auto i) { ++hits[i]; });
+        par_for(n, max_threads{4}, [&](auto i) { ++hits[i]; });
+        par_for(n, min_grain{100}, [&](auto i) { ++hits[i]; });
+
+        for(const auto& hit : hits)
+            EXPECT_EQUAL(hit.load(), 3);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::ThreadPoolTest().Run(); }
@@ -0,0 +1,188 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+
+#include <miopen/trace.hpp>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+class TraceTest
+{
+    public:
+    void Run() const
+    {
+        Disabled();
+        Spans();
+        Threads();
+        Overflow();
+        trace::SetEnabled(false);
+    }
+
+    private:
+    static std::string Dump()
+    {
+        std::ostringstream ss;
+        trace::Write(ss);
+        return ss.str();
+    }
+
+    static std::size_t Count(const std::string& str, const std::string& what)
+    {
+        auto n = std::size_t{0};
+        for(auto pos = str.find(what); pos != std::string::npos; pos = str.find(what, pos + 1))
+            ++n;
+        return n;
+    }
+
+    static std::size_t CountEvents(const std::string& trace)
+    {
+        return Count(trace, "\"ph\":\"X\"");
+    }
+
+    /// Checks that brackets are balanced outside of the strings and the strings are terminated.
+    static bool IsWellFormed(const std::string& json)
+    {
+        auto depth     = 0;
+        auto in_string = false;
+        for(auto i = std::size_t{0}; i < json.size(); ++i)
+        {
+            const auto c = json[i];
+            if(in_string)
+            {
+                if(c == '\\')
+                    ++i;
+                else if(c == '"')
+                    in_string = false;
+                else if(static_cast<unsigned char>(c) < 0x20)
+                    return false;
+            }
+            else if(c == '"')
+                in_string = true;
+            else if(c == '{' || c == '[')
+                ++depth;
+            else if(c == '}' || c == ']')
+            {
+                if(--depth < 0)
+                    return false;
+            }
+        }
+        return depth == 0 && !in_string && json.front() == '{';
+    }
+
+    static void Disabled()
+    {
+        trace::SetEnabled(false);
+        trace::Clear();
+        {
+            MIOPEN_TRACE_SPAN("test", "disabled");
+            auto evaluated = false;
+            MIOPEN_TRACE_SPAN_DETAIL("test", "disabled", (evaluated = true, "detail"));
+            EXPECT(!evaluated);
+        }
+        const auto trace = Dump();
+        EXPECT(IsWellFormed(trace));
+        EXPECT_EQUAL(CountEvents(trace), std::size_t{0});
+    }
+
+    static void Spans()
+    {
+        trace::SetEnabled(true);
+        trace::Clear();
+        {
+            MIOPEN_TRACE_SPAN("test", "outer");
+            MIOPEN_TRACE_SPAN_DETAIL("test", "inner", std::string{"a \"quoted\"\n\\ detail"});
+
+            trace::Span span{"test", "ended"};
+            EXPECT(span.IsActive());
+            span.End();
+            span.End();
+            EXPECT(!span.IsActive());
+        }
+        const auto trace = Dump();
+        EXPECT(IsWellFormed(trace));
+        EXPECT_EQUAL(CountEvents(trace), std::size_t{3});
+        EXPECT_EQUAL(Count(trace, R"("name":"outer","cat":"test")"), std::size_t{1});
+        EXPECT_EQUAL(Count(trace, R"("detail":"a \"quoted\"\u000a\\ detail")"), std::size_t{1});
+    }
+
+    static void Threads()
+    {
+        const auto n_threads = std::size_t{4};
+        const auto n_spans   = std::size_t{100};
+
+        trace::SetEnabled(true);
+        trace::Clear();
+
+        auto threads = std::vector<std::thread>{};
+        for(auto i = std::size_t{0}; i < n_threads; ++i)
+        {
+            threads.emplace_back([]() {
+                for(auto j = std::size_t{0}; j < n_spans; ++j)
+                    MIOPEN_TRACE_SPAN("test", "thread");
+            });
+        }
+        // Writing concurrently with the recording threads shall be safe.
+        EXPECT(IsWellFormed(Dump()));
+        for(auto& thread : threads)
+            thread.join();
+
+        // Events of the finished threads are kept.
+        const auto trace = Dump();
+        EXPECT(IsWellFormed(trace));
+        EXPECT_EQUAL(CountEvents(trace), n_threads * n_spans);
+        EXPECT(Count(trace, "thread_name") >= n_threads + 1);
+    }
+
+    static void Overflow()
+    {
+        // Default MIOPEN_TRACE_BUFFER_SIZE.
+        const auto capacity = std::size_t{1} << 16;
+
+        trace::SetEnabled(true);
+        trace::Clear();
+
+        std::thread{[&]() {
+            for(auto i = std::size_t{0}; i < capacity + 10; ++i)
+                MIOPEN_TRACE_SPAN("test", i < 10 ? "dropped" : "kept");
+        }}.join();
+
+        const auto trace = Dump();
+        EXPECT(IsWellFormed(trace));
+        EXPECT_EQUAL(CountEvents(trace), capacity);
+        EXPECT_EQUAL(Count(trace, "\"dropped\""), std::size_t{0});
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::TraceTest().Run(); }
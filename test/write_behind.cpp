@@ -0,0 +1,293 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+
+#include <miopen/write_behind.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace miopen {
+namespace tests {
+
+/// Stands for a db: keeps the values written to it and counts the writes and batches.
+struct MockDb
+{
+    std::mutex mutex;
+    std::map<std::string, std::string> records;
+    std::atomic<int> n_writes{0};
+    std::atomic<int> n_batches{0};
+
+    WriteBehindQueue::Write Store(const std::string& key, const std::string& value)
+    {
+        return [this, key, value]() {
+            const std::lock_guard<std::mutex> lock(mutex);
+            records[key] = value;
+            ++n_writes;
+        };
+    }
+
+    WriteBehindQueue::Write Append(const std::string& key, const std::string& value)
+    {
+        return [this, key, value]() {
+            const std::lock_guard<std::mutex> lock(mutex);
+            records[key] += value;
+            ++n_writes;
+        };
+    }
+
+    WriteBehindQueue::Batch Batch()
+    {
+        return [this](const std::function<void()>& write) {
+            ++n_batches;
+            write();
+        };
+    }
+
+    std::string Find(const std::string& key)
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        const auto it = records.find(key);
+        return it != records.end() ? it->second : "";
+    }
+};
+
+class WriteBehindTest
+{
+    public:
+    void Run() const
+    {
+        TestDisabled();
+        TestCoalescing();
+        TestReadYourWrites();
+        TestTriggers();
+        TestErrors();
+        TestConcurrentWriters();
+        TestFork();
+    }
+
+    private:
+    static WriteBehindQueue::Options Options(bool enabled, int delay_ms, std::size_t max_pending)
+    {
+        return {enabled, std::chrono::milliseconds{delay_ms}, max_pending};
+    }
+
+    void TestDisabled() const
+    {
+        MockDb db;
+        WriteBehindQueue queue{Options(false, 1000, 100)};
+
+        queue.Push("db", "a", db.Store("a", "1"));
+        EXPECT_EQUAL(db.Find("a"), "1");
+        EXPECT_EQUAL(queue.GetPendingCount(), 0);
+
+        // Errors are not hidden from the caller.
+        EXPECT(throws([&]() {
+            queue.Push("db", "a", []() { throw std::runtime_error("write failed"); });
+        }));
+    }
+
+    void TestCoalescing() const
+    {
+        MockDb db;
+        WriteBehindQueue queue{Options(true, 60 * 1000, 100)};
+
+        queue.Push("db", "a", db.Store("a", "1"), WriteBehindQueue::Coalesce::Replace, db.Batch());
+        queue.Push("db", "a", db.Store("a", "2"), WriteBehindQueue::Coalesce::Replace, db.Batch());
+        queue.Push("db", "b", db.Append("b", "x"), WriteBehindQueue::Coalesce::Append);
+        queue.Push("db", "b", db.Append("b", "y"), WriteBehindQueue::Coalesce::Append);
+        EXPECT_EQUAL(queue.GetPendingCount(), 2);
+        EXPECT_EQUAL(db.n_writes.load(), 0);
+
+        queue.Flush();
+        EXPECT_EQUAL(queue.GetPendingCount(), 0);
+        EXPECT_EQUAL(db.Find("a"), "2");
+        EXPECT_EQUAL(db.Find("b"), "xy");
+        EXPECT_EQUAL(db.n_writes.load(), 3);
+        // All the records of a target are written in one batch.
+        EXPECT_EQUAL(db.n_batches.load(), 1);
+    }
+
+    void TestReadYourWrites() const
+    {
+        MockDb db;
+        WriteBehindQueue queue{Options(true, 60 * 1000, 100)};
+
+        queue.Push("db", "a", db.Store("a", "1"));
+        queue.Push("db", "b", db.Store("b", "2"));
+        queue.Push("other", "a", db.Store("c", "3"));
+
+        queue.Flush("db", "a");
+        EXPECT_EQUAL(db.Find("a"), "1");
+        EXPECT_EQUAL(db.Find("b"), "");
+        EXPECT_EQUAL(queue.GetPendingCount(), 2);
+
+        // No pending writes.
+        queue.Flush("db", "a");
+        queue.Flush("none", "a");
+        EXPECT_EQUAL(db.n_writes.load(), 1);
+    }
+
+    void TestTriggers() const
+    {
+        {
+            MockDb db;
+            WriteBehindQueue queue{Options(true, 10, 100)};
+            queue.Push("db", "a", db.Store("a", "1"));
+            WaitFor([&]() { return db.n_writes == 1; });
+            EXPECT_EQUAL(db.Find("a"), "1");
+        }
+
+        {
+            MockDb db;
+            WriteBehindQueue queue{Options(true, 60 * 1000, 3)};
+            queue.Push("db", "a", db.Store("a", "1"));
+            queue.Push("db", "b", db.Store("b", "1"));
+            EXPECT_EQUAL(db.n_writes.load(), 0);
+            queue.Push("db", "c", db.Store("c", "1"));
+            WaitFor([&]() { return db.n_writes == 3; });
+        }
+
+        // Pending writes are completed on destruction.
+        MockDb db;
+        {
+            WriteBehindQueue queue{Options(true, 60 * 1000, 100)};
+            queue.Push("db", "a", db.Store("a", "1"));
+        }
+        EXPECT_EQUAL(db.Find("a"), "1");
+    }
+
+    void TestErrors() const
+    {
+        MockDb db;
+        WriteBehindQueue queue{Options(true, 60 * 1000, 100)};
+
+        queue.Push("db", "a", []() { throw std::runtime_error("write failed"); });
+        queue.Push("db", "b", db.Store("b", "1"));
+        queue.Push("failing",
+                   "a",
+                   db.Store("a", "1"),
+                   WriteBehindQueue::Coalesce::Replace,
+                   [](const std::function<void()>&) { throw std::runtime_error("batch failed"); });
+        queue.Flush();
+        EXPECT_EQUAL(db.Find("b"), "1");
+        EXPECT_EQUAL(db.Find("a"), "");
+    }
+
+    void TestConcurrentWriters() const
+    {
+        const auto n_threads = 4;
+        const auto n_keys    = 100;
+
+        MockDb db;
+        WriteBehindQueue queue{Options(true, 1, 16)};
+        auto threads = std::vector<std::thread>{};
+        std::atomic<int> n_failed{0};
+
+        for(auto t = 0; t < n_threads; ++t)
+        {
+            threads.emplace_back([&, t]() {
+                for(auto i = 0; i < n_keys; ++i)
+                {
+                    const auto key = std::to_string(t) + ":" + std::to_string(i);
+                    queue.Push("db",
+                               key,
+                               db.Store(key, key),
+                               WriteBehindQueue::Coalesce::Replace,
+                               db.Batch());
+                    if(i % 10 == 0)
+                    {
+                        queue.Flush("db", key);
+                        if(db.Find(key) != key)
+                            ++n_failed;
+                    }
+                }
+            });
+        }
+
+        for(auto& thread : threads)
+            thread.join();
+        queue.Flush();
+
+        EXPECT_EQUAL(n_failed.load(), 0);
+        EXPECT_EQUAL(db.n_writes.load(), n_threads * n_keys);
+        EXPECT_EQUAL(db.records.size(), n_threads * n_keys);
+    }
+
+    void TestFork() const
+    {
+        auto& queue = WriteBehindQueue::Instance();
+        if(!queue.IsEnabled())
+            return;
+
+        MockDb db;
+        queue.Push("db", "parent", db.Store("parent", "1"));
+
+        const auto pid = fork();
+        EXPECT(pid >= 0);
+
+        if(pid == 0)
+        {
+            // The worker of the parent is not running in the child, so a hang is a failure.
+            alarm(10);
+            queue.Push("db", "child", db.Store("child", "1"));
+            queue.Flush();
+            // The parent performs its own pending writes.
+            const auto ok = db.Find("child") == "1" && db.Find("parent").empty();
+            std::exit(ok ? 0 : 1);
+        }
+
+        auto status = 0;
+        EXPECT(waitpid(pid, &status, 0) == pid);
+        EXPECT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+        queue.Flush();
+        EXPECT_EQUAL(db.Find("parent"), "1");
+    }
+
+    template <class F>
+    static void WaitFor(F condition)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+        while(!condition() && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        EXPECT(condition());
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::WriteBehindTest().Run(); }